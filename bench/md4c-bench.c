@@ -0,0 +1,1422 @@
+/*
+ * MD4C: Markdown parser for C
+ * (http://github.com/mity/md4c)
+ *
+ * Copyright (c) 2016-2020 Martin Mitas
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "md4c-html.h"
+#include "cmdline.h"
+
+
+#define SIZEOF_ARRAY(a)     (sizeof(a) / sizeof(a[0]))
+
+
+/* Global options. */
+static unsigned parser_flags = 0;
+static unsigned iterations = 0;
+static unsigned split_size = 0;
+
+
+/**********************
+ ***  Input corpus  ***
+ **********************/
+
+/* The whole input is read into a single buffer. With --split, it is then
+ * treated as a sequence of (small) documents, each one made of consecutive
+ * paragraphs (or other blocks separated by a blank line) until it reaches
+ * the given size. That mimics workloads consisting of many short comments.
+ */
+
+struct doc {
+    const MD_CHAR* text;
+    MD_SIZE size;
+};
+
+static MD_CHAR* input = NULL;
+static size_t input_size = 0;
+static struct doc* docs = NULL;
+static unsigned n_docs = 0;
+
+static void
+read_input(FILE* in)
+{
+    size_t alloc = 64 * 1024;
+    size_t n;
+
+    input = malloc(alloc);
+    if(input == NULL) {
+        fprintf(stderr, "read_input: malloc() failed.\n");
+        exit(1);
+    }
+
+    while(1) {
+        if(input_size >= alloc) {
+            alloc += alloc / 2;
+            input = realloc(input, alloc);
+            if(input == NULL) {
+                fprintf(stderr, "read_input: realloc() failed.\n");
+                exit(1);
+            }
+        }
+
+        n = fread(input + input_size, 1, alloc - input_size, in);
+        if(n == 0)
+            break;
+        input_size += n;
+    }
+}
+
+static void
+split_input(void)
+{
+    size_t off = 0;
+
+    docs = malloc((split_size > 0 ? input_size / split_size + 1 : 1) * sizeof(struct doc));
+    if(docs == NULL) {
+        fprintf(stderr, "split_input: malloc() failed.\n");
+        exit(1);
+    }
+
+    if(split_size == 0) {
+        docs[0].text = input;
+        docs[0].size = (MD_SIZE) input_size;
+        n_docs = 1;
+        return;
+    }
+
+    while(off < input_size) {
+        size_t end = off + split_size;
+
+        if(end >= input_size) {
+            end = input_size;
+        } else {
+            /* Extend the document up to the nearest blank line. */
+            while(end < input_size  &&
+                  !(input[end] == '\n'  &&  end+1 < input_size  &&  input[end+1] == '\n'))
+                end++;
+            if(end < input_size)
+                end += 2;
+        }
+
+        docs[n_docs].text = input + off;
+        docs[n_docs].size = (MD_SIZE)(end - off);
+        n_docs++;
+        off = end;
+    }
+}
+
+
+/*******************
+ ***  Utilities  ***
+ *******************/
+
+static double
+now(void)
+{
+    return (double) clock() / CLOCKS_PER_SEC;
+}
+
+/* clock() measures the CPU time of all the threads, so we need the wall
+ * clock time for the "threads" benchmark. */
+static double
+now_wall(void)
+{
+#if defined CLOCK_MONOTONIC
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+#else
+    return (double) time(NULL);
+#endif
+}
+
+static void
+report(const char* name, double elapsed, unsigned n_iterations, size_t n_bytes)
+{
+    double per_doc = elapsed / ((double) n_iterations * n_docs);
+    double throughput = ((double) n_bytes * n_iterations) / elapsed / (1024.0 * 1024.0);
+
+    printf("  %-24s %10.3f ms total  %10.0f ns/doc  %9.2f MB/s\n",
+           name, elapsed * 1e3, per_doc * 1e9, throughput);
+}
+
+/* A parser which does nothing in its callbacks, so we measure just the
+ * parser itself. */
+
+static int
+null_block_callback(MD_BLOCKTYPE type, void* detail, void* userdata)
+{
+    return 0;
+}
+
+static int
+null_span_callback(MD_SPANTYPE type, void* detail, void* userdata)
+{
+    return 0;
+}
+
+static int
+null_text_callback(MD_TEXTTYPE type, const MD_CHAR* text, MD_SIZE size, void* userdata)
+{
+    return 0;
+}
+
+static void
+null_parser(MD_PARSER* parser)
+{
+    memset(parser, 0, sizeof(MD_PARSER));
+    parser->flags = parser_flags;
+    parser->enter_block = null_block_callback;
+    parser->leave_block = null_block_callback;
+    parser->enter_span = null_span_callback;
+    parser->leave_span = null_span_callback;
+    parser->text = null_text_callback;
+}
+
+
+/* Pick number of iterations so each measured variant runs about a second
+ * (unless specified explicitly with --iterations). */
+static unsigned
+calibrate_iterations(void)
+{
+    MD_PARSER parser;
+    unsigned n = 1;
+
+    if(iterations > 0)
+        return iterations;
+
+    null_parser(&parser);
+
+    while(n < (1U << 24)) {
+        double t0 = now();
+        unsigned i, j;
+
+        for(i = 0; i < n; i++) {
+            for(j = 0; j < n_docs; j++)
+                md_parse(docs[j].text, docs[j].size, &parser, NULL);
+        }
+
+        if(now() - t0 > 0.1)
+            return n * 10;
+        n *= 2;
+    }
+
+    return n;
+}
+
+
+/********************
+ ***  Benchmarks  ***
+ ********************/
+
+/* Plain md_parse(). */
+static void
+bench_parse(unsigned n_iterations)
+{
+    MD_PARSER parser;
+    double t0;
+    unsigned i, j;
+
+    null_parser(&parser);
+
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++)
+            md_parse(docs[j].text, docs[j].size, &parser, NULL);
+    }
+    report("md_parse()", now() - t0, n_iterations, input_size);
+}
+
+/* Compare md_parse() with a reused MD_PARSER_HANDLE. */
+static void
+bench_reuse(unsigned n_iterations)
+{
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    double t0;
+    unsigned i, j;
+
+    null_parser(&parser);
+
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++)
+            md_parse(docs[j].text, docs[j].size, &parser, NULL);
+    }
+    report("md_parse()", now() - t0, n_iterations, input_size);
+
+    handle = md_parser_create(&parser);
+    if(handle == NULL) {
+        fprintf(stderr, "md_parser_create() failed.\n");
+        exit(1);
+    }
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++)
+            md_parser_parse(handle, docs[j].text, docs[j].size, NULL);
+    }
+    report("md_parser_parse()", now() - t0, n_iterations, input_size);
+    md_parser_destroy(handle);
+}
+
+
+/* Allocator counting calls, to see how many times the parser hits it. */
+static unsigned long n_alloc_calls;
+
+static void*
+counting_malloc(size_t size, void* userdata)
+{
+    n_alloc_calls++;
+    return malloc(size);
+}
+
+static void*
+counting_realloc(void* ptr, size_t size, void* userdata)
+{
+    n_alloc_calls++;
+    return realloc(ptr, size);
+}
+
+static void
+counting_free(void* ptr, void* userdata)
+{
+    n_alloc_calls++;
+    free(ptr);
+}
+
+static const MD_ALLOCATOR counting_allocator = {
+    counting_malloc, counting_realloc, counting_free, NULL
+};
+
+/* Compare the default allocation with MD_ALLOC_ARENA. */
+static void
+bench_alloc(unsigned n_iterations)
+{
+    static const struct {
+        const char* name;
+        unsigned alloc_flags;
+    } variants[] = {
+        { "md_parse()",                 0 },
+        { "md_parse() + arena",         MD_ALLOC_ARENA }
+    };
+    MD_PARSER parser;
+    double t0;
+    unsigned i, j, k;
+
+    null_parser(&parser);
+    parser.abi_version = MD_PARSER_ABI_VERSION;
+    parser.allocator = &counting_allocator;
+
+    for(k = 0; k < SIZEOF_ARRAY(variants); k++) {
+        parser.alloc_flags = variants[k].alloc_flags;
+        n_alloc_calls = 0;
+        t0 = now();
+        for(i = 0; i < n_iterations; i++) {
+            for(j = 0; j < n_docs; j++)
+                md_parse(docs[j].text, docs[j].size, &parser, NULL);
+        }
+        report(variants[k].name, now() - t0, n_iterations, input_size);
+        printf("  %-24s %10.1f allocator calls/doc\n", "",
+               (double) n_alloc_calls / ((double) n_iterations * n_docs));
+    }
+}
+
+
+/* Compare md_parser_parse() with feeding the input in chunks via
+ * md_parser_feed(). */
+static void
+bench_stream(unsigned n_iterations)
+{
+    static const size_t chunk_sizes[] = { 64, 4096, 65536 };
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    char name[64];
+    double t0;
+    unsigned i, j, k;
+    size_t off, n;
+
+    null_parser(&parser);
+    handle = md_parser_create(&parser);
+    if(handle == NULL) {
+        fprintf(stderr, "md_parser_create() failed.\n");
+        exit(1);
+    }
+
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++)
+            md_parser_parse(handle, docs[j].text, docs[j].size, NULL);
+    }
+    report("md_parser_parse()", now() - t0, n_iterations, input_size);
+
+    for(k = 0; k < SIZEOF_ARRAY(chunk_sizes); k++) {
+        t0 = now();
+        for(i = 0; i < n_iterations; i++) {
+            for(j = 0; j < n_docs; j++) {
+                md_parser_begin(handle, NULL);
+                for(off = 0; off < docs[j].size; off += n) {
+                    n = docs[j].size - off;
+                    if(n > chunk_sizes[k])
+                        n = chunk_sizes[k];
+                    md_parser_feed(handle, docs[j].text + off, (MD_SIZE) n);
+                }
+                md_parser_finish(handle);
+            }
+        }
+        snprintf(name, sizeof(name), "md_parser_feed(%u B)", (unsigned) chunk_sizes[k]);
+        report(name, now() - t0, n_iterations, input_size);
+    }
+
+    md_parser_destroy(handle);
+}
+
+
+/* Simulate typing into the middle of each document: Insert a character and
+ * then delete it again. Compare parsing the whole document after each
+ * keystroke with md_parser_reparse(). */
+static void
+bench_reparse(unsigned n_iterations)
+{
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    MD_REPARSE_INFO info;
+    MD_EDIT edit;
+    MD_CHAR* text;
+    MD_SIZE size;
+    double t_full = 0.0;
+    double t_incr = 0.0;
+    double t0;
+    unsigned i, j;
+
+    null_parser(&parser);
+    handle = md_parser_create(&parser);
+    text = malloc(input_size + 1);
+    if(handle == NULL  ||  text == NULL) {
+        fprintf(stderr, "bench_reparse: out of memory.\n");
+        exit(1);
+    }
+
+    for(j = 0; j < n_docs; j++) {
+        size = docs[j].size;
+        memcpy(text, docs[j].text, size);
+        edit.beg = size / 2;
+
+        t0 = now();
+        for(i = 0; i < n_iterations; i++) {
+            memmove(text + edit.beg + 1, text + edit.beg, size - edit.beg);
+            text[edit.beg] = 'x';
+            md_parser_parse(handle, text, size + 1, NULL);
+            memmove(text + edit.beg, text + edit.beg + 1, size - edit.beg);
+            md_parser_parse(handle, text, size, NULL);
+        }
+        t_full += now() - t0;
+
+        md_parser_reparse(handle, text, size, NULL, &info, NULL);
+        t0 = now();
+        for(i = 0; i < n_iterations; i++) {
+            memmove(text + edit.beg + 1, text + edit.beg, size - edit.beg);
+            text[edit.beg] = 'x';
+            edit.old_size = 0;
+            edit.new_size = 1;
+            md_parser_reparse(handle, text, size + 1, &edit, &info, NULL);
+            memmove(text + edit.beg, text + edit.beg + 1, size - edit.beg);
+            edit.old_size = 1;
+            edit.new_size = 0;
+            md_parser_reparse(handle, text, size, &edit, &info, NULL);
+        }
+        t_incr += now() - t0;
+    }
+
+    /* (Per keystroke.) */
+    report("md_parser_parse()", t_full, 2 * n_iterations, input_size);
+    report("md_parser_reparse()", t_incr, 2 * n_iterations, input_size);
+
+    free(text);
+    md_parser_destroy(handle);
+}
+
+
+/* Parse with md_parser_set_thread_count() set to 1, 2, 4 and 8. */
+static void
+bench_threads(unsigned n_iterations)
+{
+    static const unsigned thread_counts[] = { 1, 2, 4, 8 };
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    char name[64];
+    double t0;
+    unsigned i, j, k;
+
+    null_parser(&parser);
+    handle = md_parser_create(&parser);
+    if(handle == NULL) {
+        fprintf(stderr, "md_parser_create() failed.\n");
+        exit(1);
+    }
+
+    for(k = 0; k < SIZEOF_ARRAY(thread_counts); k++) {
+        if(md_parser_set_thread_count(handle, thread_counts[k]) != 0) {
+            fprintf(stderr, "md_parser_set_thread_count() failed.\n");
+            break;
+        }
+
+        t0 = now_wall();
+        for(i = 0; i < n_iterations; i++) {
+            for(j = 0; j < n_docs; j++)
+                md_parser_parse(handle, docs[j].text, docs[j].size, NULL);
+        }
+        snprintf(name, sizeof(name), "%u thread(s)", thread_counts[k]);
+        report(name, now_wall() - t0, n_iterations, input_size);
+    }
+
+    md_parser_destroy(handle);
+}
+
+/* Time to the first leaf block reported, with and without MD_FLAG_NOREFDEFS
+ * (which allows the parser to report blocks before it sees the whole
+ * document). */
+struct first_block {
+    double t0;
+    double elapsed;
+};
+
+static int
+first_block_callback(MD_BLOCKTYPE type, void* detail, void* userdata)
+{
+    struct first_block* fb = (struct first_block*) userdata;
+
+    if(fb->elapsed < 0.0  &&  type != MD_BLOCK_DOC)
+        fb->elapsed = now_wall() - fb->t0;
+    return 0;
+}
+
+static void
+bench_first_block(unsigned n_iterations)
+{
+    static const char* names[] = { "md_parse()", "md_parse(NOREFDEFS)" };
+    MD_PARSER parser;
+    struct first_block fb;
+    double t0, first_total;
+    unsigned i, j, k;
+
+    null_parser(&parser);
+    parser.enter_block = first_block_callback;
+
+    for(k = 0; k < SIZEOF_ARRAY(names); k++) {
+        if(k == 1)
+            parser.flags |= MD_FLAG_NOREFDEFS;
+
+        first_total = 0.0;
+        t0 = now_wall();
+        for(i = 0; i < n_iterations; i++) {
+            for(j = 0; j < n_docs; j++) {
+                fb.t0 = now_wall();
+                fb.elapsed = -1.0;
+                md_parse(docs[j].text, docs[j].size, &parser, &fb);
+                if(fb.elapsed > 0.0)
+                    first_total += fb.elapsed;
+            }
+        }
+        report(names[k], now_wall() - t0, n_iterations, input_size);
+        printf("  %-24s %10.0f ns to the first block\n", "",
+               first_total / ((double) n_iterations * n_docs) * 1e9);
+    }
+}
+
+
+/* Walking the document once more: parse again vs. replay a tree built by
+ * md_parse_to_tree(). */
+static void
+bench_tree(unsigned n_iterations)
+{
+    MD_PARSER parser;
+    MD_TREE** trees;
+    double t0;
+    unsigned i, j;
+
+    null_parser(&parser);
+
+    trees = (MD_TREE**) malloc(n_docs * sizeof(MD_TREE*));
+    if(trees == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        return;
+    }
+
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++) {
+            md_parse_to_tree(docs[j].text, docs[j].size, &parser, &trees[j]);
+            if(i + 1 < n_iterations)
+                md_tree_free(trees[j]);
+        }
+    }
+    report("md_parse_to_tree()", now() - t0, n_iterations, input_size);
+
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++)
+            md_parse(docs[j].text, docs[j].size, &parser, NULL);
+    }
+    report("md_parse()", now() - t0, n_iterations, input_size);
+
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++)
+            md_tree_replay(trees[j], &parser, NULL);
+    }
+    report("md_tree_replay()", now() - t0, n_iterations, input_size);
+
+    for(j = 0; j < n_docs; j++)
+        md_tree_free(trees[j]);
+    free(trees);
+}
+
+/* Parse again vs. replay a stored event log. */
+static void
+bench_event_log(unsigned n_iterations)
+{
+    MD_PARSER parser;
+    void** logs;
+    size_t* log_sizes;
+    size_t total_log_size = 0;
+    double t0;
+    unsigned i, j;
+
+    null_parser(&parser);
+
+    logs = (void**) malloc(n_docs * sizeof(void*));
+    log_sizes = (size_t*) malloc(n_docs * sizeof(size_t));
+    if(logs == NULL  ||  log_sizes == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        free(logs);
+        free(log_sizes);
+        return;
+    }
+
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++) {
+            md_parse_to_event_log(docs[j].text, docs[j].size, &parser, &logs[j], &log_sizes[j]);
+            if(i + 1 < n_iterations)
+                md_event_log_free(logs[j], &parser);
+        }
+    }
+    report("md_parse_to_event_log()", now() - t0, n_iterations, input_size);
+
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++)
+            md_parse(docs[j].text, docs[j].size, &parser, NULL);
+    }
+    report("md_parse()", now() - t0, n_iterations, input_size);
+
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++)
+            md_event_log_replay(logs[j], log_sizes[j], docs[j].text, docs[j].size, &parser, NULL);
+    }
+    report("md_event_log_replay()", now() - t0, n_iterations, input_size);
+
+    for(j = 0; j < n_docs; j++) {
+        total_log_size += log_sizes[j];
+        md_event_log_free(logs[j], &parser);
+    }
+    printf("  %-24s %10lu bytes of log per %lu bytes of input\n", "",
+           (unsigned long) total_log_size, (unsigned long) input_size);
+    free(logs);
+    free(log_sizes);
+}
+
+/* One indirect call per event vs. md_parser_set_event_sink(). */
+static int
+null_flush_callback(const MD_EVENT* events, unsigned n_events, void* userdata)
+{
+    return 0;
+}
+
+static void
+null_output(const MD_CHAR* text, MD_SIZE size, void* userdata)
+{
+}
+
+static void
+bench_batch(unsigned n_iterations)
+{
+    MD_EVENT events[256];
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    double t0;
+    unsigned i, j, k;
+
+    null_parser(&parser);
+    handle = md_parser_create(&parser);
+    if(handle == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        return;
+    }
+
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++)
+            md_parser_parse(handle, docs[j].text, docs[j].size, NULL);
+    }
+    report("callbacks", now() - t0, n_iterations, input_size);
+
+    md_parser_set_event_sink(handle, events, SIZEOF_ARRAY(events), null_flush_callback);
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++)
+            md_parser_parse(handle, docs[j].text, docs[j].size, NULL);
+    }
+    report("event sink", now() - t0, n_iterations, input_size);
+    md_parser_destroy(handle);
+
+    for(k = 0; k < 2; k++) {
+        unsigned renderer_flags = (k == 0 ? 0 : MD_HTML_FLAG_BATCHED);
+
+        t0 = now();
+        for(i = 0; i < n_iterations; i++) {
+            for(j = 0; j < n_docs; j++)
+                md_html(docs[j].text, docs[j].size, null_output, NULL, parser_flags, renderer_flags);
+        }
+        report((k == 0 ? "md_html()" : "md_html(BATCHED)"), now() - t0, n_iterations, input_size);
+    }
+}
+
+/* A generated document with 100k reference definitions, each used once (in
+ * a different letter case), as seen in documents generated from API
+ * references. (The input file is not used.) */
+#define REF_DEFS_COUNT      100000
+
+static void
+bench_ref_defs(unsigned n_iterations)
+{
+    MD_PARSER parser;
+    MD_CHAR* text;
+    size_t size = 0;
+    double t0;
+    unsigned i;
+
+    null_parser(&parser);
+
+    text = (MD_CHAR*) malloc(REF_DEFS_COUNT * 96);
+    if(text == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        return;
+    }
+    for(i = 0; i < REF_DEFS_COUNT; i++)
+        size += sprintf(text + size, "[Api::Symbol_%u]: /api/symbol_%u.html\n", i, i);
+    size += sprintf(text + size, "\n");
+    for(i = 0; i < REF_DEFS_COUNT; i++)
+        size += sprintf(text + size, "See [API::SYMBOL_%u].\n", (i * 7919) % REF_DEFS_COUNT);
+
+    /* The iteration count calibrated for the input file is meaningless here. */
+    n_iterations = 5;
+
+    t0 = now();
+    for(i = 0; i < n_iterations; i++)
+        md_parse(text, (MD_SIZE) size, &parser, NULL);
+    printf("  %-24s %10.3f ms per document (%u ref. defs, %lu bytes)\n", "md_parse()",
+           (now() - t0) * 1e3 / n_iterations, REF_DEFS_COUNT, (unsigned long) size);
+
+    free(text);
+}
+
+/* Compare appending shared ref. defs to each document with MD_PARSER::ref_dict. */
+#define REF_DICT_COUNT      20000
+
+static void
+bench_ref_dict(unsigned n_iterations)
+{
+    MD_PARSER parser;
+    MD_REF_DICT* dict;
+    MD_CHAR* footer;
+    MD_CHAR** pages;
+    size_t footer_size = 0;
+    unsigned n_pages;
+    double t0, elapsed;
+    unsigned i, j;
+
+    null_parser(&parser);
+
+    footer = (MD_CHAR*) malloc(REF_DICT_COUNT * 64);
+    pages = (MD_CHAR**) malloc(n_docs * sizeof(MD_CHAR*));
+    if(footer == NULL  ||  pages == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+    for(i = 0; i < REF_DICT_COUNT; i++)
+        footer_size += sprintf(footer + footer_size, "[Api::Symbol_%u]: /api/symbol_%u.html\n", i, i);
+    for(j = 0; j < n_docs; j++) {
+        pages[j] = (MD_CHAR*) malloc(docs[j].size + 2 + footer_size);
+        if(pages[j] == NULL) {
+            fprintf(stderr, "Out of memory.\n");
+            exit(1);
+        }
+        memcpy(pages[j], docs[j].text, docs[j].size);
+        memcpy(pages[j] + docs[j].size, "\n\n", 2);
+        memcpy(pages[j] + docs[j].size + 2, footer, footer_size);
+    }
+
+    /* The footer dominates the time, so just parse as many documents as we
+     * manage in about a second. */
+    n_pages = 0;
+    t0 = now();
+    do {
+        j = n_pages++ % n_docs;
+        md_parse(pages[j], docs[j].size + 2 + (MD_SIZE) footer_size, &parser, NULL);
+        elapsed = now() - t0;
+    } while(elapsed < 1.0);
+    printf("  %-24s %10.3f ms total  %10.0f ns/doc\n", "md_parse() + footer",
+           elapsed * 1e3, elapsed * 1e9 / n_pages);
+
+    t0 = now();
+    if(md_ref_dict_create(footer, (MD_SIZE) footer_size, &parser, &dict) != 0) {
+        fprintf(stderr, "md_ref_dict_create() failed.\n");
+        exit(1);
+    }
+    printf("  %-24s %10.3f ms (%u ref. defs)\n", "md_ref_dict_create()",
+           (now() - t0) * 1e3, REF_DICT_COUNT);
+
+    parser.abi_version = MD_PARSER_ABI_VERSION;
+    parser.ref_dict = dict;
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++)
+            md_parse(docs[j].text, docs[j].size, &parser, NULL);
+    }
+    report("md_parse() + ref_dict", now() - t0, n_iterations, input_size);
+
+    md_ref_dict_free(dict);
+    for(j = 0; j < n_docs; j++)
+        free(pages[j]);
+    free(pages);
+    free(footer);
+}
+
+/* Non-Latin text, where recognizing emphasis and link labels needs Unicode
+ * punctuation, whitespace and case folding. The text is generated from
+ * pseudo-random codepoints of the given script. */
+#define UNICODE_DOC_SIZE    (1024 * 1024)
+
+static unsigned unicode_seed;
+
+static unsigned
+unicode_random(unsigned n)
+{
+    unicode_seed = unicode_seed * 1103515245 + 12345;
+    return (unicode_seed >> 16) % n;
+}
+
+static size_t
+unicode_put(MD_CHAR* buf, unsigned codepoint)
+{
+    if(codepoint < 0x80) {
+        buf[0] = (MD_CHAR) codepoint;
+        return 1;
+    } else if(codepoint < 0x800) {
+        buf[0] = (MD_CHAR) (0xc0 | (codepoint >> 6));
+        buf[1] = (MD_CHAR) (0x80 | (codepoint & 0x3f));
+        return 2;
+    } else {
+        buf[0] = (MD_CHAR) (0xe0 | (codepoint >> 12));
+        buf[1] = (MD_CHAR) (0x80 | ((codepoint >> 6) & 0x3f));
+        buf[2] = (MD_CHAR) (0x80 | (codepoint & 0x3f));
+        return 3;
+    }
+}
+
+/* Generate a document of paragraphs made of "words" of codepoints from
+ * [letter_min, letter_max], separated by 'space' (if any). Some words are
+ * emphasized, some are quoted by the given punctuation, and some are
+ * reference links to one of the labels defined at the end of the document,
+ * with the case of the label changed. */
+static size_t
+unicode_generate(MD_CHAR* buf, unsigned letter_min, unsigned letter_max, unsigned case_delta,
+                 unsigned space, unsigned quote_open, unsigned quote_close, unsigned full_stop)
+{
+    size_t size = 0;
+    unsigned i, j;
+
+    unicode_seed = 1;
+    while(size < UNICODE_DOC_SIZE - 4096) {
+        unsigned n_words = 20 + unicode_random(40);
+
+        for(i = 0; i < n_words; i++) {
+            unsigned n_letters = 1 + unicode_random(6);
+            unsigned kind = unicode_random(8);
+
+            if(i > 0  &&  space != 0)
+                size += unicode_put(buf + size, space);
+            if(kind == 0)
+                size += unicode_put(buf + size, quote_open);
+            if(kind <= 1)
+                size += unicode_put(buf + size, '*');
+            if(kind == 2) {
+                size += sprintf(buf + size, "[");
+                for(j = 0; j < 3; j++)
+                    size += unicode_put(buf + size, letter_min + j + case_delta);
+                size += sprintf(buf + size, "%u]", unicode_random(100));
+            } else {
+                for(j = 0; j < n_letters; j++)
+                    size += unicode_put(buf + size, letter_min + unicode_random(letter_max - letter_min + 1));
+            }
+            if(kind <= 1)
+                size += unicode_put(buf + size, '*');
+            if(kind == 0)
+                size += unicode_put(buf + size, quote_close);
+        }
+        size += unicode_put(buf + size, full_stop);
+        size += sprintf(buf + size, "\n\n");
+    }
+
+    for(i = 0; i < 100; i++) {
+        size += sprintf(buf + size, "[");
+        for(j = 0; j < 3; j++)
+            size += unicode_put(buf + size, letter_min + j);
+        size += sprintf(buf + size, "%u]: /link/%u\n", i, i);
+    }
+
+    return size;
+}
+
+static void
+bench_unicode(unsigned n_iterations)
+{
+    static const struct {
+        const char* name;
+        unsigned letter_min;
+        unsigned letter_max;
+        unsigned case_delta;
+        unsigned space;
+        unsigned quote_open;
+        unsigned quote_close;
+        unsigned full_stop;
+    } corpora[] = {
+        /* U+0430..U+044F (lower-case letters), labels upper-cased. */
+        { "Cyrillic",   0x0430, 0x044f, (unsigned) -0x20, ' ', 0x00ab, 0x00bb, '.' },
+        /* CJK ideographs, no spaces, full-width punctuation. */
+        { "CJK",        0x4e00, 0x9fa5, 0, 0, 0x300c, 0x300d, 0x3002 }
+    };
+    MD_PARSER parser;
+    MD_CHAR* text;
+    double t0, elapsed;
+    unsigned i, k;
+
+    null_parser(&parser);
+
+    text = (MD_CHAR*) malloc(UNICODE_DOC_SIZE);
+    if(text == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+
+    /* The iteration count calibrated for the input file is meaningless here. */
+    n_iterations = 20;
+
+    for(k = 0; k < SIZEOF_ARRAY(corpora); k++) {
+        size_t size = unicode_generate(text, corpora[k].letter_min, corpora[k].letter_max,
+                        corpora[k].case_delta, corpora[k].space,
+                        corpora[k].quote_open, corpora[k].quote_close, corpora[k].full_stop);
+
+        t0 = now();
+        for(i = 0; i < n_iterations; i++)
+            md_parse(text, (MD_SIZE) size, &parser, NULL);
+        elapsed = now() - t0;
+        printf("  %-24s %10.3f ms per document  %9.2f MB/s\n", corpora[k].name,
+               elapsed * 1e3 / n_iterations,
+               ((double) size * n_iterations) / elapsed / (1024.0 * 1024.0));
+    }
+
+    free(text);
+}
+
+
+/* md_parse() with MD_PARSER::stats, and where the time goes. */
+static void
+bench_stats(unsigned n_iterations)
+{
+    MD_PARSER parser;
+    MD_PARSE_STATS stats;
+    MD_PARSE_STATS total;
+    double t0;
+    unsigned i, j;
+
+    null_parser(&parser);
+    parser.abi_version = MD_PARSER_ABI_VERSION;
+
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++)
+            md_parse(docs[j].text, docs[j].size, &parser, NULL);
+    }
+    report("md_parse()", now() - t0, n_iterations, input_size);
+
+    parser.stats = &stats;
+    memset(&total, 0, sizeof(MD_PARSE_STATS));
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++) {
+            md_parse(docs[j].text, docs[j].size, &parser, NULL);
+            total.line_analysis_time += stats.line_analysis_time;
+            total.ref_def_time += stats.ref_def_time;
+            total.mark_collection_time += stats.mark_collection_time;
+            total.mark_resolution_time += stats.mark_resolution_time;
+            total.emission_time += stats.emission_time;
+            if(i == 0) {
+                total.n_lines += stats.n_lines;
+                total.n_blocks += stats.n_blocks;
+                total.n_marks += stats.n_marks;
+                total.n_rollbacks += stats.n_rollbacks;
+                total.n_ref_defs += stats.n_ref_defs;
+                total.n_ref_def_lookups += stats.n_ref_def_lookups;
+            }
+        }
+    }
+    report("md_parse() + stats", now() - t0, n_iterations, input_size);
+
+    printf("  %-24s %10.3f ms per iteration\n", "line analysis",
+           total.line_analysis_time * 1e3 / n_iterations);
+    printf("  %-24s %10.3f ms per iteration\n", "ref. defs",
+           total.ref_def_time * 1e3 / n_iterations);
+    printf("  %-24s %10.3f ms per iteration\n", "mark collection",
+           total.mark_collection_time * 1e3 / n_iterations);
+    printf("  %-24s %10.3f ms per iteration\n", "mark resolution",
+           total.mark_resolution_time * 1e3 / n_iterations);
+    printf("  %-24s %10.3f ms per iteration\n", "emission",
+           total.emission_time * 1e3 / n_iterations);
+    printf("  %-24s %u lines, %u blocks, %u marks, %u rollbacks, %u ref. defs, %u lookups\n", "",
+           total.n_lines, total.n_blocks, total.n_marks, total.n_rollbacks,
+           total.n_ref_defs, total.n_ref_def_lookups);
+}
+
+/* md_html_ex() with various sizes of the output buffer. The output callback
+ * only counts the calls (in a language binding each of them would be costly). */
+static unsigned long n_output_calls;
+
+static void
+counting_output(const MD_CHAR* text, MD_SIZE size, void* userdata)
+{
+    n_output_calls++;
+}
+
+struct out_buffer {
+    MD_CHAR* data;
+    MD_SIZE size;
+    MD_SIZE alloc;
+};
+
+static void
+copying_output(const MD_CHAR* text, MD_SIZE size, void* userdata)
+{
+    struct out_buffer* out = (struct out_buffer*) userdata;
+
+    memcpy(out->data + out->size, text, size);
+    out->size += size;
+}
+
+static void
+bench_html(unsigned n_iterations)
+{
+    static const struct {
+        const char* name;
+        MD_SIZE size;
+    } variants[] = {
+        { "unbuffered",     0 },
+        { "256 B buffer",   256 },
+        { "4 kB buffer",    MD_HTML_OUTPUT_BUFFER_SIZE },
+        { "64 kB buffer",   64 * 1024 }
+    };
+    struct out_buffer out = { NULL, 0, 0 };
+    unsigned long n_segments;
+    size_t total_size, ref_size;
+    double t0;
+    unsigned i, j, k;
+
+    for(k = 0; k < SIZEOF_ARRAY(variants); k++) {
+        n_output_calls = 0;
+        t0 = now();
+        for(i = 0; i < n_iterations; i++) {
+            for(j = 0; j < n_docs; j++) {
+                md_html_ex(docs[j].text, docs[j].size, counting_output, NULL,
+                           parser_flags, 0, variants[k].size);
+            }
+        }
+        report(variants[k].name, now() - t0, n_iterations, input_size);
+        printf("  %-24s %10lu process_output() calls per iteration\n", "",
+               n_output_calls / n_iterations);
+    }
+
+    /* Collecting the output in a (preallocated) buffer: Copying it there in
+     * the callback vs. rendering right into it. */
+    for(j = 0; j < n_docs; j++) {
+        MD_SIZE size;
+
+        md_html_to_buffer(docs[j].text, docs[j].size, NULL, 0, parser_flags, 0, &size);
+        if(size > out.alloc)
+            out.alloc = size;
+    }
+    out.data = (MD_CHAR*) malloc(out.alloc);
+    if(out.data == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++) {
+            out.size = 0;
+            md_html(docs[j].text, docs[j].size, copying_output, &out, parser_flags, 0);
+        }
+    }
+    report("md_html() + copy", now() - t0, n_iterations, input_size);
+
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++) {
+            MD_SIZE size;
+            md_html_to_buffer(docs[j].text, docs[j].size, out.data, out.alloc, parser_flags, 0, &size);
+        }
+    }
+    report("md_html_to_buffer()", now() - t0, n_iterations, input_size);
+
+    free(out.data);
+
+    /* Segments for writev(): How many, and how much of the output is not
+     * copied. */
+    n_segments = 0;
+    total_size = 0;
+    ref_size = 0;
+    t0 = now();
+    for(i = 0; i < n_iterations; i++) {
+        for(j = 0; j < n_docs; j++) {
+            MD_HTML_SEGMENTS* segments;
+
+            if(md_html_to_segments(docs[j].text, docs[j].size, parser_flags, 0, &segments) != 0)
+                continue;
+            if(i == 0) {
+                for(k = 0; k < segments->n_segments; k++) {
+                    const MD_HTML_SEGMENT* seg = &segments->segments[k];
+                    if(docs[j].text <= seg->text  &&  seg->text < docs[j].text + docs[j].size)
+                        ref_size += seg->size;
+                }
+                n_segments += segments->n_segments;
+                total_size += segments->total_size;
+            }
+            md_html_segments_free(segments);
+        }
+    }
+    report("md_html_to_segments()", now() - t0, n_iterations, input_size);
+    printf("  %-24s %10lu segments per iteration, %.1f%% of output referenced\n", "",
+           n_segments, (total_size > 0 ? 100.0 * (double) ref_size / (double) total_size : 0.0));
+}
+
+/* Escaping in the HTML renderer: A fenced code block with a varying density
+ * of characters which need to be escaped, and links with long URLs. (The
+ * input file is not used.) */
+#define ESCAPE_DOC_SIZE     (1024 * 1024)
+
+static void
+bench_escape(unsigned n_iterations)
+{
+    static const unsigned densities[] = { 0, 1, 10, 50 };
+    MD_CHAR* text;
+    char name[64];
+    size_t size;
+    double t0, elapsed;
+    unsigned i, k;
+
+    text = (MD_CHAR*) malloc(ESCAPE_DOC_SIZE + 256);
+    if(text == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+
+    /* The iteration count calibrated for the input file is meaningless here. */
+    n_iterations = 20;
+
+    for(k = 0; k < SIZEOF_ARRAY(densities) + 1; k++) {
+        unicode_seed = 1;
+        if(k < SIZEOF_ARRAY(densities)) {
+            size = sprintf(text, "```\n");
+            while(size < ESCAPE_DOC_SIZE) {
+                for(i = 0; i < 79; i++) {
+                    if(unicode_random(100) < densities[k])
+                        text[size++] = "\"&<>"[unicode_random(4)];
+                    else
+                        text[size++] = 'a' + unicode_random(26);
+                }
+                text[size++] = '\n';
+            }
+            size += sprintf(text + size, "```\n");
+            snprintf(name, sizeof(name), "code, %u%% escaped", densities[k]);
+        } else {
+            size = 0;
+            while(size < ESCAPE_DOC_SIZE) {
+                size += sprintf(text + size, "[link](https://example.com/");
+                for(i = 0; i < 200; i++)
+                    text[size++] = (i % 50 == 49 ? '^' : 'a' + unicode_random(26));
+                size += sprintf(text + size, ")\n");
+            }
+            snprintf(name, sizeof(name), "long URLs");
+        }
+
+        t0 = now();
+        for(i = 0; i < n_iterations; i++)
+            md_html(text, (MD_SIZE) size, null_output, NULL, parser_flags, 0);
+        elapsed = now() - t0;
+        printf("  %-24s %10.3f ms per document  %9.2f MB/s\n", name,
+               elapsed * 1e3 / n_iterations,
+               ((double) size * n_iterations) / elapsed / (1024.0 * 1024.0));
+    }
+
+    free(text);
+}
+
+/* Entity-dense text (as in math or in documents converted from HTML): The
+ * parser reporting the entities to text() vs. decoding them for entity(), and
+ * md_html() (which uses the latter). (The input file is not used.) */
+#define ENTITY_DOC_SIZE     (1024 * 1024)
+
+static int
+null_entity_callback(const MD_CHAR* text, MD_SIZE size, const MD_ENTITY_DETAIL* detail, void* userdata)
+{
+    return 0;
+}
+
+static void
+bench_entity(unsigned n_iterations)
+{
+    static const char* entities[] = {
+        "&alpha;", "&beta;", "&gamma;", "&Delta;", "&lambda;", "&pi;", "&sum;",
+        "&int;", "&infin;", "&le;", "&ge;", "&ne;", "&asymp;", "&rarr;",
+        "&hellip;", "&mdash;", "&nbsp;", "&laquo;", "&raquo;", "&copy;",
+        "&eacute;", "&uuml;", "&ccedil;", "&szlig;", "&NotGreaterFullEqual;",
+        "&#x3b8;", "&#8730;", "&amp;", "&lt;", "&gt;"
+    };
+    static const char* names[] = {
+        "md_parse()", "md_parse() + entity()", "md_html()", "md_html(VERBATIM_ENTITIES)"
+    };
+    MD_PARSER parser;
+    MD_CHAR* text;
+    size_t size = 0;
+    double t0, elapsed;
+    unsigned i, k;
+
+    text = (MD_CHAR*) malloc(ENTITY_DOC_SIZE + 256);
+    if(text == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+
+    unicode_seed = 1;
+    while(size < ENTITY_DOC_SIZE) {
+        for(i = 0; i < 40; i++) {
+            size += sprintf(text + size, "%s%s", (i > 0 ? " x" : ""),
+                            entities[unicode_random(SIZEOF_ARRAY(entities))]);
+        }
+        size += sprintf(text + size, "\n\n");
+    }
+
+    /* The iteration count calibrated for the input file is meaningless here. */
+    n_iterations = 20;
+
+    for(k = 0; k < SIZEOF_ARRAY(names); k++) {
+        null_parser(&parser);
+        parser.abi_version = MD_PARSER_ABI_VERSION;
+        if(k == 1)
+            parser.entity = null_entity_callback;
+
+        t0 = now();
+        for(i = 0; i < n_iterations; i++) {
+            if(k < 2)
+                md_parse(text, (MD_SIZE) size, &parser, NULL);
+            else
+                md_html(text, (MD_SIZE) size, null_output, NULL, parser_flags,
+                        (k == 3 ? MD_HTML_FLAG_VERBATIM_ENTITIES : 0));
+        }
+        elapsed = now() - t0;
+        printf("  %-24s %10.3f ms per document  %9.2f MB/s\n", names[k],
+               elapsed * 1e3 / n_iterations,
+               ((double) size * n_iterations) / elapsed / (1024.0 * 1024.0));
+    }
+
+    free(text);
+}
+
+struct benchmark {
+    const char* name;
+    const char* description;
+    void (*run)(unsigned /*n_iterations*/);
+};
+
+static const struct benchmark benchmarks[] = {
+    { "parse",      "md_parse() with no-op callbacks",          bench_parse },
+    { "reuse",      "md_parse() vs. reused MD_PARSER_HANDLE",   bench_reuse },
+    { "alloc",      "Default allocation vs. MD_ALLOC_ARENA",     bench_alloc },
+    { "stream",     "md_parser_parse() vs. chunked md_parser_feed()", bench_stream },
+    { "reparse",    "Full parse vs. md_parser_reparse() per keystroke", bench_reparse },
+    { "threads",    "md_parser_parse() with 1 to 8 threads",    bench_threads },
+    { "first-block", "Latency to the first block with MD_FLAG_NOREFDEFS", bench_first_block },
+    { "tree",       "md_parse() vs. md_tree_replay()",          bench_tree },
+    { "event-log",  "md_parse() vs. md_event_log_replay()",     bench_event_log },
+    { "batch",      "Callbacks vs. md_parser_set_event_sink()",  bench_batch },
+    { "ref-defs",   "100k reference definitions (generated input)", bench_ref_defs },
+    { "ref-dict",   "Appended ref. defs vs. MD_PARSER::ref_dict", bench_ref_dict },
+    { "unicode",    "Cyrillic and CJK text (generated input)",  bench_unicode },
+    { "stats",      "md_parse() with MD_PARSER::stats",         bench_stats },
+    { "html",       "md_html_ex() with various output buffers, md_html_to_buffer/segments()", bench_html },
+    { "escape",     "HTML and URL escaping (generated input)",  bench_escape },
+    { "entity",     "Entity decoding (generated input)",        bench_entity },
+    { NULL, NULL, NULL }
+};
+
+
+/**********************
+ ***  Main program  ***
+ **********************/
+
+static const CMDLINE_OPTION cmdline_options[] = {
+    { 'n', "iterations",                    'n', CMDLINE_OPTFLAG_REQUIREDARG },
+    { 'S', "split",                         'S', CMDLINE_OPTFLAG_REQUIREDARG },
+    { 'h', "help",                          'h', 0 },
+
+    {  0,  "commonmark",                    'c', 0 },
+    {  0,  "github",                        'g', 0 },
+
+    {  0,  NULL,                             0,  0 }
+};
+
+static void
+usage(void)
+{
+    int i;
+
+    printf(
+        "Usage: md4c-bench [OPTION]... BENCHMARK [FILE]\n"
+        "Measure performance of MD4C on the input FILE (or standard input).\n"
+        "\n"
+        "Options:\n"
+        "  -n, --iterations=N   Repeat each measurement N times (default is\n"
+        "                       calibrated to run about a second)\n"
+        "  -S, --split=SIZE     Split the input into documents of about SIZE bytes\n"
+        "                       (on blank lines)\n"
+        "  -h, --help           Display this help and exit\n"
+        "      --commonmark     CommonMark (this is default)\n"
+        "      --github         Github Flavored Markdown\n"
+        "\n"
+        "Benchmarks:\n"
+    );
+
+    for(i = 0; benchmarks[i].name != NULL; i++)
+        printf("  %-20s %s\n", benchmarks[i].name, benchmarks[i].description);
+}
+
+static const char* bench_name = NULL;
+static const char* input_path = NULL;
+
+static int
+cmdline_callback(int opt, char const* value, void* data)
+{
+    switch(opt) {
+        case 0:
+            if(bench_name == NULL) {
+                bench_name = value;
+            } else if(input_path == NULL) {
+                input_path = value;
+            } else {
+                fprintf(stderr, "Too many arguments.\n");
+                fprintf(stderr, "Use --help for more info.\n");
+                exit(1);
+            }
+            break;
+
+        case 'n':   iterations = (unsigned) atoi(value); break;
+        case 'S':   split_size = (unsigned) atoi(value); break;
+        case 'h':   usage(); exit(0); break;
+
+        case 'c':   parser_flags = MD_DIALECT_COMMONMARK; break;
+        case 'g':   parser_flags = MD_DIALECT_GITHUB; break;
+
+        default:
+            fprintf(stderr, "Illegal option: %s\n", value);
+            fprintf(stderr, "Use --help for more info.\n");
+            exit(1);
+            break;
+    }
+
+    return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+    FILE* in = stdin;
+    const struct benchmark* bench = NULL;
+    int i;
+
+    if(cmdline_read(cmdline_options, argc, argv, cmdline_callback, NULL) != 0) {
+        usage();
+        exit(1);
+    }
+
+    if(bench_name == NULL) {
+        usage();
+        exit(1);
+    }
+    for(i = 0; benchmarks[i].name != NULL; i++) {
+        if(strcmp(benchmarks[i].name, bench_name) == 0) {
+            bench = &benchmarks[i];
+            break;
+        }
+    }
+    if(bench == NULL) {
+        fprintf(stderr, "Unknown benchmark: %s\n", bench_name);
+        fprintf(stderr, "Use --help for more info.\n");
+        exit(1);
+    }
+
+    if(input_path != NULL && strcmp(input_path, "-") != 0) {
+        in = fopen(input_path, "rb");
+        if(in == NULL) {
+            fprintf(stderr, "Cannot open %s.\n", input_path);
+            exit(1);
+        }
+    }
+    read_input(in);
+    if(in != stdin)
+        fclose(in);
+    split_input();
+
+    printf("%s: %u document(s), %lu bytes\n", bench->name, n_docs, (unsigned long) input_size);
+    bench->run(calibrate_iterations());
+
+    free(docs);
+    free(input);
+    return 0;
+}
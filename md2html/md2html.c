@@ -91,32 +91,19 @@ membuf_grow(struct membuffer* buf, size_t new_asize)
     buf->asize = new_asize;
 }
 
-static void
-membuf_append(struct membuffer* buf, const char* data, MD_SIZE size)
-{
-    if(buf->asize < buf->size + size)
-        membuf_grow(buf, buf->size + buf->size / 2 + size);
-    memcpy(buf->data + buf->size, data, size);
-    buf->size += size;
-}
-
 
 /**********************
  ***  Main program  ***
  **********************/
 
-static void
-process_output(const MD_CHAR* text, MD_SIZE size, void* userdata)
-{
-    membuf_append((struct membuffer*) userdata, text, size);
-}
-
 static int
 process_file(FILE* in, FILE* out)
 {
     size_t n;
     struct membuffer buf_in = {0};
     struct membuffer buf_out = {0};
+    MD_HTML_RESUME* resume;
+    MD_SIZE written;
     int ret = -1;
     clock_t t0, t1;
 
@@ -137,12 +124,20 @@ process_file(FILE* in, FILE* out)
      * deal with the HTML header/footer and tags. */
     membuf_init(&buf_out, (MD_SIZE)(buf_in.size + buf_in.size/8 + 64));
 
-    /* Parse the document. This shall call our callbacks provided via the
-     * md_renderer_t structure. */
+    /* Render the document right into the buffer. If it is not big enough after
+     * all, grow it and fetch the rest. */
     t0 = clock();
 
-    ret = md_html(buf_in.data, (MD_SIZE)buf_in.size, process_output, (void*) &buf_out,
-                    parser_flags, renderer_flags);
+    ret = md_html_to_buffer_begin(buf_in.data, (MD_SIZE)buf_in.size,
+                    buf_out.data, (MD_SIZE)buf_out.asize, parser_flags, renderer_flags,
+                    &written, &resume);
+    buf_out.size = written;
+    while(ret == 1) {
+        membuf_grow(&buf_out, buf_out.asize + buf_out.asize / 2);
+        ret = md_html_to_buffer_resume(resume, buf_out.data + buf_out.size,
+                    (MD_SIZE)(buf_out.asize - buf_out.size), &written);
+        buf_out.size += written;
+    }
 
     t1 = clock();
     if(ret != 0) {
@@ -227,6 +222,7 @@ static const CMDLINE_OPTION cmdline_options[] = {
     {  0,  "fno-html-spans",                'G', 0 },
     {  0,  "fno-html",                      'H', 0 },
     {  0,  "fno-indented-code",             'I', 0 },
+    {  0,  "fno-ref-defs",                  'R', 0 },
 
     {  0,  NULL,                             0,  0 }
 };
@@ -281,6 +277,7 @@ usage(void)
         "      --fno-html       Same as --fno-html-blocks --fno-html-spans\n"
         "      --fno-indented-code\n"
         "                       Disable indented code blocks\n"
+        "      --fno-ref-defs   Disable link reference definitions\n"
         "\n"
         "HTML generator options:\n"
         "      --fverbatim-entities\n"
@@ -327,6 +324,7 @@ cmdline_callback(int opt, char const* value, void* data)
         case 'F':   parser_flags |= MD_FLAG_NOHTMLBLOCKS; break;
         case 'G':   parser_flags |= MD_FLAG_NOHTMLSPANS; break;
         case 'H':   parser_flags |= MD_FLAG_NOHTML; break;
+        case 'R':   parser_flags |= MD_FLAG_NOREFDEFS; break;
         case 'W':   parser_flags |= MD_FLAG_COLLAPSEWHITESPACE; break;
         case 'U':   parser_flags |= MD_FLAG_PERMISSIVEURLAUTOLINKS; break;
         case '.':   parser_flags |= MD_FLAG_PERMISSIVEWWWAUTOLINKS; break;
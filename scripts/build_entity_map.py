@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+
+import json
+import os
+import sys
+import textwrap
+import urllib.request
+
+
+# Usage: build_entity_map.py [entities.json]
+# (Without the argument, the file is downloaded from the URL below.)
+url = "https://html.spec.whatwg.org/entities.json"
+
+if len(sys.argv) > 1:
+    f = open(sys.argv[1], "r")
+    entities = json.load(f)
+    f.close()
+else:
+    entities = json.loads(urllib.request.urlopen(url).read().decode("utf-8"))
+
+# Markdown recognizes only the entities terminated with ';'.
+names = sorted(name for name in entities if name.endswith(";"))
+n = len(names)
+
+
+# The lookup is a two-level perfect hash ("hash and displace"): The name is
+# hashed with FNV-1a, the hash selects a seed from ENTITY_MAP_SEED, and the
+# hash mixed with the seed then selects the slot of the entity in the table.
+# The seeds are chosen so no two entities share a slot, and the table has no
+# empty slots. This has to be kept in sync with entity_lookup().
+def fnv1a(name):
+    h = 0x811c9dc5
+    for ch in name.encode("utf-8"):
+        h = ((h ^ ch) * 0x01000193) & 0xffffffff
+    return h
+
+def mix(h):
+    h ^= h >> 16
+    h = (h * 0x85ebca6b) & 0xffffffff
+    h ^= h >> 13
+    h = (h * 0xc2b2ae35) & 0xffffffff
+    h ^= h >> 16
+    return h
+
+n_seeds = (n + 3) // 4
+hashes = dict((name, fnv1a(name)) for name in names)
+buckets = [[] for i in range(n_seeds)]
+for name in names:
+    buckets[hashes[name] % n_seeds].append(name)
+
+seeds = [0] * n_seeds
+table = [None] * n
+for b in sorted(range(n_seeds), key = lambda b: -len(buckets[b])):
+    if not buckets[b]:
+        break
+    for seed in range(0x10000):
+        slots = set(mix(hashes[name] ^ seed) % n for name in buckets[b])
+        if len(slots) == len(buckets[b]) and all(table[s] is None for s in slots):
+            break
+    else:
+        sys.stderr.write("No seed found for bucket {}.\n".format(b))
+        sys.exit(1)
+    seeds[b] = seed
+    for name in buckets[b]:
+        table[mix(hashes[name] ^ seed) % n] = name
+
+
+sys.stdout.write("#define ENTITY_MAP_SIZE {}\n".format(n))
+sys.stdout.write("#define ENTITY_MAP_SEED_COUNT {}\n".format(n_seeds))
+sys.stdout.write("static const unsigned short ENTITY_MAP_SEED[] = {\n")
+sys.stdout.write("\n".join(textwrap.wrap(", ".join("{}".format(x) for x in seeds), 110,
+                    initial_indent = "    ", subsequent_indent="    ")))
+sys.stdout.write("\n};\n")
+sys.stdout.write("static const struct entity ENTITY_MAP[] = {\n")
+records = []
+for name in table:
+    codepoints = entities[name]["codepoints"] + [0]
+    records.append("    {{ \"{}\", {}, {{ {}, {} }} }}".format(name, len(name), codepoints[0], codepoints[1]))
+sys.stdout.write(",\n".join(records))
+sys.stdout.write("\n};\n\n")
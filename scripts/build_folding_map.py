@@ -35,86 +35,68 @@ for line in f:
 f.close()
 
 
-# If we assume that (index0 ... index-1) makes a range (as defined below),
-# check that the newly provided index is compatible with the range too; i.e.
-# verify that the range can be extended without breaking its properties.
+# Split the table into two stages: Blocks of (1 << shift) items are
+# deduplicated into 'data', and 'index' maps each block of the table to its
+# copy in 'data'. So table[i] == data[(index[i >> shift] << shift) + (i & mask)]
+# where mask == (1 << shift) - 1. The shift minimizing the total size wins.
+def split_table(table, item_size):
+    best = None
+    for shift in range(1, 10):
+        block_size = 1 << shift
+        padded = table + [0] * (-len(table) % block_size)
+        blocks = dict()
+        index = list()
+        data = list()
+        for off in range(0, len(padded), block_size):
+            block = tuple(padded[off:off+block_size])
+            if not block in blocks:
+                blocks[block] = len(data) >> shift
+                data.extend(block)
+            index.append(blocks[block])
+        if max(index) > 0xff:
+            continue
+        size = len(index) + len(data) * item_size
+        if best is None or size < best[0]:
+            best = (size, shift, index, data)
+    return best[1:]
+
+
+# Each folding is described by a record (N, DELTA, CP1, CP2): The codepoint
+# folds to N codepoints, the 1st one is the codepoint plus DELTA, and the
+# others (if any) are CP1 and CP2. The record 0 (1, 0, 0, 0) is for the
+# codepoints which fold to themselves.
 #
-# Currently, we can handle ranges which:
-#
-# (1) either form consecutive sequence of codepoints and which map that range
-#     to other consecutive range of codepoints (of the same length);
-#
-# (2) or a consecutive sequence of codepoints with step 2 where each codepoint
-#     CP is mapped to the codepoint CP+1
-#     (e.g. 0x1234 -> 0x1235; 0x1236 -> 0x1237; 0x1238 -> 0x1239; ...).
-#
-# Note: When the codepoints in the range are mapped to multiple codepoints,
-# only the 1st mapped codepoint is considered. All the other ones have to be
-# shared by all the mappings covered by the range.
-def is_range_compatible(folding, codepoint_list, index0, index):
-    N = index - index0
-    codepoint0 = codepoint_list[index0]
-    codepoint1 = codepoint_list[index0+1]
-    codepointN = codepoint_list[index]
-    mapping0 = folding[codepoint0]
-    mapping1 = folding[codepoint1]
-    mappingN = folding[codepointN]
-
-    # Check the range type (1):
-    if codepoint1 - codepoint0 == 1 and codepointN - codepoint0 == N                \
-            and mapping1[0] - mapping0[0] == 1 and mapping1[1:] == mapping0[1:]     \
-            and mappingN[0] - mapping0[0] == N and mappingN[1:] == mapping0[1:]:
-        return True
-
-    # Check the range type (2):
-    if codepoint1 - codepoint0 == 2 and codepointN - codepoint0 == 2 * N            \
-            and mapping0[0] - codepoint0 == 1                                       \
-            and mapping1[0] - codepoint1 == 1 and mapping1[1:] == mapping0[1:]      \
-            and mappingN[0] - codepointN == 1 and mappingN[1:] == mapping0[1:]:
-        return True
-
-    return False
-
-
-def mapping_str(list, mapping):
-    return ",".join("0x{:04x}".format(x) for x in mapping)
-
-for mapping_len in range(1, 4):
-    folding = folding_list[mapping_len-1]
-    codepoint_list = list(folding)
-
-    index0 = 0
-    count = len(folding)
-
-    records = list()
-    data_records = list()
-
-    while index0 < count:
-        index1 = index0 + 1
-        while index1 < count and is_range_compatible(folding, codepoint_list, index0, index1):
-            index1 += 1
-
-        if index1 - index0 > 2:
-            # Range of codepoints
-            records.append("R(0x{:04x},0x{:04x})".format(codepoint_list[index0], codepoint_list[index1-1]))
-            data_records.append(mapping_str(data_records, folding[codepoint_list[index0]]))
-            data_records.append(mapping_str(data_records, folding[codepoint_list[index1-1]]))
-            index0 = index1
-        else:
-            # Single codepoint
-            records.append("S(0x{:04x})".format(codepoint_list[index0]))
-            data_records.append(mapping_str(data_records, folding[codepoint_list[index0]]))
-            index0 += 1
-
-    sys.stdout.write("static const unsigned FOLD_MAP_{}[] = {{\n".format(mapping_len))
-    sys.stdout.write("\n".join(textwrap.wrap(", ".join(records), 110,
-                        initial_indent = "    ", subsequent_indent="    ")))
-    sys.stdout.write("\n};\n")
-
-    sys.stdout.write("static const unsigned FOLD_MAP_{}_DATA[] = {{\n".format(mapping_len))
-    sys.stdout.write("\n".join(textwrap.wrap(", ".join(data_records), 110,
-                        initial_indent = "    ", subsequent_indent="    ")))
-    sys.stdout.write("\n};\n")
-
-
-
+# As many codepoints fold with the same DELTA (e.g. the whole ranges of
+# upper-case letters), there are only few distinct records, and for each
+# codepoint we just store the index of its record.
+records = [ (1, 0, 0, 0) ]
+record_index = { records[0]: 0 }
+max_codepoint = max(max(folding) for folding in folding_list)
+table = [0] * (max_codepoint + 1)
+
+for folding in folding_list:
+    for codepoint, mapping in folding.items():
+        tail = mapping[1:] + [0] * (3 - len(mapping))
+        record = (len(mapping), mapping[0] - codepoint, tail[0], tail[1])
+        if not record in record_index:
+            record_index[record] = len(records)
+            records.append(record)
+        table[codepoint] = record_index[record]
+
+assert(len(records) <= 0xffff)
+shift, index, data = split_table(table, 2)
+
+sys.stdout.write("#define FOLD_MAP_SHIFT {}\n".format(shift))
+sys.stdout.write("static const unsigned char FOLD_MAP_INDEX[] = {\n")
+sys.stdout.write("\n".join(textwrap.wrap(", ".join("{}".format(x) for x in index), 110,
+                    initial_indent = "    ", subsequent_indent="    ")))
+sys.stdout.write("\n};\n")
+sys.stdout.write("static const unsigned short FOLD_MAP_DATA[] = {\n")
+sys.stdout.write("\n".join(textwrap.wrap(", ".join("{}".format(x) for x in data), 110,
+                    initial_indent = "    ", subsequent_indent="    ")))
+sys.stdout.write("\n};\n")
+sys.stdout.write("static const int FOLD_MAP_RECORDS[][4] = {\n")
+sys.stdout.write("\n".join(textwrap.wrap(", ".join(
+                    "{{ {}, {}, 0x{:04x}, 0x{:04x} }}".format(*r) for r in records), 110,
+                    initial_indent = "    ", subsequent_indent="    ")))
+sys.stdout.write("\n};\n\n")
@@ -42,25 +42,45 @@ f.close()
 codepoint_list.sort()
 
 
-index0 = 0
-count = len(codepoint_list)
-
-records = list()
-while index0 < count:
-    index1 = index0 + 1
-    while index1 < count and codepoint_list[index1] == codepoint_list[index1-1] + 1:
-        index1 += 1
-
-    if index1 - index0 > 1:
-        # Range of codepoints
-        records.append("R(0x{:04x},0x{:04x})".format(codepoint_list[index0], codepoint_list[index1-1]))
-    else:
-        # Single codepoint
-        records.append("S(0x{:04x})".format(codepoint_list[index0]))
-
-    index0 = index1
-
-sys.stdout.write("static const unsigned WHITESPACE_MAP[] = {\n")
-sys.stdout.write("\n".join(textwrap.wrap(", ".join(records), 110,
+# Split the table into two stages: Blocks of (1 << shift) items are
+# deduplicated into 'data', and 'index' maps each block of the table to its
+# copy in 'data'. So table[i] == data[(index[i >> shift] << shift) + (i & mask)]
+# where mask == (1 << shift) - 1. The shift minimizing the total size wins.
+def split_table(table, item_size):
+    best = None
+    for shift in range(1, 10):
+        block_size = 1 << shift
+        padded = table + [0] * (-len(table) % block_size)
+        blocks = dict()
+        index = list()
+        data = list()
+        for off in range(0, len(padded), block_size):
+            block = tuple(padded[off:off+block_size])
+            if not block in blocks:
+                blocks[block] = len(data) >> shift
+                data.extend(block)
+            index.append(blocks[block])
+        if max(index) > 0xff:
+            continue
+        size = len(index) + len(data) * item_size
+        if best is None or size < best[0]:
+            best = (size, shift, index, data)
+    return best[1:]
+
+
+# The bitmap of the codepoints, as 32-bit words.
+words = [0] * (codepoint_list[-1] // 32 + 1)
+for codepoint in codepoint_list:
+    words[codepoint // 32] |= 1 << (codepoint % 32)
+
+shift, index, data = split_table(words, 4)
+
+sys.stdout.write("#define WHITESPACE_MAP_SHIFT {}\n".format(shift))
+sys.stdout.write("static const unsigned char WHITESPACE_MAP_INDEX[] = {\n")
+sys.stdout.write("\n".join(textwrap.wrap(", ".join("{}".format(x) for x in index), 110,
+                    initial_indent = "    ", subsequent_indent="    ")))
+sys.stdout.write("\n};\n")
+sys.stdout.write("static const unsigned WHITESPACE_MAP_DATA[] = {\n")
+sys.stdout.write("\n".join(textwrap.wrap(", ".join("0x{:08x}".format(x) for x in data), 110,
                     initial_indent = "    ", subsequent_indent="    ")))
 sys.stdout.write("\n};\n\n")
@@ -74,6 +74,28 @@ echo
 echo "Mention links extension:"
 $PYTHON "$TEST_DIR/spec_tests.py" -s "$TEST_DIR/mention-links.txt" -p "$PROGRAM --fmention-links"
 
+echo
+echo "No reference definitions:"
+$PYTHON "$TEST_DIR/spec_tests.py" -s "$TEST_DIR/no-ref-defs.txt" -p "$PROGRAM --fno-ref-defs"
+
 echo
 echo "Pathological input:"
 $PYTHON "$TEST_DIR/pathological_tests.py" -p "$PROGRAM"
+
+echo
+echo "C API:"
+test/api_tests "$TEST_DIR"/*.txt
+
+if [ -x test/api_tests_fixed_flags ]; then
+    echo
+    echo "C API (parser built with MD4C_FIXED_FLAGS=MD_DIALECT_GITHUB):"
+    test/api_tests_fixed_flags "$TEST_DIR"/*.txt
+fi
+
+echo
+echo "SIMD scanners:"
+for SIMD_TESTS in test/simd_tests test/simd_tests_ssse3 test/simd_tests_avx2; do
+    if [ -x "$SIMD_TESTS" ]; then
+        "$SIMD_TESTS" "$TEST_DIR"/*.txt
+    fi
+done
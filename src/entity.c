@@ -27,2164 +27,2190 @@
 #include <string.h>
 
 
-/* The table is generated from https://html.spec.whatwg.org/entities.json */
-static const struct entity entity_table[] = {
-    { "&AElig;", { 198, 0 } },
-    { "&AMP;", { 38, 0 } },
-    { "&Aacute;", { 193, 0 } },
-    { "&Abreve;", { 258, 0 } },
-    { "&Acirc;", { 194, 0 } },
-    { "&Acy;", { 1040, 0 } },
-    { "&Afr;", { 120068, 0 } },
-    { "&Agrave;", { 192, 0 } },
-    { "&Alpha;", { 913, 0 } },
-    { "&Amacr;", { 256, 0 } },
-    { "&And;", { 10835, 0 } },
-    { "&Aogon;", { 260, 0 } },
-    { "&Aopf;", { 120120, 0 } },
-    { "&ApplyFunction;", { 8289, 0 } },
-    { "&Aring;", { 197, 0 } },
-    { "&Ascr;", { 119964, 0 } },
-    { "&Assign;", { 8788, 0 } },
-    { "&Atilde;", { 195, 0 } },
-    { "&Auml;", { 196, 0 } },
-    { "&Backslash;", { 8726, 0 } },
-    { "&Barv;", { 10983, 0 } },
-    { "&Barwed;", { 8966, 0 } },
-    { "&Bcy;", { 1041, 0 } },
-    { "&Because;", { 8757, 0 } },
-    { "&Bernoullis;", { 8492, 0 } },
-    { "&Beta;", { 914, 0 } },
-    { "&Bfr;", { 120069, 0 } },
-    { "&Bopf;", { 120121, 0 } },
-    { "&Breve;", { 728, 0 } },
-    { "&Bscr;", { 8492, 0 } },
-    { "&Bumpeq;", { 8782, 0 } },
-    { "&CHcy;", { 1063, 0 } },
-    { "&COPY;", { 169, 0 } },
-    { "&Cacute;", { 262, 0 } },
-    { "&Cap;", { 8914, 0 } },
-    { "&CapitalDifferentialD;", { 8517, 0 } },
-    { "&Cayleys;", { 8493, 0 } },
-    { "&Ccaron;", { 268, 0 } },
-    { "&Ccedil;", { 199, 0 } },
-    { "&Ccirc;", { 264, 0 } },
-    { "&Cconint;", { 8752, 0 } },
-    { "&Cdot;", { 266, 0 } },
-    { "&Cedilla;", { 184, 0 } },
-    { "&CenterDot;", { 183, 0 } },
-    { "&Cfr;", { 8493, 0 } },
-    { "&Chi;", { 935, 0 } },
-    { "&CircleDot;", { 8857, 0 } },
-    { "&CircleMinus;", { 8854, 0 } },
-    { "&CirclePlus;", { 8853, 0 } },
-    { "&CircleTimes;", { 8855, 0 } },
-    { "&ClockwiseContourIntegral;", { 8754, 0 } },
-    { "&CloseCurlyDoubleQuote;", { 8221, 0 } },
-    { "&CloseCurlyQuote;", { 8217, 0 } },
-    { "&Colon;", { 8759, 0 } },
-    { "&Colone;", { 10868, 0 } },
-    { "&Congruent;", { 8801, 0 } },
-    { "&Conint;", { 8751, 0 } },
-    { "&ContourIntegral;", { 8750, 0 } },
-    { "&Copf;", { 8450, 0 } },
-    { "&Coproduct;", { 8720, 0 } },
-    { "&CounterClockwiseContourIntegral;", { 8755, 0 } },
-    { "&Cross;", { 10799, 0 } },
-    { "&Cscr;", { 119966, 0 } },
-    { "&Cup;", { 8915, 0 } },
-    { "&CupCap;", { 8781, 0 } },
-    { "&DD;", { 8517, 0 } },
-    { "&DDotrahd;", { 10513, 0 } },
-    { "&DJcy;", { 1026, 0 } },
-    { "&DScy;", { 1029, 0 } },
-    { "&DZcy;", { 1039, 0 } },
-    { "&Dagger;", { 8225, 0 } },
-    { "&Darr;", { 8609, 0 } },
-    { "&Dashv;", { 10980, 0 } },
-    { "&Dcaron;", { 270, 0 } },
-    { "&Dcy;", { 1044, 0 } },
-    { "&Del;", { 8711, 0 } },
-    { "&Delta;", { 916, 0 } },
-    { "&Dfr;", { 120071, 0 } },
-    { "&DiacriticalAcute;", { 180, 0 } },
-    { "&DiacriticalDot;", { 729, 0 } },
-    { "&DiacriticalDoubleAcute;", { 733, 0 } },
-    { "&DiacriticalGrave;", { 96, 0 } },
-    { "&DiacriticalTilde;", { 732, 0 } },
-    { "&Diamond;", { 8900, 0 } },
-    { "&DifferentialD;", { 8518, 0 } },
-    { "&Dopf;", { 120123, 0 } },
-    { "&Dot;", { 168, 0 } },
-    { "&DotDot;", { 8412, 0 } },
-    { "&DotEqual;", { 8784, 0 } },
-    { "&DoubleContourIntegral;", { 8751, 0 } },
-    { "&DoubleDot;", { 168, 0 } },
-    { "&DoubleDownArrow;", { 8659, 0 } },
-    { "&DoubleLeftArrow;", { 8656, 0 } },
-    { "&DoubleLeftRightArrow;", { 8660, 0 } },
-    { "&DoubleLeftTee;", { 10980, 0 } },
-    { "&DoubleLongLeftArrow;", { 10232, 0 } },
-    { "&DoubleLongLeftRightArrow;", { 10234, 0 } },
-    { "&DoubleLongRightArrow;", { 10233, 0 } },
-    { "&DoubleRightArrow;", { 8658, 0 } },
-    { "&DoubleRightTee;", { 8872, 0 } },
-    { "&DoubleUpArrow;", { 8657, 0 } },
-    { "&DoubleUpDownArrow;", { 8661, 0 } },
-    { "&DoubleVerticalBar;", { 8741, 0 } },
-    { "&DownArrow;", { 8595, 0 } },
-    { "&DownArrowBar;", { 10515, 0 } },
-    { "&DownArrowUpArrow;", { 8693, 0 } },
-    { "&DownBreve;", { 785, 0 } },
-    { "&DownLeftRightVector;", { 10576, 0 } },
-    { "&DownLeftTeeVector;", { 10590, 0 } },
-    { "&DownLeftVector;", { 8637, 0 } },
-    { "&DownLeftVectorBar;", { 10582, 0 } },
-    { "&DownRightTeeVector;", { 10591, 0 } },
-    { "&DownRightVector;", { 8641, 0 } },
-    { "&DownRightVectorBar;", { 10583, 0 } },
-    { "&DownTee;", { 8868, 0 } },
-    { "&DownTeeArrow;", { 8615, 0 } },
-    { "&Downarrow;", { 8659, 0 } },
-    { "&Dscr;", { 119967, 0 } },
-    { "&Dstrok;", { 272, 0 } },
-    { "&ENG;", { 330, 0 } },
-    { "&ETH;", { 208, 0 } },
-    { "&Eacute;", { 201, 0 } },
-    { "&Ecaron;", { 282, 0 } },
-    { "&Ecirc;", { 202, 0 } },
-    { "&Ecy;", { 1069, 0 } },
-    { "&Edot;", { 278, 0 } },
-    { "&Efr;", { 120072, 0 } },
-    { "&Egrave;", { 200, 0 } },
-    { "&Element;", { 8712, 0 } },
-    { "&Emacr;", { 274, 0 } },
-    { "&EmptySmallSquare;", { 9723, 0 } },
-    { "&EmptyVerySmallSquare;", { 9643, 0 } },
-    { "&Eogon;", { 280, 0 } },
-    { "&Eopf;", { 120124, 0 } },
-    { "&Epsilon;", { 917, 0 } },
-    { "&Equal;", { 10869, 0 } },
-    { "&EqualTilde;", { 8770, 0 } },
-    { "&Equilibrium;", { 8652, 0 } },
-    { "&Escr;", { 8496, 0 } },
-    { "&Esim;", { 10867, 0 } },
-    { "&Eta;", { 919, 0 } },
-    { "&Euml;", { 203, 0 } },
-    { "&Exists;", { 8707, 0 } },
-    { "&ExponentialE;", { 8519, 0 } },
-    { "&Fcy;", { 1060, 0 } },
-    { "&Ffr;", { 120073, 0 } },
-    { "&FilledSmallSquare;", { 9724, 0 } },
-    { "&FilledVerySmallSquare;", { 9642, 0 } },
-    { "&Fopf;", { 120125, 0 } },
-    { "&ForAll;", { 8704, 0 } },
-    { "&Fouriertrf;", { 8497, 0 } },
-    { "&Fscr;", { 8497, 0 } },
-    { "&GJcy;", { 1027, 0 } },
-    { "&GT;", { 62, 0 } },
-    { "&Gamma;", { 915, 0 } },
-    { "&Gammad;", { 988, 0 } },
-    { "&Gbreve;", { 286, 0 } },
-    { "&Gcedil;", { 290, 0 } },
-    { "&Gcirc;", { 284, 0 } },
-    { "&Gcy;", { 1043, 0 } },
-    { "&Gdot;", { 288, 0 } },
-    { "&Gfr;", { 120074, 0 } },
-    { "&Gg;", { 8921, 0 } },
-    { "&Gopf;", { 120126, 0 } },
-    { "&GreaterEqual;", { 8805, 0 } },
-    { "&GreaterEqualLess;", { 8923, 0 } },
-    { "&GreaterFullEqual;", { 8807, 0 } },
-    { "&GreaterGreater;", { 10914, 0 } },
-    { "&GreaterLess;", { 8823, 0 } },
-    { "&GreaterSlantEqual;", { 10878, 0 } },
-    { "&GreaterTilde;", { 8819, 0 } },
-    { "&Gscr;", { 119970, 0 } },
-    { "&Gt;", { 8811, 0 } },
-    { "&HARDcy;", { 1066, 0 } },
-    { "&Hacek;", { 711, 0 } },
-    { "&Hat;", { 94, 0 } },
-    { "&Hcirc;", { 292, 0 } },
-    { "&Hfr;", { 8460, 0 } },
-    { "&HilbertSpace;", { 8459, 0 } },
-    { "&Hopf;", { 8461, 0 } },
-    { "&HorizontalLine;", { 9472, 0 } },
-    { "&Hscr;", { 8459, 0 } },
-    { "&Hstrok;", { 294, 0 } },
-    { "&HumpDownHump;", { 8782, 0 } },
-    { "&HumpEqual;", { 8783, 0 } },
-    { "&IEcy;", { 1045, 0 } },
-    { "&IJlig;", { 306, 0 } },
-    { "&IOcy;", { 1025, 0 } },
-    { "&Iacute;", { 205, 0 } },
-    { "&Icirc;", { 206, 0 } },
-    { "&Icy;", { 1048, 0 } },
-    { "&Idot;", { 304, 0 } },
-    { "&Ifr;", { 8465, 0 } },
-    { "&Igrave;", { 204, 0 } },
-    { "&Im;", { 8465, 0 } },
-    { "&Imacr;", { 298, 0 } },
-    { "&ImaginaryI;", { 8520, 0 } },
-    { "&Implies;", { 8658, 0 } },
-    { "&Int;", { 8748, 0 } },
-    { "&Integral;", { 8747, 0 } },
-    { "&Intersection;", { 8898, 0 } },
-    { "&InvisibleComma;", { 8291, 0 } },
-    { "&InvisibleTimes;", { 8290, 0 } },
-    { "&Iogon;", { 302, 0 } },
-    { "&Iopf;", { 120128, 0 } },
-    { "&Iota;", { 921, 0 } },
-    { "&Iscr;", { 8464, 0 } },
-    { "&Itilde;", { 296, 0 } },
-    { "&Iukcy;", { 1030, 0 } },
-    { "&Iuml;", { 207, 0 } },
-    { "&Jcirc;", { 308, 0 } },
-    { "&Jcy;", { 1049, 0 } },
-    { "&Jfr;", { 120077, 0 } },
-    { "&Jopf;", { 120129, 0 } },
-    { "&Jscr;", { 119973, 0 } },
-    { "&Jsercy;", { 1032, 0 } },
-    { "&Jukcy;", { 1028, 0 } },
-    { "&KHcy;", { 1061, 0 } },
-    { "&KJcy;", { 1036, 0 } },
-    { "&Kappa;", { 922, 0 } },
-    { "&Kcedil;", { 310, 0 } },
-    { "&Kcy;", { 1050, 0 } },
-    { "&Kfr;", { 120078, 0 } },
-    { "&Kopf;", { 120130, 0 } },
-    { "&Kscr;", { 119974, 0 } },
-    { "&LJcy;", { 1033, 0 } },
-    { "&LT;", { 60, 0 } },
-    { "&Lacute;", { 313, 0 } },
-    { "&Lambda;", { 923, 0 } },
-    { "&Lang;", { 10218, 0 } },
-    { "&Laplacetrf;", { 8466, 0 } },
-    { "&Larr;", { 8606, 0 } },
-    { "&Lcaron;", { 317, 0 } },
-    { "&Lcedil;", { 315, 0 } },
-    { "&Lcy;", { 1051, 0 } },
-    { "&LeftAngleBracket;", { 10216, 0 } },
-    { "&LeftArrow;", { 8592, 0 } },
-    { "&LeftArrowBar;", { 8676, 0 } },
-    { "&LeftArrowRightArrow;", { 8646, 0 } },
-    { "&LeftCeiling;", { 8968, 0 } },
-    { "&LeftDoubleBracket;", { 10214, 0 } },
-    { "&LeftDownTeeVector;", { 10593, 0 } },
-    { "&LeftDownVector;", { 8643, 0 } },
-    { "&LeftDownVectorBar;", { 10585, 0 } },
-    { "&LeftFloor;", { 8970, 0 } },
-    { "&LeftRightArrow;", { 8596, 0 } },
-    { "&LeftRightVector;", { 10574, 0 } },
-    { "&LeftTee;", { 8867, 0 } },
-    { "&LeftTeeArrow;", { 8612, 0 } },
-    { "&LeftTeeVector;", { 10586, 0 } },
-    { "&LeftTriangle;", { 8882, 0 } },
-    { "&LeftTriangleBar;", { 10703, 0 } },
-    { "&LeftTriangleEqual;", { 8884, 0 } },
-    { "&LeftUpDownVector;", { 10577, 0 } },
-    { "&LeftUpTeeVector;", { 10592, 0 } },
-    { "&LeftUpVector;", { 8639, 0 } },
-    { "&LeftUpVectorBar;", { 10584, 0 } },
-    { "&LeftVector;", { 8636, 0 } },
-    { "&LeftVectorBar;", { 10578, 0 } },
-    { "&Leftarrow;", { 8656, 0 } },
-    { "&Leftrightarrow;", { 8660, 0 } },
-    { "&LessEqualGreater;", { 8922, 0 } },
-    { "&LessFullEqual;", { 8806, 0 } },
-    { "&LessGreater;", { 8822, 0 } },
-    { "&LessLess;", { 10913, 0 } },
-    { "&LessSlantEqual;", { 10877, 0 } },
-    { "&LessTilde;", { 8818, 0 } },
-    { "&Lfr;", { 120079, 0 } },
-    { "&Ll;", { 8920, 0 } },
-    { "&Lleftarrow;", { 8666, 0 } },
-    { "&Lmidot;", { 319, 0 } },
-    { "&LongLeftArrow;", { 10229, 0 } },
-    { "&LongLeftRightArrow;", { 10231, 0 } },
-    { "&LongRightArrow;", { 10230, 0 } },
-    { "&Longleftarrow;", { 10232, 0 } },
-    { "&Longleftrightarrow;", { 10234, 0 } },
-    { "&Longrightarrow;", { 10233, 0 } },
-    { "&Lopf;", { 120131, 0 } },
-    { "&LowerLeftArrow;", { 8601, 0 } },
-    { "&LowerRightArrow;", { 8600, 0 } },
-    { "&Lscr;", { 8466, 0 } },
-    { "&Lsh;", { 8624, 0 } },
-    { "&Lstrok;", { 321, 0 } },
-    { "&Lt;", { 8810, 0 } },
-    { "&Map;", { 10501, 0 } },
-    { "&Mcy;", { 1052, 0 } },
-    { "&MediumSpace;", { 8287, 0 } },
-    { "&Mellintrf;", { 8499, 0 } },
-    { "&Mfr;", { 120080, 0 } },
-    { "&MinusPlus;", { 8723, 0 } },
-    { "&Mopf;", { 120132, 0 } },
-    { "&Mscr;", { 8499, 0 } },
-    { "&Mu;", { 924, 0 } },
-    { "&NJcy;", { 1034, 0 } },
-    { "&Nacute;", { 323, 0 } },
-    { "&Ncaron;", { 327, 0 } },
-    { "&Ncedil;", { 325, 0 } },
-    { "&Ncy;", { 1053, 0 } },
-    { "&NegativeMediumSpace;", { 8203, 0 } },
-    { "&NegativeThickSpace;", { 8203, 0 } },
-    { "&NegativeThinSpace;", { 8203, 0 } },
-    { "&NegativeVeryThinSpace;", { 8203, 0 } },
-    { "&NestedGreaterGreater;", { 8811, 0 } },
-    { "&NestedLessLess;", { 8810, 0 } },
-    { "&NewLine;", { 10, 0 } },
-    { "&Nfr;", { 120081, 0 } },
-    { "&NoBreak;", { 8288, 0 } },
-    { "&NonBreakingSpace;", { 160, 0 } },
-    { "&Nopf;", { 8469, 0 } },
-    { "&Not;", { 10988, 0 } },
-    { "&NotCongruent;", { 8802, 0 } },
-    { "&NotCupCap;", { 8813, 0 } },
-    { "&NotDoubleVerticalBar;", { 8742, 0 } },
-    { "&NotElement;", { 8713, 0 } },
-    { "&NotEqual;", { 8800, 0 } },
-    { "&NotEqualTilde;", { 8770, 824 } },
-    { "&NotExists;", { 8708, 0 } },
-    { "&NotGreater;", { 8815, 0 } },
-    { "&NotGreaterEqual;", { 8817, 0 } },
-    { "&NotGreaterFullEqual;", { 8807, 824 } },
-    { "&NotGreaterGreater;", { 8811, 824 } },
-    { "&NotGreaterLess;", { 8825, 0 } },
-    { "&NotGreaterSlantEqual;", { 10878, 824 } },
-    { "&NotGreaterTilde;", { 8821, 0 } },
-    { "&NotHumpDownHump;", { 8782, 824 } },
-    { "&NotHumpEqual;", { 8783, 824 } },
-    { "&NotLeftTriangle;", { 8938, 0 } },
-    { "&NotLeftTriangleBar;", { 10703, 824 } },
-    { "&NotLeftTriangleEqual;", { 8940, 0 } },
-    { "&NotLess;", { 8814, 0 } },
-    { "&NotLessEqual;", { 8816, 0 } },
-    { "&NotLessGreater;", { 8824, 0 } },
-    { "&NotLessLess;", { 8810, 824 } },
-    { "&NotLessSlantEqual;", { 10877, 824 } },
-    { "&NotLessTilde;", { 8820, 0 } },
-    { "&NotNestedGreaterGreater;", { 10914, 824 } },
-    { "&NotNestedLessLess;", { 10913, 824 } },
-    { "&NotPrecedes;", { 8832, 0 } },
-    { "&NotPrecedesEqual;", { 10927, 824 } },
-    { "&NotPrecedesSlantEqual;", { 8928, 0 } },
-    { "&NotReverseElement;", { 8716, 0 } },
-    { "&NotRightTriangle;", { 8939, 0 } },
-    { "&NotRightTriangleBar;", { 10704, 824 } },
-    { "&NotRightTriangleEqual;", { 8941, 0 } },
-    { "&NotSquareSubset;", { 8847, 824 } },
-    { "&NotSquareSubsetEqual;", { 8930, 0 } },
-    { "&NotSquareSuperset;", { 8848, 824 } },
-    { "&NotSquareSupersetEqual;", { 8931, 0 } },
-    { "&NotSubset;", { 8834, 8402 } },
-    { "&NotSubsetEqual;", { 8840, 0 } },
-    { "&NotSucceeds;", { 8833, 0 } },
-    { "&NotSucceedsEqual;", { 10928, 824 } },
-    { "&NotSucceedsSlantEqual;", { 8929, 0 } },
-    { "&NotSucceedsTilde;", { 8831, 824 } },
-    { "&NotSuperset;", { 8835, 8402 } },
-    { "&NotSupersetEqual;", { 8841, 0 } },
-    { "&NotTilde;", { 8769, 0 } },
-    { "&NotTildeEqual;", { 8772, 0 } },
-    { "&NotTildeFullEqual;", { 8775, 0 } },
-    { "&NotTildeTilde;", { 8777, 0 } },
-    { "&NotVerticalBar;", { 8740, 0 } },
-    { "&Nscr;", { 119977, 0 } },
-    { "&Ntilde;", { 209, 0 } },
-    { "&Nu;", { 925, 0 } },
-    { "&OElig;", { 338, 0 } },
-    { "&Oacute;", { 211, 0 } },
-    { "&Ocirc;", { 212, 0 } },
-    { "&Ocy;", { 1054, 0 } },
-    { "&Odblac;", { 336, 0 } },
-    { "&Ofr;", { 120082, 0 } },
-    { "&Ograve;", { 210, 0 } },
-    { "&Omacr;", { 332, 0 } },
-    { "&Omega;", { 937, 0 } },
-    { "&Omicron;", { 927, 0 } },
-    { "&Oopf;", { 120134, 0 } },
-    { "&OpenCurlyDoubleQuote;", { 8220, 0 } },
-    { "&OpenCurlyQuote;", { 8216, 0 } },
-    { "&Or;", { 10836, 0 } },
-    { "&Oscr;", { 119978, 0 } },
-    { "&Oslash;", { 216, 0 } },
-    { "&Otilde;", { 213, 0 } },
-    { "&Otimes;", { 10807, 0 } },
-    { "&Ouml;", { 214, 0 } },
-    { "&OverBar;", { 8254, 0 } },
-    { "&OverBrace;", { 9182, 0 } },
-    { "&OverBracket;", { 9140, 0 } },
-    { "&OverParenthesis;", { 9180, 0 } },
-    { "&PartialD;", { 8706, 0 } },
-    { "&Pcy;", { 1055, 0 } },
-    { "&Pfr;", { 120083, 0 } },
-    { "&Phi;", { 934, 0 } },
-    { "&Pi;", { 928, 0 } },
-    { "&PlusMinus;", { 177, 0 } },
-    { "&Poincareplane;", { 8460, 0 } },
-    { "&Popf;", { 8473, 0 } },
-    { "&Pr;", { 10939, 0 } },
-    { "&Precedes;", { 8826, 0 } },
-    { "&PrecedesEqual;", { 10927, 0 } },
-    { "&PrecedesSlantEqual;", { 8828, 0 } },
-    { "&PrecedesTilde;", { 8830, 0 } },
-    { "&Prime;", { 8243, 0 } },
-    { "&Product;", { 8719, 0 } },
-    { "&Proportion;", { 8759, 0 } },
-    { "&Proportional;", { 8733, 0 } },
-    { "&Pscr;", { 119979, 0 } },
-    { "&Psi;", { 936, 0 } },
-    { "&QUOT;", { 34, 0 } },
-    { "&Qfr;", { 120084, 0 } },
-    { "&Qopf;", { 8474, 0 } },
-    { "&Qscr;", { 119980, 0 } },
-    { "&RBarr;", { 10512, 0 } },
-    { "&REG;", { 174, 0 } },
-    { "&Racute;", { 340, 0 } },
-    { "&Rang;", { 10219, 0 } },
-    { "&Rarr;", { 8608, 0 } },
-    { "&Rarrtl;", { 10518, 0 } },
-    { "&Rcaron;", { 344, 0 } },
-    { "&Rcedil;", { 342, 0 } },
-    { "&Rcy;", { 1056, 0 } },
-    { "&Re;", { 8476, 0 } },
-    { "&ReverseElement;", { 8715, 0 } },
-    { "&ReverseEquilibrium;", { 8651, 0 } },
-    { "&ReverseUpEquilibrium;", { 10607, 0 } },
-    { "&Rfr;", { 8476, 0 } },
-    { "&Rho;", { 929, 0 } },
-    { "&RightAngleBracket;", { 10217, 0 } },
-    { "&RightArrow;", { 8594, 0 } },
-    { "&RightArrowBar;", { 8677, 0 } },
-    { "&RightArrowLeftArrow;", { 8644, 0 } },
-    { "&RightCeiling;", { 8969, 0 } },
-    { "&RightDoubleBracket;", { 10215, 0 } },
-    { "&RightDownTeeVector;", { 10589, 0 } },
-    { "&RightDownVector;", { 8642, 0 } },
-    { "&RightDownVectorBar;", { 10581, 0 } },
-    { "&RightFloor;", { 8971, 0 } },
-    { "&RightTee;", { 8866, 0 } },
-    { "&RightTeeArrow;", { 8614, 0 } },
-    { "&RightTeeVector;", { 10587, 0 } },
-    { "&RightTriangle;", { 8883, 0 } },
-    { "&RightTriangleBar;", { 10704, 0 } },
-    { "&RightTriangleEqual;", { 8885, 0 } },
-    { "&RightUpDownVector;", { 10575, 0 } },
-    { "&RightUpTeeVector;", { 10588, 0 } },
-    { "&RightUpVector;", { 8638, 0 } },
-    { "&RightUpVectorBar;", { 10580, 0 } },
-    { "&RightVector;", { 8640, 0 } },
-    { "&RightVectorBar;", { 10579, 0 } },
-    { "&Rightarrow;", { 8658, 0 } },
-    { "&Ropf;", { 8477, 0 } },
-    { "&RoundImplies;", { 10608, 0 } },
-    { "&Rrightarrow;", { 8667, 0 } },
-    { "&Rscr;", { 8475, 0 } },
-    { "&Rsh;", { 8625, 0 } },
-    { "&RuleDelayed;", { 10740, 0 } },
-    { "&SHCHcy;", { 1065, 0 } },
-    { "&SHcy;", { 1064, 0 } },
-    { "&SOFTcy;", { 1068, 0 } },
-    { "&Sacute;", { 346, 0 } },
-    { "&Sc;", { 10940, 0 } },
-    { "&Scaron;", { 352, 0 } },
-    { "&Scedil;", { 350, 0 } },
-    { "&Scirc;", { 348, 0 } },
-    { "&Scy;", { 1057, 0 } },
-    { "&Sfr;", { 120086, 0 } },
-    { "&ShortDownArrow;", { 8595, 0 } },
-    { "&ShortLeftArrow;", { 8592, 0 } },
-    { "&ShortRightArrow;", { 8594, 0 } },
-    { "&ShortUpArrow;", { 8593, 0 } },
-    { "&Sigma;", { 931, 0 } },
-    { "&SmallCircle;", { 8728, 0 } },
-    { "&Sopf;", { 120138, 0 } },
-    { "&Sqrt;", { 8730, 0 } },
-    { "&Square;", { 9633, 0 } },
-    { "&SquareIntersection;", { 8851, 0 } },
-    { "&SquareSubset;", { 8847, 0 } },
-    { "&SquareSubsetEqual;", { 8849, 0 } },
-    { "&SquareSuperset;", { 8848, 0 } },
-    { "&SquareSupersetEqual;", { 8850, 0 } },
-    { "&SquareUnion;", { 8852, 0 } },
-    { "&Sscr;", { 119982, 0 } },
-    { "&Star;", { 8902, 0 } },
-    { "&Sub;", { 8912, 0 } },
-    { "&Subset;", { 8912, 0 } },
-    { "&SubsetEqual;", { 8838, 0 } },
-    { "&Succeeds;", { 8827, 0 } },
-    { "&SucceedsEqual;", { 10928, 0 } },
-    { "&SucceedsSlantEqual;", { 8829, 0 } },
-    { "&SucceedsTilde;", { 8831, 0 } },
-    { "&SuchThat;", { 8715, 0 } },
-    { "&Sum;", { 8721, 0 } },
-    { "&Sup;", { 8913, 0 } },
-    { "&Superset;", { 8835, 0 } },
-    { "&SupersetEqual;", { 8839, 0 } },
-    { "&Supset;", { 8913, 0 } },
-    { "&THORN;", { 222, 0 } },
-    { "&TRADE;", { 8482, 0 } },
-    { "&TSHcy;", { 1035, 0 } },
-    { "&TScy;", { 1062, 0 } },
-    { "&Tab;", { 9, 0 } },
-    { "&Tau;", { 932, 0 } },
-    { "&Tcaron;", { 356, 0 } },
-    { "&Tcedil;", { 354, 0 } },
-    { "&Tcy;", { 1058, 0 } },
-    { "&Tfr;", { 120087, 0 } },
-    { "&Therefore;", { 8756, 0 } },
-    { "&Theta;", { 920, 0 } },
-    { "&ThickSpace;", { 8287, 8202 } },
-    { "&ThinSpace;", { 8201, 0 } },
-    { "&Tilde;", { 8764, 0 } },
-    { "&TildeEqual;", { 8771, 0 } },
-    { "&TildeFullEqual;", { 8773, 0 } },
-    { "&TildeTilde;", { 8776, 0 } },
-    { "&Topf;", { 120139, 0 } },
-    { "&TripleDot;", { 8411, 0 } },
-    { "&Tscr;", { 119983, 0 } },
-    { "&Tstrok;", { 358, 0 } },
-    { "&Uacute;", { 218, 0 } },
-    { "&Uarr;", { 8607, 0 } },
-    { "&Uarrocir;", { 10569, 0 } },
-    { "&Ubrcy;", { 1038, 0 } },
-    { "&Ubreve;", { 364, 0 } },
-    { "&Ucirc;", { 219, 0 } },
-    { "&Ucy;", { 1059, 0 } },
-    { "&Udblac;", { 368, 0 } },
-    { "&Ufr;", { 120088, 0 } },
-    { "&Ugrave;", { 217, 0 } },
-    { "&Umacr;", { 362, 0 } },
-    { "&UnderBar;", { 95, 0 } },
-    { "&UnderBrace;", { 9183, 0 } },
-    { "&UnderBracket;", { 9141, 0 } },
-    { "&UnderParenthesis;", { 9181, 0 } },
-    { "&Union;", { 8899, 0 } },
-    { "&UnionPlus;", { 8846, 0 } },
-    { "&Uogon;", { 370, 0 } },
-    { "&Uopf;", { 120140, 0 } },
-    { "&UpArrow;", { 8593, 0 } },
-    { "&UpArrowBar;", { 10514, 0 } },
-    { "&UpArrowDownArrow;", { 8645, 0 } },
-    { "&UpDownArrow;", { 8597, 0 } },
-    { "&UpEquilibrium;", { 10606, 0 } },
-    { "&UpTee;", { 8869, 0 } },
-    { "&UpTeeArrow;", { 8613, 0 } },
-    { "&Uparrow;", { 8657, 0 } },
-    { "&Updownarrow;", { 8661, 0 } },
-    { "&UpperLeftArrow;", { 8598, 0 } },
-    { "&UpperRightArrow;", { 8599, 0 } },
-    { "&Upsi;", { 978, 0 } },
-    { "&Upsilon;", { 933, 0 } },
-    { "&Uring;", { 366, 0 } },
-    { "&Uscr;", { 119984, 0 } },
-    { "&Utilde;", { 360, 0 } },
-    { "&Uuml;", { 220, 0 } },
-    { "&VDash;", { 8875, 0 } },
-    { "&Vbar;", { 10987, 0 } },
-    { "&Vcy;", { 1042, 0 } },
-    { "&Vdash;", { 8873, 0 } },
-    { "&Vdashl;", { 10982, 0 } },
-    { "&Vee;", { 8897, 0 } },
-    { "&Verbar;", { 8214, 0 } },
-    { "&Vert;", { 8214, 0 } },
-    { "&VerticalBar;", { 8739, 0 } },
-    { "&VerticalLine;", { 124, 0 } },
-    { "&VerticalSeparator;", { 10072, 0 } },
-    { "&VerticalTilde;", { 8768, 0 } },
-    { "&VeryThinSpace;", { 8202, 0 } },
-    { "&Vfr;", { 120089, 0 } },
-    { "&Vopf;", { 120141, 0 } },
-    { "&Vscr;", { 119985, 0 } },
-    { "&Vvdash;", { 8874, 0 } },
-    { "&Wcirc;", { 372, 0 } },
-    { "&Wedge;", { 8896, 0 } },
-    { "&Wfr;", { 120090, 0 } },
-    { "&Wopf;", { 120142, 0 } },
-    { "&Wscr;", { 119986, 0 } },
-    { "&Xfr;", { 120091, 0 } },
-    { "&Xi;", { 926, 0 } },
-    { "&Xopf;", { 120143, 0 } },
-    { "&Xscr;", { 119987, 0 } },
-    { "&YAcy;", { 1071, 0 } },
-    { "&YIcy;", { 1031, 0 } },
-    { "&YUcy;", { 1070, 0 } },
-    { "&Yacute;", { 221, 0 } },
-    { "&Ycirc;", { 374, 0 } },
-    { "&Ycy;", { 1067, 0 } },
-    { "&Yfr;", { 120092, 0 } },
-    { "&Yopf;", { 120144, 0 } },
-    { "&Yscr;", { 119988, 0 } },
-    { "&Yuml;", { 376, 0 } },
-    { "&ZHcy;", { 1046, 0 } },
-    { "&Zacute;", { 377, 0 } },
-    { "&Zcaron;", { 381, 0 } },
-    { "&Zcy;", { 1047, 0 } },
-    { "&Zdot;", { 379, 0 } },
-    { "&ZeroWidthSpace;", { 8203, 0 } },
-    { "&Zeta;", { 918, 0 } },
-    { "&Zfr;", { 8488, 0 } },
-    { "&Zopf;", { 8484, 0 } },
-    { "&Zscr;", { 119989, 0 } },
-    { "&aacute;", { 225, 0 } },
-    { "&abreve;", { 259, 0 } },
-    { "&ac;", { 8766, 0 } },
-    { "&acE;", { 8766, 819 } },
-    { "&acd;", { 8767, 0 } },
-    { "&acirc;", { 226, 0 } },
-    { "&acute;", { 180, 0 } },
-    { "&acy;", { 1072, 0 } },
-    { "&aelig;", { 230, 0 } },
-    { "&af;", { 8289, 0 } },
-    { "&afr;", { 120094, 0 } },
-    { "&agrave;", { 224, 0 } },
-    { "&alefsym;", { 8501, 0 } },
-    { "&aleph;", { 8501, 0 } },
-    { "&alpha;", { 945, 0 } },
-    { "&amacr;", { 257, 0 } },
-    { "&amalg;", { 10815, 0 } },
-    { "&amp;", { 38, 0 } },
-    { "&and;", { 8743, 0 } },
-    { "&andand;", { 10837, 0 } },
-    { "&andd;", { 10844, 0 } },
-    { "&andslope;", { 10840, 0 } },
-    { "&andv;", { 10842, 0 } },
-    { "&ang;", { 8736, 0 } },
-    { "&ange;", { 10660, 0 } },
-    { "&angle;", { 8736, 0 } },
-    { "&angmsd;", { 8737, 0 } },
-    { "&angmsdaa;", { 10664, 0 } },
-    { "&angmsdab;", { 10665, 0 } },
-    { "&angmsdac;", { 10666, 0 } },
-    { "&angmsdad;", { 10667, 0 } },
-    { "&angmsdae;", { 10668, 0 } },
-    { "&angmsdaf;", { 10669, 0 } },
-    { "&angmsdag;", { 10670, 0 } },
-    { "&angmsdah;", { 10671, 0 } },
-    { "&angrt;", { 8735, 0 } },
-    { "&angrtvb;", { 8894, 0 } },
-    { "&angrtvbd;", { 10653, 0 } },
-    { "&angsph;", { 8738, 0 } },
-    { "&angst;", { 197, 0 } },
-    { "&angzarr;", { 9084, 0 } },
-    { "&aogon;", { 261, 0 } },
-    { "&aopf;", { 120146, 0 } },
-    { "&ap;", { 8776, 0 } },
-    { "&apE;", { 10864, 0 } },
-    { "&apacir;", { 10863, 0 } },
-    { "&ape;", { 8778, 0 } },
-    { "&apid;", { 8779, 0 } },
-    { "&apos;", { 39, 0 } },
-    { "&approx;", { 8776, 0 } },
-    { "&approxeq;", { 8778, 0 } },
-    { "&aring;", { 229, 0 } },
-    { "&ascr;", { 119990, 0 } },
-    { "&ast;", { 42, 0 } },
-    { "&asymp;", { 8776, 0 } },
-    { "&asympeq;", { 8781, 0 } },
-    { "&atilde;", { 227, 0 } },
-    { "&auml;", { 228, 0 } },
-    { "&awconint;", { 8755, 0 } },
-    { "&awint;", { 10769, 0 } },
-    { "&bNot;", { 10989, 0 } },
-    { "&backcong;", { 8780, 0 } },
-    { "&backepsilon;", { 1014, 0 } },
-    { "&backprime;", { 8245, 0 } },
-    { "&backsim;", { 8765, 0 } },
-    { "&backsimeq;", { 8909, 0 } },
-    { "&barvee;", { 8893, 0 } },
-    { "&barwed;", { 8965, 0 } },
-    { "&barwedge;", { 8965, 0 } },
-    { "&bbrk;", { 9141, 0 } },
-    { "&bbrktbrk;", { 9142, 0 } },
-    { "&bcong;", { 8780, 0 } },
-    { "&bcy;", { 1073, 0 } },
-    { "&bdquo;", { 8222, 0 } },
-    { "&becaus;", { 8757, 0 } },
-    { "&because;", { 8757, 0 } },
-    { "&bemptyv;", { 10672, 0 } },
-    { "&bepsi;", { 1014, 0 } },
-    { "&bernou;", { 8492, 0 } },
-    { "&beta;", { 946, 0 } },
-    { "&beth;", { 8502, 0 } },
-    { "&between;", { 8812, 0 } },
-    { "&bfr;", { 120095, 0 } },
-    { "&bigcap;", { 8898, 0 } },
-    { "&bigcirc;", { 9711, 0 } },
-    { "&bigcup;", { 8899, 0 } },
-    { "&bigodot;", { 10752, 0 } },
-    { "&bigoplus;", { 10753, 0 } },
-    { "&bigotimes;", { 10754, 0 } },
-    { "&bigsqcup;", { 10758, 0 } },
-    { "&bigstar;", { 9733, 0 } },
-    { "&bigtriangledown;", { 9661, 0 } },
-    { "&bigtriangleup;", { 9651, 0 } },
-    { "&biguplus;", { 10756, 0 } },
-    { "&bigvee;", { 8897, 0 } },
-    { "&bigwedge;", { 8896, 0 } },
-    { "&bkarow;", { 10509, 0 } },
-    { "&blacklozenge;", { 10731, 0 } },
-    { "&blacksquare;", { 9642, 0 } },
-    { "&blacktriangle;", { 9652, 0 } },
-    { "&blacktriangledown;", { 9662, 0 } },
-    { "&blacktriangleleft;", { 9666, 0 } },
-    { "&blacktriangleright;", { 9656, 0 } },
-    { "&blank;", { 9251, 0 } },
-    { "&blk12;", { 9618, 0 } },
-    { "&blk14;", { 9617, 0 } },
-    { "&blk34;", { 9619, 0 } },
-    { "&block;", { 9608, 0 } },
-    { "&bne;", { 61, 8421 } },
-    { "&bnequiv;", { 8801, 8421 } },
-    { "&bnot;", { 8976, 0 } },
-    { "&bopf;", { 120147, 0 } },
-    { "&bot;", { 8869, 0 } },
-    { "&bottom;", { 8869, 0 } },
-    { "&bowtie;", { 8904, 0 } },
-    { "&boxDL;", { 9559, 0 } },
-    { "&boxDR;", { 9556, 0 } },
-    { "&boxDl;", { 9558, 0 } },
-    { "&boxDr;", { 9555, 0 } },
-    { "&boxH;", { 9552, 0 } },
-    { "&boxHD;", { 9574, 0 } },
-    { "&boxHU;", { 9577, 0 } },
-    { "&boxHd;", { 9572, 0 } },
-    { "&boxHu;", { 9575, 0 } },
-    { "&boxUL;", { 9565, 0 } },
-    { "&boxUR;", { 9562, 0 } },
-    { "&boxUl;", { 9564, 0 } },
-    { "&boxUr;", { 9561, 0 } },
-    { "&boxV;", { 9553, 0 } },
-    { "&boxVH;", { 9580, 0 } },
-    { "&boxVL;", { 9571, 0 } },
-    { "&boxVR;", { 9568, 0 } },
-    { "&boxVh;", { 9579, 0 } },
-    { "&boxVl;", { 9570, 0 } },
-    { "&boxVr;", { 9567, 0 } },
-    { "&boxbox;", { 10697, 0 } },
-    { "&boxdL;", { 9557, 0 } },
-    { "&boxdR;", { 9554, 0 } },
-    { "&boxdl;", { 9488, 0 } },
-    { "&boxdr;", { 9484, 0 } },
-    { "&boxh;", { 9472, 0 } },
-    { "&boxhD;", { 9573, 0 } },
-    { "&boxhU;", { 9576, 0 } },
-    { "&boxhd;", { 9516, 0 } },
-    { "&boxhu;", { 9524, 0 } },
-    { "&boxminus;", { 8863, 0 } },
-    { "&boxplus;", { 8862, 0 } },
-    { "&boxtimes;", { 8864, 0 } },
-    { "&boxuL;", { 9563, 0 } },
-    { "&boxuR;", { 9560, 0 } },
-    { "&boxul;", { 9496, 0 } },
-    { "&boxur;", { 9492, 0 } },
-    { "&boxv;", { 9474, 0 } },
-    { "&boxvH;", { 9578, 0 } },
-    { "&boxvL;", { 9569, 0 } },
-    { "&boxvR;", { 9566, 0 } },
-    { "&boxvh;", { 9532, 0 } },
-    { "&boxvl;", { 9508, 0 } },
-    { "&boxvr;", { 9500, 0 } },
-    { "&bprime;", { 8245, 0 } },
-    { "&breve;", { 728, 0 } },
-    { "&brvbar;", { 166, 0 } },
-    { "&bscr;", { 119991, 0 } },
-    { "&bsemi;", { 8271, 0 } },
-    { "&bsim;", { 8765, 0 } },
-    { "&bsime;", { 8909, 0 } },
-    { "&bsol;", { 92, 0 } },
-    { "&bsolb;", { 10693, 0 } },
-    { "&bsolhsub;", { 10184, 0 } },
-    { "&bull;", { 8226, 0 } },
-    { "&bullet;", { 8226, 0 } },
-    { "&bump;", { 8782, 0 } },
-    { "&bumpE;", { 10926, 0 } },
-    { "&bumpe;", { 8783, 0 } },
-    { "&bumpeq;", { 8783, 0 } },
-    { "&cacute;", { 263, 0 } },
-    { "&cap;", { 8745, 0 } },
-    { "&capand;", { 10820, 0 } },
-    { "&capbrcup;", { 10825, 0 } },
-    { "&capcap;", { 10827, 0 } },
-    { "&capcup;", { 10823, 0 } },
-    { "&capdot;", { 10816, 0 } },
-    { "&caps;", { 8745, 65024 } },
-    { "&caret;", { 8257, 0 } },
-    { "&caron;", { 711, 0 } },
-    { "&ccaps;", { 10829, 0 } },
-    { "&ccaron;", { 269, 0 } },
-    { "&ccedil;", { 231, 0 } },
-    { "&ccirc;", { 265, 0 } },
-    { "&ccups;", { 10828, 0 } },
-    { "&ccupssm;", { 10832, 0 } },
-    { "&cdot;", { 267, 0 } },
-    { "&cedil;", { 184, 0 } },
-    { "&cemptyv;", { 10674, 0 } },
-    { "&cent;", { 162, 0 } },
-    { "&centerdot;", { 183, 0 } },
-    { "&cfr;", { 120096, 0 } },
-    { "&chcy;", { 1095, 0 } },
-    { "&check;", { 10003, 0 } },
-    { "&checkmark;", { 10003, 0 } },
-    { "&chi;", { 967, 0 } },
-    { "&cir;", { 9675, 0 } },
-    { "&cirE;", { 10691, 0 } },
-    { "&circ;", { 710, 0 } },
-    { "&circeq;", { 8791, 0 } },
-    { "&circlearrowleft;", { 8634, 0 } },
-    { "&circlearrowright;", { 8635, 0 } },
-    { "&circledR;", { 174, 0 } },
-    { "&circledS;", { 9416, 0 } },
-    { "&circledast;", { 8859, 0 } },
-    { "&circledcirc;", { 8858, 0 } },
-    { "&circleddash;", { 8861, 0 } },
-    { "&cire;", { 8791, 0 } },
-    { "&cirfnint;", { 10768, 0 } },
-    { "&cirmid;", { 10991, 0 } },
-    { "&cirscir;", { 10690, 0 } },
-    { "&clubs;", { 9827, 0 } },
-    { "&clubsuit;", { 9827, 0 } },
-    { "&colon;", { 58, 0 } },
-    { "&colone;", { 8788, 0 } },
-    { "&coloneq;", { 8788, 0 } },
-    { "&comma;", { 44, 0 } },
-    { "&commat;", { 64, 0 } },
-    { "&comp;", { 8705, 0 } },
-    { "&compfn;", { 8728, 0 } },
-    { "&complement;", { 8705, 0 } },
-    { "&complexes;", { 8450, 0 } },
-    { "&cong;", { 8773, 0 } },
-    { "&congdot;", { 10861, 0 } },
-    { "&conint;", { 8750, 0 } },
-    { "&copf;", { 120148, 0 } },
-    { "&coprod;", { 8720, 0 } },
-    { "&copy;", { 169, 0 } },
-    { "&copysr;", { 8471, 0 } },
-    { "&crarr;", { 8629, 0 } },
-    { "&cross;", { 10007, 0 } },
-    { "&cscr;", { 119992, 0 } },
-    { "&csub;", { 10959, 0 } },
-    { "&csube;", { 10961, 0 } },
-    { "&csup;", { 10960, 0 } },
-    { "&csupe;", { 10962, 0 } },
-    { "&ctdot;", { 8943, 0 } },
-    { "&cudarrl;", { 10552, 0 } },
-    { "&cudarrr;", { 10549, 0 } },
-    { "&cuepr;", { 8926, 0 } },
-    { "&cuesc;", { 8927, 0 } },
-    { "&cularr;", { 8630, 0 } },
-    { "&cularrp;", { 10557, 0 } },
-    { "&cup;", { 8746, 0 } },
-    { "&cupbrcap;", { 10824, 0 } },
-    { "&cupcap;", { 10822, 0 } },
-    { "&cupcup;", { 10826, 0 } },
-    { "&cupdot;", { 8845, 0 } },
-    { "&cupor;", { 10821, 0 } },
-    { "&cups;", { 8746, 65024 } },
-    { "&curarr;", { 8631, 0 } },
-    { "&curarrm;", { 10556, 0 } },
-    { "&curlyeqprec;", { 8926, 0 } },
-    { "&curlyeqsucc;", { 8927, 0 } },
-    { "&curlyvee;", { 8910, 0 } },
-    { "&curlywedge;", { 8911, 0 } },
-    { "&curren;", { 164, 0 } },
-    { "&curvearrowleft;", { 8630, 0 } },
-    { "&curvearrowright;", { 8631, 0 } },
-    { "&cuvee;", { 8910, 0 } },
-    { "&cuwed;", { 8911, 0 } },
-    { "&cwconint;", { 8754, 0 } },
-    { "&cwint;", { 8753, 0 } },
-    { "&cylcty;", { 9005, 0 } },
-    { "&dArr;", { 8659, 0 } },
-    { "&dHar;", { 10597, 0 } },
-    { "&dagger;", { 8224, 0 } },
-    { "&daleth;", { 8504, 0 } },
-    { "&darr;", { 8595, 0 } },
-    { "&dash;", { 8208, 0 } },
-    { "&dashv;", { 8867, 0 } },
-    { "&dbkarow;", { 10511, 0 } },
-    { "&dblac;", { 733, 0 } },
-    { "&dcaron;", { 271, 0 } },
-    { "&dcy;", { 1076, 0 } },
-    { "&dd;", { 8518, 0 } },
-    { "&ddagger;", { 8225, 0 } },
-    { "&ddarr;", { 8650, 0 } },
-    { "&ddotseq;", { 10871, 0 } },
-    { "&deg;", { 176, 0 } },
-    { "&delta;", { 948, 0 } },
-    { "&demptyv;", { 10673, 0 } },
-    { "&dfisht;", { 10623, 0 } },
-    { "&dfr;", { 120097, 0 } },
-    { "&dharl;", { 8643, 0 } },
-    { "&dharr;", { 8642, 0 } },
-    { "&diam;", { 8900, 0 } },
-    { "&diamond;", { 8900, 0 } },
-    { "&diamondsuit;", { 9830, 0 } },
-    { "&diams;", { 9830, 0 } },
-    { "&die;", { 168, 0 } },
-    { "&digamma;", { 989, 0 } },
-    { "&disin;", { 8946, 0 } },
-    { "&div;", { 247, 0 } },
-    { "&divide;", { 247, 0 } },
-    { "&divideontimes;", { 8903, 0 } },
-    { "&divonx;", { 8903, 0 } },
-    { "&djcy;", { 1106, 0 } },
-    { "&dlcorn;", { 8990, 0 } },
-    { "&dlcrop;", { 8973, 0 } },
-    { "&dollar;", { 36, 0 } },
-    { "&dopf;", { 120149, 0 } },
-    { "&dot;", { 729, 0 } },
-    { "&doteq;", { 8784, 0 } },
-    { "&doteqdot;", { 8785, 0 } },
-    { "&dotminus;", { 8760, 0 } },
-    { "&dotplus;", { 8724, 0 } },
-    { "&dotsquare;", { 8865, 0 } },
-    { "&doublebarwedge;", { 8966, 0 } },
-    { "&downarrow;", { 8595, 0 } },
-    { "&downdownarrows;", { 8650, 0 } },
-    { "&downharpoonleft;", { 8643, 0 } },
-    { "&downharpoonright;", { 8642, 0 } },
-    { "&drbkarow;", { 10512, 0 } },
-    { "&drcorn;", { 8991, 0 } },
-    { "&drcrop;", { 8972, 0 } },
-    { "&dscr;", { 119993, 0 } },
-    { "&dscy;", { 1109, 0 } },
-    { "&dsol;", { 10742, 0 } },
-    { "&dstrok;", { 273, 0 } },
-    { "&dtdot;", { 8945, 0 } },
-    { "&dtri;", { 9663, 0 } },
-    { "&dtrif;", { 9662, 0 } },
-    { "&duarr;", { 8693, 0 } },
-    { "&duhar;", { 10607, 0 } },
-    { "&dwangle;", { 10662, 0 } },
-    { "&dzcy;", { 1119, 0 } },
-    { "&dzigrarr;", { 10239, 0 } },
-    { "&eDDot;", { 10871, 0 } },
-    { "&eDot;", { 8785, 0 } },
-    { "&eacute;", { 233, 0 } },
-    { "&easter;", { 10862, 0 } },
-    { "&ecaron;", { 283, 0 } },
-    { "&ecir;", { 8790, 0 } },
-    { "&ecirc;", { 234, 0 } },
-    { "&ecolon;", { 8789, 0 } },
-    { "&ecy;", { 1101, 0 } },
-    { "&edot;", { 279, 0 } },
-    { "&ee;", { 8519, 0 } },
-    { "&efDot;", { 8786, 0 } },
-    { "&efr;", { 120098, 0 } },
-    { "&eg;", { 10906, 0 } },
-    { "&egrave;", { 232, 0 } },
-    { "&egs;", { 10902, 0 } },
-    { "&egsdot;", { 10904, 0 } },
-    { "&el;", { 10905, 0 } },
-    { "&elinters;", { 9191, 0 } },
-    { "&ell;", { 8467, 0 } },
-    { "&els;", { 10901, 0 } },
-    { "&elsdot;", { 10903, 0 } },
-    { "&emacr;", { 275, 0 } },
-    { "&empty;", { 8709, 0 } },
-    { "&emptyset;", { 8709, 0 } },
-    { "&emptyv;", { 8709, 0 } },
-    { "&emsp13;", { 8196, 0 } },
-    { "&emsp14;", { 8197, 0 } },
-    { "&emsp;", { 8195, 0 } },
-    { "&eng;", { 331, 0 } },
-    { "&ensp;", { 8194, 0 } },
-    { "&eogon;", { 281, 0 } },
-    { "&eopf;", { 120150, 0 } },
-    { "&epar;", { 8917, 0 } },
-    { "&eparsl;", { 10723, 0 } },
-    { "&eplus;", { 10865, 0 } },
-    { "&epsi;", { 949, 0 } },
-    { "&epsilon;", { 949, 0 } },
-    { "&epsiv;", { 1013, 0 } },
-    { "&eqcirc;", { 8790, 0 } },
-    { "&eqcolon;", { 8789, 0 } },
-    { "&eqsim;", { 8770, 0 } },
-    { "&eqslantgtr;", { 10902, 0 } },
-    { "&eqslantless;", { 10901, 0 } },
-    { "&equals;", { 61, 0 } },
-    { "&equest;", { 8799, 0 } },
-    { "&equiv;", { 8801, 0 } },
-    { "&equivDD;", { 10872, 0 } },
-    { "&eqvparsl;", { 10725, 0 } },
-    { "&erDot;", { 8787, 0 } },
-    { "&erarr;", { 10609, 0 } },
-    { "&escr;", { 8495, 0 } },
-    { "&esdot;", { 8784, 0 } },
-    { "&esim;", { 8770, 0 } },
-    { "&eta;", { 951, 0 } },
-    { "&eth;", { 240, 0 } },
-    { "&euml;", { 235, 0 } },
-    { "&euro;", { 8364, 0 } },
-    { "&excl;", { 33, 0 } },
-    { "&exist;", { 8707, 0 } },
-    { "&expectation;", { 8496, 0 } },
-    { "&exponentiale;", { 8519, 0 } },
-    { "&fallingdotseq;", { 8786, 0 } },
-    { "&fcy;", { 1092, 0 } },
-    { "&female;", { 9792, 0 } },
-    { "&ffilig;", { 64259, 0 } },
-    { "&fflig;", { 64256, 0 } },
-    { "&ffllig;", { 64260, 0 } },
-    { "&ffr;", { 120099, 0 } },
-    { "&filig;", { 64257, 0 } },
-    { "&fjlig;", { 102, 106 } },
-    { "&flat;", { 9837, 0 } },
-    { "&fllig;", { 64258, 0 } },
-    { "&fltns;", { 9649, 0 } },
-    { "&fnof;", { 402, 0 } },
-    { "&fopf;", { 120151, 0 } },
-    { "&forall;", { 8704, 0 } },
-    { "&fork;", { 8916, 0 } },
-    { "&forkv;", { 10969, 0 } },
-    { "&fpartint;", { 10765, 0 } },
-    { "&frac12", { 189, 0 } },
-    { "&frac12;", { 189, 0 } },
-    { "&frac13;", { 8531, 0 } },
-    { "&frac14", { 188, 0 } },
-    { "&frac14;", { 188, 0 } },
-    { "&frac15;", { 8533, 0 } },
-    { "&frac16;", { 8537, 0 } },
-    { "&frac18;", { 8539, 0 } },
-    { "&frac23;", { 8532, 0 } },
-    { "&frac25;", { 8534, 0 } },
-    { "&frac34", { 190, 0 } },
-    { "&frac34;", { 190, 0 } },
-    { "&frac35;", { 8535, 0 } },
-    { "&frac38;", { 8540, 0 } },
-    { "&frac45;", { 8536, 0 } },
-    { "&frac56;", { 8538, 0 } },
-    { "&frac58;", { 8541, 0 } },
-    { "&frac78;", { 8542, 0 } },
-    { "&frasl;", { 8260, 0 } },
-    { "&frown;", { 8994, 0 } },
-    { "&fscr;", { 119995, 0 } },
-    { "&gE;", { 8807, 0 } },
-    { "&gEl;", { 10892, 0 } },
-    { "&gacute;", { 501, 0 } },
-    { "&gamma;", { 947, 0 } },
-    { "&gammad;", { 989, 0 } },
-    { "&gap;", { 10886, 0 } },
-    { "&gbreve;", { 287, 0 } },
-    { "&gcirc;", { 285, 0 } },
-    { "&gcy;", { 1075, 0 } },
-    { "&gdot;", { 289, 0 } },
-    { "&ge;", { 8805, 0 } },
-    { "&gel;", { 8923, 0 } },
-    { "&geq;", { 8805, 0 } },
-    { "&geqq;", { 8807, 0 } },
-    { "&geqslant;", { 10878, 0 } },
-    { "&ges;", { 10878, 0 } },
-    { "&gescc;", { 10921, 0 } },
-    { "&gesdot;", { 10880, 0 } },
-    { "&gesdoto;", { 10882, 0 } },
-    { "&gesdotol;", { 10884, 0 } },
-    { "&gesl;", { 8923, 65024 } },
-    { "&gesles;", { 10900, 0 } },
-    { "&gfr;", { 120100, 0 } },
-    { "&gg;", { 8811, 0 } },
-    { "&ggg;", { 8921, 0 } },
-    { "&gimel;", { 8503, 0 } },
-    { "&gjcy;", { 1107, 0 } },
-    { "&gl;", { 8823, 0 } },
-    { "&glE;", { 10898, 0 } },
-    { "&gla;", { 10917, 0 } },
-    { "&glj;", { 10916, 0 } },
-    { "&gnE;", { 8809, 0 } },
-    { "&gnap;", { 10890, 0 } },
-    { "&gnapprox;", { 10890, 0 } },
-    { "&gne;", { 10888, 0 } },
-    { "&gneq;", { 10888, 0 } },
-    { "&gneqq;", { 8809, 0 } },
-    { "&gnsim;", { 8935, 0 } },
-    { "&gopf;", { 120152, 0 } },
-    { "&grave;", { 96, 0 } },
-    { "&gscr;", { 8458, 0 } },
-    { "&gsim;", { 8819, 0 } },
-    { "&gsime;", { 10894, 0 } },
-    { "&gsiml;", { 10896, 0 } },
-    { "&gt;", { 62, 0 } },
-    { "&gtcc;", { 10919, 0 } },
-    { "&gtcir;", { 10874, 0 } },
-    { "&gtdot;", { 8919, 0 } },
-    { "&gtlPar;", { 10645, 0 } },
-    { "&gtquest;", { 10876, 0 } },
-    { "&gtrapprox;", { 10886, 0 } },
-    { "&gtrarr;", { 10616, 0 } },
-    { "&gtrdot;", { 8919, 0 } },
-    { "&gtreqless;", { 8923, 0 } },
-    { "&gtreqqless;", { 10892, 0 } },
-    { "&gtrless;", { 8823, 0 } },
-    { "&gtrsim;", { 8819, 0 } },
-    { "&gvertneqq;", { 8809, 65024 } },
-    { "&gvnE;", { 8809, 65024 } },
-    { "&hArr;", { 8660, 0 } },
-    { "&hairsp;", { 8202, 0 } },
-    { "&half;", { 189, 0 } },
-    { "&hamilt;", { 8459, 0 } },
-    { "&hardcy;", { 1098, 0 } },
-    { "&harr;", { 8596, 0 } },
-    { "&harrcir;", { 10568, 0 } },
-    { "&harrw;", { 8621, 0 } },
-    { "&hbar;", { 8463, 0 } },
-    { "&hcirc;", { 293, 0 } },
-    { "&hearts;", { 9829, 0 } },
-    { "&heartsuit;", { 9829, 0 } },
-    { "&hellip;", { 8230, 0 } },
-    { "&hercon;", { 8889, 0 } },
-    { "&hfr;", { 120101, 0 } },
-    { "&hksearow;", { 10533, 0 } },
-    { "&hkswarow;", { 10534, 0 } },
-    { "&hoarr;", { 8703, 0 } },
-    { "&homtht;", { 8763, 0 } },
-    { "&hookleftarrow;", { 8617, 0 } },
-    { "&hookrightarrow;", { 8618, 0 } },
-    { "&hopf;", { 120153, 0 } },
-    { "&horbar;", { 8213, 0 } },
-    { "&hscr;", { 119997, 0 } },
-    { "&hslash;", { 8463, 0 } },
-    { "&hstrok;", { 295, 0 } },
-    { "&hybull;", { 8259, 0 } },
-    { "&hyphen;", { 8208, 0 } },
-    { "&iacute;", { 237, 0 } },
-    { "&ic;", { 8291, 0 } },
-    { "&icirc;", { 238, 0 } },
-    { "&icy;", { 1080, 0 } },
-    { "&iecy;", { 1077, 0 } },
-    { "&iexcl;", { 161, 0 } },
-    { "&iff;", { 8660, 0 } },
-    { "&ifr;", { 120102, 0 } },
-    { "&igrave;", { 236, 0 } },
-    { "&ii;", { 8520, 0 } },
-    { "&iiiint;", { 10764, 0 } },
-    { "&iiint;", { 8749, 0 } },
-    { "&iinfin;", { 10716, 0 } },
-    { "&iiota;", { 8489, 0 } },
-    { "&ijlig;", { 307, 0 } },
-    { "&imacr;", { 299, 0 } },
-    { "&image;", { 8465, 0 } },
-    { "&imagline;", { 8464, 0 } },
-    { "&imagpart;", { 8465, 0 } },
-    { "&imath;", { 305, 0 } },
-    { "&imof;", { 8887, 0 } },
-    { "&imped;", { 437, 0 } },
-    { "&in;", { 8712, 0 } },
-    { "&incare;", { 8453, 0 } },
-    { "&infin;", { 8734, 0 } },
-    { "&infintie;", { 10717, 0 } },
-    { "&inodot;", { 305, 0 } },
-    { "&int;", { 8747, 0 } },
-    { "&intcal;", { 8890, 0 } },
-    { "&integers;", { 8484, 0 } },
-    { "&intercal;", { 8890, 0 } },
-    { "&intlarhk;", { 10775, 0 } },
-    { "&intprod;", { 10812, 0 } },
-    { "&iocy;", { 1105, 0 } },
-    { "&iogon;", { 303, 0 } },
-    { "&iopf;", { 120154, 0 } },
-    { "&iota;", { 953, 0 } },
-    { "&iprod;", { 10812, 0 } },
-    { "&iquest;", { 191, 0 } },
-    { "&iscr;", { 119998, 0 } },
-    { "&isin;", { 8712, 0 } },
-    { "&isinE;", { 8953, 0 } },
-    { "&isindot;", { 8949, 0 } },
-    { "&isins;", { 8948, 0 } },
-    { "&isinsv;", { 8947, 0 } },
-    { "&isinv;", { 8712, 0 } },
-    { "&it;", { 8290, 0 } },
-    { "&itilde;", { 297, 0 } },
-    { "&iukcy;", { 1110, 0 } },
-    { "&iuml;", { 239, 0 } },
-    { "&jcirc;", { 309, 0 } },
-    { "&jcy;", { 1081, 0 } },
-    { "&jfr;", { 120103, 0 } },
-    { "&jmath;", { 567, 0 } },
-    { "&jopf;", { 120155, 0 } },
-    { "&jscr;", { 119999, 0 } },
-    { "&jsercy;", { 1112, 0 } },
-    { "&jukcy;", { 1108, 0 } },
-    { "&kappa;", { 954, 0 } },
-    { "&kappav;", { 1008, 0 } },
-    { "&kcedil;", { 311, 0 } },
-    { "&kcy;", { 1082, 0 } },
-    { "&kfr;", { 120104, 0 } },
-    { "&kgreen;", { 312, 0 } },
-    { "&khcy;", { 1093, 0 } },
-    { "&kjcy;", { 1116, 0 } },
-    { "&kopf;", { 120156, 0 } },
-    { "&kscr;", { 120000, 0 } },
-    { "&lAarr;", { 8666, 0 } },
-    { "&lArr;", { 8656, 0 } },
-    { "&lAtail;", { 10523, 0 } },
-    { "&lBarr;", { 10510, 0 } },
-    { "&lE;", { 8806, 0 } },
-    { "&lEg;", { 10891, 0 } },
-    { "&lHar;", { 10594, 0 } },
-    { "&lacute;", { 314, 0 } },
-    { "&laemptyv;", { 10676, 0 } },
-    { "&lagran;", { 8466, 0 } },
-    { "&lambda;", { 955, 0 } },
-    { "&lang;", { 10216, 0 } },
-    { "&langd;", { 10641, 0 } },
-    { "&langle;", { 10216, 0 } },
-    { "&lap;", { 10885, 0 } },
-    { "&laquo;", { 171, 0 } },
-    { "&larr;", { 8592, 0 } },
-    { "&larrb;", { 8676, 0 } },
-    { "&larrbfs;", { 10527, 0 } },
-    { "&larrfs;", { 10525, 0 } },
-    { "&larrhk;", { 8617, 0 } },
-    { "&larrlp;", { 8619, 0 } },
-    { "&larrpl;", { 10553, 0 } },
-    { "&larrsim;", { 10611, 0 } },
-    { "&larrtl;", { 8610, 0 } },
-    { "&lat;", { 10923, 0 } },
-    { "&latail;", { 10521, 0 } },
-    { "&late;", { 10925, 0 } },
-    { "&lates;", { 10925, 65024 } },
-    { "&lbarr;", { 10508, 0 } },
-    { "&lbbrk;", { 10098, 0 } },
-    { "&lbrace;", { 123, 0 } },
-    { "&lbrack;", { 91, 0 } },
-    { "&lbrke;", { 10635, 0 } },
-    { "&lbrksld;", { 10639, 0 } },
-    { "&lbrkslu;", { 10637, 0 } },
-    { "&lcaron;", { 318, 0 } },
-    { "&lcedil;", { 316, 0 } },
-    { "&lceil;", { 8968, 0 } },
-    { "&lcub;", { 123, 0 } },
-    { "&lcy;", { 1083, 0 } },
-    { "&ldca;", { 10550, 0 } },
-    { "&ldquo;", { 8220, 0 } },
-    { "&ldquor;", { 8222, 0 } },
-    { "&ldrdhar;", { 10599, 0 } },
-    { "&ldrushar;", { 10571, 0 } },
-    { "&ldsh;", { 8626, 0 } },
-    { "&le;", { 8804, 0 } },
-    { "&leftarrow;", { 8592, 0 } },
-    { "&leftarrowtail;", { 8610, 0 } },
-    { "&leftharpoondown;", { 8637, 0 } },
-    { "&leftharpoonup;", { 8636, 0 } },
-    { "&leftleftarrows;", { 8647, 0 } },
-    { "&leftrightarrow;", { 8596, 0 } },
-    { "&leftrightarrows;", { 8646, 0 } },
-    { "&leftrightharpoons;", { 8651, 0 } },
-    { "&leftrightsquigarrow;", { 8621, 0 } },
-    { "&leftthreetimes;", { 8907, 0 } },
-    { "&leg;", { 8922, 0 } },
-    { "&leq;", { 8804, 0 } },
-    { "&leqq;", { 8806, 0 } },
-    { "&leqslant;", { 10877, 0 } },
-    { "&les;", { 10877, 0 } },
-    { "&lescc;", { 10920, 0 } },
-    { "&lesdot;", { 10879, 0 } },
-    { "&lesdoto;", { 10881, 0 } },
-    { "&lesdotor;", { 10883, 0 } },
-    { "&lesg;", { 8922, 65024 } },
-    { "&lesges;", { 10899, 0 } },
-    { "&lessapprox;", { 10885, 0 } },
-    { "&lessdot;", { 8918, 0 } },
-    { "&lesseqgtr;", { 8922, 0 } },
-    { "&lesseqqgtr;", { 10891, 0 } },
-    { "&lessgtr;", { 8822, 0 } },
-    { "&lesssim;", { 8818, 0 } },
-    { "&lfisht;", { 10620, 0 } },
-    { "&lfloor;", { 8970, 0 } },
-    { "&lfr;", { 120105, 0 } },
-    { "&lg;", { 8822, 0 } },
-    { "&lgE;", { 10897, 0 } },
-    { "&lhard;", { 8637, 0 } },
-    { "&lharu;", { 8636, 0 } },
-    { "&lharul;", { 10602, 0 } },
-    { "&lhblk;", { 9604, 0 } },
-    { "&ljcy;", { 1113, 0 } },
-    { "&ll;", { 8810, 0 } },
-    { "&llarr;", { 8647, 0 } },
-    { "&llcorner;", { 8990, 0 } },
-    { "&llhard;", { 10603, 0 } },
-    { "&lltri;", { 9722, 0 } },
-    { "&lmidot;", { 320, 0 } },
-    { "&lmoust;", { 9136, 0 } },
-    { "&lmoustache;", { 9136, 0 } },
-    { "&lnE;", { 8808, 0 } },
-    { "&lnap;", { 10889, 0 } },
-    { "&lnapprox;", { 10889, 0 } },
-    { "&lne;", { 10887, 0 } },
-    { "&lneq;", { 10887, 0 } },
-    { "&lneqq;", { 8808, 0 } },
-    { "&lnsim;", { 8934, 0 } },
-    { "&loang;", { 10220, 0 } },
-    { "&loarr;", { 8701, 0 } },
-    { "&lobrk;", { 10214, 0 } },
-    { "&longleftarrow;", { 10229, 0 } },
-    { "&longleftrightarrow;", { 10231, 0 } },
-    { "&longmapsto;", { 10236, 0 } },
-    { "&longrightarrow;", { 10230, 0 } },
-    { "&looparrowleft;", { 8619, 0 } },
-    { "&looparrowright;", { 8620, 0 } },
-    { "&lopar;", { 10629, 0 } },
-    { "&lopf;", { 120157, 0 } },
-    { "&loplus;", { 10797, 0 } },
-    { "&lotimes;", { 10804, 0 } },
-    { "&lowast;", { 8727, 0 } },
-    { "&lowbar;", { 95, 0 } },
-    { "&loz;", { 9674, 0 } },
-    { "&lozenge;", { 9674, 0 } },
-    { "&lozf;", { 10731, 0 } },
-    { "&lpar;", { 40, 0 } },
-    { "&lparlt;", { 10643, 0 } },
-    { "&lrarr;", { 8646, 0 } },
-    { "&lrcorner;", { 8991, 0 } },
-    { "&lrhar;", { 8651, 0 } },
-    { "&lrhard;", { 10605, 0 } },
-    { "&lrm;", { 8206, 0 } },
-    { "&lrtri;", { 8895, 0 } },
-    { "&lsaquo;", { 8249, 0 } },
-    { "&lscr;", { 120001, 0 } },
-    { "&lsh;", { 8624, 0 } },
-    { "&lsim;", { 8818, 0 } },
-    { "&lsime;", { 10893, 0 } },
-    { "&lsimg;", { 10895, 0 } },
-    { "&lsqb;", { 91, 0 } },
-    { "&lsquo;", { 8216, 0 } },
-    { "&lsquor;", { 8218, 0 } },
-    { "&lstrok;", { 322, 0 } },
-    { "&lt;", { 60, 0 } },
-    { "&ltcc;", { 10918, 0 } },
-    { "&ltcir;", { 10873, 0 } },
-    { "&ltdot;", { 8918, 0 } },
-    { "&lthree;", { 8907, 0 } },
-    { "&ltimes;", { 8905, 0 } },
-    { "&ltlarr;", { 10614, 0 } },
-    { "&ltquest;", { 10875, 0 } },
-    { "&ltrPar;", { 10646, 0 } },
-    { "&ltri;", { 9667, 0 } },
-    { "&ltrie;", { 8884, 0 } },
-    { "&ltrif;", { 9666, 0 } },
-    { "&lurdshar;", { 10570, 0 } },
-    { "&luruhar;", { 10598, 0 } },
-    { "&lvertneqq;", { 8808, 65024 } },
-    { "&lvnE;", { 8808, 65024 } },
-    { "&mDDot;", { 8762, 0 } },
-    { "&macr;", { 175, 0 } },
-    { "&male;", { 9794, 0 } },
-    { "&malt;", { 10016, 0 } },
-    { "&maltese;", { 10016, 0 } },
-    { "&map;", { 8614, 0 } },
-    { "&mapsto;", { 8614, 0 } },
-    { "&mapstodown;", { 8615, 0 } },
-    { "&mapstoleft;", { 8612, 0 } },
-    { "&mapstoup;", { 8613, 0 } },
-    { "&marker;", { 9646, 0 } },
-    { "&mcomma;", { 10793, 0 } },
-    { "&mcy;", { 1084, 0 } },
-    { "&mdash;", { 8212, 0 } },
-    { "&measuredangle;", { 8737, 0 } },
-    { "&mfr;", { 120106, 0 } },
-    { "&mho;", { 8487, 0 } },
-    { "&micro;", { 181, 0 } },
-    { "&mid;", { 8739, 0 } },
-    { "&midast;", { 42, 0 } },
-    { "&midcir;", { 10992, 0 } },
-    { "&middot;", { 183, 0 } },
-    { "&minus;", { 8722, 0 } },
-    { "&minusb;", { 8863, 0 } },
-    { "&minusd;", { 8760, 0 } },
-    { "&minusdu;", { 10794, 0 } },
-    { "&mlcp;", { 10971, 0 } },
-    { "&mldr;", { 8230, 0 } },
-    { "&mnplus;", { 8723, 0 } },
-    { "&models;", { 8871, 0 } },
-    { "&mopf;", { 120158, 0 } },
-    { "&mp;", { 8723, 0 } },
-    { "&mscr;", { 120002, 0 } },
-    { "&mstpos;", { 8766, 0 } },
-    { "&mu;", { 956, 0 } },
-    { "&multimap;", { 8888, 0 } },
-    { "&mumap;", { 8888, 0 } },
-    { "&nGg;", { 8921, 824 } },
-    { "&nGt;", { 8811, 8402 } },
-    { "&nGtv;", { 8811, 824 } },
-    { "&nLeftarrow;", { 8653, 0 } },
-    { "&nLeftrightarrow;", { 8654, 0 } },
-    { "&nLl;", { 8920, 824 } },
-    { "&nLt;", { 8810, 8402 } },
-    { "&nLtv;", { 8810, 824 } },
-    { "&nRightarrow;", { 8655, 0 } },
-    { "&nVDash;", { 8879, 0 } },
-    { "&nVdash;", { 8878, 0 } },
-    { "&nabla;", { 8711, 0 } },
-    { "&nacute;", { 324, 0 } },
-    { "&nang;", { 8736, 8402 } },
-    { "&nap;", { 8777, 0 } },
-    { "&napE;", { 10864, 824 } },
-    { "&napid;", { 8779, 824 } },
-    { "&napos;", { 329, 0 } },
-    { "&napprox;", { 8777, 0 } },
-    { "&natur;", { 9838, 0 } },
-    { "&natural;", { 9838, 0 } },
-    { "&naturals;", { 8469, 0 } },
-    { "&nbsp;", { 160, 0 } },
-    { "&nbump;", { 8782, 824 } },
-    { "&nbumpe;", { 8783, 824 } },
-    { "&ncap;", { 10819, 0 } },
-    { "&ncaron;", { 328, 0 } },
-    { "&ncedil;", { 326, 0 } },
-    { "&ncong;", { 8775, 0 } },
-    { "&ncongdot;", { 10861, 824 } },
-    { "&ncup;", { 10818, 0 } },
-    { "&ncy;", { 1085, 0 } },
-    { "&ndash;", { 8211, 0 } },
-    { "&ne;", { 8800, 0 } },
-    { "&neArr;", { 8663, 0 } },
-    { "&nearhk;", { 10532, 0 } },
-    { "&nearr;", { 8599, 0 } },
-    { "&nearrow;", { 8599, 0 } },
-    { "&nedot;", { 8784, 824 } },
-    { "&nequiv;", { 8802, 0 } },
-    { "&nesear;", { 10536, 0 } },
-    { "&nesim;", { 8770, 824 } },
-    { "&nexist;", { 8708, 0 } },
-    { "&nexists;", { 8708, 0 } },
-    { "&nfr;", { 120107, 0 } },
-    { "&ngE;", { 8807, 824 } },
-    { "&nge;", { 8817, 0 } },
-    { "&ngeq;", { 8817, 0 } },
-    { "&ngeqq;", { 8807, 824 } },
-    { "&ngeqslant;", { 10878, 824 } },
-    { "&nges;", { 10878, 824 } },
-    { "&ngsim;", { 8821, 0 } },
-    { "&ngt;", { 8815, 0 } },
-    { "&ngtr;", { 8815, 0 } },
-    { "&nhArr;", { 8654, 0 } },
-    { "&nharr;", { 8622, 0 } },
-    { "&nhpar;", { 10994, 0 } },
-    { "&ni;", { 8715, 0 } },
-    { "&nis;", { 8956, 0 } },
-    { "&nisd;", { 8954, 0 } },
-    { "&niv;", { 8715, 0 } },
-    { "&njcy;", { 1114, 0 } },
-    { "&nlArr;", { 8653, 0 } },
-    { "&nlE;", { 8806, 824 } },
-    { "&nlarr;", { 8602, 0 } },
-    { "&nldr;", { 8229, 0 } },
-    { "&nle;", { 8816, 0 } },
-    { "&nleftarrow;", { 8602, 0 } },
-    { "&nleftrightarrow;", { 8622, 0 } },
-    { "&nleq;", { 8816, 0 } },
-    { "&nleqq;", { 8806, 824 } },
-    { "&nleqslant;", { 10877, 824 } },
-    { "&nles;", { 10877, 824 } },
-    { "&nless;", { 8814, 0 } },
-    { "&nlsim;", { 8820, 0 } },
-    { "&nlt;", { 8814, 0 } },
-    { "&nltri;", { 8938, 0 } },
-    { "&nltrie;", { 8940, 0 } },
-    { "&nmid;", { 8740, 0 } },
-    { "&nopf;", { 120159, 0 } },
-    { "&not;", { 172, 0 } },
-    { "&notin;", { 8713, 0 } },
-    { "&notinE;", { 8953, 824 } },
-    { "&notindot;", { 8949, 824 } },
-    { "&notinva;", { 8713, 0 } },
-    { "&notinvb;", { 8951, 0 } },
-    { "&notinvc;", { 8950, 0 } },
-    { "&notni;", { 8716, 0 } },
-    { "&notniva;", { 8716, 0 } },
-    { "&notnivb;", { 8958, 0 } },
-    { "&notnivc;", { 8957, 0 } },
-    { "&npar;", { 8742, 0 } },
-    { "&nparallel;", { 8742, 0 } },
-    { "&nparsl;", { 11005, 8421 } },
-    { "&npart;", { 8706, 824 } },
-    { "&npolint;", { 10772, 0 } },
-    { "&npr;", { 8832, 0 } },
-    { "&nprcue;", { 8928, 0 } },
-    { "&npre;", { 10927, 824 } },
-    { "&nprec;", { 8832, 0 } },
-    { "&npreceq;", { 10927, 824 } },
-    { "&nrArr;", { 8655, 0 } },
-    { "&nrarr;", { 8603, 0 } },
-    { "&nrarrc;", { 10547, 824 } },
-    { "&nrarrw;", { 8605, 824 } },
-    { "&nrightarrow;", { 8603, 0 } },
-    { "&nrtri;", { 8939, 0 } },
-    { "&nrtrie;", { 8941, 0 } },
-    { "&nsc;", { 8833, 0 } },
-    { "&nsccue;", { 8929, 0 } },
-    { "&nsce;", { 10928, 824 } },
-    { "&nscr;", { 120003, 0 } },
-    { "&nshortmid;", { 8740, 0 } },
-    { "&nshortparallel;", { 8742, 0 } },
-    { "&nsim;", { 8769, 0 } },
-    { "&nsime;", { 8772, 0 } },
-    { "&nsimeq;", { 8772, 0 } },
-    { "&nsmid;", { 8740, 0 } },
-    { "&nspar;", { 8742, 0 } },
-    { "&nsqsube;", { 8930, 0 } },
-    { "&nsqsupe;", { 8931, 0 } },
-    { "&nsub;", { 8836, 0 } },
-    { "&nsubE;", { 10949, 824 } },
-    { "&nsube;", { 8840, 0 } },
-    { "&nsubset;", { 8834, 8402 } },
-    { "&nsubseteq;", { 8840, 0 } },
-    { "&nsubseteqq;", { 10949, 824 } },
-    { "&nsucc;", { 8833, 0 } },
-    { "&nsucceq;", { 10928, 824 } },
-    { "&nsup;", { 8837, 0 } },
-    { "&nsupE;", { 10950, 824 } },
-    { "&nsupe;", { 8841, 0 } },
-    { "&nsupset;", { 8835, 8402 } },
-    { "&nsupseteq;", { 8841, 0 } },
-    { "&nsupseteqq;", { 10950, 824 } },
-    { "&ntgl;", { 8825, 0 } },
-    { "&ntilde;", { 241, 0 } },
-    { "&ntlg;", { 8824, 0 } },
-    { "&ntriangleleft;", { 8938, 0 } },
-    { "&ntrianglelefteq;", { 8940, 0 } },
-    { "&ntriangleright;", { 8939, 0 } },
-    { "&ntrianglerighteq;", { 8941, 0 } },
-    { "&nu;", { 957, 0 } },
-    { "&num;", { 35, 0 } },
-    { "&numero;", { 8470, 0 } },
-    { "&numsp;", { 8199, 0 } },
-    { "&nvDash;", { 8877, 0 } },
-    { "&nvHarr;", { 10500, 0 } },
-    { "&nvap;", { 8781, 8402 } },
-    { "&nvdash;", { 8876, 0 } },
-    { "&nvge;", { 8805, 8402 } },
-    { "&nvgt;", { 62, 8402 } },
-    { "&nvinfin;", { 10718, 0 } },
-    { "&nvlArr;", { 10498, 0 } },
-    { "&nvle;", { 8804, 8402 } },
-    { "&nvlt;", { 60, 8402 } },
-    { "&nvltrie;", { 8884, 8402 } },
-    { "&nvrArr;", { 10499, 0 } },
-    { "&nvrtrie;", { 8885, 8402 } },
-    { "&nvsim;", { 8764, 8402 } },
-    { "&nwArr;", { 8662, 0 } },
-    { "&nwarhk;", { 10531, 0 } },
-    { "&nwarr;", { 8598, 0 } },
-    { "&nwarrow;", { 8598, 0 } },
-    { "&nwnear;", { 10535, 0 } },
-    { "&oS;", { 9416, 0 } },
-    { "&oacute;", { 243, 0 } },
-    { "&oast;", { 8859, 0 } },
-    { "&ocir;", { 8858, 0 } },
-    { "&ocirc;", { 244, 0 } },
-    { "&ocy;", { 1086, 0 } },
-    { "&odash;", { 8861, 0 } },
-    { "&odblac;", { 337, 0 } },
-    { "&odiv;", { 10808, 0 } },
-    { "&odot;", { 8857, 0 } },
-    { "&odsold;", { 10684, 0 } },
-    { "&oelig;", { 339, 0 } },
-    { "&ofcir;", { 10687, 0 } },
-    { "&ofr;", { 120108, 0 } },
-    { "&ogon;", { 731, 0 } },
-    { "&ograve;", { 242, 0 } },
-    { "&ogt;", { 10689, 0 } },
-    { "&ohbar;", { 10677, 0 } },
-    { "&ohm;", { 937, 0 } },
-    { "&oint;", { 8750, 0 } },
-    { "&olarr;", { 8634, 0 } },
-    { "&olcir;", { 10686, 0 } },
-    { "&olcross;", { 10683, 0 } },
-    { "&oline;", { 8254, 0 } },
-    { "&olt;", { 10688, 0 } },
-    { "&omacr;", { 333, 0 } },
-    { "&omega;", { 969, 0 } },
-    { "&omicron;", { 959, 0 } },
-    { "&omid;", { 10678, 0 } },
-    { "&ominus;", { 8854, 0 } },
-    { "&oopf;", { 120160, 0 } },
-    { "&opar;", { 10679, 0 } },
-    { "&operp;", { 10681, 0 } },
-    { "&oplus;", { 8853, 0 } },
-    { "&or;", { 8744, 0 } },
-    { "&orarr;", { 8635, 0 } },
-    { "&ord;", { 10845, 0 } },
-    { "&order;", { 8500, 0 } },
-    { "&orderof;", { 8500, 0 } },
-    { "&ordf;", { 170, 0 } },
-    { "&ordm;", { 186, 0 } },
-    { "&origof;", { 8886, 0 } },
-    { "&oror;", { 10838, 0 } },
-    { "&orslope;", { 10839, 0 } },
-    { "&orv;", { 10843, 0 } },
-    { "&oscr;", { 8500, 0 } },
-    { "&oslash;", { 248, 0 } },
-    { "&osol;", { 8856, 0 } },
-    { "&otilde;", { 245, 0 } },
-    { "&otimes;", { 8855, 0 } },
-    { "&otimesas;", { 10806, 0 } },
-    { "&ouml;", { 246, 0 } },
-    { "&ovbar;", { 9021, 0 } },
-    { "&par;", { 8741, 0 } },
-    { "&para;", { 182, 0 } },
-    { "&parallel;", { 8741, 0 } },
-    { "&parsim;", { 10995, 0 } },
-    { "&parsl;", { 11005, 0 } },
-    { "&part;", { 8706, 0 } },
-    { "&pcy;", { 1087, 0 } },
-    { "&percnt;", { 37, 0 } },
-    { "&period;", { 46, 0 } },
-    { "&permil;", { 8240, 0 } },
-    { "&perp;", { 8869, 0 } },
-    { "&pertenk;", { 8241, 0 } },
-    { "&pfr;", { 120109, 0 } },
-    { "&phi;", { 966, 0 } },
-    { "&phiv;", { 981, 0 } },
-    { "&phmmat;", { 8499, 0 } },
-    { "&phone;", { 9742, 0 } },
-    { "&pi;", { 960, 0 } },
-    { "&pitchfork;", { 8916, 0 } },
-    { "&piv;", { 982, 0 } },
-    { "&planck;", { 8463, 0 } },
-    { "&planckh;", { 8462, 0 } },
-    { "&plankv;", { 8463, 0 } },
-    { "&plus;", { 43, 0 } },
-    { "&plusacir;", { 10787, 0 } },
-    { "&plusb;", { 8862, 0 } },
-    { "&pluscir;", { 10786, 0 } },
-    { "&plusdo;", { 8724, 0 } },
-    { "&plusdu;", { 10789, 0 } },
-    { "&pluse;", { 10866, 0 } },
-    { "&plusmn;", { 177, 0 } },
-    { "&plussim;", { 10790, 0 } },
-    { "&plustwo;", { 10791, 0 } },
-    { "&pm;", { 177, 0 } },
-    { "&pointint;", { 10773, 0 } },
-    { "&popf;", { 120161, 0 } },
-    { "&pound;", { 163, 0 } },
-    { "&pr;", { 8826, 0 } },
-    { "&prE;", { 10931, 0 } },
-    { "&prap;", { 10935, 0 } },
-    { "&prcue;", { 8828, 0 } },
-    { "&pre;", { 10927, 0 } },
-    { "&prec;", { 8826, 0 } },
-    { "&precapprox;", { 10935, 0 } },
-    { "&preccurlyeq;", { 8828, 0 } },
-    { "&preceq;", { 10927, 0 } },
-    { "&precnapprox;", { 10937, 0 } },
-    { "&precneqq;", { 10933, 0 } },
-    { "&precnsim;", { 8936, 0 } },
-    { "&precsim;", { 8830, 0 } },
-    { "&prime;", { 8242, 0 } },
-    { "&primes;", { 8473, 0 } },
-    { "&prnE;", { 10933, 0 } },
-    { "&prnap;", { 10937, 0 } },
-    { "&prnsim;", { 8936, 0 } },
-    { "&prod;", { 8719, 0 } },
-    { "&profalar;", { 9006, 0 } },
-    { "&profline;", { 8978, 0 } },
-    { "&profsurf;", { 8979, 0 } },
-    { "&prop;", { 8733, 0 } },
-    { "&propto;", { 8733, 0 } },
-    { "&prsim;", { 8830, 0 } },
-    { "&prurel;", { 8880, 0 } },
-    { "&pscr;", { 120005, 0 } },
-    { "&psi;", { 968, 0 } },
-    { "&puncsp;", { 8200, 0 } },
-    { "&qfr;", { 120110, 0 } },
-    { "&qint;", { 10764, 0 } },
-    { "&qopf;", { 120162, 0 } },
-    { "&qprime;", { 8279, 0 } },
-    { "&qscr;", { 120006, 0 } },
-    { "&quaternions;", { 8461, 0 } },
-    { "&quatint;", { 10774, 0 } },
-    { "&quest;", { 63, 0 } },
-    { "&questeq;", { 8799, 0 } },
-    { "&quot;", { 34, 0 } },
-    { "&rAarr;", { 8667, 0 } },
-    { "&rArr;", { 8658, 0 } },
-    { "&rAtail;", { 10524, 0 } },
-    { "&rBarr;", { 10511, 0 } },
-    { "&rHar;", { 10596, 0 } },
-    { "&race;", { 8765, 817 } },
-    { "&racute;", { 341, 0 } },
-    { "&radic;", { 8730, 0 } },
-    { "&raemptyv;", { 10675, 0 } },
-    { "&rang;", { 10217, 0 } },
-    { "&rangd;", { 10642, 0 } },
-    { "&range;", { 10661, 0 } },
-    { "&rangle;", { 10217, 0 } },
-    { "&raquo;", { 187, 0 } },
-    { "&rarr;", { 8594, 0 } },
-    { "&rarrap;", { 10613, 0 } },
-    { "&rarrb;", { 8677, 0 } },
-    { "&rarrbfs;", { 10528, 0 } },
-    { "&rarrc;", { 10547, 0 } },
-    { "&rarrfs;", { 10526, 0 } },
-    { "&rarrhk;", { 8618, 0 } },
-    { "&rarrlp;", { 8620, 0 } },
-    { "&rarrpl;", { 10565, 0 } },
-    { "&rarrsim;", { 10612, 0 } },
-    { "&rarrtl;", { 8611, 0 } },
-    { "&rarrw;", { 8605, 0 } },
-    { "&ratail;", { 10522, 0 } },
-    { "&ratio;", { 8758, 0 } },
-    { "&rationals;", { 8474, 0 } },
-    { "&rbarr;", { 10509, 0 } },
-    { "&rbbrk;", { 10099, 0 } },
-    { "&rbrace;", { 125, 0 } },
-    { "&rbrack;", { 93, 0 } },
-    { "&rbrke;", { 10636, 0 } },
-    { "&rbrksld;", { 10638, 0 } },
-    { "&rbrkslu;", { 10640, 0 } },
-    { "&rcaron;", { 345, 0 } },
-    { "&rcedil;", { 343, 0 } },
-    { "&rceil;", { 8969, 0 } },
-    { "&rcub;", { 125, 0 } },
-    { "&rcy;", { 1088, 0 } },
-    { "&rdca;", { 10551, 0 } },
-    { "&rdldhar;", { 10601, 0 } },
-    { "&rdquo;", { 8221, 0 } },
-    { "&rdquor;", { 8221, 0 } },
-    { "&rdsh;", { 8627, 0 } },
-    { "&real;", { 8476, 0 } },
-    { "&realine;", { 8475, 0 } },
-    { "&realpart;", { 8476, 0 } },
-    { "&reals;", { 8477, 0 } },
-    { "&rect;", { 9645, 0 } },
-    { "&reg;", { 174, 0 } },
-    { "&rfisht;", { 10621, 0 } },
-    { "&rfloor;", { 8971, 0 } },
-    { "&rfr;", { 120111, 0 } },
-    { "&rhard;", { 8641, 0 } },
-    { "&rharu;", { 8640, 0 } },
-    { "&rharul;", { 10604, 0 } },
-    { "&rho;", { 961, 0 } },
-    { "&rhov;", { 1009, 0 } },
-    { "&rightarrow;", { 8594, 0 } },
-    { "&rightarrowtail;", { 8611, 0 } },
-    { "&rightharpoondown;", { 8641, 0 } },
-    { "&rightharpoonup;", { 8640, 0 } },
-    { "&rightleftarrows;", { 8644, 0 } },
-    { "&rightleftharpoons;", { 8652, 0 } },
-    { "&rightrightarrows;", { 8649, 0 } },
-    { "&rightsquigarrow;", { 8605, 0 } },
-    { "&rightthreetimes;", { 8908, 0 } },
-    { "&ring;", { 730, 0 } },
-    { "&risingdotseq;", { 8787, 0 } },
-    { "&rlarr;", { 8644, 0 } },
-    { "&rlhar;", { 8652, 0 } },
-    { "&rlm;", { 8207, 0 } },
-    { "&rmoust;", { 9137, 0 } },
-    { "&rmoustache;", { 9137, 0 } },
-    { "&rnmid;", { 10990, 0 } },
-    { "&roang;", { 10221, 0 } },
-    { "&roarr;", { 8702, 0 } },
-    { "&robrk;", { 10215, 0 } },
-    { "&ropar;", { 10630, 0 } },
-    { "&ropf;", { 120163, 0 } },
-    { "&roplus;", { 10798, 0 } },
-    { "&rotimes;", { 10805, 0 } },
-    { "&rpar;", { 41, 0 } },
-    { "&rpargt;", { 10644, 0 } },
-    { "&rppolint;", { 10770, 0 } },
-    { "&rrarr;", { 8649, 0 } },
-    { "&rsaquo;", { 8250, 0 } },
-    { "&rscr;", { 120007, 0 } },
-    { "&rsh;", { 8625, 0 } },
-    { "&rsqb;", { 93, 0 } },
-    { "&rsquo;", { 8217, 0 } },
-    { "&rsquor;", { 8217, 0 } },
-    { "&rthree;", { 8908, 0 } },
-    { "&rtimes;", { 8906, 0 } },
-    { "&rtri;", { 9657, 0 } },
-    { "&rtrie;", { 8885, 0 } },
-    { "&rtrif;", { 9656, 0 } },
-    { "&rtriltri;", { 10702, 0 } },
-    { "&ruluhar;", { 10600, 0 } },
-    { "&rx;", { 8478, 0 } },
-    { "&sacute;", { 347, 0 } },
-    { "&sbquo;", { 8218, 0 } },
-    { "&sc;", { 8827, 0 } },
-    { "&scE;", { 10932, 0 } },
-    { "&scap;", { 10936, 0 } },
-    { "&scaron;", { 353, 0 } },
-    { "&sccue;", { 8829, 0 } },
-    { "&sce;", { 10928, 0 } },
-    { "&scedil;", { 351, 0 } },
-    { "&scirc;", { 349, 0 } },
-    { "&scnE;", { 10934, 0 } },
-    { "&scnap;", { 10938, 0 } },
-    { "&scnsim;", { 8937, 0 } },
-    { "&scpolint;", { 10771, 0 } },
-    { "&scsim;", { 8831, 0 } },
-    { "&scy;", { 1089, 0 } },
-    { "&sdot;", { 8901, 0 } },
-    { "&sdotb;", { 8865, 0 } },
-    { "&sdote;", { 10854, 0 } },
-    { "&seArr;", { 8664, 0 } },
-    { "&searhk;", { 10533, 0 } },
-    { "&searr;", { 8600, 0 } },
-    { "&searrow;", { 8600, 0 } },
-    { "&sect;", { 167, 0 } },
-    { "&semi;", { 59, 0 } },
-    { "&seswar;", { 10537, 0 } },
-    { "&setminus;", { 8726, 0 } },
-    { "&setmn;", { 8726, 0 } },
-    { "&sext;", { 10038, 0 } },
-    { "&sfr;", { 120112, 0 } },
-    { "&sfrown;", { 8994, 0 } },
-    { "&sharp;", { 9839, 0 } },
-    { "&shchcy;", { 1097, 0 } },
-    { "&shcy;", { 1096, 0 } },
-    { "&shortmid;", { 8739, 0 } },
-    { "&shortparallel;", { 8741, 0 } },
-    { "&shy;", { 173, 0 } },
-    { "&sigma;", { 963, 0 } },
-    { "&sigmaf;", { 962, 0 } },
-    { "&sigmav;", { 962, 0 } },
-    { "&sim;", { 8764, 0 } },
-    { "&simdot;", { 10858, 0 } },
-    { "&sime;", { 8771, 0 } },
-    { "&simeq;", { 8771, 0 } },
-    { "&simg;", { 10910, 0 } },
-    { "&simgE;", { 10912, 0 } },
-    { "&siml;", { 10909, 0 } },
-    { "&simlE;", { 10911, 0 } },
-    { "&simne;", { 8774, 0 } },
-    { "&simplus;", { 10788, 0 } },
-    { "&simrarr;", { 10610, 0 } },
-    { "&slarr;", { 8592, 0 } },
-    { "&smallsetminus;", { 8726, 0 } },
-    { "&smashp;", { 10803, 0 } },
-    { "&smeparsl;", { 10724, 0 } },
-    { "&smid;", { 8739, 0 } },
-    { "&smile;", { 8995, 0 } },
-    { "&smt;", { 10922, 0 } },
-    { "&smte;", { 10924, 0 } },
-    { "&smtes;", { 10924, 65024 } },
-    { "&softcy;", { 1100, 0 } },
-    { "&sol;", { 47, 0 } },
-    { "&solb;", { 10692, 0 } },
-    { "&solbar;", { 9023, 0 } },
-    { "&sopf;", { 120164, 0 } },
-    { "&spades;", { 9824, 0 } },
-    { "&spadesuit;", { 9824, 0 } },
-    { "&spar;", { 8741, 0 } },
-    { "&sqcap;", { 8851, 0 } },
-    { "&sqcaps;", { 8851, 65024 } },
-    { "&sqcup;", { 8852, 0 } },
-    { "&sqcups;", { 8852, 65024 } },
-    { "&sqsub;", { 8847, 0 } },
-    { "&sqsube;", { 8849, 0 } },
-    { "&sqsubset;", { 8847, 0 } },
-    { "&sqsubseteq;", { 8849, 0 } },
-    { "&sqsup;", { 8848, 0 } },
-    { "&sqsupe;", { 8850, 0 } },
-    { "&sqsupset;", { 8848, 0 } },
-    { "&sqsupseteq;", { 8850, 0 } },
-    { "&squ;", { 9633, 0 } },
-    { "&square;", { 9633, 0 } },
-    { "&squarf;", { 9642, 0 } },
-    { "&squf;", { 9642, 0 } },
-    { "&srarr;", { 8594, 0 } },
-    { "&sscr;", { 120008, 0 } },
-    { "&ssetmn;", { 8726, 0 } },
-    { "&ssmile;", { 8995, 0 } },
-    { "&sstarf;", { 8902, 0 } },
-    { "&star;", { 9734, 0 } },
-    { "&starf;", { 9733, 0 } },
-    { "&straightepsilon;", { 1013, 0 } },
-    { "&straightphi;", { 981, 0 } },
-    { "&strns;", { 175, 0 } },
-    { "&sub;", { 8834, 0 } },
-    { "&subE;", { 10949, 0 } },
-    { "&subdot;", { 10941, 0 } },
-    { "&sube;", { 8838, 0 } },
-    { "&subedot;", { 10947, 0 } },
-    { "&submult;", { 10945, 0 } },
-    { "&subnE;", { 10955, 0 } },
-    { "&subne;", { 8842, 0 } },
-    { "&subplus;", { 10943, 0 } },
-    { "&subrarr;", { 10617, 0 } },
-    { "&subset;", { 8834, 0 } },
-    { "&subseteq;", { 8838, 0 } },
-    { "&subseteqq;", { 10949, 0 } },
-    { "&subsetneq;", { 8842, 0 } },
-    { "&subsetneqq;", { 10955, 0 } },
-    { "&subsim;", { 10951, 0 } },
-    { "&subsub;", { 10965, 0 } },
-    { "&subsup;", { 10963, 0 } },
-    { "&succ;", { 8827, 0 } },
-    { "&succapprox;", { 10936, 0 } },
-    { "&succcurlyeq;", { 8829, 0 } },
-    { "&succeq;", { 10928, 0 } },
-    { "&succnapprox;", { 10938, 0 } },
-    { "&succneqq;", { 10934, 0 } },
-    { "&succnsim;", { 8937, 0 } },
-    { "&succsim;", { 8831, 0 } },
-    { "&sum;", { 8721, 0 } },
-    { "&sung;", { 9834, 0 } },
-    { "&sup1", { 185, 0 } },
-    { "&sup1;", { 185, 0 } },
-    { "&sup2", { 178, 0 } },
-    { "&sup2;", { 178, 0 } },
-    { "&sup3", { 179, 0 } },
-    { "&sup3;", { 179, 0 } },
-    { "&sup;", { 8835, 0 } },
-    { "&supE;", { 10950, 0 } },
-    { "&supdot;", { 10942, 0 } },
-    { "&supdsub;", { 10968, 0 } },
-    { "&supe;", { 8839, 0 } },
-    { "&supedot;", { 10948, 0 } },
-    { "&suphsol;", { 10185, 0 } },
-    { "&suphsub;", { 10967, 0 } },
-    { "&suplarr;", { 10619, 0 } },
-    { "&supmult;", { 10946, 0 } },
-    { "&supnE;", { 10956, 0 } },
-    { "&supne;", { 8843, 0 } },
-    { "&supplus;", { 10944, 0 } },
-    { "&supset;", { 8835, 0 } },
-    { "&supseteq;", { 8839, 0 } },
-    { "&supseteqq;", { 10950, 0 } },
-    { "&supsetneq;", { 8843, 0 } },
-    { "&supsetneqq;", { 10956, 0 } },
-    { "&supsim;", { 10952, 0 } },
-    { "&supsub;", { 10964, 0 } },
-    { "&supsup;", { 10966, 0 } },
-    { "&swArr;", { 8665, 0 } },
-    { "&swarhk;", { 10534, 0 } },
-    { "&swarr;", { 8601, 0 } },
-    { "&swarrow;", { 8601, 0 } },
-    { "&swnwar;", { 10538, 0 } },
-    { "&szlig;", { 223, 0 } },
-    { "&target;", { 8982, 0 } },
-    { "&tau;", { 964, 0 } },
-    { "&tbrk;", { 9140, 0 } },
-    { "&tcaron;", { 357, 0 } },
-    { "&tcedil;", { 355, 0 } },
-    { "&tcy;", { 1090, 0 } },
-    { "&tdot;", { 8411, 0 } },
-    { "&telrec;", { 8981, 0 } },
-    { "&tfr;", { 120113, 0 } },
-    { "&there4;", { 8756, 0 } },
-    { "&therefore;", { 8756, 0 } },
-    { "&theta;", { 952, 0 } },
-    { "&thetasym;", { 977, 0 } },
-    { "&thetav;", { 977, 0 } },
-    { "&thickapprox;", { 8776, 0 } },
-    { "&thicksim;", { 8764, 0 } },
-    { "&thinsp;", { 8201, 0 } },
-    { "&thkap;", { 8776, 0 } },
-    { "&thksim;", { 8764, 0 } },
-    { "&thorn;", { 254, 0 } },
-    { "&tilde;", { 732, 0 } },
-    { "&times;", { 215, 0 } },
-    { "&timesb;", { 8864, 0 } },
-    { "&timesbar;", { 10801, 0 } },
-    { "&timesd;", { 10800, 0 } },
-    { "&tint;", { 8749, 0 } },
-    { "&toea;", { 10536, 0 } },
-    { "&top;", { 8868, 0 } },
-    { "&topbot;", { 9014, 0 } },
-    { "&topcir;", { 10993, 0 } },
-    { "&topf;", { 120165, 0 } },
-    { "&topfork;", { 10970, 0 } },
-    { "&tosa;", { 10537, 0 } },
-    { "&tprime;", { 8244, 0 } },
-    { "&trade;", { 8482, 0 } },
-    { "&triangle;", { 9653, 0 } },
-    { "&triangledown;", { 9663, 0 } },
-    { "&triangleleft;", { 9667, 0 } },
-    { "&trianglelefteq;", { 8884, 0 } },
-    { "&triangleq;", { 8796, 0 } },
-    { "&triangleright;", { 9657, 0 } },
-    { "&trianglerighteq;", { 8885, 0 } },
-    { "&tridot;", { 9708, 0 } },
-    { "&trie;", { 8796, 0 } },
-    { "&triminus;", { 10810, 0 } },
-    { "&triplus;", { 10809, 0 } },
-    { "&trisb;", { 10701, 0 } },
-    { "&tritime;", { 10811, 0 } },
-    { "&trpezium;", { 9186, 0 } },
-    { "&tscr;", { 120009, 0 } },
-    { "&tscy;", { 1094, 0 } },
-    { "&tshcy;", { 1115, 0 } },
-    { "&tstrok;", { 359, 0 } },
-    { "&twixt;", { 8812, 0 } },
-    { "&twoheadleftarrow;", { 8606, 0 } },
-    { "&twoheadrightarrow;", { 8608, 0 } },
-    { "&uArr;", { 8657, 0 } },
-    { "&uHar;", { 10595, 0 } },
-    { "&uacute;", { 250, 0 } },
-    { "&uarr;", { 8593, 0 } },
-    { "&ubrcy;", { 1118, 0 } },
-    { "&ubreve;", { 365, 0 } },
-    { "&ucirc;", { 251, 0 } },
-    { "&ucy;", { 1091, 0 } },
-    { "&udarr;", { 8645, 0 } },
-    { "&udblac;", { 369, 0 } },
-    { "&udhar;", { 10606, 0 } },
-    { "&ufisht;", { 10622, 0 } },
-    { "&ufr;", { 120114, 0 } },
-    { "&ugrave;", { 249, 0 } },
-    { "&uharl;", { 8639, 0 } },
-    { "&uharr;", { 8638, 0 } },
-    { "&uhblk;", { 9600, 0 } },
-    { "&ulcorn;", { 8988, 0 } },
-    { "&ulcorner;", { 8988, 0 } },
-    { "&ulcrop;", { 8975, 0 } },
-    { "&ultri;", { 9720, 0 } },
-    { "&umacr;", { 363, 0 } },
-    { "&uml;", { 168, 0 } },
-    { "&uogon;", { 371, 0 } },
-    { "&uopf;", { 120166, 0 } },
-    { "&uparrow;", { 8593, 0 } },
-    { "&updownarrow;", { 8597, 0 } },
-    { "&upharpoonleft;", { 8639, 0 } },
-    { "&upharpoonright;", { 8638, 0 } },
-    { "&uplus;", { 8846, 0 } },
-    { "&upsi;", { 965, 0 } },
-    { "&upsih;", { 978, 0 } },
-    { "&upsilon;", { 965, 0 } },
-    { "&upuparrows;", { 8648, 0 } },
-    { "&urcorn;", { 8989, 0 } },
-    { "&urcorner;", { 8989, 0 } },
-    { "&urcrop;", { 8974, 0 } },
-    { "&uring;", { 367, 0 } },
-    { "&urtri;", { 9721, 0 } },
-    { "&uscr;", { 120010, 0 } },
-    { "&utdot;", { 8944, 0 } },
-    { "&utilde;", { 361, 0 } },
-    { "&utri;", { 9653, 0 } },
-    { "&utrif;", { 9652, 0 } },
-    { "&uuarr;", { 8648, 0 } },
-    { "&uuml;", { 252, 0 } },
-    { "&uwangle;", { 10663, 0 } },
-    { "&vArr;", { 8661, 0 } },
-    { "&vBar;", { 10984, 0 } },
-    { "&vBarv;", { 10985, 0 } },
-    { "&vDash;", { 8872, 0 } },
-    { "&vangrt;", { 10652, 0 } },
-    { "&varepsilon;", { 1013, 0 } },
-    { "&varkappa;", { 1008, 0 } },
-    { "&varnothing;", { 8709, 0 } },
-    { "&varphi;", { 981, 0 } },
-    { "&varpi;", { 982, 0 } },
-    { "&varpropto;", { 8733, 0 } },
-    { "&varr;", { 8597, 0 } },
-    { "&varrho;", { 1009, 0 } },
-    { "&varsigma;", { 962, 0 } },
-    { "&varsubsetneq;", { 8842, 65024 } },
-    { "&varsubsetneqq;", { 10955, 65024 } },
-    { "&varsupsetneq;", { 8843, 65024 } },
-    { "&varsupsetneqq;", { 10956, 65024 } },
-    { "&vartheta;", { 977, 0 } },
-    { "&vartriangleleft;", { 8882, 0 } },
-    { "&vartriangleright;", { 8883, 0 } },
-    { "&vcy;", { 1074, 0 } },
-    { "&vdash;", { 8866, 0 } },
-    { "&vee;", { 8744, 0 } },
-    { "&veebar;", { 8891, 0 } },
-    { "&veeeq;", { 8794, 0 } },
-    { "&vellip;", { 8942, 0 } },
-    { "&verbar;", { 124, 0 } },
-    { "&vert;", { 124, 0 } },
-    { "&vfr;", { 120115, 0 } },
-    { "&vltri;", { 8882, 0 } },
-    { "&vnsub;", { 8834, 8402 } },
-    { "&vnsup;", { 8835, 8402 } },
-    { "&vopf;", { 120167, 0 } },
-    { "&vprop;", { 8733, 0 } },
-    { "&vrtri;", { 8883, 0 } },
-    { "&vscr;", { 120011, 0 } },
-    { "&vsubnE;", { 10955, 65024 } },
-    { "&vsubne;", { 8842, 65024 } },
-    { "&vsupnE;", { 10956, 65024 } },
-    { "&vsupne;", { 8843, 65024 } },
-    { "&vzigzag;", { 10650, 0 } },
-    { "&wcirc;", { 373, 0 } },
-    { "&wedbar;", { 10847, 0 } },
-    { "&wedge;", { 8743, 0 } },
-    { "&wedgeq;", { 8793, 0 } },
-    { "&weierp;", { 8472, 0 } },
-    { "&wfr;", { 120116, 0 } },
-    { "&wopf;", { 120168, 0 } },
-    { "&wp;", { 8472, 0 } },
-    { "&wr;", { 8768, 0 } },
-    { "&wreath;", { 8768, 0 } },
-    { "&wscr;", { 120012, 0 } },
-    { "&xcap;", { 8898, 0 } },
-    { "&xcirc;", { 9711, 0 } },
-    { "&xcup;", { 8899, 0 } },
-    { "&xdtri;", { 9661, 0 } },
-    { "&xfr;", { 120117, 0 } },
-    { "&xhArr;", { 10234, 0 } },
-    { "&xharr;", { 10231, 0 } },
-    { "&xi;", { 958, 0 } },
-    { "&xlArr;", { 10232, 0 } },
-    { "&xlarr;", { 10229, 0 } },
-    { "&xmap;", { 10236, 0 } },
-    { "&xnis;", { 8955, 0 } },
-    { "&xodot;", { 10752, 0 } },
-    { "&xopf;", { 120169, 0 } },
-    { "&xoplus;", { 10753, 0 } },
-    { "&xotime;", { 10754, 0 } },
-    { "&xrArr;", { 10233, 0 } },
-    { "&xrarr;", { 10230, 0 } },
-    { "&xscr;", { 120013, 0 } },
-    { "&xsqcup;", { 10758, 0 } },
-    { "&xuplus;", { 10756, 0 } },
-    { "&xutri;", { 9651, 0 } },
-    { "&xvee;", { 8897, 0 } },
-    { "&xwedge;", { 8896, 0 } },
-    { "&yacute;", { 253, 0 } },
-    { "&yacy;", { 1103, 0 } },
-    { "&ycirc;", { 375, 0 } },
-    { "&ycy;", { 1099, 0 } },
-    { "&yen;", { 165, 0 } },
-    { "&yfr;", { 120118, 0 } },
-    { "&yicy;", { 1111, 0 } },
-    { "&yopf;", { 120170, 0 } },
-    { "&yscr;", { 120014, 0 } },
-    { "&yucy;", { 1102, 0 } },
-    { "&yuml;", { 255, 0 } },
-    { "&zacute;", { 378, 0 } },
-    { "&zcaron;", { 382, 0 } },
-    { "&zcy;", { 1079, 0 } },
-    { "&zdot;", { 380, 0 } },
-    { "&zeetrf;", { 8488, 0 } },
-    { "&zeta;", { 950, 0 } },
-    { "&zfr;", { 120119, 0 } },
-    { "&zhcy;", { 1078, 0 } },
-    { "&zigrarr;", { 8669, 0 } },
-    { "&zopf;", { 120171, 0 } },
-    { "&zscr;", { 120015, 0 } },
-    { "&zwj;", { 8205, 0 } },
-    { "&zwnj;", { 8204, 0 } }
+/* The table is generated by scripts/build_entity_map.py from
+ * https://html.spec.whatwg.org/entities.json. It is ordered by the perfect
+ * hash implemented in entity_lookup(), so a lookup needs to compute the hash
+ * and compare a single entry. */
+#define ENTITY_MAP_SIZE 2125
+#define ENTITY_MAP_SEED_COUNT 532
+static const unsigned short ENTITY_MAP_SEED[] = {
+    18, 7, 108, 3, 1, 116, 8, 37, 59, 15, 63, 60, 6, 5, 0, 1, 8, 8, 0, 23, 2, 3, 25, 421, 0, 9, 28, 11, 0, 16,
+    35, 182, 54, 16, 7, 15, 0, 111, 22, 14, 5, 3, 54, 108, 98, 13, 87, 0, 1, 91, 15, 1, 37, 314, 35, 116, 2,
+    468, 1, 0, 33, 0, 6, 30, 4, 0, 70, 21, 8, 13, 94, 12, 64, 172, 5, 77, 23, 38, 118, 3, 0, 17, 56, 13, 125,
+    5, 169, 2, 12, 11, 4, 0, 296, 58, 8, 152, 74, 285, 18, 188, 43, 45, 32, 169, 3, 64, 384, 216, 12, 1, 60,
+    143, 9, 0, 6, 1, 0, 4, 28, 134, 9, 203, 0, 4, 3, 33, 12, 125, 0, 34, 9, 89, 7, 32, 28, 203, 211, 8, 1, 49,
+    18, 17, 6, 153, 19, 43, 12, 33, 3, 7, 23, 3, 0, 11, 39, 57, 98, 7, 36, 1, 151, 1, 66, 1, 31, 139, 3, 3,
+    53, 0, 2, 34, 1286, 17, 39, 24, 134, 109, 37, 23, 1, 23, 35, 110, 27, 0, 0, 18, 123, 124, 57, 40, 4, 39,
+    0, 1, 130, 68, 19, 532, 0, 23, 0, 14, 0, 0, 69, 319, 0, 52, 96, 4, 77, 1, 2, 45, 88, 4, 364, 3, 3, 6, 2,
+    22, 429, 225, 58, 59, 43, 178, 15, 38, 49, 59, 9, 467, 60, 1, 3, 17, 41, 299, 35, 1654, 311, 1, 33, 128,
+    73, 34, 55, 3, 177, 0, 141, 33, 28, 4, 42, 10, 196, 4, 45, 14, 32, 446, 54, 12, 175, 17, 134, 231, 34, 0,
+    79, 15, 51, 273, 134, 110, 1, 2, 13, 5, 17, 136, 18, 70, 15, 8, 183, 18, 29, 1169, 5, 309, 1, 1, 1, 35,
+    155, 7, 80, 43, 115, 5, 381, 268, 46, 166, 33, 50, 6, 817, 34, 23, 44, 148, 28, 11, 16, 1136, 4, 1, 1, 21,
+    500, 217, 0, 22, 3, 267, 44, 182, 48, 476, 1, 239, 5, 7, 102, 5, 7, 309, 14, 48, 1, 196, 301, 10, 1495,
+    26, 199, 19, 22, 101, 63, 157, 48, 44, 0, 1, 141, 0, 93, 288, 667, 3, 0, 0, 158, 300, 28, 31, 8, 115, 52,
+    99, 196, 141, 1296, 0, 87, 199, 35, 7, 94, 3, 12, 114, 29, 166, 99, 139, 485, 9, 196, 156, 655, 36, 0,
+    771, 182, 577, 7, 11, 145, 0, 95, 252, 16, 78, 65, 19, 962, 1, 2337, 11, 22, 0, 734, 225, 273, 266, 328,
+    3, 213, 4, 205, 1143, 15, 198, 15, 179, 0, 41, 85, 25, 129, 200, 6, 551, 5, 859, 282, 1095, 49, 5, 565,
+    14, 2, 0, 184, 89, 228, 176, 0, 1322, 781, 34, 78, 245, 16, 3, 60, 78, 231, 48, 4, 3, 287, 2962, 18, 542,
+    28, 2, 367, 265, 583, 2, 491, 35, 317, 447, 43, 2737, 148, 0, 650, 0, 107, 72, 51, 658, 949, 50, 11, 1537,
+    18, 1170, 3, 3522, 9, 55, 586, 472, 1711, 3, 0, 37, 0, 1044, 1, 3, 1345, 0, 99, 630, 21, 294, 6123, 875,
+    298, 257, 12, 4900, 3655, 5683, 8, 939, 10, 940
 };
-
-
-struct entity_key {
-    const char* name;
-    size_t name_size;
+static const struct entity ENTITY_MAP[] = {
+    { "&prime;", 7, { 8242, 0 } },
+    { "&subseteq;", 10, { 8838, 0 } },
+    { "&LowerLeftArrow;", 16, { 8601, 0 } },
+    { "&boxur;", 7, { 9492, 0 } },
+    { "&DownLeftRightVector;", 21, { 10576, 0 } },
+    { "&Star;", 6, { 8902, 0 } },
+    { "&Yscr;", 6, { 119988, 0 } },
+    { "&ffr;", 5, { 120099, 0 } },
+    { "&gneqq;", 7, { 8809, 0 } },
+    { "&Pscr;", 6, { 119979, 0 } },
+    { "&precnsim;", 10, { 8936, 0 } },
+    { "&gamma;", 7, { 947, 0 } },
+    { "&Wopf;", 6, { 120142, 0 } },
+    { "&wscr;", 6, { 120012, 0 } },
+    { "&boxdl;", 7, { 9488, 0 } },
+    { "&empty;", 7, { 8709, 0 } },
+    { "&LessSlantEqual;", 16, { 10877, 0 } },
+    { "&not;", 5, { 172, 0 } },
+    { "&Gg;", 4, { 8921, 0 } },
+    { "&GreaterTilde;", 14, { 8819, 0 } },
+    { "&otilde;", 8, { 245, 0 } },
+    { "&bepsi;", 7, { 1014, 0 } },
+    { "&RightTeeVector;", 16, { 10587, 0 } },
+    { "&lesseqgtr;", 11, { 8922, 0 } },
+    { "&suphsub;", 9, { 10967, 0 } },
+    { "&Uuml;", 6, { 220, 0 } },
+    { "&downarrow;", 11, { 8595, 0 } },
+    { "&nsupset;", 9, { 8835, 8402 } },
+    { "&simrarr;", 9, { 10610, 0 } },
+    { "&rightarrowtail;", 16, { 8611, 0 } },
+    { "&OElig;", 7, { 338, 0 } },
+    { "&varsigma;", 10, { 962, 0 } },
+    { "&asymp;", 7, { 8776, 0 } },
+    { "&Vdash;", 7, { 8873, 0 } },
+    { "&lnapprox;", 10, { 10889, 0 } },
+    { "&topcir;", 8, { 10993, 0 } },
+    { "&sup;", 5, { 8835, 0 } },
+    { "&SupersetEqual;", 15, { 8839, 0 } },
+    { "&bsime;", 7, { 8909, 0 } },
+    { "&DZcy;", 6, { 1039, 0 } },
+    { "&nearrow;", 9, { 8599, 0 } },
+    { "&subne;", 7, { 8842, 0 } },
+    { "&ffilig;", 8, { 64259, 0 } },
+    { "&times;", 7, { 215, 0 } },
+    { "&brvbar;", 8, { 166, 0 } },
+    { "&Sc;", 4, { 10940, 0 } },
+    { "&sube;", 6, { 8838, 0 } },
+    { "&andv;", 6, { 10842, 0 } },
+    { "&boxhd;", 7, { 9516, 0 } },
+    { "&ensp;", 6, { 8194, 0 } },
+    { "&rightrightarrows;", 18, { 8649, 0 } },
+    { "&nltrie;", 8, { 8940, 0 } },
+    { "&NotGreaterFullEqual;", 21, { 8807, 824 } },
+    { "&roplus;", 8, { 10798, 0 } },
+    { "&quaternions;", 13, { 8461, 0 } },
+    { "&xcup;", 6, { 8899, 0 } },
+    { "&Racute;", 8, { 340, 0 } },
+    { "&yuml;", 6, { 255, 0 } },
+    { "&rsquor;", 8, { 8217, 0 } },
+    { "&Nu;", 4, { 925, 0 } },
+    { "&bumpe;", 7, { 8783, 0 } },
+    { "&NestedLessLess;", 16, { 8810, 0 } },
+    { "&theta;", 7, { 952, 0 } },
+    { "&jcirc;", 7, { 309, 0 } },
+    { "&utri;", 6, { 9653, 0 } },
+    { "&OpenCurlyQuote;", 16, { 8216, 0 } },
+    { "&NotPrecedes;", 13, { 8832, 0 } },
+    { "&leftleftarrows;", 16, { 8647, 0 } },
+    { "&prod;", 6, { 8719, 0 } },
+    { "&straightepsilon;", 17, { 1013, 0 } },
+    { "&dharr;", 7, { 8642, 0 } },
+    { "&Eta;", 5, { 919, 0 } },
+    { "&notnivb;", 9, { 8958, 0 } },
+    { "&shy;", 5, { 173, 0 } },
+    { "&breve;", 7, { 728, 0 } },
+    { "&nsupseteq;", 11, { 8841, 0 } },
+    { "&DoubleContourIntegral;", 23, { 8751, 0 } },
+    { "&acE;", 5, { 8766, 819 } },
+    { "&sdotb;", 7, { 8865, 0 } },
+    { "&lhblk;", 7, { 9604, 0 } },
+    { "&fcy;", 5, { 1092, 0 } },
+    { "&duarr;", 7, { 8693, 0 } },
+    { "&frac16;", 8, { 8537, 0 } },
+    { "&lfisht;", 8, { 10620, 0 } },
+    { "&boxVL;", 7, { 9571, 0 } },
+    { "&forkv;", 7, { 10969, 0 } },
+    { "&raquo;", 7, { 187, 0 } },
+    { "&odash;", 7, { 8861, 0 } },
+    { "&nsupE;", 7, { 10950, 824 } },
+    { "&erarr;", 7, { 10609, 0 } },
+    { "&scirc;", 7, { 349, 0 } },
+    { "&setminus;", 10, { 8726, 0 } },
+    { "&DDotrahd;", 10, { 10513, 0 } },
+    { "&lhard;", 7, { 8637, 0 } },
+    { "&lsaquo;", 8, { 8249, 0 } },
+    { "&bsolb;", 7, { 10693, 0 } },
+    { "&smid;", 6, { 8739, 0 } },
+    { "&diam;", 6, { 8900, 0 } },
+    { "&Rrightarrow;", 13, { 8667, 0 } },
+    { "&colon;", 7, { 58, 0 } },
+    { "&ngtr;", 6, { 8815, 0 } },
+    { "&PrecedesSlantEqual;", 20, { 8828, 0 } },
+    { "&yucy;", 6, { 1102, 0 } },
+    { "&race;", 6, { 8765, 817 } },
+    { "&dagger;", 8, { 8224, 0 } },
+    { "&dzcy;", 6, { 1119, 0 } },
+    { "&lfloor;", 8, { 8970, 0 } },
+    { "&larrfs;", 8, { 10525, 0 } },
+    { "&rightharpoonup;", 16, { 8640, 0 } },
+    { "&bigcup;", 8, { 8899, 0 } },
+    { "&harr;", 6, { 8596, 0 } },
+    { "&gesdotol;", 10, { 10884, 0 } },
+    { "&minus;", 7, { 8722, 0 } },
+    { "&half;", 6, { 189, 0 } },
+    { "&twixt;", 7, { 8812, 0 } },
+    { "&capdot;", 8, { 10816, 0 } },
+    { "&DoubleDownArrow;", 17, { 8659, 0 } },
+    { "&vartheta;", 10, { 977, 0 } },
+    { "&mid;", 5, { 8739, 0 } },
+    { "&angmsdah;", 10, { 10671, 0 } },
+    { "&setmn;", 7, { 8726, 0 } },
+    { "&coprod;", 8, { 8720, 0 } },
+    { "&oopf;", 6, { 120160, 0 } },
+    { "&orv;", 5, { 10843, 0 } },
+    { "&spadesuit;", 11, { 9824, 0 } },
+    { "&leftrightarrows;", 17, { 8646, 0 } },
+    { "&bigodot;", 9, { 10752, 0 } },
+    { "&bscr;", 6, { 119991, 0 } },
+    { "&ccaps;", 7, { 10829, 0 } },
+    { "&sub;", 5, { 8834, 0 } },
+    { "&UnionPlus;", 11, { 8846, 0 } },
+    { "&nprcue;", 8, { 8928, 0 } },
+    { "&DoubleLongRightArrow;", 22, { 10233, 0 } },
+    { "&pound;", 7, { 163, 0 } },
+    { "&agrave;", 8, { 224, 0 } },
+    { "&nvsim;", 7, { 8764, 8402 } },
+    { "&epsiv;", 7, { 1013, 0 } },
+    { "&amalg;", 7, { 10815, 0 } },
+    { "&Map;", 5, { 10501, 0 } },
+    { "&Vvdash;", 8, { 8874, 0 } },
+    { "&xrarr;", 7, { 10230, 0 } },
+    { "&nap;", 5, { 8777, 0 } },
+    { "&ldquor;", 8, { 8222, 0 } },
+    { "&NotHumpEqual;", 14, { 8783, 824 } },
+    { "&vsupnE;", 8, { 10956, 65024 } },
+    { "&nsub;", 6, { 8836, 0 } },
+    { "&bNot;", 6, { 10989, 0 } },
+    { "&quot;", 6, { 34, 0 } },
+    { "&rthree;", 8, { 8908, 0 } },
+    { "&uopf;", 6, { 120166, 0 } },
+    { "&circledR;", 10, { 174, 0 } },
+    { "&curlyvee;", 10, { 8910, 0 } },
+    { "&NotSupersetEqual;", 18, { 8841, 0 } },
+    { "&Ufr;", 5, { 120088, 0 } },
+    { "&Uarr;", 6, { 8607, 0 } },
+    { "&lthree;", 8, { 8907, 0 } },
+    { "&nprec;", 7, { 8832, 0 } },
+    { "&Alpha;", 7, { 913, 0 } },
+    { "&upharpoonleft;", 15, { 8639, 0 } },
+    { "&vartriangleright;", 18, { 8883, 0 } },
+    { "&wreath;", 8, { 8768, 0 } },
+    { "&backepsilon;", 13, { 1014, 0 } },
+    { "&Dstrok;", 8, { 272, 0 } },
+    { "&lbrkslu;", 9, { 10637, 0 } },
+    { "&OverBar;", 9, { 8254, 0 } },
+    { "&NotSquareSubset;", 17, { 8847, 824 } },
+    { "&RightVectorBar;", 16, { 10579, 0 } },
+    { "&SquareSuperset;", 16, { 8848, 0 } },
+    { "&loarr;", 7, { 8701, 0 } },
+    { "&tbrk;", 6, { 9140, 0 } },
+    { "&nparsl;", 8, { 11005, 8421 } },
+    { "&frac15;", 8, { 8533, 0 } },
+    { "&boxUR;", 7, { 9562, 0 } },
+    { "&seArr;", 7, { 8664, 0 } },
+    { "&Rang;", 6, { 10219, 0 } },
+    { "&frac13;", 8, { 8531, 0 } },
+    { "&searhk;", 8, { 10533, 0 } },
+    { "&tcedil;", 8, { 355, 0 } },
+    { "&luruhar;", 9, { 10598, 0 } },
+    { "&NotSucceeds;", 13, { 8833, 0 } },
+    { "&sol;", 5, { 47, 0 } },
+    { "&circleddash;", 13, { 8861, 0 } },
+    { "&uArr;", 6, { 8657, 0 } },
+    { "&ulcrop;", 8, { 8975, 0 } },
+    { "&HilbertSpace;", 14, { 8459, 0 } },
+    { "&Iukcy;", 7, { 1030, 0 } },
+    { "&LongLeftRightArrow;", 20, { 10231, 0 } },
+    { "&Ycy;", 5, { 1067, 0 } },
+    { "&glE;", 5, { 10898, 0 } },
+    { "&DiacriticalAcute;", 18, { 180, 0 } },
+    { "&bprime;", 8, { 8245, 0 } },
+    { "&ApplyFunction;", 15, { 8289, 0 } },
+    { "&precapprox;", 12, { 10935, 0 } },
+    { "&varrho;", 8, { 1009, 0 } },
+    { "&diamond;", 9, { 8900, 0 } },
+    { "&midast;", 8, { 42, 0 } },
+    { "&oint;", 6, { 8750, 0 } },
+    { "&notinvc;", 9, { 8950, 0 } },
+    { "&nlt;", 5, { 8814, 0 } },
+    { "&scnsim;", 8, { 8937, 0 } },
+    { "&RightTriangleBar;", 18, { 10704, 0 } },
+    { "&Vee;", 5, { 8897, 0 } },
+    { "&looparrowleft;", 15, { 8619, 0 } },
+    { "&cent;", 6, { 162, 0 } },
+    { "&trianglerighteq;", 17, { 8885, 0 } },
+    { "&els;", 5, { 10901, 0 } },
+    { "&Oacute;", 8, { 211, 0 } },
+    { "&excl;", 6, { 33, 0 } },
+    { "&supseteqq;", 11, { 10950, 0 } },
+    { "&NotHumpDownHump;", 17, { 8782, 824 } },
+    { "&lat;", 5, { 10923, 0 } },
+    { "&supE;", 6, { 10950, 0 } },
+    { "&curarr;", 8, { 8631, 0 } },
+    { "&blacktriangle;", 15, { 9652, 0 } },
+    { "&circeq;", 8, { 8791, 0 } },
+    { "&Ubreve;", 8, { 364, 0 } },
+    { "&lacute;", 8, { 314, 0 } },
+    { "&boxdL;", 7, { 9557, 0 } },
+    { "&UpArrowDownArrow;", 18, { 8645, 0 } },
+    { "&ecir;", 6, { 8790, 0 } },
+    { "&laemptyv;", 10, { 10676, 0 } },
+    { "&Uacute;", 8, { 218, 0 } },
+    { "&NoBreak;", 9, { 8288, 0 } },
+    { "&loang;", 7, { 10220, 0 } },
+    { "&racute;", 8, { 341, 0 } },
+    { "&CapitalDifferentialD;", 22, { 8517, 0 } },
+    { "&period;", 8, { 46, 0 } },
+    { "&bigsqcup;", 10, { 10758, 0 } },
+    { "&nrArr;", 7, { 8655, 0 } },
+    { "&gE;", 4, { 8807, 0 } },
+    { "&bnot;", 6, { 8976, 0 } },
+    { "&RightUpDownVector;", 19, { 10575, 0 } },
+    { "&cedil;", 7, { 184, 0 } },
+    { "&nVDash;", 8, { 8879, 0 } },
+    { "&xvee;", 6, { 8897, 0 } },
+    { "&prop;", 6, { 8733, 0 } },
+    { "&zopf;", 6, { 120171, 0 } },
+    { "&subedot;", 9, { 10947, 0 } },
+    { "&rx;", 4, { 8478, 0 } },
+    { "&qopf;", 6, { 120162, 0 } },
+    { "&boxHd;", 7, { 9572, 0 } },
+    { "&NotNestedLessLess;", 19, { 10913, 824 } },
+    { "&Bernoullis;", 12, { 8492, 0 } },
+    { "&leftrightharpoons;", 19, { 8651, 0 } },
+    { "&opar;", 6, { 10679, 0 } },
+    { "&lmoust;", 8, { 9136, 0 } },
+    { "&straightphi;", 13, { 981, 0 } },
+    { "&mopf;", 6, { 120158, 0 } },
+    { "&Cup;", 5, { 8915, 0 } },
+    { "&Equilibrium;", 13, { 8652, 0 } },
+    { "&NotExists;", 11, { 8708, 0 } },
+    { "&ntriangleleft;", 15, { 8938, 0 } },
+    { "&CircleMinus;", 13, { 8854, 0 } },
+    { "&boxminus;", 10, { 8863, 0 } },
+    { "&Succeeds;", 10, { 8827, 0 } },
+    { "&tilde;", 7, { 732, 0 } },
+    { "&nsmid;", 7, { 8740, 0 } },
+    { "&solbar;", 8, { 9023, 0 } },
+    { "&GT;", 4, { 62, 0 } },
+    { "&GreaterLess;", 13, { 8823, 0 } },
+    { "&comma;", 7, { 44, 0 } },
+    { "&nabla;", 7, { 8711, 0 } },
+    { "&ngeqq;", 7, { 8807, 824 } },
+    { "&NewLine;", 9, { 10, 0 } },
+    { "&easter;", 8, { 10862, 0 } },
+    { "&sqsupe;", 8, { 8850, 0 } },
+    { "&npre;", 6, { 10927, 824 } },
+    { "&AMP;", 5, { 38, 0 } },
+    { "&bemptyv;", 9, { 10672, 0 } },
+    { "&softcy;", 8, { 1100, 0 } },
+    { "&angmsdaa;", 10, { 10664, 0 } },
+    { "&cdot;", 6, { 267, 0 } },
+    { "&rpar;", 6, { 41, 0 } },
+    { "&ee;", 4, { 8519, 0 } },
+    { "&Kappa;", 7, { 922, 0 } },
+    { "&Oslash;", 8, { 216, 0 } },
+    { "&Cap;", 5, { 8914, 0 } },
+    { "&nrightarrow;", 13, { 8603, 0 } },
+    { "&nsubseteq;", 11, { 8840, 0 } },
+    { "&Tfr;", 5, { 120087, 0 } },
+    { "&square;", 8, { 9633, 0 } },
+    { "&dcaron;", 8, { 271, 0 } },
+    { "&DoubleLongLeftArrow;", 21, { 10232, 0 } },
+    { "&asympeq;", 9, { 8781, 0 } },
+    { "&Gt;", 4, { 8811, 0 } },
+    { "&UpDownArrow;", 13, { 8597, 0 } },
+    { "&topbot;", 8, { 9014, 0 } },
+    { "&Vdashl;", 8, { 10982, 0 } },
+    { "&DotDot;", 8, { 8412, 0 } },
+    { "&ang;", 5, { 8736, 0 } },
+    { "&leftrightarrow;", 16, { 8596, 0 } },
+    { "&DownArrowUpArrow;", 18, { 8693, 0 } },
+    { "&Dagger;", 8, { 8225, 0 } },
+    { "&lvnE;", 6, { 8808, 65024 } },
+    { "&Nacute;", 8, { 323, 0 } },
+    { "&harrw;", 7, { 8621, 0 } },
+    { "&gesl;", 6, { 8923, 65024 } },
+    { "&angrtvb;", 9, { 8894, 0 } },
+    { "&ENG;", 5, { 330, 0 } },
+    { "&swArr;", 7, { 8665, 0 } },
+    { "&lrhar;", 7, { 8651, 0 } },
+    { "&iinfin;", 8, { 10716, 0 } },
+    { "&ssetmn;", 8, { 8726, 0 } },
+    { "&nsubE;", 7, { 10949, 824 } },
+    { "&awint;", 7, { 10769, 0 } },
+    { "&rdquor;", 8, { 8221, 0 } },
+    { "&eplus;", 7, { 10865, 0 } },
+    { "&in;", 4, { 8712, 0 } },
+    { "&boxVl;", 7, { 9570, 0 } },
+    { "&varsupsetneqq;", 15, { 10956, 65024 } },
+    { "&UnderBracket;", 14, { 9141, 0 } },
+    { "&subsetneqq;", 12, { 10955, 0 } },
+    { "&UpperRightArrow;", 17, { 8599, 0 } },
+    { "&lharul;", 8, { 10602, 0 } },
+    { "&ntilde;", 8, { 241, 0 } },
+    { "&Nfr;", 5, { 120081, 0 } },
+    { "&Ccedil;", 8, { 199, 0 } },
+    { "&rscr;", 6, { 120007, 0 } },
+    { "&upuparrows;", 12, { 8648, 0 } },
+    { "&sup2;", 6, { 178, 0 } },
+    { "&ifr;", 5, { 120102, 0 } },
+    { "&sqcup;", 7, { 8852, 0 } },
+    { "&dblac;", 7, { 733, 0 } },
+    { "&NotDoubleVerticalBar;", 22, { 8742, 0 } },
+    { "&Product;", 9, { 8719, 0 } },
+    { "&nldr;", 6, { 8229, 0 } },
+    { "&rangle;", 8, { 10217, 0 } },
+    { "&Iscr;", 6, { 8464, 0 } },
+    { "&part;", 6, { 8706, 0 } },
+    { "&rarrtl;", 8, { 8611, 0 } },
+    { "&Dfr;", 5, { 120071, 0 } },
+    { "&Cedilla;", 9, { 184, 0 } },
+    { "&frac25;", 8, { 8534, 0 } },
+    { "&Qfr;", 5, { 120084, 0 } },
+    { "&lAtail;", 8, { 10523, 0 } },
+    { "&angst;", 7, { 197, 0 } },
+    { "&Ascr;", 6, { 119964, 0 } },
+    { "&rharu;", 7, { 8640, 0 } },
+    { "&ImaginaryI;", 12, { 8520, 0 } },
+    { "&profalar;", 10, { 9006, 0 } },
+    { "&lesges;", 8, { 10899, 0 } },
+    { "&boxhD;", 7, { 9573, 0 } },
+    { "&prcue;", 7, { 8828, 0 } },
+    { "&NotLess;", 9, { 8814, 0 } },
+    { "&smeparsl;", 10, { 10724, 0 } },
+    { "&yopf;", 6, { 120170, 0 } },
+    { "&tshcy;", 7, { 1115, 0 } },
+    { "&LeftVectorBar;", 15, { 10578, 0 } },
+    { "&ldca;", 6, { 10550, 0 } },
+    { "&nbump;", 7, { 8782, 824 } },
+    { "&crarr;", 7, { 8629, 0 } },
+    { "&rpargt;", 8, { 10644, 0 } },
+    { "&Gammad;", 8, { 988, 0 } },
+    { "&mumap;", 7, { 8888, 0 } },
+    { "&DownRightTeeVector;", 20, { 10591, 0 } },
+    { "&ecy;", 5, { 1101, 0 } },
+    { "&perp;", 6, { 8869, 0 } },
+    { "&fallingdotseq;", 15, { 8786, 0 } },
+    { "&Idot;", 6, { 304, 0 } },
+    { "&les;", 5, { 10877, 0 } },
+    { "&copy;", 6, { 169, 0 } },
+    { "&utrif;", 7, { 9652, 0 } },
+    { "&Igrave;", 8, { 204, 0 } },
+    { "&urcorner;", 10, { 8989, 0 } },
+    { "&vartriangleleft;", 17, { 8882, 0 } },
+    { "&rarrfs;", 8, { 10526, 0 } },
+    { "&rcy;", 5, { 1088, 0 } },
+    { "&conint;", 8, { 8750, 0 } },
+    { "&pfr;", 5, { 120109, 0 } },
+    { "&lneqq;", 7, { 8808, 0 } },
+    { "&Lsh;", 5, { 8624, 0 } },
+    { "&xhArr;", 7, { 10234, 0 } },
+    { "&gtcir;", 7, { 10874, 0 } },
+    { "&Gscr;", 6, { 119970, 0 } },
+    { "&NotTildeTilde;", 15, { 8777, 0 } },
+    { "&divideontimes;", 15, { 8903, 0 } },
+    { "&frac45;", 8, { 8536, 0 } },
+    { "&centerdot;", 11, { 183, 0 } },
+    { "&GreaterGreater;", 16, { 10914, 0 } },
+    { "&Odblac;", 8, { 336, 0 } },
+    { "&boxDL;", 7, { 9559, 0 } },
+    { "&nwArr;", 7, { 8662, 0 } },
+    { "&equiv;", 7, { 8801, 0 } },
+    { "&DiacriticalGrave;", 18, { 96, 0 } },
+    { "&notinE;", 8, { 8953, 824 } },
+    { "&mlcp;", 6, { 10971, 0 } },
+    { "&RightArrowBar;", 15, { 8677, 0 } },
+    { "&Scedil;", 8, { 350, 0 } },
+    { "&mho;", 5, { 8487, 0 } },
+    { "&there4;", 8, { 8756, 0 } },
+    { "&rAtail;", 8, { 10524, 0 } },
+    { "&intercal;", 10, { 8890, 0 } },
+    { "&sqcap;", 7, { 8851, 0 } },
+    { "&curren;", 8, { 164, 0 } },
+    { "&Int;", 5, { 8748, 0 } },
+    { "&Pi;", 4, { 928, 0 } },
+    { "&gbreve;", 8, { 287, 0 } },
+    { "&Intersection;", 14, { 8898, 0 } },
+    { "&cupor;", 7, { 10821, 0 } },
+    { "&xcap;", 6, { 8898, 0 } },
+    { "&thicksim;", 10, { 8764, 0 } },
+    { "&vee;", 5, { 8744, 0 } },
+    { "&cuvee;", 7, { 8910, 0 } },
+    { "&zeta;", 6, { 950, 0 } },
+    { "&simg;", 6, { 10910, 0 } },
+    { "&angzarr;", 9, { 9084, 0 } },
+    { "&hkswarow;", 10, { 10534, 0 } },
+    { "&HumpEqual;", 11, { 8783, 0 } },
+    { "&hbar;", 6, { 8463, 0 } },
+    { "&spar;", 6, { 8741, 0 } },
+    { "&boxdR;", 7, { 9554, 0 } },
+    { "&Zcy;", 5, { 1047, 0 } },
+    { "&precneqq;", 10, { 10933, 0 } },
+    { "&andand;", 8, { 10837, 0 } },
+    { "&angle;", 7, { 8736, 0 } },
+    { "&circledS;", 10, { 9416, 0 } },
+    { "&preceq;", 8, { 10927, 0 } },
+    { "&lobrk;", 7, { 10214, 0 } },
+    { "&DiacriticalDoubleAcute;", 24, { 733, 0 } },
+    { "&lpar;", 6, { 40, 0 } },
+    { "&Precedes;", 10, { 8826, 0 } },
+    { "&Lleftarrow;", 12, { 8666, 0 } },
+    { "&Bopf;", 6, { 120121, 0 } },
+    { "&ThinSpace;", 11, { 8201, 0 } },
+    { "&backsim;", 9, { 8765, 0 } },
+    { "&gfr;", 5, { 120100, 0 } },
+    { "&die;", 5, { 168, 0 } },
+    { "&Longrightarrow;", 16, { 10233, 0 } },
+    { "&nless;", 7, { 8814, 0 } },
+    { "&HARDcy;", 8, { 1066, 0 } },
+    { "&supsetneq;", 11, { 8843, 0 } },
+    { "&bigotimes;", 11, { 10754, 0 } },
+    { "&lozf;", 6, { 10731, 0 } },
+    { "&Aogon;", 7, { 260, 0 } },
+    { "&emsp;", 6, { 8195, 0 } },
+    { "&bdquo;", 7, { 8222, 0 } },
+    { "&bigwedge;", 10, { 8896, 0 } },
+    { "&cacute;", 8, { 263, 0 } },
+    { "&capand;", 8, { 10820, 0 } },
+    { "&xuplus;", 8, { 10756, 0 } },
+    { "&lne;", 5, { 10887, 0 } },
+    { "&zeetrf;", 8, { 8488, 0 } },
+    { "&ltimes;", 8, { 8905, 0 } },
+    { "&efDot;", 7, { 8786, 0 } },
+    { "&euml;", 6, { 235, 0 } },
+    { "&parallel;", 10, { 8741, 0 } },
+    { "&DownArrow;", 11, { 8595, 0 } },
+    { "&SHCHcy;", 8, { 1065, 0 } },
+    { "&RoundImplies;", 14, { 10608, 0 } },
+    { "&imagpart;", 10, { 8465, 0 } },
+    { "&biguplus;", 10, { 10756, 0 } },
+    { "&Assign;", 8, { 8788, 0 } },
+    { "&Qopf;", 6, { 8474, 0 } },
+    { "&LeftTriangleEqual;", 19, { 8884, 0 } },
+    { "&thinsp;", 8, { 8201, 0 } },
+    { "&oror;", 6, { 10838, 0 } },
+    { "&RightDownVector;", 17, { 8642, 0 } },
+    { "&fllig;", 7, { 64258, 0 } },
+    { "&Nopf;", 6, { 8469, 0 } },
+    { "&Euml;", 6, { 203, 0 } },
+    { "&jcy;", 5, { 1081, 0 } },
+    { "&bcy;", 5, { 1073, 0 } },
+    { "&lowast;", 8, { 8727, 0 } },
+    { "&supplus;", 9, { 10944, 0 } },
+    { "&veebar;", 8, { 8891, 0 } },
+    { "&mscr;", 6, { 120002, 0 } },
+    { "&Copf;", 6, { 8450, 0 } },
+    { "&rfisht;", 8, { 10621, 0 } },
+    { "&Sopf;", 6, { 120138, 0 } },
+    { "&awconint;", 10, { 8755, 0 } },
+    { "&sfr;", 5, { 120112, 0 } },
+    { "&mcomma;", 8, { 10793, 0 } },
+    { "&checkmark;", 11, { 10003, 0 } },
+    { "&lharu;", 7, { 8636, 0 } },
+    { "&equals;", 8, { 61, 0 } },
+    { "&para;", 6, { 182, 0 } },
+    { "&lAarr;", 7, { 8666, 0 } },
+    { "&ograve;", 8, { 242, 0 } },
+    { "&ccups;", 7, { 10828, 0 } },
+    { "&tfr;", 5, { 120113, 0 } },
+    { "&SquareUnion;", 13, { 8852, 0 } },
+    { "&ccirc;", 7, { 265, 0 } },
+    { "&caret;", 7, { 8257, 0 } },
+    { "&iquest;", 8, { 191, 0 } },
+    { "&risingdotseq;", 14, { 8787, 0 } },
+    { "&succeq;", 8, { 10928, 0 } },
+    { "&dfisht;", 8, { 10623, 0 } },
+    { "&lnap;", 6, { 10889, 0 } },
+    { "&UnderBar;", 10, { 95, 0 } },
+    { "&DownRightVectorBar;", 20, { 10583, 0 } },
+    { "&cap;", 5, { 8745, 0 } },
+    { "&barwedge;", 10, { 8965, 0 } },
+    { "&YIcy;", 6, { 1031, 0 } },
+    { "&hellip;", 8, { 8230, 0 } },
+    { "&female;", 8, { 9792, 0 } },
+    { "&ntriangleright;", 16, { 8939, 0 } },
+    { "&Sup;", 5, { 8913, 0 } },
+    { "&rtri;", 6, { 9657, 0 } },
+    { "&sigmav;", 8, { 962, 0 } },
+    { "&dollar;", 8, { 36, 0 } },
+    { "&Rho;", 5, { 929, 0 } },
+    { "&Mcy;", 5, { 1052, 0 } },
+    { "&angmsdac;", 10, { 10666, 0 } },
+    { "&tridot;", 8, { 9708, 0 } },
+    { "&supmult;", 9, { 10946, 0 } },
+    { "&GreaterEqualLess;", 18, { 8923, 0 } },
+    { "&leftharpoonup;", 15, { 8636, 0 } },
+    { "&hopf;", 6, { 120153, 0 } },
+    { "&Rsh;", 5, { 8625, 0 } },
+    { "&Supset;", 8, { 8913, 0 } },
+    { "&ljcy;", 6, { 1113, 0 } },
+    { "&hoarr;", 7, { 8703, 0 } },
+    { "&eg;", 4, { 10906, 0 } },
+    { "&puncsp;", 8, { 8200, 0 } },
+    { "&ngE;", 5, { 8807, 824 } },
+    { "&sce;", 5, { 10928, 0 } },
+    { "&minusb;", 8, { 8863, 0 } },
+    { "&cross;", 7, { 10007, 0 } },
+    { "&Lcy;", 5, { 1051, 0 } },
+    { "&sccue;", 7, { 8829, 0 } },
+    { "&gopf;", 6, { 120152, 0 } },
+    { "&LeftTriangleBar;", 17, { 10703, 0 } },
+    { "&sim;", 5, { 8764, 0 } },
+    { "&ThickSpace;", 12, { 8287, 8202 } },
+    { "&Wcirc;", 7, { 372, 0 } },
+    { "&NotRightTriangleBar;", 21, { 10704, 824 } },
+    { "&ominus;", 8, { 8854, 0 } },
+    { "&cwconint;", 10, { 8754, 0 } },
+    { "&rmoust;", 8, { 9137, 0 } },
+    { "&af;", 4, { 8289, 0 } },
+    { "&Cacute;", 8, { 262, 0 } },
+    { "&thetav;", 8, { 977, 0 } },
+    { "&NegativeThickSpace;", 20, { 8203, 0 } },
+    { "&rcedil;", 8, { 343, 0 } },
+    { "&nGt;", 5, { 8811, 8402 } },
+    { "&topf;", 6, { 120165, 0 } },
+    { "&sqsube;", 8, { 8849, 0 } },
+    { "&Beta;", 6, { 914, 0 } },
+    { "&therefore;", 11, { 8756, 0 } },
+    { "&lgE;", 5, { 10897, 0 } },
+    { "&NotVerticalBar;", 16, { 8740, 0 } },
+    { "&TSHcy;", 7, { 1035, 0 } },
+    { "&acute;", 7, { 180, 0 } },
+    { "&SOFTcy;", 8, { 1068, 0 } },
+    { "&UpperLeftArrow;", 16, { 8598, 0 } },
+    { "&trisb;", 7, { 10701, 0 } },
+    { "&boxtimes;", 10, { 8864, 0 } },
+    { "&KHcy;", 6, { 1061, 0 } },
+    { "&supsub;", 8, { 10964, 0 } },
+    { "&rAarr;", 7, { 8667, 0 } },
+    { "&Ccaron;", 8, { 268, 0 } },
+    { "&Qscr;", 6, { 119980, 0 } },
+    { "&LeftDownVectorBar;", 19, { 10585, 0 } },
+    { "&afr;", 5, { 120094, 0 } },
+    { "&xrArr;", 7, { 10233, 0 } },
+    { "&NotGreaterLess;", 16, { 8825, 0 } },
+    { "&kcedil;", 8, { 311, 0 } },
+    { "&nsimeq;", 8, { 8772, 0 } },
+    { "&multimap;", 10, { 8888, 0 } },
+    { "&Iacute;", 8, { 205, 0 } },
+    { "&bnequiv;", 9, { 8801, 8421 } },
+    { "&Zfr;", 5, { 8488, 0 } },
+    { "&lesseqqgtr;", 12, { 10891, 0 } },
+    { "&pm;", 4, { 177, 0 } },
+    { "&urcorn;", 8, { 8989, 0 } },
+    { "&nvrtrie;", 9, { 8885, 8402 } },
+    { "&ntrianglelefteq;", 17, { 8940, 0 } },
+    { "&demptyv;", 9, { 10673, 0 } },
+    { "&succcurlyeq;", 13, { 8829, 0 } },
+    { "&yfr;", 5, { 120118, 0 } },
+    { "&Equal;", 7, { 10869, 0 } },
+    { "&deg;", 5, { 176, 0 } },
+    { "&qint;", 6, { 10764, 0 } },
+    { "&sext;", 6, { 10038, 0 } },
+    { "&zdot;", 6, { 380, 0 } },
+    { "&RightArrowLeftArrow;", 21, { 8644, 0 } },
+    { "&boxVh;", 7, { 9579, 0 } },
+    { "&szlig;", 7, { 223, 0 } },
+    { "&thkap;", 7, { 8776, 0 } },
+    { "&lsquo;", 7, { 8216, 0 } },
+    { "&Acy;", 5, { 1040, 0 } },
+    { "&telrec;", 8, { 8981, 0 } },
+    { "&Square;", 8, { 9633, 0 } },
+    { "&plusdu;", 8, { 10789, 0 } },
+    { "&hcirc;", 7, { 293, 0 } },
+    { "&varphi;", 8, { 981, 0 } },
+    { "&Eopf;", 6, { 120124, 0 } },
+    { "&Wfr;", 5, { 120090, 0 } },
+    { "&Ccirc;", 7, { 264, 0 } },
+    { "&darr;", 6, { 8595, 0 } },
+    { "&DownTeeArrow;", 14, { 8615, 0 } },
+    { "&THORN;", 7, { 222, 0 } },
+    { "&larr;", 6, { 8592, 0 } },
+    { "&boxDR;", 7, { 9556, 0 } },
+    { "&rtriltri;", 10, { 10702, 0 } },
+    { "&elinters;", 10, { 9191, 0 } },
+    { "&Integral;", 10, { 8747, 0 } },
+    { "&UpEquilibrium;", 15, { 10606, 0 } },
+    { "&Oopf;", 6, { 120134, 0 } },
+    { "&Ll;", 4, { 8920, 0 } },
+    { "&varsubsetneq;", 14, { 8842, 65024 } },
+    { "&prec;", 6, { 8826, 0 } },
+    { "&rbarr;", 7, { 10509, 0 } },
+    { "&rbrke;", 7, { 10636, 0 } },
+    { "&measuredangle;", 15, { 8737, 0 } },
+    { "&ubrcy;", 7, { 1118, 0 } },
+    { "&rlm;", 5, { 8207, 0 } },
+    { "&Kscr;", 6, { 119974, 0 } },
+    { "&RightDownVectorBar;", 20, { 10581, 0 } },
+    { "&Tilde;", 7, { 8764, 0 } },
+    { "&ncongdot;", 10, { 10861, 824 } },
+    { "&shcy;", 6, { 1096, 0 } },
+    { "&nwnear;", 8, { 10535, 0 } },
+    { "&lbrke;", 7, { 10635, 0 } },
+    { "&Zeta;", 6, { 918, 0 } },
+    { "&rsquo;", 7, { 8217, 0 } },
+    { "&ldquo;", 7, { 8220, 0 } },
+    { "&lEg;", 5, { 10891, 0 } },
+    { "&natural;", 9, { 9838, 0 } },
+    { "&origof;", 8, { 8886, 0 } },
+    { "&cudarrr;", 9, { 10549, 0 } },
+    { "&NotGreaterTilde;", 17, { 8821, 0 } },
+    { "&NotLeftTriangleEqual;", 22, { 8940, 0 } },
+    { "&lbrack;", 8, { 91, 0 } },
+    { "&sum;", 5, { 8721, 0 } },
+    { "&boxvr;", 7, { 9500, 0 } },
+    { "&vellip;", 8, { 8942, 0 } },
+    { "&rarrw;", 7, { 8605, 0 } },
+    { "&bigstar;", 9, { 9733, 0 } },
+    { "&gg;", 4, { 8811, 0 } },
+    { "&Mellintrf;", 11, { 8499, 0 } },
+    { "&bigtriangledown;", 17, { 9661, 0 } },
+    { "&GJcy;", 6, { 1027, 0 } },
+    { "&odot;", 6, { 8857, 0 } },
+    { "&dtrif;", 7, { 9662, 0 } },
+    { "&dcy;", 5, { 1076, 0 } },
+    { "&gsim;", 6, { 8819, 0 } },
+    { "&apos;", 6, { 39, 0 } },
+    { "&NotEqual;", 10, { 8800, 0 } },
+    { "&lltri;", 7, { 9722, 0 } },
+    { "&bernou;", 8, { 8492, 0 } },
+    { "&Leftarrow;", 11, { 8656, 0 } },
+    { "&lrarr;", 7, { 8646, 0 } },
+    { "&ZeroWidthSpace;", 16, { 8203, 0 } },
+    { "&erDot;", 7, { 8787, 0 } },
+    { "&triangleright;", 15, { 9657, 0 } },
+    { "&HumpDownHump;", 14, { 8782, 0 } },
+    { "&mapsto;", 8, { 8614, 0 } },
+    { "&numsp;", 7, { 8199, 0 } },
+    { "&jsercy;", 8, { 1112, 0 } },
+    { "&nvlArr;", 8, { 10498, 0 } },
+    { "&Ofr;", 5, { 120082, 0 } },
+    { "&gvertneqq;", 11, { 8809, 65024 } },
+    { "&jmath;", 7, { 567, 0 } },
+    { "&Hfr;", 5, { 8460, 0 } },
+    { "&disin;", 7, { 8946, 0 } },
+    { "&mstpos;", 8, { 8766, 0 } },
+    { "&egsdot;", 8, { 10904, 0 } },
+    { "&iiota;", 7, { 8489, 0 } },
+    { "&iiiint;", 8, { 10764, 0 } },
+    { "&nsime;", 7, { 8772, 0 } },
+    { "&ctdot;", 7, { 8943, 0 } },
+    { "&cirscir;", 9, { 10690, 0 } },
+    { "&Chi;", 5, { 935, 0 } },
+    { "&num;", 5, { 35, 0 } },
+    { "&hyphen;", 8, { 8208, 0 } },
+    { "&emsp13;", 8, { 8196, 0 } },
+    { "&vzigzag;", 9, { 10650, 0 } },
+    { "&lnsim;", 7, { 8934, 0 } },
+    { "&rect;", 6, { 9645, 0 } },
+    { "&DJcy;", 6, { 1026, 0 } },
+    { "&RightTriangleEqual;", 20, { 8885, 0 } },
+    { "&edot;", 6, { 279, 0 } },
+    { "&propto;", 8, { 8733, 0 } },
+    { "&Amacr;", 7, { 256, 0 } },
+    { "&reals;", 7, { 8477, 0 } },
+    { "&Lang;", 6, { 10218, 0 } },
+    { "&Wscr;", 6, { 119986, 0 } },
+    { "&robrk;", 7, { 10215, 0 } },
+    { "&Yopf;", 6, { 120144, 0 } },
+    { "&Hacek;", 7, { 711, 0 } },
+    { "&rightarrow;", 12, { 8594, 0 } },
+    { "&nleqslant;", 11, { 10877, 824 } },
+    { "&fltns;", 7, { 9649, 0 } },
+    { "&Pr;", 4, { 10939, 0 } },
+    { "&blk34;", 7, { 9619, 0 } },
+    { "&nscr;", 6, { 120003, 0 } },
+    { "&SquareIntersection;", 20, { 8851, 0 } },
+    { "&isin;", 6, { 8712, 0 } },
+    { "&hybull;", 8, { 8259, 0 } },
+    { "&frasl;", 7, { 8260, 0 } },
+    { "&NotNestedGreaterGreater;", 25, { 10914, 824 } },
+    { "&siml;", 6, { 10909, 0 } },
+    { "&yen;", 5, { 165, 0 } },
+    { "&wedbar;", 8, { 10847, 0 } },
+    { "&tau;", 5, { 964, 0 } },
+    { "&eparsl;", 8, { 10723, 0 } },
+    { "&rsaquo;", 8, { 8250, 0 } },
+    { "&OverBrace;", 11, { 9182, 0 } },
+    { "&sime;", 6, { 8771, 0 } },
+    { "&Lacute;", 8, { 313, 0 } },
+    { "&lesdotor;", 10, { 10883, 0 } },
+    { "&EmptyVerySmallSquare;", 22, { 9643, 0 } },
+    { "&Colon;", 7, { 8759, 0 } },
+    { "&dotminus;", 10, { 8760, 0 } },
+    { "&wr;", 4, { 8768, 0 } },
+    { "&precsim;", 9, { 8830, 0 } },
+    { "&oslash;", 8, { 248, 0 } },
+    { "&eqvparsl;", 10, { 10725, 0 } },
+    { "&rdldhar;", 9, { 10601, 0 } },
+    { "&ldrdhar;", 9, { 10599, 0 } },
+    { "&Not;", 5, { 10988, 0 } },
+    { "&nleqq;", 7, { 8806, 824 } },
+    { "&scnE;", 6, { 10934, 0 } },
+    { "&verbar;", 8, { 124, 0 } },
+    { "&RightAngleBracket;", 19, { 10217, 0 } },
+    { "&dopf;", 6, { 120149, 0 } },
+    { "&Xopf;", 6, { 120143, 0 } },
+    { "&Barwed;", 8, { 8966, 0 } },
+    { "&ShortLeftArrow;", 16, { 8592, 0 } },
+    { "&kgreen;", 8, { 312, 0 } },
+    { "&NegativeMediumSpace;", 21, { 8203, 0 } },
+    { "&Hscr;", 6, { 8459, 0 } },
+    { "&gtrless;", 9, { 8823, 0 } },
+    { "&uhblk;", 7, { 9600, 0 } },
+    { "&succnapprox;", 13, { 10938, 0 } },
+    { "&varpropto;", 11, { 8733, 0 } },
+    { "&ubreve;", 8, { 365, 0 } },
+    { "&alpha;", 7, { 945, 0 } },
+    { "&RightUpTeeVector;", 18, { 10588, 0 } },
+    { "&sc;", 4, { 8827, 0 } },
+    { "&Dopf;", 6, { 120123, 0 } },
+    { "&primes;", 8, { 8473, 0 } },
+    { "&frac35;", 8, { 8535, 0 } },
+    { "&subnE;", 7, { 10955, 0 } },
+    { "&LessGreater;", 13, { 8822, 0 } },
+    { "&lotimes;", 9, { 10804, 0 } },
+    { "&NotSquareSuperset;", 19, { 8848, 824 } },
+    { "&Fopf;", 6, { 120125, 0 } },
+    { "&simdot;", 8, { 10858, 0 } },
+    { "&clubs;", 7, { 9827, 0 } },
+    { "&bbrk;", 6, { 9141, 0 } },
+    { "&ruluhar;", 9, { 10600, 0 } },
+    { "&Ugrave;", 8, { 217, 0 } },
+    { "&lcaron;", 8, { 318, 0 } },
+    { "&mapstoup;", 10, { 8613, 0 } },
+    { "&complexes;", 11, { 8450, 0 } },
+    { "&oast;", 6, { 8859, 0 } },
+    { "&nsccue;", 8, { 8929, 0 } },
+    { "&vprop;", 7, { 8733, 0 } },
+    { "&blk14;", 7, { 9617, 0 } },
+    { "&rightleftarrows;", 17, { 8644, 0 } },
+    { "&rarrpl;", 8, { 10565, 0 } },
+    { "&Rcy;", 5, { 1056, 0 } },
+    { "&twoheadleftarrow;", 18, { 8606, 0 } },
+    { "&quatint;", 9, { 10774, 0 } },
+    { "&horbar;", 8, { 8213, 0 } },
+    { "&complement;", 12, { 8705, 0 } },
+    { "&Union;", 7, { 8899, 0 } },
+    { "&isinE;", 7, { 8953, 0 } },
+    { "&geq;", 5, { 8805, 0 } },
+    { "&subdot;", 8, { 10941, 0 } },
+    { "&notin;", 7, { 8713, 0 } },
+    { "&nrtrie;", 8, { 8941, 0 } },
+    { "&pluse;", 7, { 10866, 0 } },
+    { "&expectation;", 13, { 8496, 0 } },
+    { "&Tcaron;", 8, { 356, 0 } },
+    { "&latail;", 8, { 10521, 0 } },
+    { "&dfr;", 5, { 120097, 0 } },
+    { "&simlE;", 7, { 10911, 0 } },
+    { "&Psi;", 5, { 936, 0 } },
+    { "&apid;", 6, { 8779, 0 } },
+    { "&lmidot;", 8, { 320, 0 } },
+    { "&downdownarrows;", 16, { 8650, 0 } },
+    { "&Yfr;", 5, { 120092, 0 } },
+    { "&dash;", 6, { 8208, 0 } },
+    { "&LeftTeeVector;", 15, { 10586, 0 } },
+    { "&div;", 5, { 247, 0 } },
+    { "&TildeTilde;", 12, { 8776, 0 } },
+    { "&timesb;", 8, { 8864, 0 } },
+    { "&LeftRightArrow;", 16, { 8596, 0 } },
+    { "&comp;", 6, { 8705, 0 } },
+    { "&ncup;", 6, { 10818, 0 } },
+    { "&uogon;", 7, { 371, 0 } },
+    { "&lurdshar;", 10, { 10570, 0 } },
+    { "&bumpE;", 7, { 10926, 0 } },
+    { "&supdot;", 8, { 10942, 0 } },
+    { "&CircleDot;", 11, { 8857, 0 } },
+    { "&PartialD;", 10, { 8706, 0 } },
+    { "&mnplus;", 8, { 8723, 0 } },
+    { "&parsim;", 8, { 10995, 0 } },
+    { "&imath;", 7, { 305, 0 } },
+    { "&subrarr;", 9, { 10617, 0 } },
+    { "&Jcirc;", 7, { 308, 0 } },
+    { "&TildeEqual;", 12, { 8771, 0 } },
+    { "&le;", 4, { 8804, 0 } },
+    { "&DoubleDot;", 11, { 168, 0 } },
+    { "&cuepr;", 7, { 8926, 0 } },
+    { "&GreaterFullEqual;", 18, { 8807, 0 } },
+    { "&notindot;", 10, { 8949, 824 } },
+    { "&scpolint;", 10, { 10771, 0 } },
+    { "&nge;", 5, { 8817, 0 } },
+    { "&smashp;", 8, { 10803, 0 } },
+    { "&tprime;", 8, { 8244, 0 } },
+    { "&bigvee;", 8, { 8897, 0 } },
+    { "&SmallCircle;", 13, { 8728, 0 } },
+    { "&prurel;", 8, { 8880, 0 } },
+    { "&tcy;", 5, { 1090, 0 } },
+    { "&LeftAngleBracket;", 18, { 10216, 0 } },
+    { "&boxplus;", 9, { 8862, 0 } },
+    { "&dArr;", 6, { 8659, 0 } },
+    { "&nleq;", 6, { 8816, 0 } },
+    { "&simplus;", 9, { 10788, 0 } },
+    { "&el;", 4, { 10905, 0 } },
+    { "&star;", 6, { 9734, 0 } },
+    { "&YAcy;", 6, { 1071, 0 } },
+    { "&lparlt;", 8, { 10643, 0 } },
+    { "&sacute;", 8, { 347, 0 } },
+    { "&strns;", 7, { 175, 0 } },
+    { "&boxUl;", 7, { 9564, 0 } },
+    { "&lambda;", 8, { 955, 0 } },
+    { "&NegativeThinSpace;", 19, { 8203, 0 } },
+    { "&larrhk;", 8, { 8617, 0 } },
+    { "&utilde;", 8, { 361, 0 } },
+    { "&lbrace;", 8, { 123, 0 } },
+    { "&eqslantgtr;", 12, { 10902, 0 } },
+    { "&Dscr;", 6, { 119967, 0 } },
+    { "&rdsh;", 6, { 8627, 0 } },
+    { "&Hopf;", 6, { 8461, 0 } },
+    { "&EmptySmallSquare;", 18, { 9723, 0 } },
+    { "&xnis;", 6, { 8955, 0 } },
+    { "&plusdo;", 8, { 8724, 0 } },
+    { "&rarrhk;", 8, { 8618, 0 } },
+    { "&Mscr;", 6, { 8499, 0 } },
+    { "&shortmid;", 10, { 8739, 0 } },
+    { "&nequiv;", 8, { 8802, 0 } },
+    { "&njcy;", 6, { 1114, 0 } },
+    { "&rsh;", 5, { 8625, 0 } },
+    { "&varnothing;", 12, { 8709, 0 } },
+    { "&piv;", 5, { 982, 0 } },
+    { "&NotLeftTriangleBar;", 20, { 10703, 824 } },
+    { "&mdash;", 7, { 8212, 0 } },
+    { "&pr;", 4, { 8826, 0 } },
+    { "&Implies;", 9, { 8658, 0 } },
+    { "&ges;", 5, { 10878, 0 } },
+    { "&because;", 9, { 8757, 0 } },
+    { "&drcrop;", 8, { 8972, 0 } },
+    { "&DownArrowBar;", 14, { 10515, 0 } },
+    { "&lE;", 4, { 8806, 0 } },
+    { "&gnE;", 5, { 8809, 0 } },
+    { "&boxHU;", 7, { 9577, 0 } },
+    { "&apE;", 5, { 10864, 0 } },
+    { "&frac12;", 8, { 189, 0 } },
+    { "&lang;", 6, { 10216, 0 } },
+    { "&nRightarrow;", 13, { 8655, 0 } },
+    { "&subsub;", 8, { 10965, 0 } },
+    { "&bfr;", 5, { 120095, 0 } },
+    { "&leftharpoondown;", 17, { 8637, 0 } },
+    { "&cirmid;", 8, { 10991, 0 } },
+    { "&rmoustache;", 12, { 9137, 0 } },
+    { "&nvgt;", 6, { 62, 8402 } },
+    { "&plusmn;", 8, { 177, 0 } },
+    { "&FilledSmallSquare;", 19, { 9724, 0 } },
+    { "&Zcaron;", 8, { 381, 0 } },
+    { "&curvearrowright;", 17, { 8631, 0 } },
+    { "&ltdot;", 7, { 8918, 0 } },
+    { "&hslash;", 8, { 8463, 0 } },
+    { "&gtrapprox;", 11, { 10886, 0 } },
+    { "&frown;", 7, { 8994, 0 } },
+    { "&xmap;", 6, { 10236, 0 } },
+    { "&ldrushar;", 10, { 10571, 0 } },
+    { "&Vert;", 6, { 8214, 0 } },
+    { "&subset;", 8, { 8834, 0 } },
+    { "&LessFullEqual;", 15, { 8806, 0 } },
+    { "&scE;", 5, { 10932, 0 } },
+    { "&nVdash;", 8, { 8878, 0 } },
+    { "&urtri;", 7, { 9721, 0 } },
+    { "&boxvR;", 7, { 9566, 0 } },
+    { "&supne;", 7, { 8843, 0 } },
+    { "&plustwo;", 9, { 10791, 0 } },
+    { "&Fouriertrf;", 12, { 8497, 0 } },
+    { "&mu;", 4, { 956, 0 } },
+    { "&roang;", 7, { 10221, 0 } },
+    { "&dscr;", 6, { 119993, 0 } },
+    { "&Kcy;", 5, { 1050, 0 } },
+    { "&nedot;", 7, { 8784, 824 } },
+    { "&rrarr;", 7, { 8649, 0 } },
+    { "&emsp14;", 8, { 8197, 0 } },
+    { "&auml;", 6, { 228, 0 } },
+    { "&lcedil;", 8, { 316, 0 } },
+    { "&LeftArrowBar;", 14, { 8676, 0 } },
+    { "&Kfr;", 5, { 120078, 0 } },
+    { "&Emacr;", 7, { 274, 0 } },
+    { "&Tcedil;", 8, { 354, 0 } },
+    { "&Tau;", 5, { 932, 0 } },
+    { "&Esim;", 6, { 10867, 0 } },
+    { "&Ecy;", 5, { 1069, 0 } },
+    { "&LeftTeeArrow;", 14, { 8612, 0 } },
+    { "&nsup;", 6, { 8837, 0 } },
+    { "&subseteqq;", 11, { 10949, 0 } },
+    { "&gEl;", 5, { 10892, 0 } },
+    { "&dotplus;", 9, { 8724, 0 } },
+    { "&dotsquare;", 11, { 8865, 0 } },
+    { "&LeftVector;", 12, { 8636, 0 } },
+    { "&triangleleft;", 14, { 9667, 0 } },
+    { "&nsupe;", 7, { 8841, 0 } },
+    { "&par;", 5, { 8741, 0 } },
+    { "&xopf;", 6, { 120169, 0 } },
+    { "&fopf;", 6, { 120151, 0 } },
+    { "&ratail;", 8, { 10522, 0 } },
+    { "&Atilde;", 8, { 195, 0 } },
+    { "&cirE;", 6, { 10691, 0 } },
+    { "&backcong;", 10, { 8780, 0 } },
+    { "&Zopf;", 6, { 8484, 0 } },
+    { "&RightTriangle;", 15, { 8883, 0 } },
+    { "&between;", 9, { 8812, 0 } },
+    { "&phiv;", 6, { 981, 0 } },
+    { "&incare;", 8, { 8453, 0 } },
+    { "&iacute;", 8, { 237, 0 } },
+    { "&lsqb;", 6, { 91, 0 } },
+    { "&eqcirc;", 8, { 8790, 0 } },
+    { "&sscr;", 6, { 120008, 0 } },
+    { "&ovbar;", 7, { 9021, 0 } },
+    { "&downharpoonright;", 18, { 8642, 0 } },
+    { "&TRADE;", 7, { 8482, 0 } },
+    { "&and;", 5, { 8743, 0 } },
+    { "&otimesas;", 10, { 10806, 0 } },
+    { "&cularr;", 8, { 8630, 0 } },
+    { "&lHar;", 6, { 10594, 0 } },
+    { "&Longleftrightarrow;", 20, { 10234, 0 } },
+    { "&neArr;", 7, { 8663, 0 } },
+    { "&heartsuit;", 11, { 9829, 0 } },
+    { "&Prime;", 7, { 8243, 0 } },
+    { "&supsup;", 8, { 10966, 0 } },
+    { "&cirfnint;", 10, { 10768, 0 } },
+    { "&coloneq;", 9, { 8788, 0 } },
+    { "&ecaron;", 8, { 283, 0 } },
+    { "&Cscr;", 6, { 119966, 0 } },
+    { "&lopar;", 7, { 10629, 0 } },
+    { "&dd;", 4, { 8518, 0 } },
+    { "&supseteq;", 10, { 8839, 0 } },
+    { "&Verbar;", 8, { 8214, 0 } },
+    { "&cemptyv;", 9, { 10674, 0 } },
+    { "&DifferentialD;", 15, { 8518, 0 } },
+    { "&kfr;", 5, { 120104, 0 } },
+    { "&nearr;", 7, { 8599, 0 } },
+    { "&bigcirc;", 9, { 9711, 0 } },
+    { "&toea;", 6, { 10536, 0 } },
+    { "&LeftDoubleBracket;", 19, { 10214, 0 } },
+    { "&DoubleLeftTee;", 15, { 10980, 0 } },
+    { "&larrtl;", 8, { 8610, 0 } },
+    { "&bkarow;", 8, { 10509, 0 } },
+    { "&glj;", 5, { 10916, 0 } },
+    { "&Zacute;", 8, { 377, 0 } },
+    { "&PrecedesTilde;", 15, { 8830, 0 } },
+    { "&lscr;", 6, { 120001, 0 } },
+    { "&Lscr;", 6, { 8466, 0 } },
+    { "&ap;", 4, { 8776, 0 } },
+    { "&CenterDot;", 11, { 183, 0 } },
+    { "&iff;", 5, { 8660, 0 } },
+    { "&drcorn;", 8, { 8991, 0 } },
+    { "&xharr;", 7, { 10231, 0 } },
+    { "&utdot;", 7, { 8944, 0 } },
+    { "&rbrksld;", 9, { 10638, 0 } },
+    { "&QUOT;", 6, { 34, 0 } },
+    { "&gtquest;", 9, { 10876, 0 } },
+    { "&triangledown;", 14, { 9663, 0 } },
+    { "&csup;", 6, { 10960, 0 } },
+    { "&nLtv;", 6, { 8810, 824 } },
+    { "&squarf;", 8, { 9642, 0 } },
+    { "&pitchfork;", 11, { 8916, 0 } },
+    { "&icy;", 5, { 1080, 0 } },
+    { "&npr;", 5, { 8832, 0 } },
+    { "&ddarr;", 7, { 8650, 0 } },
+    { "&thetasym;", 10, { 977, 0 } },
+    { "&eth;", 5, { 240, 0 } },
+    { "&copf;", 6, { 120148, 0 } },
+    { "&trade;", 7, { 8482, 0 } },
+    { "&uuarr;", 7, { 8648, 0 } },
+    { "&duhar;", 7, { 10607, 0 } },
+    { "&ZHcy;", 6, { 1046, 0 } },
+    { "&ccedil;", 8, { 231, 0 } },
+    { "&lesdot;", 8, { 10879, 0 } },
+    { "&Acirc;", 7, { 194, 0 } },
+    { "&intcal;", 8, { 8890, 0 } },
+    { "&scsim;", 7, { 8831, 0 } },
+    { "&Ncedil;", 8, { 325, 0 } },
+    { "&zacute;", 8, { 378, 0 } },
+    { "&NotSucceedsTilde;", 18, { 8831, 824 } },
+    { "&shortparallel;", 15, { 8741, 0 } },
+    { "&NotRightTriangle;", 18, { 8939, 0 } },
+    { "&Lcaron;", 8, { 317, 0 } },
+    { "&kjcy;", 6, { 1116, 0 } },
+    { "&Larr;", 6, { 8606, 0 } },
+    { "&frac18;", 8, { 8539, 0 } },
+    { "&EqualTilde;", 12, { 8770, 0 } },
+    { "&ropf;", 6, { 120163, 0 } },
+    { "&Uscr;", 6, { 119984, 0 } },
+    { "&gtlPar;", 8, { 10645, 0 } },
+    { "&LeftArrowRightArrow;", 21, { 8646, 0 } },
+    { "&LeftArrow;", 11, { 8592, 0 } },
+    { "&srarr;", 7, { 8594, 0 } },
+    { "&Gcedil;", 8, { 290, 0 } },
+    { "&delta;", 7, { 948, 0 } },
+    { "&epar;", 6, { 8917, 0 } },
+    { "&sect;", 6, { 167, 0 } },
+    { "&plussim;", 9, { 10790, 0 } },
+    { "&supsim;", 8, { 10952, 0 } },
+    { "&xsqcup;", 8, { 10758, 0 } },
+    { "&tcaron;", 8, { 357, 0 } },
+    { "&NotSuperset;", 13, { 8835, 8402 } },
+    { "&squf;", 6, { 9642, 0 } },
+    { "&rBarr;", 7, { 10511, 0 } },
+    { "&simeq;", 7, { 8771, 0 } },
+    { "&iopf;", 6, { 120154, 0 } },
+    { "&VerticalBar;", 13, { 8739, 0 } },
+    { "&rtimes;", 8, { 8906, 0 } },
+    { "&Lambda;", 8, { 923, 0 } },
+    { "&DotEqual;", 10, { 8784, 0 } },
+    { "&maltese;", 9, { 10016, 0 } },
+    { "&rarrsim;", 9, { 10612, 0 } },
+    { "&iuml;", 6, { 239, 0 } },
+    { "&Afr;", 5, { 120068, 0 } },
+    { "&hfr;", 5, { 120101, 0 } },
+    { "&smtes;", 7, { 10924, 65024 } },
+    { "&aacute;", 8, { 225, 0 } },
+    { "&rho;", 5, { 961, 0 } },
+    { "&Edot;", 6, { 278, 0 } },
+    { "&nles;", 6, { 10877, 824 } },
+    { "&DoubleRightTee;", 16, { 8872, 0 } },
+    { "&hearts;", 8, { 9829, 0 } },
+    { "&Rarr;", 6, { 8608, 0 } },
+    { "&Barv;", 6, { 10983, 0 } },
+    { "&Gopf;", 6, { 120126, 0 } },
+    { "&Sigma;", 7, { 931, 0 } },
+    { "&CloseCurlyDoubleQuote;", 23, { 8221, 0 } },
+    { "&hookleftarrow;", 15, { 8617, 0 } },
+    { "&aelig;", 7, { 230, 0 } },
+    { "&planckh;", 9, { 8462, 0 } },
+    { "&imof;", 6, { 8887, 0 } },
+    { "&Rcaron;", 8, { 344, 0 } },
+    { "&Fscr;", 6, { 8497, 0 } },
+    { "&Iopf;", 6, { 120128, 0 } },
+    { "&xi;", 4, { 958, 0 } },
+    { "&cudarrl;", 9, { 10552, 0 } },
+    { "&gtreqqless;", 12, { 10892, 0 } },
+    { "&DoubleLongLeftRightArrow;", 26, { 10234, 0 } },
+    { "&lsim;", 6, { 8818, 0 } },
+    { "&Dot;", 5, { 168, 0 } },
+    { "&boxUr;", 7, { 9561, 0 } },
+    { "&ExponentialE;", 14, { 8519, 0 } },
+    { "&jukcy;", 7, { 1108, 0 } },
+    { "&nGtv;", 6, { 8811, 824 } },
+    { "&uwangle;", 9, { 10663, 0 } },
+    { "&Conint;", 8, { 8751, 0 } },
+    { "&triminus;", 10, { 10810, 0 } },
+    { "&thickapprox;", 13, { 8776, 0 } },
+    { "&Downarrow;", 11, { 8659, 0 } },
+    { "&bowtie;", 8, { 8904, 0 } },
+    { "&lbrksld;", 9, { 10639, 0 } },
+    { "&bne;", 5, { 61, 8421 } },
+    { "&nLt;", 5, { 8810, 8402 } },
+    { "&Uarrocir;", 10, { 10569, 0 } },
+    { "&compfn;", 8, { 8728, 0 } },
+    { "&nwarhk;", 8, { 10531, 0 } },
+    { "&nbumpe;", 8, { 8783, 824 } },
+    { "&sqsubset;", 10, { 8847, 0 } },
+    { "&circledast;", 12, { 8859, 0 } },
+    { "&Delta;", 7, { 916, 0 } },
+    { "&varr;", 6, { 8597, 0 } },
+    { "&ncong;", 7, { 8775, 0 } },
+    { "&rarrc;", 7, { 10547, 0 } },
+    { "&Theta;", 7, { 920, 0 } },
+    { "&TScy;", 6, { 1062, 0 } },
+    { "&Ycirc;", 7, { 374, 0 } },
+    { "&sfrown;", 8, { 8994, 0 } },
+    { "&ForAll;", 8, { 8704, 0 } },
+    { "&cularrp;", 9, { 10557, 0 } },
+    { "&nparallel;", 11, { 8742, 0 } },
+    { "&nlE;", 5, { 8806, 824 } },
+    { "&ffllig;", 8, { 64260, 0 } },
+    { "&omid;", 6, { 10678, 0 } },
+    { "&NotTildeEqual;", 15, { 8772, 0 } },
+    { "&oacute;", 8, { 243, 0 } },
+    { "&bsemi;", 7, { 8271, 0 } },
+    { "&iprod;", 7, { 10812, 0 } },
+    { "&nsucc;", 7, { 8833, 0 } },
+    { "&Jukcy;", 7, { 1028, 0 } },
+    { "&ggg;", 5, { 8921, 0 } },
+    { "&ulcorn;", 8, { 8988, 0 } },
+    { "&nesim;", 7, { 8770, 824 } },
+    { "&rbrace;", 8, { 125, 0 } },
+    { "&phmmat;", 8, { 8499, 0 } },
+    { "&DoubleVerticalBar;", 19, { 8741, 0 } },
+    { "&swarhk;", 8, { 10534, 0 } },
+    { "&gscr;", 6, { 8458, 0 } },
+    { "&ni;", 4, { 8715, 0 } },
+    { "&LeftUpDownVector;", 18, { 10577, 0 } },
+    { "&geqq;", 6, { 8807, 0 } },
+    { "&nGg;", 5, { 8921, 824 } },
+    { "&nsubset;", 9, { 8834, 8402 } },
+    { "&gimel;", 7, { 8503, 0 } },
+    { "&Kopf;", 6, { 120130, 0 } },
+    { "&eqslantless;", 13, { 10901, 0 } },
+    { "&hstrok;", 8, { 295, 0 } },
+    { "&psi;", 5, { 968, 0 } },
+    { "&Lcedil;", 8, { 315, 0 } },
+    { "&Escr;", 6, { 8496, 0 } },
+    { "&MinusPlus;", 11, { 8723, 0 } },
+    { "&models;", 8, { 8871, 0 } },
+    { "&lescc;", 7, { 10920, 0 } },
+    { "&mldr;", 6, { 8230, 0 } },
+    { "&pi;", 4, { 960, 0 } },
+    { "&DoubleLeftRightArrow;", 22, { 8660, 0 } },
+    { "&qfr;", 5, { 120110, 0 } },
+    { "&fflig;", 7, { 64256, 0 } },
+    { "&ecolon;", 8, { 8789, 0 } },
+    { "&NotGreater;", 12, { 8815, 0 } },
+    { "&ccupssm;", 9, { 10832, 0 } },
+    { "&ocy;", 5, { 1086, 0 } },
+    { "&nharr;", 7, { 8622, 0 } },
+    { "&Otilde;", 8, { 213, 0 } },
+    { "&Icirc;", 7, { 206, 0 } },
+    { "&boxhu;", 7, { 9524, 0 } },
+    { "&Auml;", 6, { 196, 0 } },
+    { "&uacute;", 8, { 250, 0 } },
+    { "&boxUL;", 7, { 9565, 0 } },
+    { "&VerticalSeparator;", 19, { 10072, 0 } },
+    { "&LeftUpVector;", 14, { 8639, 0 } },
+    { "&angmsdae;", 10, { 10668, 0 } },
+    { "&Popf;", 6, { 8473, 0 } },
+    { "&bottom;", 8, { 8869, 0 } },
+    { "&lrhard;", 8, { 10605, 0 } },
+    { "&vrtri;", 7, { 8883, 0 } },
+    { "&Otimes;", 8, { 10807, 0 } },
+    { "&ic;", 4, { 8291, 0 } },
+    { "&Breve;", 7, { 728, 0 } },
+    { "&rightleftharpoons;", 19, { 8652, 0 } },
+    { "&vBarv;", 7, { 10985, 0 } },
+    { "&CloseCurlyQuote;", 17, { 8217, 0 } },
+    { "&spades;", 8, { 9824, 0 } },
+    { "&SucceedsSlantEqual;", 20, { 8829, 0 } },
+    { "&gtrarr;", 8, { 10616, 0 } },
+    { "&nbsp;", 6, { 160, 0 } },
+    { "&udhar;", 7, { 10606, 0 } },
+    { "&ucirc;", 7, { 251, 0 } },
+    { "&Udblac;", 8, { 368, 0 } },
+    { "&aopf;", 6, { 120146, 0 } },
+    { "&bopf;", 6, { 120147, 0 } },
+    { "&llcorner;", 10, { 8990, 0 } },
+    { "&lfr;", 5, { 120105, 0 } },
+    { "&nsce;", 6, { 10928, 824 } },
+    { "&NotEqualTilde;", 15, { 8770, 824 } },
+    { "&Hat;", 5, { 94, 0 } },
+    { "&nvrArr;", 8, { 10499, 0 } },
+    { "&scap;", 6, { 10936, 0 } },
+    { "&lBarr;", 7, { 10510, 0 } },
+    { "&rotimes;", 9, { 10805, 0 } },
+    { "&blacklozenge;", 14, { 10731, 0 } },
+    { "&napE;", 6, { 10864, 824 } },
+    { "&trie;", 6, { 8796, 0 } },
+    { "&vBar;", 6, { 10984, 0 } },
+    { "&Efr;", 5, { 120072, 0 } },
+    { "&ReverseEquilibrium;", 20, { 8651, 0 } },
+    { "&subE;", 6, { 10949, 0 } },
+    { "&DScy;", 6, { 1029, 0 } },
+    { "&Ocy;", 5, { 1054, 0 } },
+    { "&bull;", 6, { 8226, 0 } },
+    { "&Hcirc;", 7, { 292, 0 } },
+    { "&VerticalLine;", 14, { 124, 0 } },
+    { "&UpArrowBar;", 12, { 10514, 0 } },
+    { "&eqcolon;", 9, { 8789, 0 } },
+    { "&squ;", 5, { 9633, 0 } },
+    { "&blacktriangleright;", 20, { 9656, 0 } },
+    { "&Umacr;", 7, { 362, 0 } },
+    { "&colone;", 8, { 8788, 0 } },
+    { "&weierp;", 8, { 8472, 0 } },
+    { "&vdash;", 7, { 8866, 0 } },
+    { "&tosa;", 6, { 10537, 0 } },
+    { "&Tstrok;", 8, { 358, 0 } },
+    { "&gnsim;", 7, { 8935, 0 } },
+    { "&NotGreaterSlantEqual;", 22, { 10878, 824 } },
+    { "&notinvb;", 9, { 8951, 0 } },
+    { "&NotPrecedesSlantEqual;", 23, { 8928, 0 } },
+    { "&xlarr;", 7, { 10229, 0 } },
+    { "&orarr;", 7, { 8635, 0 } },
+    { "&frac14;", 8, { 188, 0 } },
+    { "&eqsim;", 7, { 8770, 0 } },
+    { "&nshortparallel;", 16, { 8742, 0 } },
+    { "&kopf;", 6, { 120156, 0 } },
+    { "&prnap;", 7, { 10937, 0 } },
+    { "&ac;", 4, { 8766, 0 } },
+    { "&rdca;", 6, { 10551, 0 } },
+    { "&cwint;", 7, { 8753, 0 } },
+    { "&Re;", 4, { 8476, 0 } },
+    { "&vDash;", 7, { 8872, 0 } },
+    { "&UnderParenthesis;", 18, { 9181, 0 } },
+    { "&leftthreetimes;", 16, { 8907, 0 } },
+    { "&vfr;", 5, { 120115, 0 } },
+    { "&VDash;", 7, { 8875, 0 } },
+    { "&DoubleUpArrow;", 15, { 8657, 0 } },
+    { "&ntgl;", 6, { 8825, 0 } },
+    { "&NotSucceedsEqual;", 18, { 10928, 824 } },
+    { "&nvHarr;", 8, { 10500, 0 } },
+    { "&gvnE;", 6, { 8809, 65024 } },
+    { "&backsimeq;", 11, { 8909, 0 } },
+    { "&Ocirc;", 7, { 212, 0 } },
+    { "&leftarrow;", 11, { 8592, 0 } },
+    { "&boxV;", 6, { 9553, 0 } },
+    { "&ne;", 4, { 8800, 0 } },
+    { "&nearhk;", 8, { 10532, 0 } },
+    { "&nang;", 6, { 8736, 8402 } },
+    { "&npar;", 6, { 8742, 0 } },
+    { "&sharp;", 7, { 9839, 0 } },
+    { "&jopf;", 6, { 120155, 0 } },
+    { "&Rscr;", 6, { 8475, 0 } },
+    { "&Xscr;", 6, { 119987, 0 } },
+    { "&boxVH;", 7, { 9580, 0 } },
+    { "&vangrt;", 8, { 10652, 0 } },
+    { "&doteqdot;", 10, { 8785, 0 } },
+    { "&Xfr;", 5, { 120091, 0 } },
+    { "&iecy;", 6, { 1077, 0 } },
+    { "&rbbrk;", 7, { 10099, 0 } },
+    { "&leqq;", 6, { 8806, 0 } },
+    { "&olcir;", 7, { 10686, 0 } },
+    { "&ufisht;", 8, { 10622, 0 } },
+    { "&lessgtr;", 9, { 8822, 0 } },
+    { "&Iuml;", 6, { 207, 0 } },
+    { "&kscr;", 6, { 120000, 0 } },
+    { "&gne;", 5, { 10888, 0 } },
+    { "&angmsdad;", 10, { 10667, 0 } },
+    { "&ll;", 4, { 8810, 0 } },
+    { "&Uopf;", 6, { 120140, 0 } },
+    { "&SquareSubset;", 14, { 8847, 0 } },
+    { "&boxuR;", 7, { 9560, 0 } },
+    { "&llhard;", 8, { 10603, 0 } },
+    { "&NotLessSlantEqual;", 19, { 10877, 824 } },
+    { "&gdot;", 6, { 289, 0 } },
+    { "&varsupsetneq;", 14, { 8843, 65024 } },
+    { "&qprime;", 8, { 8279, 0 } },
+    { "&npolint;", 9, { 10772, 0 } },
+    { "&DownRightVector;", 17, { 8641, 0 } },
+    { "&semi;", 6, { 59, 0 } },
+    { "&UpTee;", 7, { 8869, 0 } },
+    { "&hercon;", 8, { 8889, 0 } },
+    { "&RightCeiling;", 14, { 8969, 0 } },
+    { "&Gdot;", 6, { 288, 0 } },
+    { "&exponentiale;", 14, { 8519, 0 } },
+    { "&cupcup;", 8, { 10826, 0 } },
+    { "&hardcy;", 8, { 1098, 0 } },
+    { "&RightDoubleBracket;", 20, { 10215, 0 } },
+    { "&succ;", 6, { 8827, 0 } },
+    { "&quest;", 7, { 63, 0 } },
+    { "&boxH;", 6, { 9552, 0 } },
+    { "&homtht;", 8, { 8763, 0 } },
+    { "&nsupseteqq;", 12, { 10950, 824 } },
+    { "&SucceedsTilde;", 15, { 8831, 0 } },
+    { "&curlyeqprec;", 13, { 8926, 0 } },
+    { "&dzigrarr;", 10, { 10239, 0 } },
+    { "&Updownarrow;", 13, { 8661, 0 } },
+    { "&leqslant;", 10, { 10877, 0 } },
+    { "&SubsetEqual;", 13, { 8838, 0 } },
+    { "&LessTilde;", 11, { 8818, 0 } },
+    { "&Vbar;", 6, { 10987, 0 } },
+    { "&rtrie;", 7, { 8885, 0 } },
+    { "&late;", 6, { 10925, 0 } },
+    { "&VerticalTilde;", 15, { 8768, 0 } },
+    { "&NotLessGreater;", 16, { 8824, 0 } },
+    { "&malt;", 6, { 10016, 0 } },
+    { "&rcaron;", 8, { 345, 0 } },
+    { "&lbbrk;", 7, { 10098, 0 } },
+    { "&LeftTee;", 9, { 8867, 0 } },
+    { "&gjcy;", 6, { 1107, 0 } },
+    { "&gl;", 4, { 8823, 0 } },
+    { "&check;", 7, { 10003, 0 } },
+    { "&bump;", 6, { 8782, 0 } },
+    { "&alefsym;", 9, { 8501, 0 } },
+    { "&rfr;", 5, { 120111, 0 } },
+    { "&SquareSupersetEqual;", 21, { 8850, 0 } },
+    { "&boxVr;", 7, { 9567, 0 } },
+    { "&LeftDownVector;", 16, { 8643, 0 } },
+    { "&boxDr;", 7, { 9555, 0 } },
+    { "&sqsupseteq;", 12, { 8850, 0 } },
+    { "&TripleDot;", 11, { 8411, 0 } },
+    { "&yacy;", 6, { 1103, 0 } },
+    { "&LJcy;", 6, { 1033, 0 } },
+    { "&Zdot;", 6, { 379, 0 } },
+    { "&NotSquareSubsetEqual;", 22, { 8930, 0 } },
+    { "&ShortDownArrow;", 16, { 8595, 0 } },
+    { "&ufr;", 5, { 120114, 0 } },
+    { "&rnmid;", 7, { 10990, 0 } },
+    { "&gsiml;", 7, { 10896, 0 } },
+    { "&scnap;", 7, { 10938, 0 } },
+    { "&LowerRightArrow;", 17, { 8600, 0 } },
+    { "&RightFloor;", 12, { 8971, 0 } },
+    { "&ape;", 5, { 8778, 0 } },
+    { "&harrcir;", 9, { 10568, 0 } },
+    { "&Cayleys;", 9, { 8493, 0 } },
+    { "&langd;", 7, { 10641, 0 } },
+    { "&ntlg;", 6, { 8824, 0 } },
+    { "&permil;", 8, { 8240, 0 } },
+    { "&Oscr;", 6, { 119978, 0 } },
+    { "&nacute;", 8, { 324, 0 } },
+    { "&nhpar;", 7, { 10994, 0 } },
+    { "&Pcy;", 5, { 1055, 0 } },
+    { "&LeftDownTeeVector;", 19, { 10593, 0 } },
+    { "&ltrie;", 7, { 8884, 0 } },
+    { "&Tab;", 5, { 9, 0 } },
+    { "&curlywedge;", 12, { 8911, 0 } },
+    { "&imacr;", 7, { 299, 0 } },
+    { "&leq;", 5, { 8804, 0 } },
+    { "&elsdot;", 8, { 10903, 0 } },
+    { "&vArr;", 6, { 8661, 0 } },
+    { "&CupCap;", 8, { 8781, 0 } },
+    { "&vltri;", 7, { 8882, 0 } },
+    { "&diamondsuit;", 13, { 9830, 0 } },
+    { "&nLl;", 5, { 8920, 824 } },
+    { "&gnap;", 6, { 10890, 0 } },
+    { "&LeftCeiling;", 13, { 8968, 0 } },
+    { "&ring;", 6, { 730, 0 } },
+    { "&upsi;", 6, { 965, 0 } },
+    { "&andslope;", 10, { 10840, 0 } },
+    { "&eogon;", 7, { 281, 0 } },
+    { "&lap;", 5, { 10885, 0 } },
+    { "&NestedGreaterGreater;", 22, { 8811, 0 } },
+    { "&ltrif;", 7, { 9666, 0 } },
+    { "&operp;", 7, { 10681, 0 } },
+    { "&bigoplus;", 10, { 10753, 0 } },
+    { "&rarrbfs;", 9, { 10528, 0 } },
+    { "&ohm;", 5, { 937, 0 } },
+    { "&otimes;", 8, { 8855, 0 } },
+    { "&fscr;", 6, { 119995, 0 } },
+    { "&Jscr;", 6, { 119973, 0 } },
+    { "&rceil;", 7, { 8969, 0 } },
+    { "&oline;", 7, { 8254, 0 } },
+    { "&Cdot;", 6, { 266, 0 } },
+    { "&lsimg;", 7, { 10895, 0 } },
+    { "&icirc;", 7, { 238, 0 } },
+    { "&NotLessTilde;", 14, { 8820, 0 } },
+    { "&Ifr;", 5, { 8465, 0 } },
+    { "&rlhar;", 7, { 8652, 0 } },
+    { "&escr;", 6, { 8495, 0 } },
+    { "&phone;", 7, { 9742, 0 } },
+    { "&xoplus;", 8, { 10753, 0 } },
+    { "&smt;", 5, { 10922, 0 } },
+    { "&sup1;", 6, { 185, 0 } },
+    { "&simne;", 7, { 8774, 0 } },
+    { "&chi;", 5, { 967, 0 } },
+    { "&nhArr;", 7, { 8654, 0 } },
+    { "&ReverseElement;", 16, { 8715, 0 } },
+    { "&Lstrok;", 8, { 321, 0 } },
+    { "&rationals;", 11, { 8474, 0 } },
+    { "&tint;", 6, { 8749, 0 } },
+    { "&Dcaron;", 8, { 270, 0 } },
+    { "&olcross;", 9, { 10683, 0 } },
+    { "&larrbfs;", 9, { 10527, 0 } },
+    { "&Ffr;", 5, { 120073, 0 } },
+    { "&searr;", 7, { 8600, 0 } },
+    { "&InvisibleComma;", 16, { 8291, 0 } },
+    { "&eacute;", 8, { 233, 0 } },
+    { "&GreaterSlantEqual;", 19, { 10878, 0 } },
+    { "&pertenk;", 9, { 8241, 0 } },
+    { "&xwedge;", 8, { 8896, 0 } },
+    { "&Utilde;", 8, { 360, 0 } },
+    { "&angrt;", 7, { 8735, 0 } },
+    { "&Superset;", 10, { 8835, 0 } },
+    { "&vsubnE;", 8, { 10955, 65024 } },
+    { "&ropar;", 7, { 10630, 0 } },
+    { "&ucy;", 5, { 1091, 0 } },
+    { "&pcy;", 5, { 1087, 0 } },
+    { "&jscr;", 6, { 119999, 0 } },
+    { "&zigrarr;", 9, { 8669, 0 } },
+    { "&seswar;", 8, { 10537, 0 } },
+    { "&Congruent;", 11, { 8801, 0 } },
+    { "&aring;", 7, { 229, 0 } },
+    { "&prnsim;", 8, { 8936, 0 } },
+    { "&npart;", 7, { 8706, 824 } },
+    { "&supdsub;", 9, { 10968, 0 } },
+    { "&bcong;", 7, { 8780, 0 } },
+    { "&slarr;", 7, { 8592, 0 } },
+    { "&amacr;", 7, { 257, 0 } },
+    { "&fjlig;", 7, { 102, 106 } },
+    { "&sup3;", 6, { 179, 0 } },
+    { "&Subset;", 8, { 8912, 0 } },
+    { "&nsqsupe;", 9, { 8931, 0 } },
+    { "&amp;", 5, { 38, 0 } },
+    { "&uparrow;", 9, { 8593, 0 } },
+    { "&or;", 4, { 8744, 0 } },
+    { "&Exists;", 8, { 8707, 0 } },
+    { "&boxHD;", 7, { 9574, 0 } },
+    { "&gtreqless;", 11, { 8923, 0 } },
+    { "&ETH;", 5, { 208, 0 } },
+    { "&NotPrecedesEqual;", 18, { 10927, 824 } },
+    { "&NotLeftTriangle;", 17, { 8938, 0 } },
+    { "&forall;", 8, { 8704, 0 } },
+    { "&aogon;", 7, { 261, 0 } },
+    { "&Sscr;", 6, { 119982, 0 } },
+    { "&percnt;", 8, { 37, 0 } },
+    { "&larrlp;", 8, { 8619, 0 } },
+    { "&Cfr;", 5, { 8493, 0 } },
+    { "&Scirc;", 7, { 348, 0 } },
+    { "&caron;", 7, { 711, 0 } },
+    { "&leftarrowtail;", 15, { 8610, 0 } },
+    { "&nfr;", 5, { 120107, 0 } },
+    { "&Wedge;", 7, { 8896, 0 } },
+    { "&sdot;", 6, { 8901, 0 } },
+    { "&oplus;", 7, { 8853, 0 } },
+    { "&wedgeq;", 8, { 8793, 0 } },
+    { "&divonx;", 8, { 8903, 0 } },
+    { "&ngt;", 5, { 8815, 0 } },
+    { "&olt;", 5, { 10688, 0 } },
+    { "&hksearow;", 10, { 10533, 0 } },
+    { "&epsi;", 6, { 949, 0 } },
+    { "&Gamma;", 7, { 915, 0 } },
+    { "&boxul;", 7, { 9496, 0 } },
+    { "&ccaron;", 8, { 269, 0 } },
+    { "&simgE;", 7, { 10912, 0 } },
+    { "&Jfr;", 5, { 120077, 0 } },
+    { "&submult;", 9, { 10945, 0 } },
+    { "&natur;", 7, { 9838, 0 } },
+    { "&IOcy;", 6, { 1025, 0 } },
+    { "&ugrave;", 8, { 249, 0 } },
+    { "&angrtvbd;", 10, { 10653, 0 } },
+    { "&circlearrowright;", 18, { 8635, 0 } },
+    { "&curlyeqsucc;", 13, { 8927, 0 } },
+    { "&nexist;", 8, { 8708, 0 } },
+    { "&xutri;", 7, { 9651, 0 } },
+    { "&Mopf;", 6, { 120132, 0 } },
+    { "&ShortUpArrow;", 14, { 8593, 0 } },
+    { "&digamma;", 9, { 989, 0 } },
+    { "&vsubne;", 8, { 8842, 65024 } },
+    { "&DownBreve;", 11, { 785, 0 } },
+    { "&AElig;", 7, { 198, 0 } },
+    { "&fpartint;", 10, { 10765, 0 } },
+    { "&rfloor;", 8, { 8971, 0 } },
+    { "&Vcy;", 5, { 1042, 0 } },
+    { "&dHar;", 6, { 10597, 0 } },
+    { "&NotTildeFullEqual;", 19, { 8775, 0 } },
+    { "&napid;", 7, { 8779, 824 } },
+    { "&SucceedsEqual;", 15, { 10928, 0 } },
+    { "&udarr;", 7, { 8645, 0 } },
+    { "&boxVR;", 7, { 9568, 0 } },
+    { "&bsim;", 6, { 8765, 0 } },
+    { "&esdot;", 7, { 8784, 0 } },
+    { "&Fcy;", 5, { 1060, 0 } },
+    { "&gtrdot;", 8, { 8919, 0 } },
+    { "&Upsi;", 6, { 978, 0 } },
+    { "&timesd;", 8, { 10800, 0 } },
+    { "&rightthreetimes;", 17, { 8908, 0 } },
+    { "&angmsdab;", 10, { 10665, 0 } },
+    { "&solb;", 6, { 10692, 0 } },
+    { "&lneq;", 6, { 10887, 0 } },
+    { "&nis;", 5, { 8956, 0 } },
+    { "&RBarr;", 7, { 10512, 0 } },
+    { "&LT;", 4, { 60, 0 } },
+    { "&Zscr;", 6, { 119989, 0 } },
+    { "&iiint;", 7, { 8749, 0 } },
+    { "&PlusMinus;", 11, { 177, 0 } },
+    { "&Hstrok;", 8, { 294, 0 } },
+    { "&urcrop;", 8, { 8974, 0 } },
+    { "&cscr;", 6, { 119992, 0 } },
+    { "&Bumpeq;", 8, { 8782, 0 } },
+    { "&popf;", 6, { 120161, 0 } },
+    { "&congdot;", 9, { 10861, 0 } },
+    { "&Del;", 5, { 8711, 0 } },
+    { "&iexcl;", 7, { 161, 0 } },
+    { "&odiv;", 6, { 10808, 0 } },
+    { "&triangle;", 10, { 9653, 0 } },
+    { "&Because;", 9, { 8757, 0 } },
+    { "&supedot;", 9, { 10948, 0 } },
+    { "&kcy;", 5, { 1082, 0 } },
+    { "&macr;", 6, { 175, 0 } },
+    { "&boxbox;", 8, { 10697, 0 } },
+    { "&looparrowright;", 16, { 8620, 0 } },
+    { "&bigtriangleup;", 15, { 9651, 0 } },
+    { "&cir;", 5, { 9675, 0 } },
+    { "&oscr;", 6, { 8500, 0 } },
+    { "&And;", 5, { 10835, 0 } },
+    { "&triplus;", 9, { 10809, 0 } },
+    { "&nu;", 4, { 957, 0 } },
+    { "&csub;", 6, { 10959, 0 } },
+    { "&blacktriangleleft;", 19, { 9666, 0 } },
+    { "&rArr;", 6, { 8658, 0 } },
+    { "&leg;", 5, { 8922, 0 } },
+    { "&dstrok;", 8, { 273, 0 } },
+    { "&eopf;", 6, { 120150, 0 } },
+    { "&gtrsim;", 8, { 8819, 0 } },
+    { "&bullet;", 8, { 8226, 0 } },
+    { "&curarrm;", 9, { 10556, 0 } },
+    { "&angmsdaf;", 10, { 10669, 0 } },
+    { "&middot;", 8, { 183, 0 } },
+    { "&ogt;", 5, { 10689, 0 } },
+    { "&rangd;", 7, { 10642, 0 } },
+    { "&nsim;", 6, { 8769, 0 } },
+    { "&lowbar;", 8, { 95, 0 } },
+    { "&nlsim;", 7, { 8820, 0 } },
+    { "&boxvl;", 7, { 9508, 0 } },
+    { "&NJcy;", 6, { 1034, 0 } },
+    { "&boxhU;", 7, { 9576, 0 } },
+    { "&lceil;", 7, { 8968, 0 } },
+    { "&vcy;", 5, { 1074, 0 } },
+    { "&dtdot;", 7, { 8945, 0 } },
+    { "&frac58;", 8, { 8541, 0 } },
+    { "&NotSucceedsSlantEqual;", 23, { 8929, 0 } },
+    { "&lnE;", 5, { 8808, 0 } },
+    { "&cups;", 6, { 8746, 65024 } },
+    { "&lrtri;", 7, { 8895, 0 } },
+    { "&longleftrightarrow;", 20, { 10231, 0 } },
+    { "&integers;", 10, { 8484, 0 } },
+    { "&nvlt;", 6, { 60, 8402 } },
+    { "&uharr;", 7, { 8638, 0 } },
+    { "&GreaterEqual;", 14, { 8805, 0 } },
+    { "&order;", 7, { 8500, 0 } },
+    { "&sqcaps;", 8, { 8851, 65024 } },
+    { "&Ucirc;", 7, { 219, 0 } },
+    { "&blacktriangledown;", 19, { 9662, 0 } },
+    { "&rarrap;", 8, { 10613, 0 } },
+    { "&smile;", 7, { 8995, 0 } },
+    { "&egrave;", 8, { 232, 0 } },
+    { "&cylcty;", 8, { 9005, 0 } },
+    { "&barvee;", 8, { 8893, 0 } },
+    { "&uplus;", 7, { 8846, 0 } },
+    { "&profline;", 10, { 8978, 0 } },
+    { "&LessLess;", 10, { 10913, 0 } },
+    { "&zwnj;", 6, { 8204, 0 } },
+    { "&DiacriticalTilde;", 18, { 732, 0 } },
+    { "&emptyv;", 8, { 8709, 0 } },
+    { "&cupbrcap;", 10, { 10824, 0 } },
+    { "&Therefore;", 11, { 8756, 0 } },
+    { "&Ograve;", 8, { 210, 0 } },
+    { "&iukcy;", 7, { 1110, 0 } },
+    { "&boxdr;", 7, { 9484, 0 } },
+    { "&starf;", 7, { 9733, 0 } },
+    { "&NotRightTriangleEqual;", 23, { 8941, 0 } },
+    { "&longrightarrow;", 16, { 10230, 0 } },
+    { "&downharpoonleft;", 17, { 8643, 0 } },
+    { "&nleftrightarrow;", 17, { 8622, 0 } },
+    { "&lvertneqq;", 11, { 8808, 65024 } },
+    { "&Jcy;", 5, { 1049, 0 } },
+    { "&ord;", 5, { 10845, 0 } },
+    { "&euro;", 6, { 8364, 0 } },
+    { "&Laplacetrf;", 12, { 8466, 0 } },
+    { "&DoubleUpDownArrow;", 19, { 8661, 0 } },
+    { "&gesdot;", 8, { 10880, 0 } },
+    { "&gsime;", 7, { 10894, 0 } },
+    { "&dtri;", 6, { 9663, 0 } },
+    { "&dot;", 5, { 729, 0 } },
+    { "&bbrktbrk;", 10, { 9142, 0 } },
+    { "&NotSubsetEqual;", 16, { 8840, 0 } },
+    { "&Ouml;", 6, { 214, 0 } },
+    { "&ReverseUpEquilibrium;", 22, { 10607, 0 } },
+    { "&ddotseq;", 9, { 10871, 0 } },
+    { "&Sfr;", 5, { 120086, 0 } },
+    { "&csupe;", 7, { 10962, 0 } },
+    { "&curvearrowleft;", 16, { 8630, 0 } },
+    { "&RightVector;", 13, { 8640, 0 } },
+    { "&ncap;", 6, { 10819, 0 } },
+    { "&emacr;", 7, { 275, 0 } },
+    { "&nvltrie;", 9, { 8884, 8402 } },
+    { "&Eacute;", 8, { 201, 0 } },
+    { "&Backslash;", 11, { 8726, 0 } },
+    { "&Rightarrow;", 12, { 8658, 0 } },
+    { "&mDDot;", 7, { 8762, 0 } },
+    { "&Sacute;", 8, { 346, 0 } },
+    { "&ecirc;", 7, { 234, 0 } },
+    { "&Ubrcy;", 7, { 1038, 0 } },
+    { "&block;", 7, { 9608, 0 } },
+    { "&yacute;", 8, { 253, 0 } },
+    { "&circlearrowleft;", 17, { 8634, 0 } },
+    { "&nvle;", 6, { 8804, 8402 } },
+    { "&minusdu;", 9, { 10794, 0 } },
+    { "&nvge;", 6, { 8805, 8402 } },
+    { "&lbarr;", 7, { 10508, 0 } },
+    { "&Tscr;", 6, { 119983, 0 } },
+    { "&iocy;", 6, { 1105, 0 } },
+    { "&nltri;", 7, { 8938, 0 } },
+    { "&Cconint;", 9, { 8752, 0 } },
+    { "&LeftUpTeeVector;", 17, { 10592, 0 } },
+    { "&NotGreaterGreater;", 19, { 8811, 824 } },
+    { "&LessEqualGreater;", 18, { 8922, 0 } },
+    { "&zwj;", 5, { 8205, 0 } },
+    { "&nesear;", 8, { 10536, 0 } },
+    { "&circledcirc;", 13, { 8858, 0 } },
+    { "&gacute;", 8, { 501, 0 } },
+    { "&igrave;", 8, { 236, 0 } },
+    { "&apacir;", 8, { 10863, 0 } },
+    { "&dwangle;", 9, { 10662, 0 } },
+    { "&Topf;", 6, { 120139, 0 } },
+    { "&iogon;", 7, { 303, 0 } },
+    { "&DownLeftVector;", 16, { 8637, 0 } },
+    { "&notnivc;", 9, { 8957, 0 } },
+    { "&diams;", 7, { 9830, 0 } },
+    { "&DoubleRightArrow;", 18, { 8658, 0 } },
+    { "&approx;", 8, { 8776, 0 } },
+    { "&real;", 6, { 8476, 0 } },
+    { "&swnwar;", 8, { 10538, 0 } },
+    { "&nvinfin;", 9, { 10718, 0 } },
+    { "&notinva;", 9, { 8713, 0 } },
+    { "&raemptyv;", 10, { 10675, 0 } },
+    { "&Vopf;", 6, { 120141, 0 } },
+    { "&ddagger;", 9, { 8225, 0 } },
+    { "&DD;", 4, { 8517, 0 } },
+    { "&Im;", 4, { 8465, 0 } },
+    { "&Gbreve;", 8, { 286, 0 } },
+    { "&rarrb;", 7, { 8677, 0 } },
+    { "&vnsup;", 7, { 8835, 8402 } },
+    { "&napprox;", 9, { 8777, 0 } },
+    { "&isins;", 7, { 8948, 0 } },
+    { "&bsol;", 6, { 92, 0 } },
+    { "&orslope;", 9, { 10839, 0 } },
+    { "&tscr;", 6, { 120009, 0 } },
+    { "&swarr;", 7, { 8601, 0 } },
+    { "&gtdot;", 7, { 8919, 0 } },
+    { "&yscr;", 6, { 120014, 0 } },
+    { "&emptyset;", 10, { 8709, 0 } },
+    { "&tstrok;", 8, { 359, 0 } },
+    { "&Phi;", 5, { 934, 0 } },
+    { "&hscr;", 6, { 119997, 0 } },
+    { "&capcup;", 8, { 10823, 0 } },
+    { "&smallsetminus;", 15, { 8726, 0 } },
+    { "&ntrianglerighteq;", 18, { 8941, 0 } },
+    { "&Iogon;", 7, { 302, 0 } },
+    { "&cupcap;", 8, { 10822, 0 } },
+    { "&mp;", 4, { 8723, 0 } },
+    { "&djcy;", 6, { 1106, 0 } },
+    { "&epsilon;", 9, { 949, 0 } },
+    { "&nspar;", 7, { 8742, 0 } },
+    { "&Proportional;", 14, { 8733, 0 } },
+    { "&NotReverseElement;", 19, { 8716, 0 } },
+    { "&Omega;", 7, { 937, 0 } },
+    { "&marker;", 8, { 9646, 0 } },
+    { "&rtrif;", 7, { 9656, 0 } },
+    { "&VeryThinSpace;", 15, { 8202, 0 } },
+    { "&ltcir;", 7, { 10873, 0 } },
+    { "&Gcirc;", 7, { 284, 0 } },
+    { "&cuesc;", 7, { 8927, 0 } },
+    { "&sung;", 6, { 9834, 0 } },
+    { "&numero;", 8, { 8470, 0 } },
+    { "&gcirc;", 7, { 285, 0 } },
+    { "&langle;", 8, { 10216, 0 } },
+    { "&pscr;", 6, { 120005, 0 } },
+    { "&nmid;", 6, { 8740, 0 } },
+    { "&Longleftarrow;", 15, { 10232, 0 } },
+    { "&UpTeeArrow;", 12, { 8613, 0 } },
+    { "&LeftRightVector;", 17, { 10574, 0 } },
+    { "&uscr;", 6, { 120010, 0 } },
+    { "&notniva;", 9, { 8716, 0 } },
+    { "&pointint;", 10, { 10773, 0 } },
+    { "&nges;", 6, { 10878, 824 } },
+    { "&RightUpVectorBar;", 18, { 10580, 0 } },
+    { "&leftrightsquigarrow;", 21, { 8621, 0 } },
+    { "&tdot;", 6, { 8411, 0 } },
+    { "&uarr;", 6, { 8593, 0 } },
+    { "&swarrow;", 9, { 8601, 0 } },
+    { "&bumpeq;", 8, { 8783, 0 } },
+    { "&succapprox;", 12, { 10936, 0 } },
+    { "&Eogon;", 7, { 280, 0 } },
+    { "&infintie;", 10, { 10717, 0 } },
+    { "&ltquest;", 9, { 10875, 0 } },
+    { "&efr;", 5, { 120098, 0 } },
+    { "&lessapprox;", 12, { 10885, 0 } },
+    { "&rppolint;", 10, { 10770, 0 } },
+    { "&Omacr;", 7, { 332, 0 } },
+    { "&ofr;", 5, { 120108, 0 } },
+    { "&dbkarow;", 9, { 10511, 0 } },
+    { "&eDot;", 6, { 8785, 0 } },
+    { "&larrpl;", 8, { 10553, 0 } },
+    { "&infin;", 7, { 8734, 0 } },
+    { "&laquo;", 7, { 171, 0 } },
+    { "&Nscr;", 6, { 119977, 0 } },
+    { "&lrm;", 5, { 8206, 0 } },
+    { "&NotSubset;", 11, { 8834, 8402 } },
+    { "&searrow;", 9, { 8600, 0 } },
+    { "&Aopf;", 6, { 120120, 0 } },
+    { "&male;", 6, { 9794, 0 } },
+    { "&nexists;", 9, { 8708, 0 } },
+    { "&ell;", 5, { 8467, 0 } },
+    { "&REG;", 5, { 174, 0 } },
+    { "&xdtri;", 7, { 9661, 0 } },
+    { "&cfr;", 5, { 120096, 0 } },
+    { "&napos;", 7, { 329, 0 } },
+    { "&cuwed;", 7, { 8911, 0 } },
+    { "&TildeFullEqual;", 16, { 8773, 0 } },
+    { "&scy;", 5, { 1089, 0 } },
+    { "&subsim;", 8, { 10951, 0 } },
+    { "&nsube;", 7, { 8840, 0 } },
+    { "&subplus;", 9, { 10943, 0 } },
+    { "&frac23;", 8, { 8532, 0 } },
+    { "&Aring;", 7, { 197, 0 } },
+    { "&Sum;", 5, { 8721, 0 } },
+    { "&prnE;", 6, { 10933, 0 } },
+    { "&kappa;", 7, { 954, 0 } },
+    { "&sqsub;", 7, { 8847, 0 } },
+    { "&uml;", 5, { 168, 0 } },
+    { "&lesssim;", 9, { 8818, 0 } },
+    { "&mfr;", 5, { 120106, 0 } },
+    { "&triangleq;", 11, { 8796, 0 } },
+    { "&lsquor;", 8, { 8218, 0 } },
+    { "&Xi;", 4, { 926, 0 } },
+    { "&plusb;", 7, { 8862, 0 } },
+    { "&precnapprox;", 13, { 10937, 0 } },
+    { "&varpi;", 7, { 982, 0 } },
+    { "&NotTilde;", 10, { 8769, 0 } },
+    { "&RuleDelayed;", 13, { 10740, 0 } },
+    { "&plankv;", 8, { 8463, 0 } },
+    { "&angmsdag;", 10, { 10670, 0 } },
+    { "&drbkarow;", 10, { 10512, 0 } },
+    { "&uharl;", 7, { 8639, 0 } },
+    { "&suplarr;", 9, { 10619, 0 } },
+    { "&lates;", 7, { 10925, 65024 } },
+    { "&equivDD;", 9, { 10872, 0 } },
+    { "&doteq;", 7, { 8784, 0 } },
+    { "&gtcc;", 6, { 10919, 0 } },
+    { "&iscr;", 6, { 119998, 0 } },
+    { "&boxHu;", 7, { 9575, 0 } },
+    { "&ouml;", 6, { 246, 0 } },
+    { "&cong;", 6, { 8773, 0 } },
+    { "&nsubseteqq;", 12, { 10949, 824 } },
+    { "&CirclePlus;", 12, { 8853, 0 } },
+    { "&inodot;", 8, { 305, 0 } },
+    { "&niv;", 5, { 8715, 0 } },
+    { "&gel;", 5, { 8923, 0 } },
+    { "&Jopf;", 6, { 120129, 0 } },
+    { "&loz;", 5, { 9674, 0 } },
+    { "&nvap;", 6, { 8781, 8402 } },
+    { "&rhard;", 7, { 8641, 0 } },
+    { "&sigmaf;", 8, { 962, 0 } },
+    { "&OverBracket;", 13, { 9140, 0 } },
+    { "&Ncaron;", 8, { 327, 0 } },
+    { "&image;", 7, { 8465, 0 } },
+    { "&geqslant;", 10, { 10878, 0 } },
+    { "&blacksquare;", 13, { 9642, 0 } },
+    { "&top;", 5, { 8868, 0 } },
+    { "&ndash;", 7, { 8211, 0 } },
+    { "&Scy;", 5, { 1057, 0 } },
+    { "&IJlig;", 7, { 306, 0 } },
+    { "&npreceq;", 9, { 10927, 824 } },
+    { "&rarr;", 6, { 8594, 0 } },
+    { "&supsetneqq;", 12, { 10956, 0 } },
+    { "&Uparrow;", 9, { 8657, 0 } },
+    { "&wedge;", 7, { 8743, 0 } },
+    { "&ContourIntegral;", 17, { 8750, 0 } },
+    { "&eDDot;", 7, { 10871, 0 } },
+    { "&omega;", 7, { 969, 0 } },
+    { "&gescc;", 7, { 10921, 0 } },
+    { "&jfr;", 5, { 120103, 0 } },
+    { "&ltlarr;", 8, { 10614, 0 } },
+    { "&rbrkslu;", 9, { 10640, 0 } },
+    { "&lopf;", 6, { 120157, 0 } },
+    { "&abreve;", 8, { 259, 0 } },
+    { "&daleth;", 8, { 8504, 0 } },
+    { "&exist;", 7, { 8707, 0 } },
+    { "&planck;", 8, { 8463, 0 } },
+    { "&ge;", 4, { 8805, 0 } },
+    { "&NotGreaterEqual;", 17, { 8817, 0 } },
+    { "&Egrave;", 8, { 200, 0 } },
+    { "&radic;", 7, { 8730, 0 } },
+    { "&NotCupCap;", 11, { 8813, 0 } },
+    { "&gammad;", 8, { 989, 0 } },
+    { "&ijlig;", 7, { 307, 0 } },
+    { "&scaron;", 8, { 353, 0 } },
+    { "&hArr;", 6, { 8660, 0 } },
+    { "&upsih;", 7, { 978, 0 } },
+    { "&LeftUpVectorBar;", 17, { 10584, 0 } },
+    { "&caps;", 6, { 8745, 65024 } },
+    { "&oelig;", 7, { 339, 0 } },
+    { "&parsl;", 7, { 11005, 0 } },
+    { "&supset;", 8, { 8835, 0 } },
+    { "&sopf;", 6, { 120164, 0 } },
+    { "&Element;", 9, { 8712, 0 } },
+    { "&mapstodown;", 12, { 8615, 0 } },
+    { "&capcap;", 8, { 10827, 0 } },
+    { "&lozenge;", 9, { 9674, 0 } },
+    { "&egs;", 5, { 10902, 0 } },
+    { "&shchcy;", 8, { 1097, 0 } },
+    { "&fnof;", 6, { 402, 0 } },
+    { "&boxvH;", 7, { 9578, 0 } },
+    { "&isinsv;", 8, { 8947, 0 } },
+    { "&nrtri;", 7, { 8939, 0 } },
+    { "&Rfr;", 5, { 8476, 0 } },
+    { "&oS;", 4, { 9416, 0 } },
+    { "&larrb;", 7, { 8676, 0 } },
+    { "&lsh;", 5, { 8624, 0 } },
+    { "&ogon;", 6, { 731, 0 } },
+    { "&rightharpoondown;", 18, { 8641, 0 } },
+    { "&ncaron;", 8, { 328, 0 } },
+    { "&osol;", 6, { 8856, 0 } },
+    { "&prap;", 6, { 10935, 0 } },
+    { "&vnsub;", 7, { 8834, 8402 } },
+    { "&rharul;", 8, { 10604, 0 } },
+    { "&OpenCurlyDoubleQuote;", 22, { 8220, 0 } },
+    { "&SquareSubsetEqual;", 19, { 8849, 0 } },
+    { "&Kcedil;", 8, { 310, 0 } },
+    { "&flat;", 6, { 9837, 0 } },
+    { "&LeftFloor;", 11, { 8970, 0 } },
+    { "&Lfr;", 5, { 120079, 0 } },
+    { "&Cross;", 7, { 10799, 0 } },
+    { "&eng;", 5, { 331, 0 } },
+    { "&lg;", 4, { 8822, 0 } },
+    { "&Ropf;", 6, { 8477, 0 } },
+    { "&RightArrow;", 12, { 8594, 0 } },
+    { "&bsolhsub;", 10, { 10184, 0 } },
+    { "&Ncy;", 5, { 1053, 0 } },
+    { "&backprime;", 11, { 8245, 0 } },
+    { "&lstrok;", 8, { 322, 0 } },
+    { "&qscr;", 6, { 120006, 0 } },
+    { "&nrarrc;", 8, { 10547, 824 } },
+    { "&LeftTriangle;", 14, { 8882, 0 } },
+    { "&intprod;", 9, { 10812, 0 } },
+    { "&Dcy;", 5, { 1044, 0 } },
+    { "&ulcorner;", 10, { 8988, 0 } },
+    { "&rbrack;", 8, { 93, 0 } },
+    { "&dashv;", 7, { 8867, 0 } },
+    { "&PrecedesEqual;", 15, { 10927, 0 } },
+    { "&Gfr;", 5, { 120074, 0 } },
+    { "&Uring;", 7, { 366, 0 } },
+    { "&imped;", 7, { 437, 0 } },
+    { "&wopf;", 6, { 120168, 0 } },
+    { "&gesdoto;", 9, { 10882, 0 } },
+    { "&dharl;", 7, { 8643, 0 } },
+    { "&becaus;", 8, { 8757, 0 } },
+    { "&suphsol;", 9, { 10185, 0 } },
+    { "&SuchThat;", 10, { 8715, 0 } },
+    { "&lcy;", 5, { 1083, 0 } },
+    { "&Yuml;", 6, { 376, 0 } },
+    { "&gneq;", 6, { 10888, 0 } },
+    { "&nLeftarrow;", 12, { 8653, 0 } },
+    { "&mcy;", 5, { 1084, 0 } },
+    { "&boxuL;", 7, { 9563, 0 } },
+    { "&trianglelefteq;", 16, { 8884, 0 } },
+    { "&lcub;", 6, { 123, 0 } },
+    { "&nleftarrow;", 12, { 8602, 0 } },
+    { "&approxeq;", 10, { 8778, 0 } },
+    { "&boxvL;", 7, { 9569, 0 } },
+    { "&pre;", 5, { 10927, 0 } },
+    { "&Dashv;", 7, { 10980, 0 } },
+    { "&omacr;", 7, { 333, 0 } },
+    { "&ratio;", 7, { 8758, 0 } },
+    { "&sqcups;", 8, { 8852, 65024 } },
+    { "&udblac;", 8, { 369, 0 } },
+    { "&ultri;", 7, { 9720, 0 } },
+    { "&DownLeftVectorBar;", 19, { 10582, 0 } },
+    { "&Icy;", 5, { 1048, 0 } },
+    { "&rdquo;", 7, { 8221, 0 } },
+    { "&Gcy;", 5, { 1043, 0 } },
+    { "&lArr;", 6, { 8656, 0 } },
+    { "&xotime;", 8, { 10754, 0 } },
+    { "&ltrPar;", 8, { 10646, 0 } },
+    { "&NonBreakingSpace;", 18, { 160, 0 } },
+    { "&lsime;", 7, { 10893, 0 } },
+    { "&ycy;", 5, { 1099, 0 } },
+    { "&varsubsetneqq;", 15, { 10955, 65024 } },
+    { "&notni;", 7, { 8716, 0 } },
+    { "&nsucceq;", 9, { 10928, 824 } },
+    { "&ohbar;", 7, { 10677, 0 } },
+    { "&rightsquigarrow;", 17, { 8605, 0 } },
+    { "&ngeqslant;", 11, { 10878, 824 } },
+    { "&MediumSpace;", 13, { 8287, 0 } },
+    { "&Ecaron;", 8, { 282, 0 } },
+    { "&Sqrt;", 6, { 8730, 0 } },
+    { "&gnapprox;", 10, { 10890, 0 } },
+    { "&filig;", 7, { 64257, 0 } },
+    { "&esim;", 6, { 8770, 0 } },
+    { "&Bscr;", 6, { 8492, 0 } },
+    { "&RightTee;", 10, { 8866, 0 } },
+    { "&DownTee;", 9, { 8868, 0 } },
+    { "&upsilon;", 9, { 965, 0 } },
+    { "&capbrcup;", 10, { 10825, 0 } },
+    { "&cup;", 5, { 8746, 0 } },
+    { "&phi;", 5, { 966, 0 } },
+    { "&rHar;", 6, { 10596, 0 } },
+    { "&grave;", 7, { 96, 0 } },
+    { "&thorn;", 7, { 254, 0 } },
+    { "&ii;", 4, { 8520, 0 } },
+    { "&NotLessLess;", 13, { 8810, 824 } },
+    { "&succsim;", 9, { 8831, 0 } },
+    { "&NegativeVeryThinSpace;", 23, { 8203, 0 } },
+    { "&Ntilde;", 8, { 209, 0 } },
+    { "&uring;", 7, { 367, 0 } },
+    { "&Itilde;", 8, { 296, 0 } },
+    { "&profsurf;", 10, { 8979, 0 } },
+    { "&nle;", 5, { 8816, 0 } },
+    { "&ssmile;", 8, { 8995, 0 } },
+    { "&frac78;", 8, { 8542, 0 } },
+    { "&supnE;", 7, { 10956, 0 } },
+    { "&ngeq;", 6, { 8817, 0 } },
+    { "&uHar;", 6, { 10595, 0 } },
+    { "&RightUpVector;", 15, { 8638, 0 } },
+    { "&cupdot;", 8, { 8845, 0 } },
+    { "&gla;", 5, { 10917, 0 } },
+    { "&range;", 7, { 10661, 0 } },
+    { "&RightDownTeeVector;", 20, { 10589, 0 } },
+    { "&boxvh;", 7, { 9532, 0 } },
+    { "&Omicron;", 9, { 927, 0 } },
+    { "&frac34;", 8, { 190, 0 } },
+    { "&minusd;", 8, { 8760, 0 } },
+    { "&ycirc;", 7, { 375, 0 } },
+    { "&gap;", 5, { 10886, 0 } },
+    { "&realpart;", 10, { 8476, 0 } },
+    { "&xcirc;", 7, { 9711, 0 } },
+    { "&umacr;", 7, { 363, 0 } },
+    { "&lagran;", 8, { 8466, 0 } },
+    { "&ordm;", 6, { 186, 0 } },
+    { "&aleph;", 7, { 8501, 0 } },
+    { "&Upsilon;", 9, { 933, 0 } },
+    { "&NotLessEqual;", 14, { 8816, 0 } },
+    { "&Rarrtl;", 8, { 10518, 0 } },
+    { "&wcirc;", 7, { 373, 0 } },
+    { "&csube;", 7, { 10961, 0 } },
+    { "&Sub;", 5, { 8912, 0 } },
+    { "&acd;", 5, { 8767, 0 } },
+    { "&LongLeftArrow;", 15, { 10229, 0 } },
+    { "&Poincareplane;", 15, { 8460, 0 } },
+    { "&NotSquareSupersetEqual;", 24, { 8931, 0 } },
+    { "&Bfr;", 5, { 120069, 0 } },
+    { "&ncy;", 5, { 1085, 0 } },
+    { "&Epsilon;", 9, { 917, 0 } },
+    { "&yicy;", 6, { 1111, 0 } },
+    { "&micro;", 7, { 181, 0 } },
+    { "&xodot;", 7, { 10752, 0 } },
+    { "&ocir;", 6, { 8858, 0 } },
+    { "&nvDash;", 8, { 8877, 0 } },
+    { "&Vfr;", 5, { 120089, 0 } },
+    { "&Coproduct;", 11, { 8720, 0 } },
+    { "&rcub;", 6, { 125, 0 } },
+    { "&copysr;", 8, { 8471, 0 } },
+    { "&YUcy;", 6, { 1070, 0 } },
+    { "&ast;", 5, { 42, 0 } },
+    { "&NotElement;", 12, { 8713, 0 } },
+    { "&angmsd;", 8, { 8737, 0 } },
+    { "&Yacute;", 8, { 221, 0 } },
+    { "&gesles;", 8, { 10900, 0 } },
+    { "&nlarr;", 7, { 8602, 0 } },
+    { "&nrarrw;", 8, { 8605, 824 } },
+    { "&Aacute;", 8, { 193, 0 } },
+    { "&ClockwiseContourIntegral;", 26, { 8754, 0 } },
+    { "&gcy;", 5, { 1075, 0 } },
+    { "&Rcedil;", 8, { 342, 0 } },
+    { "&succnsim;", 10, { 8937, 0 } },
+    { "&KJcy;", 6, { 1036, 0 } },
+    { "&realine;", 9, { 8475, 0 } },
+    { "&loplus;", 8, { 10797, 0 } },
+    { "&Darr;", 6, { 8609, 0 } },
+    { "&uuml;", 6, { 252, 0 } },
+    { "&ldsh;", 6, { 8626, 0 } },
+    { "&tscy;", 6, { 1094, 0 } },
+    { "&midcir;", 8, { 10992, 0 } },
+    { "&llarr;", 7, { 8647, 0 } },
+    { "&nlArr;", 7, { 8653, 0 } },
+    { "&Leftrightarrow;", 16, { 8660, 0 } },
+    { "&rang;", 6, { 10217, 0 } },
+    { "&orderof;", 9, { 8500, 0 } },
+    { "&lesg;", 6, { 8922, 65024 } },
+    { "&angsph;", 8, { 8738, 0 } },
+    { "&ltcc;", 6, { 10918, 0 } },
+    { "&subsup;", 8, { 10963, 0 } },
+    { "&blank;", 7, { 9251, 0 } },
+    { "&nrarr;", 7, { 8603, 0 } },
+    { "&ascr;", 6, { 119990, 0 } },
+    { "&omicron;", 9, { 959, 0 } },
+    { "&vscr;", 6, { 120011, 0 } },
+    { "&lesdoto;", 9, { 10881, 0 } },
+    { "&zscr;", 6, { 120015, 0 } },
+    { "&ngsim;", 7, { 8821, 0 } },
+    { "&prE;", 5, { 10931, 0 } },
+    { "&boxv;", 6, { 9474, 0 } },
+    { "&Abreve;", 8, { 258, 0 } },
+    { "&rarrlp;", 8, { 8620, 0 } },
+    { "&dscy;", 6, { 1109, 0 } },
+    { "&boxDl;", 7, { 9558, 0 } },
+    { "&Uogon;", 7, { 370, 0 } },
+    { "&timesbar;", 10, { 10801, 0 } },
+    { "&khcy;", 6, { 1093, 0 } },
+    { "&Scaron;", 8, { 352, 0 } },
+    { "&preccurlyeq;", 13, { 8828, 0 } },
+    { "&sigma;", 7, { 963, 0 } },
+    { "&sdote;", 7, { 10854, 0 } },
+    { "&Tcy;", 5, { 1058, 0 } },
+    { "&trpezium;", 10, { 9186, 0 } },
+    { "&Mu;", 4, { 924, 0 } },
+    { "&wp;", 4, { 8472, 0 } },
+    { "&Mfr;", 5, { 120080, 0 } },
+    { "&equest;", 8, { 8799, 0 } },
+    { "&ordf;", 6, { 170, 0 } },
+    { "&Proportion;", 12, { 8759, 0 } },
+    { "&Ecirc;", 7, { 202, 0 } },
+    { "&frac38;", 8, { 8540, 0 } },
+    { "&cire;", 6, { 8791, 0 } },
+    { "&longmapsto;", 12, { 10236, 0 } },
+    { "&nwarr;", 7, { 8598, 0 } },
+    { "&CHcy;", 6, { 1063, 0 } },
+    { "&reg;", 5, { 174, 0 } },
+    { "&nsc;", 5, { 8833, 0 } },
+    { "&dsol;", 6, { 10742, 0 } },
+    { "&lessdot;", 9, { 8918, 0 } },
+    { "&Lt;", 4, { 8810, 0 } },
+    { "&rhov;", 6, { 1009, 0 } },
+    { "&Jsercy;", 8, { 1032, 0 } },
+    { "&zcaron;", 8, { 382, 0 } },
+    { "&bot;", 5, { 8869, 0 } },
+    { "&sqsupset;", 10, { 8848, 0 } },
+    { "&tritime;", 9, { 10811, 0 } },
+    { "&ocirc;", 7, { 244, 0 } },
+    { "&veeeq;", 7, { 8794, 0 } },
+    { "&lmoustache;", 12, { 9136, 0 } },
+    { "&Ucy;", 5, { 1059, 0 } },
+    { "&circ;", 6, { 710, 0 } },
+    { "&InvisibleTimes;", 16, { 8290, 0 } },
+    { "&rlarr;", 7, { 8644, 0 } },
+    { "&SHcy;", 6, { 1064, 0 } },
+    { "&naturals;", 10, { 8469, 0 } },
+    { "&doublebarwedge;", 16, { 8966, 0 } },
+    { "&Lopf;", 6, { 120131, 0 } },
+    { "&Iota;", 6, { 921, 0 } },
+    { "&xscr;", 6, { 120013, 0 } },
+    { "&Lmidot;", 8, { 319, 0 } },
+    { "&questeq;", 9, { 8799, 0 } },
+    { "&nvdash;", 8, { 8876, 0 } },
+    { "&bigcap;", 8, { 8898, 0 } },
+    { "&plus;", 6, { 43, 0 } },
+    { "&hamilt;", 8, { 8459, 0 } },
+    { "&xlArr;", 7, { 10232, 0 } },
+    { "&prsim;", 7, { 8830, 0 } },
+    { "&commat;", 8, { 64, 0 } },
+    { "&Vscr;", 6, { 119985, 0 } },
+    { "&LongRightArrow;", 16, { 10230, 0 } },
+    { "&DiacriticalDot;", 16, { 729, 0 } },
+    { "&longleftarrow;", 15, { 10229, 0 } },
+    { "&HorizontalLine;", 16, { 9472, 0 } },
+    { "&odsold;", 8, { 10684, 0 } },
+    { "&Colone;", 8, { 10868, 0 } },
+    { "&hairsp;", 8, { 8202, 0 } },
+    { "&Pfr;", 5, { 120083, 0 } },
+    { "&isinv;", 7, { 8712, 0 } },
+    { "&iota;", 6, { 953, 0 } },
+    { "&zfr;", 5, { 120119, 0 } },
+    { "&nopf;", 6, { 120159, 0 } },
+    { "&pluscir;", 9, { 10786, 0 } },
+    { "&topfork;", 9, { 10970, 0 } },
+    { "&fork;", 6, { 8916, 0 } },
+    { "&andd;", 6, { 10844, 0 } },
+    { "&frac56;", 8, { 8538, 0 } },
+    { "&CounterClockwiseContourIntegral;", 33, { 8755, 0 } },
+    { "&target;", 8, { 8982, 0 } },
+    { "&supe;", 6, { 8839, 0 } },
+    { "&kappav;", 8, { 1008, 0 } },
+    { "&odblac;", 8, { 337, 0 } },
+    { "&wfr;", 5, { 120116, 0 } },
+    { "&twoheadrightarrow;", 19, { 8608, 0 } },
+    { "&Or;", 4, { 10836, 0 } },
+    { "&RightTeeArrow;", 15, { 8614, 0 } },
+    { "&ShortRightArrow;", 17, { 8594, 0 } },
+    { "&boxh;", 6, { 9472, 0 } },
+    { "&DownLeftTeeVector;", 19, { 10590, 0 } },
+    { "&sqsup;", 7, { 8848, 0 } },
+    { "&subsetneq;", 11, { 8842, 0 } },
+    { "&ange;", 6, { 10660, 0 } },
+    { "&olarr;", 7, { 8634, 0 } },
+    { "&rsqb;", 6, { 93, 0 } },
+    { "&mapstoleft;", 12, { 8612, 0 } },
+    { "&xfr;", 5, { 120117, 0 } },
+    { "&lrcorner;", 10, { 8991, 0 } },
+    { "&FilledVerySmallSquare;", 23, { 9642, 0 } },
+    { "&hookrightarrow;", 16, { 8618, 0 } },
+    { "&lt;", 4, { 60, 0 } },
+    { "&vsupne;", 8, { 8843, 65024 } },
+    { "&plusacir;", 10, { 10787, 0 } },
+    { "&ltri;", 6, { 9667, 0 } },
+    { "&sbquo;", 7, { 8218, 0 } },
+    { "&eta;", 5, { 951, 0 } },
+    { "&zcy;", 5, { 1079, 0 } },
+    { "&smte;", 6, { 10924, 0 } },
+    { "&sqsubseteq;", 12, { 8849, 0 } },
+    { "&chcy;", 6, { 1095, 0 } },
+    { "&nshortmid;", 11, { 8740, 0 } },
+    { "&imagline;", 10, { 8464, 0 } },
+    { "&gt;", 4, { 62, 0 } },
+    { "&Bcy;", 5, { 1041, 0 } },
+    { "&clubsuit;", 10, { 9827, 0 } },
+    { "&barwed;", 8, { 8965, 0 } },
+    { "&ncedil;", 8, { 326, 0 } },
+    { "&beta;", 6, { 946, 0 } },
+    { "&it;", 4, { 8290, 0 } },
+    { "&nwarrow;", 9, { 8598, 0 } },
+    { "&updownarrow;", 13, { 8597, 0 } },
+    { "&vert;", 6, { 124, 0 } },
+    { "&intlarhk;", 10, { 10775, 0 } },
+    { "&varepsilon;", 12, { 1013, 0 } },
+    { "&vopf;", 6, { 120167, 0 } },
+    { "&int;", 5, { 8747, 0 } },
+    { "&thksim;", 8, { 8764, 0 } },
+    { "&isindot;", 9, { 8949, 0 } },
+    { "&dlcrop;", 8, { 8973, 0 } },
+    { "&OverParenthesis;", 17, { 9180, 0 } },
+    { "&acirc;", 7, { 226, 0 } },
+    { "&upharpoonright;", 16, { 8638, 0 } },
+    { "&Imacr;", 7, { 298, 0 } },
+    { "&varkappa;", 10, { 1008, 0 } },
+    { "&atilde;", 8, { 227, 0 } },
+    { "&ofcir;", 7, { 10687, 0 } },
+    { "&larrsim;", 9, { 10611, 0 } },
+    { "&divide;", 8, { 247, 0 } },
+    { "&nisd;", 6, { 8954, 0 } },
+    { "&DoubleLeftArrow;", 17, { 8656, 0 } },
+    { "&blk12;", 7, { 9618, 0 } },
+    { "&UpArrow;", 9, { 8593, 0 } },
+    { "&NotCongruent;", 14, { 8802, 0 } },
+    { "&roarr;", 7, { 8702, 0 } },
+    { "&beth;", 6, { 8502, 0 } },
+    { "&nLeftrightarrow;", 17, { 8654, 0 } },
+    { "&map;", 5, { 8614, 0 } },
+    { "&zhcy;", 6, { 1078, 0 } },
+    { "&dlcorn;", 8, { 8990, 0 } },
+    { "&IEcy;", 6, { 1045, 0 } },
+    { "&sstarf;", 8, { 8902, 0 } },
+    { "&Agrave;", 8, { 192, 0 } },
+    { "&nsqsube;", 9, { 8930, 0 } },
+    { "&Diamond;", 9, { 8900, 0 } },
+    { "&UnderBrace;", 12, { 9183, 0 } },
+    { "&COPY;", 6, { 169, 0 } },
+    { "&CircleTimes;", 13, { 8855, 0 } },
+    { "&succneqq;", 10, { 10934, 0 } },
+    { "&scedil;", 8, { 351, 0 } },
+    { "&acy;", 5, { 1072, 0 } },
+    { "&itilde;", 8, { 297, 0 } }
 };
 
-static int
-entity_cmp(const void* p_key, const void* p_entity)
-{
-    struct entity_key* key = (struct entity_key*) p_key;
-    struct entity* ent = (struct entity*) p_entity;
 
-    return strncmp(key->name, ent->name, key->name_size);
+static unsigned
+entity_mix(unsigned h)
+{
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
 }
 
 const struct entity*
 entity_lookup(const char* name, size_t name_size)
 {
-    struct entity_key key = { name, name_size };
+    const struct entity* ent;
+    unsigned h = 0x811c9dc5;
+    size_t i;
+
+    /* FNV-1a hash of the name selects a seed which, mixed into the hash,
+     * selects the only entity the name may be. */
+    for(i = 0; i < name_size; i++)
+        h = (h ^ (unsigned char) name[i]) * 0x01000193;
+    h = entity_mix(h ^ ENTITY_MAP_SEED[h % ENTITY_MAP_SEED_COUNT]);
+    ent = &ENTITY_MAP[h % ENTITY_MAP_SIZE];
 
-    return bsearch(&key,
-                   entity_table,
-                   sizeof(entity_table) / sizeof(entity_table[0]),
-                   sizeof(struct entity),
-                   entity_cmp);
+    if(ent->name_size != name_size  ||  memcmp(ent->name, name, name_size) != 0)
+        return NULL;
+    return ent;
 }
@@ -33,6 +33,7 @@
  * Single-codepoint entities have codepoints[1] set to zero. */
 struct entity {
     const char* name;
+    unsigned name_size;
     unsigned codepoints[2];
 };
 
@@ -24,10 +24,10 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "md4c-html.h"
-#include "entity.h"
 
 
 #if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 199409L
@@ -45,8 +45,45 @@
     #define snprintf _snprintf
 #endif
 
+/* Suppress "unused parameter" warnings. */
+#define MD_UNUSED(x)                ((void)x)
+
+/* SIMD support for finding what needs escaping. Define MD4C_NO_SIMD to
+ * disable it altogether. */
+#if !defined MD4C_NO_SIMD  &&  !defined MD4C_USE_UTF16
+    #if defined __SSE2__  ||  defined _M_X64  ||  (defined _M_IX86_FP  &&  _M_IX86_FP >= 2)
+        #define MD_SIMD_SSE2        1
+        #include <emmintrin.h>
+    #endif
+    #if defined __SSSE3__  ||  defined __AVX__
+        #define MD_SIMD_SSSE3       1
+        #include <tmmintrin.h>
+    #endif
+    #if defined __AVX2__
+        #define MD_SIMD_AVX2        1
+        #include <immintrin.h>
+    #endif
+#endif
+
+#if defined MD_SIMD_SSE2
+    #if defined __GNUC__
+        #define md_ctz(x)           ((unsigned) __builtin_ctz(x))
+    #elif defined _MSC_VER
+        #include <intrin.h>
+        static inline unsigned
+        md_ctz(unsigned x)
+        {
+            unsigned long index;
+            _BitScanForward(&index, x);
+            return (unsigned) index;
+        }
+    #endif
+#endif
 
 
+
+typedef struct MD_HTML_SEGMENT_BUILD_tag MD_HTML_SEGMENT_BUILD;
+
 typedef struct MD_HTML_tag MD_HTML;
 struct MD_HTML_tag {
     void (*process_output)(const MD_CHAR*, MD_SIZE, void*);
@@ -54,11 +91,38 @@ struct MD_HTML_tag {
     unsigned flags;
     int image_nesting_level;
     char escape_map[256];
+
+    /* Write-combining buffer for the output (out_alloc is zero if the output
+     * is not buffered). With out_fixed, it is the caller's buffer of
+     * md_html_to_buffer() which is never flushed: Once it is full, the rest of
+     * the output goes directly to process_output(). */
+    MD_CHAR* out_buf;
+    MD_SIZE out_size;
+    MD_SIZE out_alloc;
+    int out_fixed;
+
+    /* For md_html_to_segments(), out_buf is the current chunk of the arena.
+     * See render_segment(). */
+    MD_HTML_SEGMENT_BUILD* seg;
+
+#if defined MD_SIMD_SSSE3
+    /* Nibble tables for PSHUFB: An ASCII byte needs escaping in URL iff
+     * (url_lo_nibbles[byte & 0xf] & url_hi_nibbles[byte >> 4]) != 0.
+     * (Any non-ASCII byte needs it.) */
+    unsigned char url_lo_nibbles[16];
+    unsigned char url_hi_nibbles[16];
+#endif
 };
 
 #define NEED_HTML_ESC_FLAG   0x1
 #define NEED_URL_ESC_FLAG    0x2
 
+/* Some characters need to be escaped in normal HTML text. */
+#define NEED_HTML_ESC(ch)   (r->escape_map[(unsigned char)(ch)] & NEED_HTML_ESC_FLAG)
+
+/* Some characters need to be escaped in URL attributes. */
+#define NEED_URL_ESC(ch)    (r->escape_map[(unsigned char)(ch)] & NEED_URL_ESC_FLAG)
+
 
 /*****************************************
  ***  HTML rendering helper functions  ***
@@ -70,10 +134,59 @@ struct MD_HTML_tag {
 #define ISALNUM(ch)     (ISLOWER(ch) || ISUPPER(ch) || ISDIGIT(ch))
 
 
+static void
+render_flush(MD_HTML* r)
+{
+    if(r->out_size > 0  &&  !r->out_fixed) {
+        r->process_output(r->out_buf, r->out_size, r->userdata);
+        r->out_size = 0;
+    }
+}
+
+static void render_segment(MD_HTML* r, const MD_CHAR* text, MD_SIZE size);
+
+static void
+render_verbatim_slow(MD_HTML* r, const MD_CHAR* text, MD_SIZE size)
+{
+    if(r->seg != NULL) {
+        render_segment(r, text, size);
+        return;
+    }
+
+    if(r->out_fixed) {
+        MD_SIZE n = r->out_alloc - r->out_size;
+
+        if(n > size)
+            n = size;
+        if(n > 0) {
+            memcpy(r->out_buf + r->out_size, text, n);
+            r->out_size += n;
+        }
+        if(n < size)
+            r->process_output(text + n, size - n, r->userdata);
+        return;
+    }
+
+    render_flush(r);
+
+    if(size < r->out_alloc) {
+        memcpy(r->out_buf, text, size);
+        r->out_size = size;
+    } else {
+        /* Too big to be worth copying. */
+        r->process_output(text, size, r->userdata);
+    }
+}
+
 static inline void
 render_verbatim(MD_HTML* r, const MD_CHAR* text, MD_SIZE size)
 {
-    r->process_output(text, size, r->userdata);
+    if(size < r->out_alloc - r->out_size) {
+        memcpy(r->out_buf + r->out_size, text, size);
+        r->out_size += size;
+    } else {
+        render_verbatim_slow(r, text, size);
+    }
 }
 
 /* Keep this as a macro. Most compiler should then be smart enough to replace
@@ -82,22 +195,152 @@ render_verbatim(MD_HTML* r, const MD_CHAR* text, MD_SIZE size)
         render_verbatim((r), (verbatim), (MD_SIZE) (strlen(verbatim)))
 
 
+/* Find the next character which needs HTML escaping (or the end). */
+static inline MD_OFFSET
+skip_html_safe(MD_HTML* r, const MD_CHAR* data, MD_OFFSET off, MD_SIZE size)
+{
+#if defined MD_SIMD_SSE2
+    /* Only '"' (0x22), '&' (0x26), '<' (0x3c) and '>' (0x3e) need it, i.e.
+     * a byte does iff (byte | 0x04) == '&' or (byte | 0x02) == '>'. And so
+     * does '\0' (strchr() in md_html_ex() matches the terminator) which is
+     * then dropped. This has to be kept in sync with the NEED_HTML_ESC_FLAG
+     * in md_html_ex(). */
+#if defined MD_SIMD_AVX2
+    {
+        const __m256i bit2 = _mm256_set1_epi8(0x04);
+        const __m256i bit1 = _mm256_set1_epi8(0x02);
+        const __m256i amp = _mm256_set1_epi8('&');
+        const __m256i gt = _mm256_set1_epi8('>');
+        const __m256i zero = _mm256_setzero_si256();
+
+        while(off + 32 <= size) {
+            __m256i v = _mm256_loadu_si256((const __m256i*) (data + off));
+            __m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_or_si256(v, bit2), amp),
+                                          _mm256_cmpeq_epi8(_mm256_or_si256(v, bit1), gt));
+            hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(v, zero));
+            unsigned mask = (unsigned) _mm256_movemask_epi8(hit);
+
+            if(mask != 0)
+                return off + md_ctz(mask);
+            off += 32;
+        }
+    }
+#endif
+    {
+        const __m128i bit2 = _mm_set1_epi8(0x04);
+        const __m128i bit1 = _mm_set1_epi8(0x02);
+        const __m128i amp = _mm_set1_epi8('&');
+        const __m128i gt = _mm_set1_epi8('>');
+        const __m128i zero = _mm_setzero_si128();
+
+        while(off + 16 <= size) {
+            __m128i v = _mm_loadu_si128((const __m128i*) (data + off));
+            __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(_mm_or_si128(v, bit2), amp),
+                                       _mm_cmpeq_epi8(_mm_or_si128(v, bit1), gt));
+            hit = _mm_or_si128(hit, _mm_cmpeq_epi8(v, zero));
+            unsigned mask = (unsigned) _mm_movemask_epi8(hit);
+
+            if(mask != 0)
+                return off + md_ctz(mask);
+            off += 16;
+        }
+    }
+#endif
+
+    /* Optimization: Use some loop unrolling. */
+    while(off + 3 < size  &&  !NEED_HTML_ESC(data[off+0])  &&  !NEED_HTML_ESC(data[off+1])
+                          &&  !NEED_HTML_ESC(data[off+2])  &&  !NEED_HTML_ESC(data[off+3]))
+        off += 4;
+    while(off < size  &&  !NEED_HTML_ESC(data[off]))
+        off++;
+    return off;
+}
+
+/* Find the next character which needs URL escaping (or the end). */
+static inline MD_OFFSET
+skip_url_safe(MD_HTML* r, const MD_CHAR* data, MD_OFFSET off, MD_SIZE size)
+{
+#if defined MD_SIMD_SSSE3
+    {
+        const __m128i lo_tbl = _mm_loadu_si128((const __m128i*) r->url_lo_nibbles);
+        const __m128i hi_tbl = _mm_loadu_si128((const __m128i*) r->url_hi_nibbles);
+        const __m128i nibble_mask = _mm_set1_epi8(0x0f);
+#if defined MD_SIMD_AVX2
+        const __m256i lo_tbl2 = _mm256_broadcastsi128_si256(lo_tbl);
+        const __m256i hi_tbl2 = _mm256_broadcastsi128_si256(hi_tbl);
+        const __m256i nibble_mask2 = _mm256_set1_epi8(0x0f);
+
+        while(off + 32 <= size) {
+            __m256i v = _mm256_loadu_si256((const __m256i*) (data + off));
+            __m256i lo = _mm256_shuffle_epi8(lo_tbl2, _mm256_and_si256(v, nibble_mask2));
+            __m256i hi = _mm256_shuffle_epi8(hi_tbl2, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble_mask2));
+            __m256i safe = _mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256());
+            /* (Bytes >= 0x80 are caught by the sign bit.) */
+            unsigned mask = ~(unsigned) _mm256_movemask_epi8(safe) | (unsigned) _mm256_movemask_epi8(v);
+
+            if(mask != 0)
+                return off + md_ctz(mask);
+            off += 32;
+        }
+#endif
+        while(off + 16 <= size) {
+            __m128i v = _mm_loadu_si128((const __m128i*) (data + off));
+            __m128i lo = _mm_shuffle_epi8(lo_tbl, _mm_and_si128(v, nibble_mask));
+            __m128i hi = _mm_shuffle_epi8(hi_tbl, _mm_and_si128(_mm_srli_epi16(v, 4), nibble_mask));
+            __m128i safe = _mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128());
+            /* (Bytes >= 0x80 are caught by the sign bit.) */
+            unsigned mask = (~(unsigned) _mm_movemask_epi8(safe) | (unsigned) _mm_movemask_epi8(v)) & 0xffff;
+
+            if(mask != 0)
+                return off + md_ctz(mask);
+            off += 16;
+        }
+    }
+#elif defined MD_SIMD_SSE2
+    {
+        /* ASCII alphanumerics never need escaping. Check the rest in
+         * escape_map[]. */
+        const __m128i case_bit = _mm_set1_epi8(0x20);
+        const __m128i before_a = _mm_set1_epi8('a' - 1);
+        const __m128i after_z = _mm_set1_epi8('z' + 1);
+        const __m128i before_0 = _mm_set1_epi8('0' - 1);
+        const __m128i after_9 = _mm_set1_epi8('9' + 1);
+
+        while(off + 16 <= size) {
+            __m128i v = _mm_loadu_si128((const __m128i*) (data + off));
+            __m128i lower = _mm_or_si128(v, case_bit);
+            __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, before_a), _mm_cmplt_epi8(lower, after_z));
+            __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, before_0), _mm_cmplt_epi8(v, after_9));
+            unsigned mask = ~(unsigned) _mm_movemask_epi8(_mm_or_si128(alpha, digit)) & 0xffff;
+
+            while(mask != 0) {
+                unsigned i = md_ctz(mask);
+                if(NEED_URL_ESC(data[off + i]))
+                    return off + i;
+                mask &= mask - 1;
+            }
+            off += 16;
+        }
+    }
+#endif
+
+    /* Optimization: Use some loop unrolling. */
+    while(off + 3 < size  &&  !NEED_URL_ESC(data[off+0])  &&  !NEED_URL_ESC(data[off+1])
+                          &&  !NEED_URL_ESC(data[off+2])  &&  !NEED_URL_ESC(data[off+3]))
+        off += 4;
+    while(off < size  &&  !NEED_URL_ESC(data[off]))
+        off++;
+    return off;
+}
+
 static void
 render_html_escaped(MD_HTML* r, const MD_CHAR* data, MD_SIZE size)
 {
     MD_OFFSET beg = 0;
     MD_OFFSET off = 0;
 
-    /* Some characters need to be escaped in normal HTML text. */
-    #define NEED_HTML_ESC(ch)   (r->escape_map[(unsigned char)(ch)] & NEED_HTML_ESC_FLAG)
-
     while(1) {
-        /* Optimization: Use some loop unrolling. */
-        while(off + 3 < size  &&  !NEED_HTML_ESC(data[off+0])  &&  !NEED_HTML_ESC(data[off+1])
-                              &&  !NEED_HTML_ESC(data[off+2])  &&  !NEED_HTML_ESC(data[off+3]))
-            off += 4;
-        while(off < size  &&  !NEED_HTML_ESC(data[off]))
-            off++;
+        off = skip_html_safe(r, data, off, size);
 
         if(off > beg)
             render_verbatim(r, data + beg, off - beg);
@@ -124,12 +367,8 @@ render_url_escaped(MD_HTML* r, const MD_CHAR* data, MD_SIZE size)
     MD_OFFSET beg = 0;
     MD_OFFSET off = 0;
 
-    /* Some characters need to be escaped in URL attributes. */
-    #define NEED_URL_ESC(ch)    (r->escape_map[(unsigned char)(ch)] & NEED_URL_ESC_FLAG)
-
     while(1) {
-        while(off < size  &&  !NEED_URL_ESC(data[off]))
-            off++;
+        off = skip_url_safe(r, data, off, size);
         if(off > beg)
             render_verbatim(r, data + beg, off - beg);
 
@@ -154,17 +393,6 @@ render_url_escaped(MD_HTML* r, const MD_CHAR* data, MD_SIZE size)
     }
 }
 
-static unsigned
-hex_val(char ch)
-{
-    if('0' <= ch && ch <= '9')
-        return ch - '0';
-    if('A' <= ch && ch <= 'Z')
-        return ch - 'A' + 10;
-    else
-        return ch - 'a' + 10;
-}
-
 static void
 render_utf8_codepoint(MD_HTML* r, unsigned codepoint,
                       void (*fn_append)(MD_HTML*, const MD_CHAR*, MD_SIZE))
@@ -201,48 +429,40 @@ render_utf8_codepoint(MD_HTML* r, unsigned codepoint,
 }
 
 /* Translate entity to its UTF-8 equivalent, or output the verbatim one
- * if such entity is unknown (or if the translation is disabled). */
+ * if such entity is unknown. */
 static void
-render_entity(MD_HTML* r, const MD_CHAR* text, MD_SIZE size,
-              void (*fn_append)(MD_HTML*, const MD_CHAR*, MD_SIZE))
+render_decoded_entity(MD_HTML* r, const MD_CHAR* text, MD_SIZE size, const MD_ENTITY_DETAIL* detail,
+                      void (*fn_append)(MD_HTML*, const MD_CHAR*, MD_SIZE))
 {
-    if(r->flags & MD_HTML_FLAG_VERBATIM_ENTITIES) {
-        render_verbatim(r, text, size);
+    unsigned i;
+
+    if(detail->n_codepoints == 0) {
+        fn_append(r, text, size);
         return;
     }
 
     /* We assume UTF-8 output is what is desired. */
-    if(size > 3 && text[1] == '#') {
-        unsigned codepoint = 0;
-
-        if(text[2] == 'x' || text[2] == 'X') {
-            /* Hexadecimal entity (e.g. "&#x1234abcd;")). */
-            MD_SIZE i;
-            for(i = 3; i < size-1; i++)
-                codepoint = 16 * codepoint + hex_val(text[i]);
-        } else {
-            /* Decimal entity (e.g. "&1234;") */
-            MD_SIZE i;
-            for(i = 2; i < size-1; i++)
-                codepoint = 10 * codepoint + (text[i] - '0');
-        }
+    for(i = 0; i < detail->n_codepoints; i++)
+        render_utf8_codepoint(r, detail->codepoints[i], fn_append);
+}
+
+/* Same for an entity we have no MD_ENTITY_DETAIL for (or if the translation
+ * is disabled). */
+static void
+render_entity(MD_HTML* r, const MD_CHAR* text, MD_SIZE size,
+              void (*fn_append)(MD_HTML*, const MD_CHAR*, MD_SIZE))
+{
+    MD_ENTITY_DETAIL detail;
 
-        render_utf8_codepoint(r, codepoint, fn_append);
+    if(r->flags & MD_HTML_FLAG_VERBATIM_ENTITIES) {
+        render_verbatim(r, text, size);
         return;
-    } else {
-        /* Named entity (e.g. "&nbsp;"). */
-        const struct entity* ent;
-
-        ent = entity_lookup(text, size);
-        if(ent != NULL) {
-            render_utf8_codepoint(r, ent->codepoints[0], fn_append);
-            if(ent->codepoints[1])
-                render_utf8_codepoint(r, ent->codepoints[1], fn_append);
-            return;
-        }
     }
 
-    fn_append(r, text, size);
+    if(md_decode_entity(text, size, &detail) == 0)
+        render_decoded_entity(r, text, size, &detail, fn_append);
+    else
+        fn_append(r, text, size);
 }
 
 static void
@@ -529,6 +749,39 @@ text_callback(MD_TEXTTYPE type, const MD_CHAR* text, MD_SIZE size, void* userdat
     return 0;
 }
 
+static int
+entity_callback(const MD_CHAR* text, MD_SIZE size, const MD_ENTITY_DETAIL* detail, void* userdata)
+{
+    MD_HTML* r = (MD_HTML*) userdata;
+
+    render_decoded_entity(r, text, size, detail, render_html_escaped);
+    return 0;
+}
+
+/* Size of the event array for MD_HTML_FLAG_BATCHED. */
+#define EVENT_BATCH_SIZE    256
+
+static int
+flush_events_callback(const MD_EVENT* events, unsigned n_events, void* userdata)
+{
+    unsigned i;
+
+    for(i = 0; i < n_events; i++) {
+        const MD_EVENT* ev = &events[i];
+        void* detail = (void*) ev->data;
+
+        switch(ev->kind) {
+            case MD_EVENT_ENTER_BLOCK:  enter_block_callback((MD_BLOCKTYPE) ev->type, detail, userdata); break;
+            case MD_EVENT_LEAVE_BLOCK:  leave_block_callback((MD_BLOCKTYPE) ev->type, detail, userdata); break;
+            case MD_EVENT_ENTER_SPAN:   enter_span_callback((MD_SPANTYPE) ev->type, detail, userdata); break;
+            case MD_EVENT_LEAVE_SPAN:   leave_span_callback((MD_SPANTYPE) ev->type, detail, userdata); break;
+            case MD_EVENT_TEXT:         text_callback((MD_TEXTTYPE) ev->type, (const MD_CHAR*) ev->data, ev->size, userdata); break;
+        }
+    }
+
+    return 0;
+}
+
 static void
 debug_log_callback(const char* msg, void* userdata)
 {
@@ -537,13 +790,12 @@ debug_log_callback(const char* msg, void* userdata)
         fprintf(stderr, "MD4C: %s\n", msg);
 }
 
-int
-md_html(const MD_CHAR* input, MD_SIZE input_size,
-        void (*process_output)(const MD_CHAR*, MD_SIZE, void*),
-        void* userdata, unsigned parser_flags, unsigned renderer_flags)
+/* Render the document with the output set up in r. */
+static int
+render_document(MD_HTML* r, const MD_CHAR* input, MD_SIZE input_size, unsigned parser_flags)
 {
-    MD_HTML render = { process_output, userdata, renderer_flags, 0, { 0 } };
     int i;
+    int ret;
 
     MD_PARSER parser = {
         0,
@@ -557,19 +809,33 @@ md_html(const MD_CHAR* input, MD_SIZE input_size,
         NULL
     };
 
+    /* Let the parser decode the entities (unless we output them verbatim). */
+    parser.abi_version = MD_PARSER_ABI_VERSION;
+    if(!(r->flags & MD_HTML_FLAG_VERBATIM_ENTITIES))
+        parser.entity = entity_callback;
+
     /* Build map of characters which need escaping. */
     for(i = 0; i < 256; i++) {
         unsigned char ch = (unsigned char) i;
 
         if(strchr("\"&<>", ch) != NULL)
-            render.escape_map[i] |= NEED_HTML_ESC_FLAG;
+            r->escape_map[i] |= NEED_HTML_ESC_FLAG;
 
         if(!ISALNUM(ch)  &&  strchr("~-_.+!*(),%#@?=;:/,+$", ch) == NULL)
-            render.escape_map[i] |= NEED_URL_ESC_FLAG;
+            r->escape_map[i] |= NEED_URL_ESC_FLAG;
+    }
+
+#if defined MD_SIMD_SSSE3
+    /* Each of the 8 ASCII high nibbles gets its own bit. */
+    for(i = 0; i < 0x80; i++) {
+        r->url_hi_nibbles[i >> 4] = (unsigned char) (1 << (i >> 4));
+        if(r->escape_map[i] & NEED_URL_ESC_FLAG)
+            r->url_lo_nibbles[i & 0xf] |= (unsigned char) (1 << (i >> 4));
     }
+#endif
 
     /* Consider skipping UTF-8 byte order mark (BOM). */
-    if(renderer_flags & MD_HTML_FLAG_SKIP_UTF8_BOM  &&  sizeof(MD_CHAR) == 1) {
+    if(r->flags & MD_HTML_FLAG_SKIP_UTF8_BOM  &&  sizeof(MD_CHAR) == 1) {
         static const MD_CHAR bom[3] = { 0xef, 0xbb, 0xbf };
         if(input_size >= sizeof(bom)  &&  memcmp(input, bom, sizeof(bom)) == 0) {
             input += sizeof(bom);
@@ -577,6 +843,351 @@ md_html(const MD_CHAR* input, MD_SIZE input_size,
         }
     }
 
-    return md_parse(input, input_size, &parser, (void*) &render);
+    if(r->flags & MD_HTML_FLAG_BATCHED) {
+        MD_EVENT events[EVENT_BATCH_SIZE];
+        MD_PARSER_HANDLE* handle;
+
+        handle = md_parser_create(&parser);
+        if(handle == NULL)
+            return -1;
+        md_parser_set_event_sink(handle, events, EVENT_BATCH_SIZE, flush_events_callback);
+        ret = md_parser_parse(handle, input, input_size, (void*) r);
+        md_parser_destroy(handle);
+    } else {
+        ret = md_parse(input, input_size, &parser, (void*) r);
+    }
+
+    return ret;
+}
+
+int
+md_html_ex(const MD_CHAR* input, MD_SIZE input_size,
+           void (*process_output)(const MD_CHAR*, MD_SIZE, void*),
+           void* userdata, unsigned parser_flags, unsigned renderer_flags,
+           MD_SIZE output_buffer_size)
+{
+    MD_HTML render;
+    MD_CHAR out_buf[MD_HTML_OUTPUT_BUFFER_SIZE];
+    int ret;
+
+    memset(&render, 0, sizeof(render));
+    render.process_output = process_output;
+    render.userdata = userdata;
+    render.flags = renderer_flags;
+
+    if(output_buffer_size > sizeof(out_buf)) {
+        render.out_buf = (MD_CHAR*) malloc(output_buffer_size);
+        if(render.out_buf == NULL)
+            return -1;
+    } else {
+        render.out_buf = out_buf;
+    }
+    render.out_alloc = output_buffer_size;
+
+    ret = render_document(&render, input, input_size, parser_flags);
+
+    /* Even on a failure, so the application gets everything up to it as
+     * without the buffering. */
+    render_flush(&render);
+
+    if(render.out_buf != out_buf)
+        free(render.out_buf);
+    return ret;
+}
+
+static void
+count_output(const MD_CHAR* text, MD_SIZE size, void* userdata)
+{
+    MD_UNUSED(text);
+    *(MD_SIZE*) userdata += size;
+}
+
+int
+md_html_to_buffer(const MD_CHAR* input, MD_SIZE input_size,
+                  MD_CHAR* buffer, MD_SIZE buffer_size,
+                  unsigned parser_flags, unsigned renderer_flags, MD_SIZE* p_size)
+{
+    MD_SIZE rest_size = 0;
+    MD_HTML render;
+    int ret;
+
+    memset(&render, 0, sizeof(render));
+    render.process_output = count_output;
+    render.userdata = &rest_size;
+    render.flags = renderer_flags;
+    render.out_buf = buffer;
+    render.out_alloc = buffer_size;
+    render.out_fixed = 1;
+
+    ret = render_document(&render, input, input_size, parser_flags);
+    *p_size = render.out_size + rest_size;
+    return ret;
+}
+
+/* The output which has not fit into the caller's buffer. */
+struct MD_HTML_RESUME {
+    MD_CHAR* data;
+    MD_SIZE size;
+    MD_SIZE alloc;
+    MD_SIZE off;
+    int failed;
+};
+
+static void
+keep_output(const MD_CHAR* text, MD_SIZE size, void* userdata)
+{
+    MD_HTML_RESUME* rest = (MD_HTML_RESUME*) userdata;
+
+    if(rest->failed)
+        return;
+
+    if(rest->size + size > rest->alloc) {
+        MD_SIZE new_alloc = rest->size + rest->size / 2 + size;
+        MD_CHAR* new_data;
+
+        new_data = (MD_CHAR*) realloc(rest->data, new_alloc);
+        if(new_data == NULL) {
+            rest->failed = 1;
+            return;
+        }
+        rest->data = new_data;
+        rest->alloc = new_alloc;
+    }
+
+    memcpy(rest->data + rest->size, text, size);
+    rest->size += size;
+}
+
+int
+md_html_to_buffer_begin(const MD_CHAR* input, MD_SIZE input_size,
+                        MD_CHAR* buffer, MD_SIZE buffer_size,
+                        unsigned parser_flags, unsigned renderer_flags,
+                        MD_SIZE* p_written, MD_HTML_RESUME** p_resume)
+{
+    MD_HTML_RESUME rest = { NULL, 0, 0, 0, 0 };
+    MD_HTML render;
+    int ret;
+
+    memset(&render, 0, sizeof(render));
+    render.process_output = keep_output;
+    render.userdata = &rest;
+    render.flags = renderer_flags;
+    render.out_buf = buffer;
+    render.out_alloc = buffer_size;
+    render.out_fixed = 1;
+
+    *p_written = 0;
+    *p_resume = NULL;
+
+    ret = render_document(&render, input, input_size, parser_flags);
+    if(ret != 0  ||  rest.failed) {
+        free(rest.data);
+        return -1;
+    }
+
+    *p_written = render.out_size;
+    if(rest.size == 0)
+        return 0;
+
+    *p_resume = (MD_HTML_RESUME*) malloc(sizeof(MD_HTML_RESUME));
+    if(*p_resume == NULL) {
+        free(rest.data);
+        return -1;
+    }
+    **p_resume = rest;
+    return 1;
+}
+
+int
+md_html_to_buffer_resume(MD_HTML_RESUME* resume, MD_CHAR* buffer, MD_SIZE buffer_size,
+                         MD_SIZE* p_written)
+{
+    MD_SIZE n = resume->size - resume->off;
+
+    if(n > buffer_size)
+        n = buffer_size;
+    if(n > 0)
+        memcpy(buffer, resume->data + resume->off, n);
+    resume->off += n;
+    *p_written = n;
+
+    if(resume->off < resume->size)
+        return 1;
+
+    md_html_to_buffer_abort(resume);
+    return 0;
 }
 
+void
+md_html_to_buffer_abort(MD_HTML_RESUME* resume)
+{
+    free(resume->data);
+    free(resume);
+}
+
+/* Output collected as segments (see md_html_to_segments()): Runs of at least
+ * SEGMENT_MIN_REF_SIZE bytes of the input are referenced, everything else is
+ * copied into the arena, where the consecutive pieces form a single segment.
+ *
+ * Copying the short pieces (most of them are tags, escapes and short runs of
+ * text between them) is cheaper than a segment for each of them. To keep the
+ * fast path of render_verbatim() intact, out_alloc is kept at most
+ * SEGMENT_MIN_REF_SIZE bytes ahead of out_size, so only the short pieces are
+ * copied there and anything longer gets here.
+ */
+#define SEGMENT_MIN_REF_SIZE    64
+#define SEGMENT_CHUNK_SIZE      4096
+
+typedef struct MD_HTML_CHUNK_tag MD_HTML_CHUNK;
+struct MD_HTML_CHUNK_tag {
+    MD_HTML_CHUNK* next;
+    /* Followed by the data. */
+};
+
+struct MD_HTML_SEGMENT_BUILD_tag {
+    MD_HTML_SEGMENTS result;    /* Must be the first member. */
+    MD_HTML_SEGMENT* segments;
+    unsigned alloc_segments;
+    MD_HTML_CHUNK* chunks;
+    MD_SIZE chunk_alloc;
+    MD_SIZE seg_beg;            /* Where the pending segment in out_buf begins. */
+    const MD_CHAR* input_beg;
+    const MD_CHAR* input_end;
+    int failed;
+};
+
+static int
+segment_append(MD_HTML_SEGMENT_BUILD* b, const MD_CHAR* text, size_t size)
+{
+    if(b->result.n_segments >= b->alloc_segments) {
+        unsigned new_alloc = (b->alloc_segments > 0 ? b->alloc_segments * 2 : 64);
+        MD_HTML_SEGMENT* new_segments;
+
+        new_segments = (MD_HTML_SEGMENT*) realloc(b->segments, new_alloc * sizeof(MD_HTML_SEGMENT));
+        if(new_segments == NULL)
+            return -1;
+        b->segments = new_segments;
+        b->result.segments = new_segments;
+        b->alloc_segments = new_alloc;
+    }
+
+    b->segments[b->result.n_segments].text = text;
+    b->segments[b->result.n_segments].size = size;
+    b->result.n_segments++;
+    b->result.total_size += size;
+    return 0;
+}
+
+/* Turn what has been copied into the current chunk into a segment. */
+static int
+segment_close_pending(MD_HTML* r)
+{
+    MD_HTML_SEGMENT_BUILD* b = r->seg;
+
+    if(r->out_size > b->seg_beg) {
+        if(segment_append(b, r->out_buf + b->seg_beg, r->out_size - b->seg_beg) != 0)
+            return -1;
+        b->seg_beg = r->out_size;
+    }
+    return 0;
+}
+
+static void
+render_segment(MD_HTML* r, const MD_CHAR* text, MD_SIZE size)
+{
+    MD_HTML_SEGMENT_BUILD* b = r->seg;
+
+    if(b->failed  ||  size == 0)
+        return;
+
+    if(size >= SEGMENT_MIN_REF_SIZE  &&  b->input_beg <= text  &&  text + size <= b->input_end) {
+        if(segment_close_pending(r) != 0  ||  segment_append(b, text, size) != 0)
+            goto abort;
+    } else {
+        if(size > b->chunk_alloc - r->out_size) {
+            MD_SIZE chunk_alloc = (size > SEGMENT_CHUNK_SIZE ? size : SEGMENT_CHUNK_SIZE);
+            MD_HTML_CHUNK* chunk;
+
+            if(segment_close_pending(r) != 0)
+                goto abort;
+            chunk = (MD_HTML_CHUNK*) malloc(sizeof(MD_HTML_CHUNK) + chunk_alloc);
+            if(chunk == NULL)
+                goto abort;
+            chunk->next = b->chunks;
+            b->chunks = chunk;
+            b->chunk_alloc = chunk_alloc;
+            b->seg_beg = 0;
+            r->out_buf = (MD_CHAR*) (chunk + 1);
+            r->out_size = 0;
+        }
+
+        memcpy(r->out_buf + r->out_size, text, size);
+        r->out_size += size;
+    }
+
+    r->out_alloc = r->out_size + SEGMENT_MIN_REF_SIZE;
+    if(r->out_alloc > b->chunk_alloc)
+        r->out_alloc = b->chunk_alloc;
+    return;
+
+abort:
+    /* Anything further ends up here and is ignored. */
+    b->failed = 1;
+    r->out_alloc = r->out_size;
+}
+
+void
+md_html_segments_free(MD_HTML_SEGMENTS* segments)
+{
+    MD_HTML_SEGMENT_BUILD* b = (MD_HTML_SEGMENT_BUILD*) segments;
+
+    while(b->chunks != NULL) {
+        MD_HTML_CHUNK* next = b->chunks->next;
+        free(b->chunks);
+        b->chunks = next;
+    }
+    free(b->segments);
+    free(b);
+}
+
+int
+md_html_to_segments(const MD_CHAR* input, MD_SIZE input_size,
+                    unsigned parser_flags, unsigned renderer_flags,
+                    MD_HTML_SEGMENTS** p_segments)
+{
+    MD_HTML render;
+    MD_HTML_SEGMENT_BUILD* b;
+    int ret;
+
+    *p_segments = NULL;
+    memset(&render, 0, sizeof(render));
+    render.flags = renderer_flags;
+
+    b = (MD_HTML_SEGMENT_BUILD*) malloc(sizeof(MD_HTML_SEGMENT_BUILD));
+    if(b == NULL)
+        return -1;
+    memset(b, 0, sizeof(MD_HTML_SEGMENT_BUILD));
+    b->input_beg = input;
+    b->input_end = input + input_size;
+    render.seg = b;
+
+    ret = render_document(&render, input, input_size, parser_flags);
+    if(ret == 0  &&  !b->failed  &&  segment_close_pending(&render) != 0)
+        ret = -1;
+    if(ret != 0  ||  b->failed) {
+        md_html_segments_free(&b->result);
+        return -1;
+    }
+
+    *p_segments = &b->result;
+    return 0;
+}
+
+int
+md_html(const MD_CHAR* input, MD_SIZE input_size,
+        void (*process_output)(const MD_CHAR*, MD_SIZE, void*),
+        void* userdata, unsigned parser_flags, unsigned renderer_flags)
+{
+    return md_html_ex(input, input_size, process_output, userdata,
+                      parser_flags, renderer_flags, MD_HTML_OUTPUT_BUFFER_SIZE);
+}
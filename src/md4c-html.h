@@ -38,6 +38,7 @@
 #define MD_HTML_FLAG_VERBATIM_ENTITIES      0x0002
 #define MD_HTML_FLAG_SKIP_UTF8_BOM          0x0004
 #define MD_HTML_FLAG_XHTML                  0x0008
+#define MD_HTML_FLAG_BATCHED                0x0010  /* Receive the events through md_parser_set_event_sink(). */
 
 
 /* Render Markdown into HTML.
@@ -48,7 +49,8 @@
  * Params input and input_size specify the Markdown input.
  * Callback process_output() gets called with chunks of HTML output.
  * (Typical implementation may just output the bytes to a file or append to
- * some buffer).
+ * some buffer). The output is collected in an internal buffer of
+ * MD_HTML_OUTPUT_BUFFER_SIZE bytes, so the chunks are mostly about that big.
  * Param userdata is just propgated back to process_output() callback.
  * Param parser_flags are flags from md4c.h propagated to md_parse().
  * Param render_flags is bitmask of MD_HTML_FLAG_xxxx.
@@ -60,6 +62,93 @@ int md_html(const MD_CHAR* input, MD_SIZE input_size,
             void (*process_output)(const MD_CHAR*, MD_SIZE, void*),
             void* userdata, unsigned parser_flags, unsigned renderer_flags);
 
+/* Default size of the md_html() output buffer. */
+#define MD_HTML_OUTPUT_BUFFER_SIZE          4096
+
+/* Same as md_html(), but with an explicit size of the output buffer. Bigger
+ * buffer means fewer process_output() calls (which helps if they are costly,
+ * e.g. in a language binding). Zero disables the buffering so every fragment
+ * of the output is passed to process_output() as soon as it is generated.
+ * The buffer is flushed when full and before md_html_ex() returns.
+ *
+ * Returns -1 also if the buffer cannot be allocated.
+ */
+int md_html_ex(const MD_CHAR* input, MD_SIZE input_size,
+               void (*process_output)(const MD_CHAR*, MD_SIZE, void*),
+               void* userdata, unsigned parser_flags, unsigned renderer_flags,
+               MD_SIZE output_buffer_size);
+
+/* Render into a buffer provided by the caller, snprintf() style: At most
+ * buffer_size bytes of the output are written into the buffer (with no
+ * terminating zero), and *p_size is set to the size of the complete output.
+ * So if *p_size > buffer_size, the output has been truncated and the caller
+ * may render again into a buffer of *p_size bytes. (The buffer may be NULL if
+ * buffer_size is zero, to just get the size.)
+ *
+ * Returns -1 on error (if md_parse() fails), 0 on success.
+ */
+int md_html_to_buffer(const MD_CHAR* input, MD_SIZE input_size,
+                      MD_CHAR* buffer, MD_SIZE buffer_size,
+                      unsigned parser_flags, unsigned renderer_flags, MD_SIZE* p_size);
+
+/* Render into buffers provided by the caller without rendering anything twice.
+ *
+ * md_html_to_buffer_begin() renders the document directly into the buffer
+ * (as md_html_to_buffer() does) and keeps the output which does not fit in an
+ * internal buffer. md_html_to_buffer_resume() then continues where the
+ * previous call has stopped, with the same or another buffer. (So only the
+ * rest of the output gets copied twice.)
+ *
+ * Both set *p_written to the count of bytes written into the buffer, and
+ * return 0 when the output is complete, 1 if there is more to come (call
+ * md_html_to_buffer_resume() again, or md_html_to_buffer_abort() if not
+ * interested in the rest), or -1 on error. *p_resume is set (to non-NULL)
+ * only if 1 is returned, and it is released when 0 or -1 is returned.
+ */
+typedef struct MD_HTML_RESUME MD_HTML_RESUME;
+
+int md_html_to_buffer_begin(const MD_CHAR* input, MD_SIZE input_size,
+                            MD_CHAR* buffer, MD_SIZE buffer_size,
+                            unsigned parser_flags, unsigned renderer_flags,
+                            MD_SIZE* p_written, MD_HTML_RESUME** p_resume);
+int md_html_to_buffer_resume(MD_HTML_RESUME* resume, MD_CHAR* buffer, MD_SIZE buffer_size,
+                             MD_SIZE* p_written);
+void md_html_to_buffer_abort(MD_HTML_RESUME* resume);
+
+/* Render into a list of segments (pieces of the output), so the application
+ * may write the output with writev() or sendmsg() without copying it first.
+ *
+ * Longer runs of the output which are verbatim copies of the input (most of
+ * the text usually) are not copied: Their segments point into the input, so
+ * it has to stay valid (and unchanged) as long as the segments are used. The
+ * rest (tags, escaped characters, and short runs of text among them) is
+ * copied into an arena kept in the MD_HTML_SEGMENTS, one segment for all
+ * that is consecutive.
+ *
+ * The members of MD_HTML_SEGMENT are the same as of POSIX struct iovec (so
+ * they usually have the same layout, but applications should check that, or
+ * convert them, before passing the segments to writev()). Note the count of
+ * the segments may be bigger than IOV_MAX.
+ *
+ * Returns -1 on error (if md_parse() fails, or out of memory), or 0 and sets
+ * *p_segments on success. Release it with md_html_segments_free().
+ */
+typedef struct MD_HTML_SEGMENT {
+    const MD_CHAR* text;
+    size_t size;
+} MD_HTML_SEGMENT;
+
+typedef struct MD_HTML_SEGMENTS {
+    const MD_HTML_SEGMENT* segments;
+    unsigned n_segments;
+    size_t total_size;
+} MD_HTML_SEGMENTS;
+
+int md_html_to_segments(const MD_CHAR* input, MD_SIZE input_size,
+                        unsigned parser_flags, unsigned renderer_flags,
+                        MD_HTML_SEGMENTS** p_segments);
+void md_html_segments_free(MD_HTML_SEGMENTS* segments);
+
 
 #ifdef __cplusplus
     }  /* extern "C" { */
@@ -24,6 +24,7 @@
  */
 
 #include "md4c.h"
+#include "entity.h"
 
 #include <limits.h>
 #include <stdio.h>
@@ -114,6 +115,98 @@
 /* Suppress "unused parameter" warnings. */
 #define MD_UNUSED(x)                ((void)x)
 
+/* SIMD support. We only use it for scanning 8-bit encoded text. Define
+ * MD4C_NO_SIMD to disable it altogether.
+ *
+ * The instruction set is chosen at compile time, from what the compiler is
+ * told the target CPU supports (e.g. -mssse3 or -mavx2); there is no runtime
+ * CPU detection. So a default x86_64 build uses only SSE2, and a build with
+ * -mavx2 does not run on CPUs without AVX2. */
+#if !defined MD4C_NO_SIMD  &&  !defined MD4C_USE_UTF16
+    #if defined __SSE2__  ||  defined _M_X64  ||  (defined _M_IX86_FP  &&  _M_IX86_FP >= 2)
+        #define MD_SIMD_SSE2        1
+        #include <emmintrin.h>
+    #endif
+    #if defined __SSSE3__  ||  defined __AVX__
+        #define MD_SIMD_SSSE3       1
+        #include <tmmintrin.h>
+    #endif
+    #if defined __AVX2__
+        #define MD_SIMD_AVX2        1
+        #include <immintrin.h>
+    #endif
+#endif
+
+#if defined MD_SIMD_SSE2
+    #if defined __GNUC__
+        #define md_ctz(x)           ((unsigned) __builtin_ctz(x))
+    #elif defined _MSC_VER
+        #include <intrin.h>
+        static inline unsigned
+        md_ctz(unsigned x)
+        {
+            unsigned long index;
+            _BitScanForward(&index, x);
+            return (unsigned) index;
+        }
+    #endif
+#endif
+
+/* Threads for the parallel inline analysis (see md_parser_set_thread_count()).
+ * Define MD4C_NO_THREADS to build without them. */
+#if !defined MD4C_NO_THREADS
+    #if defined _WIN32
+        #include <windows.h>
+        #define MD_THREADS          1
+        typedef HANDLE MD_THREAD;
+    #elif defined __unix__  ||  defined __APPLE__
+        #include <pthread.h>
+        #define MD_THREADS          1
+        typedef pthread_t MD_THREAD;
+    #endif
+#endif
+
+/* Dialect fixed at build time. Define MD4C_FIXED_FLAGS (e.g. to
+ * MD_DIALECT_GITHUB) if the parser is only ever used with the same flags:
+ * All the tests of the flags are then constant, and the compiler drops the
+ * code for the disabled extensions from the hot loops. The parser then
+ * refuses any other MD_PARSER::flags. (MD_FLAG_NOREFDEFS is an exception: It
+ * stays a run-time flag.) */
+#ifdef MD4C_FIXED_FLAGS
+    #define MD_FIXED_FLAGS_MASK     (~(unsigned) MD_FLAG_NOREFDEFS)
+    #define MD_PARSER_FLAGS(ctx)    (((unsigned) (MD4C_FIXED_FLAGS) & MD_FIXED_FLAGS_MASK) |   \
+                                     ((ctx)->parser.flags & ~MD_FIXED_FLAGS_MASK))
+#else
+    #define MD_PARSER_FLAGS(ctx)    ((ctx)->parser.flags)
+#endif
+
+/* Clock (in seconds) for MD_PARSER::stats and MD_PARSER::time_limit. */
+#if defined _WIN32
+    #include <windows.h>
+    static double
+    md_clock(void)
+    {
+        LARGE_INTEGER freq, now;
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&now);
+        return (double) now.QuadPart / (double) freq.QuadPart;
+    }
+#else
+    #include <time.h>
+    static double
+    md_clock(void)
+    {
+    #if defined CLOCK_MONOTONIC
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+    #else
+        /* Strict ISO C: Only the processor time is available. */
+        return (double) clock() / CLOCKS_PER_SEC;
+    #endif
+    }
+#endif
+
 
 /************************
  ***  Internal Types  ***
@@ -128,6 +221,7 @@ typedef struct MD_MARK_tag MD_MARK;
 typedef struct MD_BLOCK_tag MD_BLOCK;
 typedef struct MD_CONTAINER_tag MD_CONTAINER;
 typedef struct MD_REF_DEF_tag MD_REF_DEF;
+typedef struct MD_REF_DEF_SLOT_tag MD_REF_DEF_SLOT;
 
 
 /* During analyzes of inline marks, we need to manage some "mark chains",
@@ -140,28 +234,113 @@ struct MD_MARKCHAIN_tag {
     int tail;   /* Index of last mark in the chain, or -1 if empty. */
 };
 
+enum MD_LINETYPE_tag {
+    MD_LINE_BLANK,
+    MD_LINE_HR,
+    MD_LINE_ATXHEADER,
+    MD_LINE_SETEXTHEADER,
+    MD_LINE_SETEXTUNDERLINE,
+    MD_LINE_INDENTEDCODE,
+    MD_LINE_FENCEDCODE,
+    MD_LINE_HTML,
+    MD_LINE_TEXT,
+    MD_LINE_TABLE,
+    MD_LINE_TABLEUNDERLINE
+};
+typedef enum MD_LINETYPE_tag MD_LINETYPE;
+
+typedef struct MD_LINE_ANALYSIS_tag MD_LINE_ANALYSIS;
+struct MD_LINE_ANALYSIS_tag {
+    MD_LINETYPE type    : 16;
+    unsigned data       : 16;
+    OFF beg;
+    OFF end;
+    unsigned indent;        /* Indentation level. */
+};
+
+/* Chunk of the bump arena (see MD_ALLOC_ARENA). The allocated blocks follow
+ * the header. */
+typedef struct MD_ARENA_CHUNK_tag MD_ARENA_CHUNK;
+struct MD_ARENA_CHUNK_tag {
+    MD_ARENA_CHUNK* next;
+    size_t size;    /* Usable size (excluding this header). */
+    size_t used;
+};
+
+typedef struct MD_ARENA_tag MD_ARENA;
+struct MD_ARENA_tag {
+    MD_ARENA_CHUNK* chunk;      /* Current (first) chunk of the arena. */
+    void* last_block;           /* Last arena block, may grow in place. */
+    size_t n_used;              /* Bytes of the blocks (and their headers). */
+};
+
+/* Leaf block whose inlines are analyzed by a worker thread (see
+ * md_analyze_inlines_in_parallel()). */
+typedef struct MD_INLINE_JOB_tag MD_INLINE_JOB;
+struct MD_INLINE_JOB_tag {
+    const MD_BLOCK* block;
+    MD_MARK* marks;         /* The analyzed marks. */
+    size_t marks_off;       /* (Offset of ->marks in MD_INLINE_WORKER::results.) */
+    int n_marks;
+    int ptr_chain_head;     /* PTR_CHAIN of the marks. */
+    int ptr_chain_tail;
+    int ret;
+};
+
+typedef struct MD_INLINE_WORKER_tag MD_INLINE_WORKER;
+
+/* State of md_parser_set_event_sink(). While it is active, the callbacks in
+ * MD_CTX::parser are replaced with ones collecting the events, and
+ * MD_CTX::userdata points to this structure. */
+typedef struct MD_EVENT_BATCH_tag MD_EVENT_BATCH;
+struct MD_EVENT_BATCH_tag {
+    MD_PARSER parser;       /* The original callbacks. */
+    void* userdata;         /* The application's userdata. */
+    MD_EVENT* events;
+    unsigned n_events;
+    unsigned capacity;
+    int (*flush)(const MD_EVENT* /*events*/, unsigned /*n_events*/, void* /*userdata*/);
+};
+
 /* Context propagated through all the parsing. */
 typedef struct MD_CTX_tag MD_CTX;
 struct MD_CTX_tag {
     /* Immutable stuff (parameters of md_parse()). */
     const CHAR* text;
     SZ size;
+    OFF text_base;          /* Offset of text in the whole input (see md_stream_discard()). */
     MD_PARSER parser;
     void* userdata;
+    MD_EVENT_BATCH* batch;  /* See md_parser_set_event_sink(). */
 
     /* When this is true, it allows some optimizations. */
     int doc_ends_with_newline;
 
+    /* Memory management. */
+    const MD_ALLOCATOR* allocator;  /* NULL means the C library. */
+    MD_ARENA arena;
+    int use_arena;
+
     /* Helper temporary growing buffer. */
     CHAR* buffer;
     unsigned alloc_buffer;
 
+    /* Growing buffer for the key of a looked up link label. */
+    unsigned char* lookup_key;
+    size_t alloc_lookup_key;
+
     /* Reference definitions. */
     MD_REF_DEF* ref_defs;
     int n_ref_defs;
     int alloc_ref_defs;
-    void** ref_def_hashtable;
+    unsigned char* ref_def_keys;    /* Normalized labels (see md_link_label_key()). */
+    size_t n_ref_def_keys;
+    size_t alloc_ref_def_keys;
+    MD_REF_DEF_SLOT* ref_def_hashtable;
     int ref_def_hashtable_size;
+    int alloc_ref_def_hashtable;
+    int ref_defs_frozen;    /* See md_parser_reparse(). */
+    int ref_defs_changed;
 
     /* Stack of inline/span markers.
      * This is only used for parsing a single block contents but by storing it
@@ -177,6 +356,21 @@ struct MD_CTX_tag {
     char mark_char_map[256];
 #endif
 
+#if defined MD_SIMD_SSE2
+    /* Alternative representations of mark_char_map[] for the SIMD scanner.
+     * (See md_build_mark_char_map().) */
+    int mark_alnum_prefilter_valid;     /* No alnum, space or >= 0x80 is a mark char. */
+    unsigned char mark_lo_nibbles[16];  /* Nibble tables for PSHUFB. */
+    unsigned char mark_hi_nibbles[16];
+    int mark_nibbles_valid;
+
+    /* Window of the newline prepass (see md_find_newline()): Bit i of the
+     * mask is set iff CH(newline_window_beg + i) is '\r' or '\n'. */
+    OFF newline_window_beg;
+    unsigned newline_window_mask;
+    int newline_window_valid;
+#endif
+
     /* For resolving of inline spans. */
     MD_MARKCHAIN mark_chains[13];
 #define PTR_CHAIN                               (ctx->mark_chains[0])
@@ -232,30 +426,49 @@ struct MD_CTX_tag {
     int html_block_type;    /* For checking closing raw HTML condition. */
     int last_line_has_list_loosening_effect;
     int last_list_item_starts_with_two_blank_lines;
-};
+    int li_opener_end;      /* ctx->n_block_bytes after the last MD_BLOCK_LI opener. */
 
-enum MD_LINETYPE_tag {
-    MD_LINE_BLANK,
-    MD_LINE_HR,
-    MD_LINE_ATXHEADER,
-    MD_LINE_SETEXTHEADER,
-    MD_LINE_SETEXTUNDERLINE,
-    MD_LINE_INDENTEDCODE,
-    MD_LINE_FENCEDCODE,
-    MD_LINE_HTML,
-    MD_LINE_TEXT,
-    MD_LINE_TABLE,
-    MD_LINE_TABLEUNDERLINE
+    /* State of md_process_lines(). */
+    OFF line_off;
+    const MD_LINE_ANALYSIS* pivot_line;
+    MD_LINE_ANALYSIS* line;
+    MD_LINE_ANALYSIS line_buf[2];
+
+    /* For the parallel inline analysis. */
+    MD_INLINE_WORKER* workers;
+    int n_workers;
+    MD_INLINE_JOB* inline_jobs;
+    int n_inline_jobs;
+    int alloc_inline_jobs;
+    int next_inline_job;
+
+    /* For MD_PARSER::stats. The counters are always updated, the clock is
+     * only read if the application has asked for the stats. */
+    MD_PARSE_STATS stats;
+    int stats_phase;        /* MD_STATS_xxxx */
+    double stats_clock;     /* When stats_phase has been entered. */
+
+    /* For the resource limits (MD_PARSER::max_memory etc.). */
+    size_t n_charged_bytes;
+    int limit_exceeded;
+
+    /* For the cancellation (MD_PARSER::time_limit and MD_PARSER::cancel). */
+    double deadline;
+    int cancel_countdown;   /* Checks to skip before the next md_poll_cancel(). */
+    int cancelled;
 };
-typedef enum MD_LINETYPE_tag MD_LINETYPE;
 
-typedef struct MD_LINE_ANALYSIS_tag MD_LINE_ANALYSIS;
-struct MD_LINE_ANALYSIS_tag {
-    MD_LINETYPE type    : 16;
-    unsigned data       : 16;
-    OFF beg;
-    OFF end;
-    unsigned indent;        /* Indentation level. */
+struct MD_INLINE_WORKER_tag {
+    MD_CTX ctx;             /* Private copy of the main context. */
+    MD_INLINE_JOB* jobs;
+    int n_jobs;
+    MD_MARK* results;       /* Marks of all the jobs, one after another. */
+    size_t n_results;
+    size_t alloc_results;
+#if defined MD_THREADS
+    MD_THREAD thread;
+    int has_thread;
+#endif
 };
 
 typedef struct MD_LINE_tag MD_LINE;
@@ -374,7 +587,8 @@ md_text_with_null_replacement(MD_CTX* ctx, MD_TEXTTYPE type, const CHAR* str, SZ
         ret = ctx->parser.text(MD_TEXT_NULLCHAR, _T(""), 1, ctx->userdata);
         if(ret != 0)
             return ret;
-        off++;
+        str++;
+        size--;
     }
 }
 
@@ -387,13 +601,243 @@ md_text_with_null_replacement(MD_CTX* ctx, MD_TEXTTYPE type, const CHAR* str, SZ
     } while(0)
 
 
+/* Memory management.
+ *
+ * All memory goes through md_malloc(), md_realloc() and md_free(). These use
+ * either the caller-provided MD_ALLOCATOR (or the C library), or a simple bump
+ * arena (MD_ALLOC_ARENA). In the latter case, md_free() only releases the
+ * block if it is the last one, and everything is released in
+ * md_arena_release() at the end of parsing.
+ */
+
+/* Size of the (minimal) arena chunk. */
+#define MD_ARENA_CHUNK_SIZE     (64 * 1024)
+
+/* All arena blocks are aligned to this. Each block is preceded by a header of
+ * this size holding the block size. */
+#define MD_ARENA_ALIGN          16
+#define MD_ARENA_ALIGNED(sz)    (((sz) + MD_ARENA_ALIGN - 1) & ~((size_t) MD_ARENA_ALIGN - 1))
+#define MD_ARENA_CHUNK_HDR      MD_ARENA_ALIGNED(sizeof(MD_ARENA_CHUNK))
+#define MD_ARENA_CHUNK_DATA(c)  ((char*)(c) + MD_ARENA_CHUNK_HDR)
+#define MD_ARENA_BLOCK_SIZE(p)  (*(size_t*)((char*)(p) - MD_ARENA_ALIGN))
+
+static inline void*
+md_sys_malloc(const MD_ALLOCATOR* allocator, size_t size)
+{
+    return (allocator != NULL ? allocator->malloc_fn(size, allocator->userdata) : malloc(size));
+}
+
+static inline void*
+md_sys_realloc(const MD_ALLOCATOR* allocator, void* ptr, size_t size)
+{
+    return (allocator != NULL ? allocator->realloc_fn(ptr, size, allocator->userdata) : realloc(ptr, size));
+}
+
+static inline void
+md_sys_free(const MD_ALLOCATOR* allocator, void* ptr)
+{
+    if(allocator != NULL)
+        allocator->free_fn(ptr, allocator->userdata);
+    else
+        free(ptr);
+}
+
+static void*
+md_arena_alloc(const MD_ALLOCATOR* allocator, MD_ARENA* arena, size_t size)
+{
+    MD_ARENA_CHUNK* chunk = arena->chunk;
+    size_t need = MD_ARENA_ALIGN + MD_ARENA_ALIGNED(size);
+    char* ptr;
+
+    if(chunk == NULL  ||  chunk->size - chunk->used < need) {
+        size_t chunk_size = (need > MD_ARENA_CHUNK_SIZE ? need : MD_ARENA_CHUNK_SIZE);
+
+        chunk = (MD_ARENA_CHUNK*) md_sys_malloc(allocator, MD_ARENA_CHUNK_HDR + chunk_size);
+        if(chunk == NULL)
+            return NULL;
+        chunk->next = arena->chunk;
+        chunk->size = chunk_size;
+        chunk->used = 0;
+        arena->chunk = chunk;
+    }
+
+    ptr = MD_ARENA_CHUNK_DATA(chunk) + chunk->used + MD_ARENA_ALIGN;
+    MD_ARENA_BLOCK_SIZE(ptr) = MD_ARENA_ALIGNED(size);
+    chunk->used += need;
+    arena->n_used += need;
+    arena->last_block = ptr;
+    return ptr;
+}
+
+static void*
+md_arena_realloc(const MD_ALLOCATOR* allocator, MD_ARENA* arena, void* ptr, size_t size)
+{
+    size_t old_size;
+    void* new_ptr;
+
+    if(ptr == NULL)
+        return md_arena_alloc(allocator, arena, size);
+
+    old_size = MD_ARENA_BLOCK_SIZE(ptr);
+    if(size <= old_size)
+        return ptr;
+
+    /* If it is the last block, try to grow it in place. */
+    if(ptr == arena->last_block) {
+        MD_ARENA_CHUNK* chunk = arena->chunk;
+        size_t extra = MD_ARENA_ALIGNED(size) - old_size;
+
+        if(chunk->size - chunk->used >= extra) {
+            chunk->used += extra;
+            arena->n_used += extra;
+            MD_ARENA_BLOCK_SIZE(ptr) += extra;
+            return ptr;
+        }
+    }
+
+    new_ptr = md_arena_alloc(allocator, arena, size);
+    if(new_ptr == NULL)
+        return NULL;
+    memcpy(new_ptr, ptr, old_size);
+    return new_ptr;
+}
+
+static void
+md_arena_free(MD_ARENA* arena, void* ptr)
+{
+    /* We can only give back the last block. */
+    if(ptr != NULL  &&  ptr == arena->last_block) {
+        arena->chunk->used -= MD_ARENA_ALIGN + MD_ARENA_BLOCK_SIZE(ptr);
+        arena->n_used -= MD_ARENA_ALIGN + MD_ARENA_BLOCK_SIZE(ptr);
+        arena->last_block = NULL;
+    }
+}
+
+static void
+md_arena_release(const MD_ALLOCATOR* allocator, MD_ARENA* arena)
+{
+    while(arena->chunk != NULL) {
+        MD_ARENA_CHUNK* next = arena->chunk->next;
+        md_sys_free(allocator, arena->chunk);
+        arena->chunk = next;
+    }
+    arena->last_block = NULL;
+    arena->n_used = 0;
+}
+
+/* With MD_PARSER::max_memory, the memory is counted as it is allocated and
+ * freed, so that the limit applies to the peak consumption. Blocks outside
+ * the arena are then preceded by a header holding their size (so md_free()
+ * knows what it gives back); the arena knows its blocks' sizes already.
+ *
+ * Note MD_CTX::n_charged_bytes starts from zero with each document, and
+ * freeing a buffer kept from a previous document makes it "negative". The
+ * unsigned arithmetic below wraps around correctly as long as the count
+ * never exceeds the limit. */
+#define MD_CHARGED_HDR          MD_ARENA_ALIGN
+#define MD_CHARGED_SIZE(p)      (*(size_t*)((char*)(p) - MD_CHARGED_HDR))
+
+/* Count the allocation against MD_PARSER::max_memory. */
+static int
+md_charge_memory(MD_CTX* ctx, size_t size)
+{
+    if(size > ctx->parser.max_memory - ctx->n_charged_bytes) {
+        MD_LOG("Memory limit exceeded (see MD_PARSER::max_memory).");
+        ctx->limit_exceeded = TRUE;
+        return -1;
+    }
+
+    ctx->n_charged_bytes += size;
+    return 0;
+}
+
+static void*
+md_charged_realloc(MD_CTX* ctx, void* ptr, size_t size)
+{
+    size_t old_size = 0;
+    char* block;
+
+    if(size > (size_t) -1 - 2 * MD_CHARGED_HDR) {
+        MD_LOG("Memory limit exceeded (see MD_PARSER::max_memory).");
+        ctx->limit_exceeded = TRUE;
+        return NULL;
+    }
+
+    if(ctx->use_arena) {
+        /* Charge the most it may take, then what it has really taken. */
+        size_t n_used = ctx->arena.n_used;
+        size_t charge = MD_ARENA_ALIGN + MD_ARENA_ALIGNED(size);
+
+        if(ptr != NULL  &&  size <= MD_ARENA_BLOCK_SIZE(ptr))
+            return ptr;
+        if(md_charge_memory(ctx, charge) != 0)
+            return NULL;
+        block = (char*) md_arena_realloc(ctx->allocator, &ctx->arena, ptr, size);
+        ctx->n_charged_bytes -= charge - (ctx->arena.n_used - n_used);
+        return block;
+    }
+
+    if(ptr != NULL)
+        old_size = MD_CHARGED_HDR + MD_CHARGED_SIZE(ptr);
+    if(MD_CHARGED_HDR + size > old_size  &&  md_charge_memory(ctx, MD_CHARGED_HDR + size - old_size) != 0)
+        return NULL;
+
+    block = (char*) md_sys_realloc(ctx->allocator,
+                (ptr != NULL ? (char*) ptr - MD_CHARGED_HDR : NULL), MD_CHARGED_HDR + size);
+    if(block == NULL) {
+        if(MD_CHARGED_HDR + size > old_size)
+            ctx->n_charged_bytes -= MD_CHARGED_HDR + size - old_size;
+        return NULL;
+    }
+    if(MD_CHARGED_HDR + size < old_size)
+        ctx->n_charged_bytes -= old_size - (MD_CHARGED_HDR + size);
+
+    block += MD_CHARGED_HDR;
+    MD_CHARGED_SIZE(block) = size;
+    return block;
+}
+
+static inline void*
+md_malloc(MD_CTX* ctx, size_t size)
+{
+    if(ctx->parser.max_memory > 0)
+        return md_charged_realloc(ctx, NULL, size);
+    return (ctx->use_arena ? md_arena_alloc(ctx->allocator, &ctx->arena, size) : md_sys_malloc(ctx->allocator, size));
+}
+
+static inline void*
+md_realloc(MD_CTX* ctx, void* ptr, size_t size)
+{
+    if(ctx->parser.max_memory > 0)
+        return md_charged_realloc(ctx, ptr, size);
+    return (ctx->use_arena ? md_arena_realloc(ctx->allocator, &ctx->arena, ptr, size) : md_sys_realloc(ctx->allocator, ptr, size));
+}
+
+static inline void
+md_free(MD_CTX* ctx, void* ptr)
+{
+    if(ctx->use_arena) {
+        size_t n_used = ctx->arena.n_used;
+
+        md_arena_free(&ctx->arena, ptr);
+        ctx->n_charged_bytes -= n_used - ctx->arena.n_used;
+    } else if(ctx->parser.max_memory > 0  &&  ptr != NULL) {
+        ctx->n_charged_bytes -= MD_CHARGED_HDR + MD_CHARGED_SIZE(ptr);
+        md_sys_free(ctx->allocator, (char*) ptr - MD_CHARGED_HDR);
+    } else {
+        md_sys_free(ctx->allocator, ptr);
+    }
+}
+
+
 #define MD_TEMP_BUFFER(sz)                                                  \
     do {                                                                    \
+        MD_STATS_PEAK(aux_buffer_size, (sz));                               \
         if(sz > ctx->alloc_buffer) {                                        \
             CHAR* new_buffer;                                               \
             SZ new_size = ((sz) + (sz) / 2 + 128) & ~127;                   \
                                                                             \
-            new_buffer = realloc(ctx->buffer, new_size);                    \
+            new_buffer = md_realloc(ctx, ctx->buffer, new_size);            \
             if(new_buffer == NULL) {                                        \
                 MD_LOG("realloc() failed.");                                \
                 ret = -1;                                                   \
@@ -445,6 +889,7 @@ md_text_with_null_replacement(MD_CTX* ctx, MD_TEXTTYPE type, const CHAR* str, SZ
 #define MD_TEXT(type, str, size)                                            \
     do {                                                                    \
         if(size > 0) {                                                      \
+            ctx->stats.emission_size += (size);                             \
             ret = ctx->parser.text((type), (str), (size), ctx->userdata);   \
             if(ret != 0) {                                                  \
                 MD_LOG("Aborted from text() callback.");                    \
@@ -453,9 +898,26 @@ md_text_with_null_replacement(MD_CTX* ctx, MD_TEXTTYPE type, const CHAR* str, SZ
         }                                                                   \
     } while(0)
 
+#define MD_TEXT_ENTITY_(str, size)                                          \
+    do {                                                                    \
+        ctx->stats.emission_size += (size);                                 \
+        if(ctx->parser.entity != NULL) {                                    \
+            MD_ENTITY_DETAIL entity_detail;                                 \
+            md_decode_entity_str((str), (size), &entity_detail);            \
+            ret = ctx->parser.entity((str), (size), &entity_detail, ctx->userdata); \
+        } else {                                                            \
+            ret = ctx->parser.text(MD_TEXT_ENTITY, (str), (size), ctx->userdata); \
+        }                                                                   \
+        if(ret != 0) {                                                      \
+            MD_LOG("Aborted from entity() callback.");                      \
+            goto abort;                                                     \
+        }                                                                   \
+    } while(0)
+
 #define MD_TEXT_INSECURE(type, str, size)                                   \
     do {                                                                    \
         if(size > 0) {                                                      \
+            ctx->stats.emission_size += (size);                             \
             ret = md_text_with_null_replacement(ctx, type, str, size);      \
             if(ret != 0) {                                                  \
                 MD_LOG("Aborted from text() callback.");                    \
@@ -465,6 +927,98 @@ md_text_with_null_replacement(MD_CTX* ctx, MD_TEXTTYPE type, const CHAR* str, SZ
     } while(0)
 
 
+/* Phases of the parsing measured for MD_PARSER::stats. Time spent in
+ * MD_STATS_NONE is not accounted anywhere. */
+#define MD_STATS_NONE           0
+#define MD_STATS_LINES          1
+#define MD_STATS_REFDEFS        2
+#define MD_STATS_MARKS          3
+#define MD_STATS_RESOLVE        4
+#define MD_STATS_EMIT           5
+
+/* Switch to the given phase, accounting the time spent in the current one.
+ * Returns the previous phase so it can be restored. The phases may nest
+ * (e.g. the blocks are processed in the middle of the line analysis with
+ * MD_FLAG_NOREFDEFS) and the time is always accounted to the innermost. */
+static int
+md_stats_switch(MD_CTX* ctx, int phase)
+{
+    int prev_phase = ctx->stats_phase;
+    double now = md_clock();
+    double elapsed = now - ctx->stats_clock;
+
+    switch(prev_phase) {
+        case MD_STATS_LINES:    ctx->stats.line_analysis_time += elapsed; break;
+        case MD_STATS_REFDEFS:  ctx->stats.ref_def_time += elapsed; break;
+        case MD_STATS_MARKS:    ctx->stats.mark_collection_time += elapsed; break;
+        case MD_STATS_RESOLVE:  ctx->stats.mark_resolution_time += elapsed; break;
+        case MD_STATS_EMIT:     ctx->stats.emission_time += elapsed; break;
+        default:                break;
+    }
+
+    ctx->stats_phase = phase;
+    ctx->stats_clock = now;
+    return prev_phase;
+}
+
+#define MD_STATS_ENTER(phase)                                               \
+    (ctx->parser.stats != NULL ? md_stats_switch(ctx, (phase)) : MD_STATS_NONE)
+
+#define MD_STATS_SWITCH(phase)                                              \
+    do {                                                                    \
+        if(ctx->parser.stats != NULL)                                       \
+            md_stats_switch(ctx, (phase));                                  \
+    } while(0)
+
+/* Record the peak use of a work buffer (MD_PARSE_STATS::xxx_buffer_size). */
+#define MD_STATS_PEAK(member, size)                                         \
+    do {                                                                    \
+        if((size_t) (size) > ctx->stats.member)                             \
+            ctx->stats.member = (size_t) (size);                            \
+    } while(0)
+
+
+/* How many cancellation checks (lines, blocks, marks) to skip between
+ * looking at MD_PARSER::cancel and the clock. */
+#define MD_CANCEL_POLL_INTERVAL     256
+
+/* Whether the application wants the parsing to stop (see MD_PARSER::cancel
+ * and MD_PARSER::time_limit). Once it says so, it keeps saying so. */
+static int
+md_poll_cancel(MD_CTX* ctx)
+{
+    if(!ctx->cancelled) {
+        if(ctx->parser.cancel != NULL  &&  *ctx->parser.cancel != 0) {
+            MD_LOG("Cancelled (see MD_PARSER::cancel).");
+            ctx->cancelled = TRUE;
+        } else if(ctx->parser.time_limit > 0.0  &&  md_clock() >= ctx->deadline) {
+            MD_LOG("Time limit exceeded (see MD_PARSER::time_limit).");
+            ctx->cancelled = TRUE;
+        }
+    }
+
+    if(ctx->cancelled)
+        ctx->cancel_countdown = 0;
+    else if(ctx->parser.cancel != NULL  ||  ctx->parser.time_limit > 0.0)
+        ctx->cancel_countdown = MD_CANCEL_POLL_INTERVAL;
+    else
+        ctx->cancel_countdown = INT_MAX;
+    return ctx->cancelled;
+}
+
+/* Cheap enough to be evaluated for every line, block or mark. */
+#define MD_IS_CANCELLED()                                                   \
+    (--ctx->cancel_countdown < 0  &&  md_poll_cancel(ctx))
+
+#define MD_CHECK_CANCEL()                                                   \
+    do {                                                                    \
+        if(MD_IS_CANCELLED()) {                                             \
+            ret = -1;                                                       \
+            goto abort;                                                     \
+        }                                                                   \
+    } while(0)
+
+
 
 /*************************
  ***  Unicode Support  ***
@@ -478,213 +1032,398 @@ struct MD_UNICODE_FOLD_INFO_tag {
 
 
 #if defined MD4C_USE_UTF16 || defined MD4C_USE_UTF8
-    /* Binary search over sorted "map" of codepoints. Consecutive sequences
-     * of codepoints may be encoded in the map by just using the
-     * (MIN_CODEPOINT | 0x40000000) and (MAX_CODEPOINT | 0x80000000).
-     *
-     * Returns index of the found record in the map (in the case of ranges,
-     * the minimal value is used); or -1 on failure. */
-    static int
-    md_unicode_bsearch__(unsigned codepoint, const unsigned* map, size_t map_size)
+    /* Test the codepoint in a bitmap split into two stages (as generated by
+     * scripts/build_punct_map.py and scripts/build_whitespace_map.py): index[]
+     * maps each block of (1 << shift) 32-bit words of the bitmap to its
+     * (deduplicated) copy in data[]. Codepoints beyond the index are not in
+     * the map. */
+    static inline int
+    md_unicode_bitmap__(unsigned codepoint, const unsigned char* index, size_t index_size,
+                        const unsigned* data, unsigned shift)
     {
-        int beg, end;
-        int pivot_beg, pivot_end;
-
-        beg = 0;
-        end = (int) map_size-1;
-        while(beg <= end) {
-            /* Pivot may be a range, not just a single value. */
-            pivot_beg = pivot_end = (beg + end) / 2;
-            if(map[pivot_end] & 0x40000000)
-                pivot_end++;
-            if(map[pivot_beg] & 0x80000000)
-                pivot_beg--;
-
-            if(codepoint < (map[pivot_beg] & 0x00ffffff))
-                end = pivot_beg - 1;
-            else if(codepoint > (map[pivot_end] & 0x00ffffff))
-                beg = pivot_end + 1;
-            else
-                return pivot_beg;
-        }
+        unsigned word = codepoint >> 5;
+        unsigned block = word >> shift;
 
-        return -1;
+        if(block >= index_size)
+            return FALSE;
+
+        word = data[((unsigned) index[block] << shift) + (word & ((1U << shift) - 1))];
+        return (word >> (codepoint & 0x1f)) & 0x1;
     }
 
     static int
     md_is_unicode_whitespace__(unsigned codepoint)
     {
-#define R(cp_min, cp_max)   ((cp_min) | 0x40000000), ((cp_max) | 0x80000000)
-#define S(cp)               (cp)
         /* Unicode "Zs" category.
          * (generated by scripts/build_whitespace_map.py) */
-        static const unsigned WHITESPACE_MAP[] = {
-            S(0x0020), S(0x00a0), S(0x1680), R(0x2000,0x200a), S(0x202f), S(0x205f), S(0x3000)
+#define WHITESPACE_MAP_SHIFT 2
+        static const unsigned char WHITESPACE_MAP_INDEX[] = {
+            0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+            1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 3, 1, 1, 1, 1, 1,
+            1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2
+        };
+        static const unsigned WHITESPACE_MAP_DATA[] = {
+            0x00000000, 0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+            0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x000007ff, 0x00008000, 0x80000000, 0x00000000
         };
-#undef R
-#undef S
 
         /* The ASCII ones are the most frequently used ones, also CommonMark
          * specification requests few more in this range. */
         if(codepoint <= 0x7f)
             return ISWHITESPACE_(codepoint);
 
-        return (md_unicode_bsearch__(codepoint, WHITESPACE_MAP, SIZEOF_ARRAY(WHITESPACE_MAP)) >= 0);
+        return md_unicode_bitmap__(codepoint, WHITESPACE_MAP_INDEX, SIZEOF_ARRAY(WHITESPACE_MAP_INDEX),
+                                   WHITESPACE_MAP_DATA, WHITESPACE_MAP_SHIFT);
+#undef WHITESPACE_MAP_SHIFT
     }
 
     static int
     md_is_unicode_punct__(unsigned codepoint)
     {
-#define R(cp_min, cp_max)   ((cp_min) | 0x40000000), ((cp_max) | 0x80000000)
-#define S(cp)               (cp)
         /* Unicode "Pc", "Pd", "Pe", "Pf", "Pi", "Po", "Ps" categories.
          * (generated by scripts/build_punct_map.py) */
-        static const unsigned PUNCT_MAP[] = {
-            R(0x0021,0x0023), R(0x0025,0x002a), R(0x002c,0x002f), R(0x003a,0x003b), R(0x003f,0x0040),
-            R(0x005b,0x005d), S(0x005f), S(0x007b), S(0x007d), S(0x00a1), S(0x00a7), S(0x00ab), R(0x00b6,0x00b7),
-            S(0x00bb), S(0x00bf), S(0x037e), S(0x0387), R(0x055a,0x055f), R(0x0589,0x058a), S(0x05be), S(0x05c0),
-            S(0x05c3), S(0x05c6), R(0x05f3,0x05f4), R(0x0609,0x060a), R(0x060c,0x060d), S(0x061b), R(0x061e,0x061f),
-            R(0x066a,0x066d), S(0x06d4), R(0x0700,0x070d), R(0x07f7,0x07f9), R(0x0830,0x083e), S(0x085e),
-            R(0x0964,0x0965), S(0x0970), S(0x09fd), S(0x0a76), S(0x0af0), S(0x0c77), S(0x0c84), S(0x0df4), S(0x0e4f),
-            R(0x0e5a,0x0e5b), R(0x0f04,0x0f12), S(0x0f14), R(0x0f3a,0x0f3d), S(0x0f85), R(0x0fd0,0x0fd4),
-            R(0x0fd9,0x0fda), R(0x104a,0x104f), S(0x10fb), R(0x1360,0x1368), S(0x1400), S(0x166e), R(0x169b,0x169c),
-            R(0x16eb,0x16ed), R(0x1735,0x1736), R(0x17d4,0x17d6), R(0x17d8,0x17da), R(0x1800,0x180a),
-            R(0x1944,0x1945), R(0x1a1e,0x1a1f), R(0x1aa0,0x1aa6), R(0x1aa8,0x1aad), R(0x1b5a,0x1b60),
-            R(0x1bfc,0x1bff), R(0x1c3b,0x1c3f), R(0x1c7e,0x1c7f), R(0x1cc0,0x1cc7), S(0x1cd3), R(0x2010,0x2027),
-            R(0x2030,0x2043), R(0x2045,0x2051), R(0x2053,0x205e), R(0x207d,0x207e), R(0x208d,0x208e),
-            R(0x2308,0x230b), R(0x2329,0x232a), R(0x2768,0x2775), R(0x27c5,0x27c6), R(0x27e6,0x27ef),
-            R(0x2983,0x2998), R(0x29d8,0x29db), R(0x29fc,0x29fd), R(0x2cf9,0x2cfc), R(0x2cfe,0x2cff), S(0x2d70),
-            R(0x2e00,0x2e2e), R(0x2e30,0x2e4f), S(0x2e52), R(0x3001,0x3003), R(0x3008,0x3011), R(0x3014,0x301f),
-            S(0x3030), S(0x303d), S(0x30a0), S(0x30fb), R(0xa4fe,0xa4ff), R(0xa60d,0xa60f), S(0xa673), S(0xa67e),
-            R(0xa6f2,0xa6f7), R(0xa874,0xa877), R(0xa8ce,0xa8cf), R(0xa8f8,0xa8fa), S(0xa8fc), R(0xa92e,0xa92f),
-            S(0xa95f), R(0xa9c1,0xa9cd), R(0xa9de,0xa9df), R(0xaa5c,0xaa5f), R(0xaade,0xaadf), R(0xaaf0,0xaaf1),
-            S(0xabeb), R(0xfd3e,0xfd3f), R(0xfe10,0xfe19), R(0xfe30,0xfe52), R(0xfe54,0xfe61), S(0xfe63), S(0xfe68),
-            R(0xfe6a,0xfe6b), R(0xff01,0xff03), R(0xff05,0xff0a), R(0xff0c,0xff0f), R(0xff1a,0xff1b),
-            R(0xff1f,0xff20), R(0xff3b,0xff3d), S(0xff3f), S(0xff5b), S(0xff5d), R(0xff5f,0xff65), R(0x10100,0x10102),
-            S(0x1039f), S(0x103d0), S(0x1056f), S(0x10857), S(0x1091f), S(0x1093f), R(0x10a50,0x10a58), S(0x10a7f),
-            R(0x10af0,0x10af6), R(0x10b39,0x10b3f), R(0x10b99,0x10b9c), S(0x10ead), R(0x10f55,0x10f59),
-            R(0x11047,0x1104d), R(0x110bb,0x110bc), R(0x110be,0x110c1), R(0x11140,0x11143), R(0x11174,0x11175),
-            R(0x111c5,0x111c8), S(0x111cd), S(0x111db), R(0x111dd,0x111df), R(0x11238,0x1123d), S(0x112a9),
-            R(0x1144b,0x1144f), R(0x1145a,0x1145b), S(0x1145d), S(0x114c6), R(0x115c1,0x115d7), R(0x11641,0x11643),
-            R(0x11660,0x1166c), R(0x1173c,0x1173e), S(0x1183b), R(0x11944,0x11946), S(0x119e2), R(0x11a3f,0x11a46),
-            R(0x11a9a,0x11a9c), R(0x11a9e,0x11aa2), R(0x11c41,0x11c45), R(0x11c70,0x11c71), R(0x11ef7,0x11ef8),
-            S(0x11fff), R(0x12470,0x12474), R(0x16a6e,0x16a6f), S(0x16af5), R(0x16b37,0x16b3b), S(0x16b44),
-            R(0x16e97,0x16e9a), S(0x16fe2), S(0x1bc9f), R(0x1da87,0x1da8b), R(0x1e95e,0x1e95f)
+#define PUNCT_MAP_SHIFT 2
+        static const unsigned char PUNCT_MAP_INDEX[] = {
+            0, 1, 2, 2, 2, 2, 3, 4, 2, 2, 5, 6, 7, 8, 9, 10, 11, 2, 12, 13, 14, 15, 2, 2, 16, 17, 2, 18, 19, 2, 20,
+            21, 22, 23, 2, 2, 2, 2, 24, 2, 25, 2, 2, 2, 26, 27, 28, 29, 30, 2, 31, 2, 32, 33, 34, 35, 36, 37, 2, 2, 2,
+            2, 2, 2, 38, 39, 2, 2, 2, 2, 40, 2, 2, 2, 2, 2, 2, 2, 41, 42, 2, 2, 2, 43, 2, 2, 2, 2, 2, 44, 15, 2, 45,
+            2, 2, 2, 46, 47, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 48, 2, 2, 49, 50, 2, 2, 51,
+            52, 53, 54, 55, 56, 2, 57, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 58, 2, 59, 2,
+            60, 2, 2, 2, 61, 2, 2, 2, 2, 62, 2, 2, 63, 2, 2, 2, 2, 2, 64, 2, 65, 2, 66, 67, 68, 69, 2, 2, 2, 2, 2, 70,
+            71, 2, 72, 73, 74, 75, 76, 77, 2, 2, 78, 79, 2, 80, 81, 2, 82, 2, 83, 2, 84, 85, 86, 87, 2, 2, 88, 2, 2,
+            2, 2, 89, 2, 90, 2, 2, 2, 2, 2, 2, 2, 2, 91, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 92, 93, 94, 2, 2, 2, 2, 2, 2, 95, 2, 85, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 96, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 97, 2, 2, 2, 2,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 98
+        };
+        static const unsigned PUNCT_MAP_DATA[] = {
+            0x00000000, 0x8c00f7ee, 0xb8000001, 0x28000000, 0x00000000, 0x88c00882, 0x00000000, 0x00000000,
+            0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x40000000,
+            0x00000080, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xfc000000, 0x00000000,
+            0x00000600, 0x40000000, 0x00000049, 0x00180000, 0xc8003600, 0x00000000, 0x00000000, 0x00003c00,
+            0x00000000, 0x00000000, 0x00100000, 0x00000000, 0x00003fff, 0x00000000, 0x00000000, 0x00000000,
+            0x00000000, 0x00000000, 0x00000000, 0x03800000, 0x00000000, 0x7fff0000, 0x40000000, 0x00000000,
+            0x00000000, 0x00000000, 0x00000000, 0x00010030, 0x00000000, 0x00000000, 0x00000000, 0x20000000,
+            0x00000000, 0x00000000, 0x00000000, 0x00400000, 0x00000000, 0x00000000, 0x00000000, 0x00010000,
+            0x00000000, 0x00000000, 0x00000000, 0x00800000, 0x00000010, 0x00000000, 0x00000000, 0x00000000,
+            0x00000000, 0x00000000, 0x00000000, 0x00100000, 0x00000000, 0x00000000, 0x0c008000, 0x00000000,
+            0x0017fff0, 0x3c000000, 0x00000000, 0x00000000, 0x00000020, 0x00000000, 0x061f0000, 0x00000000,
+            0x00000000, 0x00000000, 0x0000fc00, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x08000000,
+            0x00000000, 0x00000000, 0x00000000, 0x000001ff, 0x00000001, 0x00000000, 0x00000000, 0x00000000,
+            0x00000000, 0x00000000, 0x00000000, 0x00004000, 0x18000000, 0x00000000, 0x00000000, 0x00003800,
+            0x00000000, 0x00600000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x07700000, 0x00000000,
+            0x000007ff, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000030, 0x00000000,
+            0xc0000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00003f7f, 0x00000000, 0x00000000,
+            0x00000000, 0x00000000, 0xfc000000, 0x00000001, 0x00000000, 0x00000000, 0x00000000, 0xf0000000,
+            0x00000000, 0xf8000000, 0x00000000, 0xc0000000, 0x00000000, 0x00000000, 0x000800ff, 0x00000000,
+            0xffff0000, 0xffff00ff, 0x7ffbffef, 0x60000000, 0x00006000, 0x00000000, 0x00000000, 0x00000000,
+            0x00000f00, 0x00000600, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x003fff00,
+            0x00000000, 0x00000000, 0x00000060, 0x0000ffc0, 0x01fffff8, 0x00000000, 0x0f000000, 0x30000000,
+            0x00000000, 0x00000000, 0x00000000, 0xde000000, 0xffffffff, 0xffff7fff, 0x0004ffff, 0x00000000,
+            0xfff3ff0e, 0x20010000, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0x00000000, 0x08000000,
+            0x00000000, 0x00000000, 0x00000000, 0xc0000000, 0x0000e000, 0x00000000, 0x00000000, 0x40080000,
+            0x00000000, 0x00000000, 0x00000000, 0x00fc0000, 0x00000000, 0x00000000, 0x00000000, 0x00f00000,
+            0x00000000, 0x00000000, 0x0000c000, 0x17000000, 0x00000000, 0x0000c000, 0x80000000, 0x00000000,
+            0x00000000, 0x00000000, 0xc0003ffe, 0x00000000, 0x00000000, 0x00000000, 0xf0000000, 0x00000000,
+            0x00000000, 0x00000000, 0xc0000000, 0x00030000, 0x00000000, 0x00000000, 0x00000000, 0x00000800,
+            0x00000000, 0xc0000000, 0x00000000, 0x00000000, 0x03ff0000, 0xffff0000, 0xfff7ffff, 0x00000d0b,
+            0x8c00f7ee, 0xb8000001, 0xa8000000, 0x0000003f, 0x00000007, 0x00000000, 0x00000000, 0x00000000,
+            0x80000000, 0x00000000, 0x00010000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00008000,
+            0x00000000, 0x00000000, 0x00800000, 0x00000000, 0x80000000, 0x80000000, 0x00000000, 0x00000000,
+            0x00000000, 0x00000000, 0x01ff0000, 0x80000000, 0x00000000, 0x00000000, 0x00000000, 0x007f0000,
+            0x00000000, 0xfe000000, 0x00000000, 0x00000000, 0x1e000000, 0x00000000, 0x00000000, 0x00000000,
+            0x00000000, 0x00002000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x03e00000, 0x00000000,
+            0x00000000, 0x00000000, 0x00003f80, 0x00000000, 0x00000000, 0xd8000000, 0x00000003, 0x00000000,
+            0x00000000, 0x00000000, 0x0000000f, 0x00300000, 0x00000000, 0x00000000, 0xe80021e0, 0x00000000,
+            0x00000000, 0x3f000000, 0x00000000, 0x00000000, 0x00000000, 0x00000200, 0x00000000, 0x00000000,
+            0x00000000, 0x00000000, 0x2c00f800, 0x00000000, 0x00000000, 0x00000000, 0x00000040, 0x00000000,
+            0x00000000, 0x00000000, 0x00fffffe, 0x00000000, 0x00000000, 0x00000000, 0x0000000e, 0x00001fff,
+            0x00000000, 0x70000000, 0x00000000, 0x00000000, 0x00000000, 0x08000000, 0x00000000, 0x00000000,
+            0x00000000, 0x00000000, 0x00000070, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000004,
+            0x00000000, 0x80000000, 0x0000007f, 0x00000000, 0xdc000000, 0x00000007, 0x00000000, 0x00000000,
+            0x00000000, 0x00000000, 0x0000003e, 0x00030000, 0x00000000, 0x00000000, 0x00000000, 0x01800000,
+            0x00000000, 0x00000000, 0x00000000, 0x80000000, 0x00000000, 0x00000000, 0x00000000, 0x001f0000,
+            0x00000000, 0x00000000, 0x00000000, 0x0000c000, 0x00000000, 0x00000000, 0x00000000, 0x00200000,
+            0x00000000, 0x0f800000, 0x00000010, 0x00000000, 0x07800000, 0x00000000, 0x00000000, 0x00000000,
+            0x80000000, 0x00000000, 0x00000000, 0x00000000, 0x00000f80, 0x00000000, 0x00000000, 0x00000000,
+            0x00000000, 0x00000000, 0xc0000000, 0x00000000
         };
-#undef R
-#undef S
 
         /* The ASCII ones are the most frequently used ones, also CommonMark
          * specification requests few more in this range. */
         if(codepoint <= 0x7f)
             return ISPUNCT_(codepoint);
 
-        return (md_unicode_bsearch__(codepoint, PUNCT_MAP, SIZEOF_ARRAY(PUNCT_MAP)) >= 0);
+        return md_unicode_bitmap__(codepoint, PUNCT_MAP_INDEX, SIZEOF_ARRAY(PUNCT_MAP_INDEX),
+                                   PUNCT_MAP_DATA, PUNCT_MAP_SHIFT);
+#undef PUNCT_MAP_SHIFT
     }
 
     static void
     md_get_unicode_fold_info(unsigned codepoint, MD_UNICODE_FOLD_INFO* info)
     {
-#define R(cp_min, cp_max)   ((cp_min) | 0x40000000), ((cp_max) | 0x80000000)
-#define S(cp)               (cp)
-        /* Unicode "Pc", "Pd", "Pe", "Pf", "Pi", "Po", "Ps" categories.
+        /* Unicode case folding ("C" and "F" statuses). Each codepoint maps to a
+         * record (N, DELTA, CP1, CP2): It folds into N codepoints, the 1st one
+         * is the codepoint plus DELTA, the others are CP1 and CP2.
          * (generated by scripts/build_folding_map.py) */
-        static const unsigned FOLD_MAP_1[] = {
-            R(0x0041,0x005a), S(0x00b5), R(0x00c0,0x00d6), R(0x00d8,0x00de), R(0x0100,0x012e), R(0x0132,0x0136),
-            R(0x0139,0x0147), R(0x014a,0x0176), S(0x0178), R(0x0179,0x017d), S(0x017f), S(0x0181), S(0x0182),
-            S(0x0184), S(0x0186), S(0x0187), S(0x0189), S(0x018a), S(0x018b), S(0x018e), S(0x018f), S(0x0190),
-            S(0x0191), S(0x0193), S(0x0194), S(0x0196), S(0x0197), S(0x0198), S(0x019c), S(0x019d), S(0x019f),
-            R(0x01a0,0x01a4), S(0x01a6), S(0x01a7), S(0x01a9), S(0x01ac), S(0x01ae), S(0x01af), S(0x01b1), S(0x01b2),
-            S(0x01b3), S(0x01b5), S(0x01b7), S(0x01b8), S(0x01bc), S(0x01c4), S(0x01c5), S(0x01c7), S(0x01c8),
-            S(0x01ca), R(0x01cb,0x01db), R(0x01de,0x01ee), S(0x01f1), S(0x01f2), S(0x01f4), S(0x01f6), S(0x01f7),
-            R(0x01f8,0x021e), S(0x0220), R(0x0222,0x0232), S(0x023a), S(0x023b), S(0x023d), S(0x023e), S(0x0241),
-            S(0x0243), S(0x0244), S(0x0245), R(0x0246,0x024e), S(0x0345), S(0x0370), S(0x0372), S(0x0376), S(0x037f),
-            S(0x0386), R(0x0388,0x038a), S(0x038c), S(0x038e), S(0x038f), R(0x0391,0x03a1), R(0x03a3,0x03ab),
-            S(0x03c2), S(0x03cf), S(0x03d0), S(0x03d1), S(0x03d5), S(0x03d6), R(0x03d8,0x03ee), S(0x03f0), S(0x03f1),
-            S(0x03f4), S(0x03f5), S(0x03f7), S(0x03f9), S(0x03fa), R(0x03fd,0x03ff), R(0x0400,0x040f),
-            R(0x0410,0x042f), R(0x0460,0x0480), R(0x048a,0x04be), S(0x04c0), R(0x04c1,0x04cd), R(0x04d0,0x052e),
-            R(0x0531,0x0556), R(0x10a0,0x10c5), S(0x10c7), S(0x10cd), R(0x13f8,0x13fd), S(0x1c80), S(0x1c81),
-            S(0x1c82), S(0x1c83), S(0x1c84), S(0x1c85), S(0x1c86), S(0x1c87), S(0x1c88), R(0x1c90,0x1cba),
-            R(0x1cbd,0x1cbf), R(0x1e00,0x1e94), S(0x1e9b), R(0x1ea0,0x1efe), R(0x1f08,0x1f0f), R(0x1f18,0x1f1d),
-            R(0x1f28,0x1f2f), R(0x1f38,0x1f3f), R(0x1f48,0x1f4d), S(0x1f59), S(0x1f5b), S(0x1f5d), S(0x1f5f),
-            R(0x1f68,0x1f6f), S(0x1fb8), S(0x1fb9), S(0x1fba), S(0x1fbb), S(0x1fbe), R(0x1fc8,0x1fcb), S(0x1fd8),
-            S(0x1fd9), S(0x1fda), S(0x1fdb), S(0x1fe8), S(0x1fe9), S(0x1fea), S(0x1feb), S(0x1fec), S(0x1ff8),
-            S(0x1ff9), S(0x1ffa), S(0x1ffb), S(0x2126), S(0x212a), S(0x212b), S(0x2132), R(0x2160,0x216f), S(0x2183),
-            R(0x24b6,0x24cf), R(0x2c00,0x2c2e), S(0x2c60), S(0x2c62), S(0x2c63), S(0x2c64), R(0x2c67,0x2c6b),
-            S(0x2c6d), S(0x2c6e), S(0x2c6f), S(0x2c70), S(0x2c72), S(0x2c75), S(0x2c7e), S(0x2c7f), R(0x2c80,0x2ce2),
-            S(0x2ceb), S(0x2ced), S(0x2cf2), R(0xa640,0xa66c), R(0xa680,0xa69a), R(0xa722,0xa72e), R(0xa732,0xa76e),
-            S(0xa779), S(0xa77b), S(0xa77d), R(0xa77e,0xa786), S(0xa78b), S(0xa78d), S(0xa790), S(0xa792),
-            R(0xa796,0xa7a8), S(0xa7aa), S(0xa7ab), S(0xa7ac), S(0xa7ad), S(0xa7ae), S(0xa7b0), S(0xa7b1), S(0xa7b2),
-            S(0xa7b3), R(0xa7b4,0xa7be), S(0xa7c2), S(0xa7c4), S(0xa7c5), S(0xa7c6), S(0xa7c7), S(0xa7c9), S(0xa7f5),
-            R(0xab70,0xabbf), R(0xff21,0xff3a), R(0x10400,0x10427), R(0x104b0,0x104d3), R(0x10c80,0x10cb2),
-            R(0x118a0,0x118bf), R(0x16e40,0x16e5f), R(0x1e900,0x1e921)
-        };
-        static const unsigned FOLD_MAP_1_DATA[] = {
-            0x0061, 0x007a, 0x03bc, 0x00e0, 0x00f6, 0x00f8, 0x00fe, 0x0101, 0x012f, 0x0133, 0x0137, 0x013a, 0x0148,
-            0x014b, 0x0177, 0x00ff, 0x017a, 0x017e, 0x0073, 0x0253, 0x0183, 0x0185, 0x0254, 0x0188, 0x0256, 0x0257,
-            0x018c, 0x01dd, 0x0259, 0x025b, 0x0192, 0x0260, 0x0263, 0x0269, 0x0268, 0x0199, 0x026f, 0x0272, 0x0275,
-            0x01a1, 0x01a5, 0x0280, 0x01a8, 0x0283, 0x01ad, 0x0288, 0x01b0, 0x028a, 0x028b, 0x01b4, 0x01b6, 0x0292,
-            0x01b9, 0x01bd, 0x01c6, 0x01c6, 0x01c9, 0x01c9, 0x01cc, 0x01cc, 0x01dc, 0x01df, 0x01ef, 0x01f3, 0x01f3,
-            0x01f5, 0x0195, 0x01bf, 0x01f9, 0x021f, 0x019e, 0x0223, 0x0233, 0x2c65, 0x023c, 0x019a, 0x2c66, 0x0242,
-            0x0180, 0x0289, 0x028c, 0x0247, 0x024f, 0x03b9, 0x0371, 0x0373, 0x0377, 0x03f3, 0x03ac, 0x03ad, 0x03af,
-            0x03cc, 0x03cd, 0x03ce, 0x03b1, 0x03c1, 0x03c3, 0x03cb, 0x03c3, 0x03d7, 0x03b2, 0x03b8, 0x03c6, 0x03c0,
-            0x03d9, 0x03ef, 0x03ba, 0x03c1, 0x03b8, 0x03b5, 0x03f8, 0x03f2, 0x03fb, 0x037b, 0x037d, 0x0450, 0x045f,
-            0x0430, 0x044f, 0x0461, 0x0481, 0x048b, 0x04bf, 0x04cf, 0x04c2, 0x04ce, 0x04d1, 0x052f, 0x0561, 0x0586,
-            0x2d00, 0x2d25, 0x2d27, 0x2d2d, 0x13f0, 0x13f5, 0x0432, 0x0434, 0x043e, 0x0441, 0x0442, 0x0442, 0x044a,
-            0x0463, 0xa64b, 0x10d0, 0x10fa, 0x10fd, 0x10ff, 0x1e01, 0x1e95, 0x1e61, 0x1ea1, 0x1eff, 0x1f00, 0x1f07,
-            0x1f10, 0x1f15, 0x1f20, 0x1f27, 0x1f30, 0x1f37, 0x1f40, 0x1f45, 0x1f51, 0x1f53, 0x1f55, 0x1f57, 0x1f60,
-            0x1f67, 0x1fb0, 0x1fb1, 0x1f70, 0x1f71, 0x03b9, 0x1f72, 0x1f75, 0x1fd0, 0x1fd1, 0x1f76, 0x1f77, 0x1fe0,
-            0x1fe1, 0x1f7a, 0x1f7b, 0x1fe5, 0x1f78, 0x1f79, 0x1f7c, 0x1f7d, 0x03c9, 0x006b, 0x00e5, 0x214e, 0x2170,
-            0x217f, 0x2184, 0x24d0, 0x24e9, 0x2c30, 0x2c5e, 0x2c61, 0x026b, 0x1d7d, 0x027d, 0x2c68, 0x2c6c, 0x0251,
-            0x0271, 0x0250, 0x0252, 0x2c73, 0x2c76, 0x023f, 0x0240, 0x2c81, 0x2ce3, 0x2cec, 0x2cee, 0x2cf3, 0xa641,
-            0xa66d, 0xa681, 0xa69b, 0xa723, 0xa72f, 0xa733, 0xa76f, 0xa77a, 0xa77c, 0x1d79, 0xa77f, 0xa787, 0xa78c,
-            0x0265, 0xa791, 0xa793, 0xa797, 0xa7a9, 0x0266, 0x025c, 0x0261, 0x026c, 0x026a, 0x029e, 0x0287, 0x029d,
-            0xab53, 0xa7b5, 0xa7bf, 0xa7c3, 0xa794, 0x0282, 0x1d8e, 0xa7c8, 0xa7ca, 0xa7f6, 0x13a0, 0x13ef, 0xff41,
-            0xff5a, 0x10428, 0x1044f, 0x104d8, 0x104fb, 0x10cc0, 0x10cf2, 0x118c0, 0x118df, 0x16e60, 0x16e7f, 0x1e922,
-            0x1e943
-        };
-        static const unsigned FOLD_MAP_2[] = {
-            S(0x00df), S(0x0130), S(0x0149), S(0x01f0), S(0x0587), S(0x1e96), S(0x1e97), S(0x1e98), S(0x1e99),
-            S(0x1e9a), S(0x1e9e), S(0x1f50), R(0x1f80,0x1f87), R(0x1f88,0x1f8f), R(0x1f90,0x1f97), R(0x1f98,0x1f9f),
-            R(0x1fa0,0x1fa7), R(0x1fa8,0x1faf), S(0x1fb2), S(0x1fb3), S(0x1fb4), S(0x1fb6), S(0x1fbc), S(0x1fc2),
-            S(0x1fc3), S(0x1fc4), S(0x1fc6), S(0x1fcc), S(0x1fd6), S(0x1fe4), S(0x1fe6), S(0x1ff2), S(0x1ff3),
-            S(0x1ff4), S(0x1ff6), S(0x1ffc), S(0xfb00), S(0xfb01), S(0xfb02), S(0xfb05), S(0xfb06), S(0xfb13),
-            S(0xfb14), S(0xfb15), S(0xfb16), S(0xfb17)
-        };
-        static const unsigned FOLD_MAP_2_DATA[] = {
-            0x0073,0x0073, 0x0069,0x0307, 0x02bc,0x006e, 0x006a,0x030c, 0x0565,0x0582, 0x0068,0x0331, 0x0074,0x0308,
-            0x0077,0x030a, 0x0079,0x030a, 0x0061,0x02be, 0x0073,0x0073, 0x03c5,0x0313, 0x1f00,0x03b9, 0x1f07,0x03b9,
-            0x1f00,0x03b9, 0x1f07,0x03b9, 0x1f20,0x03b9, 0x1f27,0x03b9, 0x1f20,0x03b9, 0x1f27,0x03b9, 0x1f60,0x03b9,
-            0x1f67,0x03b9, 0x1f60,0x03b9, 0x1f67,0x03b9, 0x1f70,0x03b9, 0x03b1,0x03b9, 0x03ac,0x03b9, 0x03b1,0x0342,
-            0x03b1,0x03b9, 0x1f74,0x03b9, 0x03b7,0x03b9, 0x03ae,0x03b9, 0x03b7,0x0342, 0x03b7,0x03b9, 0x03b9,0x0342,
-            0x03c1,0x0313, 0x03c5,0x0342, 0x1f7c,0x03b9, 0x03c9,0x03b9, 0x03ce,0x03b9, 0x03c9,0x0342, 0x03c9,0x03b9,
-            0x0066,0x0066, 0x0066,0x0069, 0x0066,0x006c, 0x0073,0x0074, 0x0073,0x0074, 0x0574,0x0576, 0x0574,0x0565,
-            0x0574,0x056b, 0x057e,0x0576, 0x0574,0x056d
+#define FOLD_MAP_SHIFT 5
+        static const unsigned char FOLD_MAP_INDEX[] = {
+            0, 0, 1, 0, 0, 2, 3, 0, 4, 5, 6, 7, 8, 9, 10, 11, 4, 12, 13, 0, 0, 0, 0, 0, 0, 0, 14, 15, 16, 17, 18, 19,
+            20, 21, 0, 4, 22, 4, 23, 4, 4, 24, 25, 0, 26, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 27, 28,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 29, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 30, 31, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            4, 4, 4, 4, 32, 4, 4, 4, 33, 34, 35, 36, 37, 38, 39, 40, 0, 0, 0, 0, 0, 0, 0, 0, 0, 41, 0, 42, 43, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 44, 45, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 46, 47, 0, 48, 4, 4, 4, 49, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 50, 51, 0, 0, 0, 0, 52, 4, 53, 54, 55, 56, 57, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 58, 59, 59, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 60, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 61, 62, 0, 0, 0, 63,
+            64, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 65, 66, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 67, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 67, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 68, 69
         };
-        static const unsigned FOLD_MAP_3[] = {
-            S(0x0390), S(0x03b0), S(0x1f52), S(0x1f54), S(0x1f56), S(0x1fb7), S(0x1fc7), S(0x1fd2), S(0x1fd3),
-            S(0x1fd7), S(0x1fe2), S(0x1fe3), S(0x1fe7), S(0x1ff7), S(0xfb03), S(0xfb04)
+        static const unsigned short FOLD_MAP_DATA[] = {
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1,
+            1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+            1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 96, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0,
+            3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3,
+            0, 97, 0, 3, 0, 3, 0, 3, 0, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 98, 3, 0, 3, 0, 3, 0, 3, 0,
+            3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3,
+            0, 3, 0, 4, 3, 0, 3, 0, 3, 0, 5, 0, 6, 3, 0, 3, 0, 7, 3, 0, 8, 8, 3, 0, 0, 9, 10, 11, 3, 0, 8, 12, 0, 13,
+            14, 3, 0, 0, 0, 13, 15, 0, 16, 3, 0, 3, 0, 3, 0, 17, 3, 0, 17, 0, 0, 3, 0, 17, 3, 0, 18, 18, 3, 0, 3, 0,
+            19, 3, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 20, 3, 0, 20, 3, 0, 20, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0,
+            3, 0, 3, 0, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 99, 20, 3, 0, 3, 0, 21, 22, 3, 0, 3,
+            0, 3, 0, 3, 0, 23, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 0, 0, 0, 0, 0, 0, 24, 3, 0,
+            25, 26, 0, 0, 3, 0, 27, 28, 29, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 30, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 3, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 30, 0, 0, 0, 0, 0,
+            0, 31, 0, 32, 32, 32, 0, 33, 0, 34, 34, 142, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1,
+            1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 143, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 35, 36, 37, 0, 0, 0, 38, 39, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0,
+            3, 0, 3, 0, 3, 0, 40, 41, 0, 0, 42, 43, 0, 3, 0, 44, 3, 0, 0, 23, 23, 23, 45, 45, 45, 45, 45, 45, 45, 45,
+            45, 45, 45, 45, 45, 45, 45, 45, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+            1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0,
+            3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 46, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0,
+            0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 0, 47,
+            47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47,
+            47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 100, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+            48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+            48, 0, 48, 0, 0, 0, 0, 0, 48, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 49, 49, 49, 49, 49, 49, 0, 0, 50, 51, 52, 53, 53, 54,
+            55, 56, 57, 0, 0, 0, 0, 0, 0, 0, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58,
+            58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 0, 0,
+            58, 58, 58, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 101, 102, 103, 104, 105, 59,
+            0, 0, 106, 0, 0, 0, 0, 0, 0, 0, 0, 0, 49, 49, 49, 49, 49, 49, 49, 49, 0, 0, 0, 0, 0, 0, 0, 0, 49, 49, 49,
+            49, 49, 49, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 49, 49, 49, 49, 49, 49, 49, 49, 0, 0, 0, 0, 0, 0, 0, 0, 49, 49,
+            49, 49, 49, 49, 49, 49, 0, 0, 0, 0, 0, 0, 0, 0, 49, 49, 49, 49, 49, 49, 0, 0, 107, 0, 144, 0, 145, 0, 146,
+            0, 0, 49, 0, 49, 0, 49, 0, 49, 0, 0, 0, 0, 0, 0, 0, 0, 49, 49, 49, 49, 49, 49, 49, 49, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 108, 108, 108, 108, 108, 108, 108, 108, 109, 109, 109, 109, 109, 109, 109,
+            109, 110, 110, 110, 110, 110, 110, 110, 110, 111, 111, 111, 111, 111, 111, 111, 111, 112, 112, 112, 112,
+            112, 112, 112, 112, 113, 113, 113, 113, 113, 113, 113, 113, 0, 0, 114, 115, 116, 0, 117, 147, 49, 49, 60,
+            60, 118, 0, 61, 0, 0, 0, 119, 120, 121, 0, 122, 148, 62, 62, 62, 62, 123, 0, 0, 0, 0, 0, 149, 150, 0, 0,
+            124, 151, 49, 49, 63, 63, 0, 0, 0, 0, 0, 0, 152, 153, 125, 0, 126, 154, 49, 49, 64, 64, 44, 0, 0, 0, 0, 0,
+            127, 128, 129, 0, 130, 155, 65, 65, 66, 66, 131, 0, 0, 0, 0, 0, 0, 0, 0, 0, 67, 0, 0, 0, 68, 69, 0, 0, 0,
+            0, 0, 0, 70, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71,
+            71, 71, 71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72,
+            72, 72, 72, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47,
+            47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47,
+            47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 73, 74,
+            75, 0, 0, 3, 0, 3, 0, 3, 0, 76, 77, 78, 79, 0, 3, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 80, 80, 3, 0, 3, 0, 0,
+            0, 0, 0, 0, 0, 0, 3, 0, 3, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 3, 0, 3, 0, 3, 0,
+            3, 0, 3, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3,
+            0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 0, 0, 0, 0, 0, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0,
+            3, 0, 0, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 3, 0, 81, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 0, 0, 0, 3, 0, 82, 0, 0, 3, 0, 3, 0,
+            0, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 83, 84, 85, 86, 83, 0, 87, 88, 89, 90,
+            3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 3, 0, 0, 0, 3, 0, 41, 91, 92, 3, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 93, 93, 93, 93, 93, 93, 93, 93, 93,
+            93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93,
+            93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 93, 132, 133, 134, 156, 157, 135, 136, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 137, 138, 139, 140, 141, 0, 0, 0, 0, 0, 0, 0, 0, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94,
+            94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94,
+            94, 94, 94, 94, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94,
+            94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 94, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33,
+            33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+            1, 1, 1, 1, 1, 1, 1, 1, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95,
+            95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 95, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
         };
-        static const unsigned FOLD_MAP_3_DATA[] = {
-            0x03b9,0x0308,0x0301, 0x03c5,0x0308,0x0301, 0x03c5,0x0313,0x0300, 0x03c5,0x0313,0x0301,
-            0x03c5,0x0313,0x0342, 0x03b1,0x0342,0x03b9, 0x03b7,0x0342,0x03b9, 0x03b9,0x0308,0x0300,
-            0x03b9,0x0308,0x0301, 0x03b9,0x0308,0x0342, 0x03c5,0x0308,0x0300, 0x03c5,0x0308,0x0301,
-            0x03c5,0x0308,0x0342, 0x03c9,0x0342,0x03b9, 0x0066,0x0066,0x0069, 0x0066,0x0066,0x006c
-        };
-#undef R
-#undef S
-        static const struct {
-            const unsigned* map;
-            const unsigned* data;
-            size_t map_size;
-            unsigned n_codepoints;
-        } FOLD_MAP_LIST[] = {
-            { FOLD_MAP_1, FOLD_MAP_1_DATA, SIZEOF_ARRAY(FOLD_MAP_1), 1 },
-            { FOLD_MAP_2, FOLD_MAP_2_DATA, SIZEOF_ARRAY(FOLD_MAP_2), 2 },
-            { FOLD_MAP_3, FOLD_MAP_3_DATA, SIZEOF_ARRAY(FOLD_MAP_3), 3 }
+        static const int FOLD_MAP_RECORDS[][4] = {
+            { 1, 0, 0x0000, 0x0000 }, { 1, 32, 0x0000, 0x0000 }, { 1, 775, 0x0000, 0x0000 }, { 1, 1, 0x0000, 0x0000 },
+            { 1, -121, 0x0000, 0x0000 }, { 1, -268, 0x0000, 0x0000 }, { 1, 210, 0x0000, 0x0000 }, { 1, 206, 0x0000,
+            0x0000 }, { 1, 205, 0x0000, 0x0000 }, { 1, 79, 0x0000, 0x0000 }, { 1, 202, 0x0000, 0x0000 }, { 1, 203,
+            0x0000, 0x0000 }, { 1, 207, 0x0000, 0x0000 }, { 1, 211, 0x0000, 0x0000 }, { 1, 209, 0x0000, 0x0000 }, { 1,
+            213, 0x0000, 0x0000 }, { 1, 214, 0x0000, 0x0000 }, { 1, 218, 0x0000, 0x0000 }, { 1, 217, 0x0000, 0x0000 },
+            { 1, 219, 0x0000, 0x0000 }, { 1, 2, 0x0000, 0x0000 }, { 1, -97, 0x0000, 0x0000 }, { 1, -56, 0x0000, 0x0000
+            }, { 1, -130, 0x0000, 0x0000 }, { 1, 10795, 0x0000, 0x0000 }, { 1, -163, 0x0000, 0x0000 }, { 1, 10792,
+            0x0000, 0x0000 }, { 1, -195, 0x0000, 0x0000 }, { 1, 69, 0x0000, 0x0000 }, { 1, 71, 0x0000, 0x0000 }, { 1,
+            116, 0x0000, 0x0000 }, { 1, 38, 0x0000, 0x0000 }, { 1, 37, 0x0000, 0x0000 }, { 1, 64, 0x0000, 0x0000 }, {
+            1, 63, 0x0000, 0x0000 }, { 1, 8, 0x0000, 0x0000 }, { 1, -30, 0x0000, 0x0000 }, { 1, -25, 0x0000, 0x0000 },
+            { 1, -15, 0x0000, 0x0000 }, { 1, -22, 0x0000, 0x0000 }, { 1, -54, 0x0000, 0x0000 }, { 1, -48, 0x0000,
+            0x0000 }, { 1, -60, 0x0000, 0x0000 }, { 1, -64, 0x0000, 0x0000 }, { 1, -7, 0x0000, 0x0000 }, { 1, 80,
+            0x0000, 0x0000 }, { 1, 15, 0x0000, 0x0000 }, { 1, 48, 0x0000, 0x0000 }, { 1, 7264, 0x0000, 0x0000 }, { 1,
+            -8, 0x0000, 0x0000 }, { 1, -6222, 0x0000, 0x0000 }, { 1, -6221, 0x0000, 0x0000 }, { 1, -6212, 0x0000,
+            0x0000 }, { 1, -6210, 0x0000, 0x0000 }, { 1, -6211, 0x0000, 0x0000 }, { 1, -6204, 0x0000, 0x0000 }, { 1,
+            -6180, 0x0000, 0x0000 }, { 1, 35267, 0x0000, 0x0000 }, { 1, -3008, 0x0000, 0x0000 }, { 1, -58, 0x0000,
+            0x0000 }, { 1, -74, 0x0000, 0x0000 }, { 1, -7173, 0x0000, 0x0000 }, { 1, -86, 0x0000, 0x0000 }, { 1, -100,
+            0x0000, 0x0000 }, { 1, -112, 0x0000, 0x0000 }, { 1, -128, 0x0000, 0x0000 }, { 1, -126, 0x0000, 0x0000 }, {
+            1, -7517, 0x0000, 0x0000 }, { 1, -8383, 0x0000, 0x0000 }, { 1, -8262, 0x0000, 0x0000 }, { 1, 28, 0x0000,
+            0x0000 }, { 1, 16, 0x0000, 0x0000 }, { 1, 26, 0x0000, 0x0000 }, { 1, -10743, 0x0000, 0x0000 }, { 1, -3814,
+            0x0000, 0x0000 }, { 1, -10727, 0x0000, 0x0000 }, { 1, -10780, 0x0000, 0x0000 }, { 1, -10749, 0x0000,
+            0x0000 }, { 1, -10783, 0x0000, 0x0000 }, { 1, -10782, 0x0000, 0x0000 }, { 1, -10815, 0x0000, 0x0000 }, {
+            1, -35332, 0x0000, 0x0000 }, { 1, -42280, 0x0000, 0x0000 }, { 1, -42308, 0x0000, 0x0000 }, { 1, -42319,
+            0x0000, 0x0000 }, { 1, -42315, 0x0000, 0x0000 }, { 1, -42305, 0x0000, 0x0000 }, { 1, -42258, 0x0000,
+            0x0000 }, { 1, -42282, 0x0000, 0x0000 }, { 1, -42261, 0x0000, 0x0000 }, { 1, 928, 0x0000, 0x0000 }, { 1,
+            -42307, 0x0000, 0x0000 }, { 1, -35384, 0x0000, 0x0000 }, { 1, -38864, 0x0000, 0x0000 }, { 1, 40, 0x0000,
+            0x0000 }, { 1, 34, 0x0000, 0x0000 }, { 2, -108, 0x0073, 0x0000 }, { 2, -199, 0x0307, 0x0000 }, { 2, 371,
+            0x006e, 0x0000 }, { 2, -390, 0x030c, 0x0000 }, { 2, -34, 0x0582, 0x0000 }, { 2, -7726, 0x0331, 0x0000 }, {
+            2, -7715, 0x0308, 0x0000 }, { 2, -7713, 0x030a, 0x0000 }, { 2, -7712, 0x030a, 0x0000 }, { 2, -7737,
+            0x02be, 0x0000 }, { 2, -7723, 0x0073, 0x0000 }, { 2, -7051, 0x0313, 0x0000 }, { 2, -128, 0x03b9, 0x0000 },
+            { 2, -136, 0x03b9, 0x0000 }, { 2, -112, 0x03b9, 0x0000 }, { 2, -120, 0x03b9, 0x0000 }, { 2, -64, 0x03b9,
+            0x0000 }, { 2, -72, 0x03b9, 0x0000 }, { 2, -66, 0x03b9, 0x0000 }, { 2, -7170, 0x03b9, 0x0000 }, { 2,
+            -7176, 0x03b9, 0x0000 }, { 2, -7173, 0x0342, 0x0000 }, { 2, -7179, 0x03b9, 0x0000 }, { 2, -78, 0x03b9,
+            0x0000 }, { 2, -7180, 0x03b9, 0x0000 }, { 2, -7190, 0x03b9, 0x0000 }, { 2, -7183, 0x0342, 0x0000 }, { 2,
+            -7189, 0x03b9, 0x0000 }, { 2, -7197, 0x0342, 0x0000 }, { 2, -7203, 0x0313, 0x0000 }, { 2, -7201, 0x0342,
+            0x0000 }, { 2, -118, 0x03b9, 0x0000 }, { 2, -7210, 0x03b9, 0x0000 }, { 2, -7206, 0x03b9, 0x0000 }, { 2,
+            -7213, 0x0342, 0x0000 }, { 2, -7219, 0x03b9, 0x0000 }, { 2, -64154, 0x0066, 0x0000 }, { 2, -64155, 0x0069,
+            0x0000 }, { 2, -64156, 0x006c, 0x0000 }, { 2, -64146, 0x0074, 0x0000 }, { 2, -64147, 0x0074, 0x0000 }, {
+            2, -62879, 0x0576, 0x0000 }, { 2, -62880, 0x0565, 0x0000 }, { 2, -62881, 0x056b, 0x0000 }, { 2, -62872,
+            0x0576, 0x0000 }, { 2, -62883, 0x056d, 0x0000 }, { 3, 41, 0x0308, 0x0301 }, { 3, 21, 0x0308, 0x0301 }, {
+            3, -7053, 0x0313, 0x0300 }, { 3, -7055, 0x0313, 0x0301 }, { 3, -7057, 0x0313, 0x0342 }, { 3, -7174,
+            0x0342, 0x03b9 }, { 3, -7184, 0x0342, 0x03b9 }, { 3, -7193, 0x0308, 0x0300 }, { 3, -7194, 0x0308, 0x0301
+            }, { 3, -7198, 0x0308, 0x0342 }, { 3, -7197, 0x0308, 0x0300 }, { 3, -7198, 0x0308, 0x0301 }, { 3, -7202,
+            0x0308, 0x0342 }, { 3, -7214, 0x0342, 0x03b9 }, { 3, -64157, 0x0066, 0x0069 }, { 3, -64158, 0x0066, 0x006c
+            }
         };
 
-        int i;
+        unsigned block = codepoint >> FOLD_MAP_SHIFT;
+        const int* record;
 
         /* Fast path for ASCII characters. */
         if(codepoint <= 0x7f) {
@@ -695,39 +1434,19 @@ struct MD_UNICODE_FOLD_INFO_tag {
             return;
         }
 
-        /* Try to locate the codepoint in any of the maps. */
-        for(i = 0; i < (int) SIZEOF_ARRAY(FOLD_MAP_LIST); i++) {
-            int index;
-
-            index = md_unicode_bsearch__(codepoint, FOLD_MAP_LIST[i].map, FOLD_MAP_LIST[i].map_size);
-            if(index >= 0) {
-                /* Found the mapping. */
-                unsigned n_codepoints = FOLD_MAP_LIST[i].n_codepoints;
-                const unsigned* map = FOLD_MAP_LIST[i].map;
-                const unsigned* codepoints = FOLD_MAP_LIST[i].data + (index * n_codepoints);
-
-                memcpy(info->codepoints, codepoints, sizeof(unsigned) * n_codepoints);
-                info->n_codepoints = n_codepoints;
-
-                if(FOLD_MAP_LIST[i].map[index] != codepoint) {
-                    /* The found mapping maps whole range of codepoints,
-                     * i.e. we have to offset info->codepoints[0] accordingly. */
-                    if((map[index] & 0x00ffffff)+1 == codepoints[0]) {
-                        /* Alternating type of the range. */
-                        info->codepoints[0] = codepoint + ((codepoint & 0x1) == (map[index] & 0x1) ? 1 : 0);
-                    } else {
-                        /* Range to range kind of mapping. */
-                        info->codepoints[0] += (codepoint - (map[index] & 0x00ffffff));
-                    }
-                }
-
-                return;
-            }
+        if(block < SIZEOF_ARRAY(FOLD_MAP_INDEX)) {
+            record = FOLD_MAP_RECORDS[FOLD_MAP_DATA[((unsigned) FOLD_MAP_INDEX[block] << FOLD_MAP_SHIFT) +
+                                                    (codepoint & ((1U << FOLD_MAP_SHIFT) - 1))]];
+        } else {
+            /* No mapping. Map the codepoint to itself. */
+            record = FOLD_MAP_RECORDS[0];
         }
+#undef FOLD_MAP_SHIFT
 
-        /* No mapping found. Map the codepoint to itself. */
-        info->codepoints[0] = codepoint;
-        info->n_codepoints = 1;
+        info->codepoints[0] = codepoint + record[1];
+        info->codepoints[1] = (unsigned) record[2];
+        info->codepoints[2] = (unsigned) record[3];
+        info->n_codepoints = (unsigned) record[0];
     }
 #endif
 
@@ -936,7 +1655,7 @@ md_merge_lines_alloc(MD_CTX* ctx, OFF beg, OFF end, const MD_LINE* lines, int n_
 {
     CHAR* buffer;
 
-    buffer = (CHAR*) malloc(sizeof(CHAR) * (end - beg));
+    buffer = (CHAR*) md_malloc(ctx, sizeof(CHAR) * (end - beg));
     if(buffer == NULL) {
         MD_LOG("malloc() failed.");
         return -1;
@@ -956,8 +1675,16 @@ md_skip_unicode_whitespace(const CHAR* label, OFF off, SZ size)
     unsigned codepoint;
 
     while(off < size) {
+        /* Fast path for ASCII characters. */
+        if(ISASCII_(label[off])) {
+            if(!ISWHITESPACE_(label[off])  &&  !ISNEWLINE_(label[off]))
+                break;
+            off++;
+            continue;
+        }
+
         codepoint = md_decode_unicode(label, off, size, &char_size);
-        if(!ISUNICODEWHITESPACE_(codepoint)  &&  !ISNEWLINE_(label[off]))
+        if(!ISUNICODEWHITESPACE_(codepoint))
             break;
         off += char_size;
     }
@@ -1326,12 +2053,73 @@ md_is_entity(MD_CTX* ctx, OFF beg, OFF max_end, OFF* p_end)
     return md_is_entity_str(ctx, ctx->text, beg, max_end, p_end);
 }
 
+/* Decode the entity (as recognized by md_is_entity_str()). */
+static void
+md_decode_entity_str(const CHAR* text, SZ size, MD_ENTITY_DETAIL* detail)
+{
+    OFF off;
 
-/******************************
- ***  Attribute Management  ***
- ******************************/
+    detail->n_codepoints = 0;
+    detail->codepoints[0] = 0;
+    detail->codepoints[1] = 0;
 
-typedef struct MD_ATTRIBUTE_BUILD_tag MD_ATTRIBUTE_BUILD;
+    if(text[1] == _T('#')) {
+        unsigned codepoint = 0;
+
+        if(text[2] == _T('x')  ||  text[2] == _T('X')) {
+            for(off = 3; off < size-1; off++) {
+                unsigned ch = (unsigned) text[off];
+                codepoint = 16 * codepoint + (ch <= '9' ? ch - '0' : (ch | 0x20) - 'a' + 10);
+            }
+        } else {
+            for(off = 2; off < size-1; off++)
+                codepoint = 10 * codepoint + (unsigned) (text[off] - _T('0'));
+        }
+
+        if(codepoint == 0  ||  codepoint > 0x10ffff)
+            codepoint = 0xfffd;
+        detail->n_codepoints = 1;
+        detail->codepoints[0] = codepoint;
+    } else {
+        const struct entity* ent;
+#if defined MD4C_USE_UTF16
+        /* The entity table is in ASCII (and the name is at most 48 letters
+         * and digits, see md_is_named_entity_contents()). */
+        char name[2 + 48];
+
+        for(off = 0; off < size; off++)
+            name[off] = (char) text[off];
+        ent = entity_lookup(name, size);
+#else
+        ent = entity_lookup(text, size);
+#endif
+        if(ent != NULL) {
+            detail->n_codepoints = (ent->codepoints[1] != 0 ? 2 : 1);
+            detail->codepoints[0] = ent->codepoints[0];
+            detail->codepoints[1] = ent->codepoints[1];
+        }
+    }
+}
+
+int
+md_decode_entity(const MD_CHAR* text, MD_SIZE size, MD_ENTITY_DETAIL* detail)
+{
+    OFF end;
+
+    if(size == 0  ||  text[0] != _T('&')  ||
+       !md_is_entity_str(NULL, text, 0, size, &end)  ||  end != size)
+        return -1;
+
+    md_decode_entity_str(text, size, detail);
+    return 0;
+}
+
+
+/******************************
+ ***  Attribute Management  ***
+ ******************************/
+
+typedef struct MD_ATTRIBUTE_BUILD_tag MD_ATTRIBUTE_BUILD;
 struct MD_ATTRIBUTE_BUILD_tag {
     CHAR* text;
     MD_TEXTTYPE* substr_types;
@@ -1352,27 +2140,32 @@ md_build_attr_append_substr(MD_CTX* ctx, MD_ATTRIBUTE_BUILD* build,
     if(build->substr_count >= build->substr_alloc) {
         MD_TEXTTYPE* new_substr_types;
         OFF* new_substr_offsets;
+        int new_alloc;
 
-        build->substr_alloc = (build->substr_alloc > 0
+        new_alloc = (build->substr_alloc > 0
                 ? build->substr_alloc + build->substr_alloc / 2
                 : 8);
-        new_substr_types = (MD_TEXTTYPE*) realloc(build->substr_types,
-                                    build->substr_alloc * sizeof(MD_TEXTTYPE));
+
+        /* Store each reallocated buffer right away, so md_free_attribute()
+         * frees the right one if the other reallocation fails. */
+        new_substr_types = (MD_TEXTTYPE*) md_realloc(ctx, build->substr_types,
+                                    new_alloc * sizeof(MD_TEXTTYPE));
         if(new_substr_types == NULL) {
             MD_LOG("realloc() failed.");
             return -1;
         }
+        build->substr_types = new_substr_types;
+
         /* Note +1 to reserve space for final offset (== raw_size). */
-        new_substr_offsets = (OFF*) realloc(build->substr_offsets,
-                                    (build->substr_alloc+1) * sizeof(OFF));
+        new_substr_offsets = (OFF*) md_realloc(ctx, build->substr_offsets,
+                                    (new_alloc+1) * sizeof(OFF));
         if(new_substr_offsets == NULL) {
             MD_LOG("realloc() failed.");
-            free(new_substr_types);
             return -1;
         }
-
-        build->substr_types = new_substr_types;
         build->substr_offsets = new_substr_offsets;
+
+        build->substr_alloc = new_alloc;
     }
 
     build->substr_types[build->substr_count] = type;
@@ -1384,13 +2177,15 @@ md_build_attr_append_substr(MD_CTX* ctx, MD_ATTRIBUTE_BUILD* build,
 static void
 md_free_attribute(MD_CTX* ctx, MD_ATTRIBUTE_BUILD* build)
 {
-    MD_UNUSED(ctx);
-
-    if(build->substr_alloc > 0) {
-        free(build->text);
-        free(build->substr_types);
-        free(build->substr_offsets);
+    /* A trivial attribute owns no memory. Otherwise, free whatever has been
+     * allocated (even if md_build_attribute() has failed half-way), and
+     * forget it so that calling this again is harmless. */
+    if(build->text != NULL  &&  build->substr_types != build->trivial_types) {
+        md_free(ctx, build->text);
+        md_free(ctx, build->substr_types);
+        md_free(ctx, build->substr_offsets);
     }
+    memset(build, 0, sizeof(MD_ATTRIBUTE_BUILD));
 }
 
 static int
@@ -1424,7 +2219,7 @@ md_build_attribute(MD_CTX* ctx, const CHAR* raw_text, SZ raw_size,
         build->trivial_offsets[1] = raw_size;
         off = raw_size;
     } else {
-        build->text = (CHAR*) malloc(raw_size * sizeof(CHAR));
+        build->text = (CHAR*) md_malloc(ctx, raw_size * sizeof(CHAR));
         if(build->text == NULL) {
             MD_LOG("malloc() failed.");
             goto abort;
@@ -1505,331 +2300,335 @@ md_fnv1a(unsigned base, const void* data, size_t n)
 struct MD_REF_DEF_tag {
     CHAR* label;
     CHAR* title;
-    unsigned hash;
+    unsigned hash;          /* Hash of the key. */
     SZ label_size;
     SZ title_size;
     OFF dest_beg;
     OFF dest_end;
+    size_t key_off;         /* Normalized label in ctx->ref_def_keys[]. */
+    SZ key_size;
     unsigned char label_needs_free : 1;
     unsigned char title_needs_free : 1;
 };
 
 /* Label equivalence is quite complicated with regards to whitespace and case
- * folding. This complicates computing a hash of it as well as direct comparison
- * of two labels. */
+ * folding. So we normalize each label into a key once: Leading and trailing
+ * whitespace is stripped, each whitespace run is collapsed into a single
+ * space and all the other characters are case-folded. The resulting
+ * codepoints are stored as UTF-8 (regardless of the MD_CHAR encoding), so
+ * two labels are equivalent if and only if their keys are the same bytes.
+ *
+ * Each codepoint of the label may fold to up to 3 codepoints, 4 bytes each.
+ */
+#define MD_LINK_LABEL_KEY_MAX(size)     ((size_t)(size) * 12)
 
-static unsigned
-md_link_label_hash(const CHAR* label, SZ size)
+/* For processing whole words of bytes at once: MD_WORD_ONES has 0x01 in each
+ * byte, MD_WORD_HIGHS has 0x80 in each byte. */
+#define MD_WORD_ONES                    ((size_t) -1 / 0xff)
+#define MD_WORD_HIGHS                   (MD_WORD_ONES * 0x80)
+
+static size_t
+md_link_label_key(const CHAR* label, SZ size, unsigned char* key)
 {
-    unsigned hash = MD_FNV1A_BASE;
+    unsigned char* ptr = key;
     OFF off;
-    unsigned codepoint;
-    int is_whitespace = FALSE;
 
     off = md_skip_unicode_whitespace(label, 0, size);
     while(off < size) {
+        MD_UNICODE_FOLD_INFO fold_info;
+        unsigned codepoint;
         SZ char_size;
+        unsigned i;
 
-        codepoint = md_decode_unicode(label, off, size, &char_size);
-        is_whitespace = ISUNICODEWHITESPACE_(codepoint) || ISNEWLINE_(label[off]);
+#ifndef MD4C_USE_UTF16
+        /* Fast path: Words of printable ASCII characters (no byte >= 0x80 nor
+         * <= ' ') just need to lower-case 'A' ... 'Z'. */
+        while(off + sizeof(size_t) <= size) {
+            size_t w;
+            size_t upper;
+
+            memcpy(&w, label + off, sizeof(size_t));
+            if((w & MD_WORD_HIGHS) != 0  ||  ((w - MD_WORD_ONES * 0x21) & ~w & MD_WORD_HIGHS) != 0)
+                break;
+
+            /* (No byte overflows into the next one as all of them are < 0x80.) */
+            upper = (w + MD_WORD_ONES * (0x80 - 'A')) & ~(w + MD_WORD_ONES * (0x7f - 'Z')) & MD_WORD_HIGHS;
+            w |= upper >> 2;
+            memcpy(ptr, &w, sizeof(size_t));
+            ptr += sizeof(size_t);
+            off += sizeof(size_t);
+        }
+        if(off >= size)
+            break;
+#endif
+
+        /* Fast path for any ASCII character. */
+        if(ISASCII_(label[off])) {
+            if(ISWHITESPACE_(label[off]) || ISNEWLINE_(label[off])) {
+                off = md_skip_unicode_whitespace(label, off, size);
+                if(off < size)
+                    *ptr++ = ' ';
+            } else {
+                *ptr++ = (unsigned char) (ISUPPER_(label[off]) ? label[off] + ('a' - 'A') : label[off]);
+                off++;
+            }
+            continue;
+        }
 
-        if(is_whitespace) {
-            codepoint = ' ';
-            hash = md_fnv1a(hash, &codepoint, sizeof(unsigned));
+        codepoint = md_decode_unicode(label, off, size, &char_size);
+        if(ISUNICODEWHITESPACE_(codepoint) || ISNEWLINE_(label[off])) {
             off = md_skip_unicode_whitespace(label, off, size);
-        } else {
-            MD_UNICODE_FOLD_INFO fold_info;
+            if(off < size)
+                *ptr++ = ' ';
+            continue;
+        }
 
-            md_get_unicode_fold_info(codepoint, &fold_info);
-            hash = md_fnv1a(hash, fold_info.codepoints, fold_info.n_codepoints * sizeof(unsigned));
-            off += char_size;
+        md_get_unicode_fold_info(codepoint, &fold_info);
+        for(i = 0; i < fold_info.n_codepoints; i++) {
+            codepoint = fold_info.codepoints[i];
+            if(codepoint < 0x80) {
+                *ptr++ = (unsigned char) codepoint;
+            } else if(codepoint < 0x800) {
+                *ptr++ = (unsigned char) (0xc0 | (codepoint >> 6));
+                *ptr++ = (unsigned char) (0x80 | (codepoint & 0x3f));
+            } else if(codepoint < 0x10000) {
+                *ptr++ = (unsigned char) (0xe0 | (codepoint >> 12));
+                *ptr++ = (unsigned char) (0x80 | ((codepoint >> 6) & 0x3f));
+                *ptr++ = (unsigned char) (0x80 | (codepoint & 0x3f));
+            } else {
+                *ptr++ = (unsigned char) (0xf0 | (codepoint >> 18));
+                *ptr++ = (unsigned char) (0x80 | ((codepoint >> 12) & 0x3f));
+                *ptr++ = (unsigned char) (0x80 | ((codepoint >> 6) & 0x3f));
+                *ptr++ = (unsigned char) (0x80 | (codepoint & 0x3f));
+            }
         }
+        off += char_size;
     }
 
-    return hash;
+    return (size_t) (ptr - key);
 }
 
-static OFF
-md_link_label_cmp_load_fold_info(const CHAR* label, OFF off, SZ size,
-                                 MD_UNICODE_FOLD_INFO* fold_info)
+/* Compute the key of the new ref. def. and store it in ctx->ref_def_keys[]. */
+static int
+md_ref_def_make_key(MD_CTX* ctx, MD_REF_DEF* def)
 {
-    unsigned codepoint;
-    SZ char_size;
-
-    if(off >= size) {
-        /* Treat end of a link label as a whitespace. */
-        goto whitespace;
-    }
+    size_t max_size = MD_LINK_LABEL_KEY_MAX(def->label_size);
 
-    codepoint = md_decode_unicode(label, off, size, &char_size);
-    off += char_size;
-    if(ISUNICODEWHITESPACE_(codepoint)) {
-        /* Treat all whitespace as equivalent */
-        goto whitespace;
-    }
-
-    /* Get real folding info. */
-    md_get_unicode_fold_info(codepoint, fold_info);
-    return off;
+    if(ctx->n_ref_def_keys + max_size > ctx->alloc_ref_def_keys) {
+        unsigned char* new_keys;
+        size_t new_alloc;
 
-whitespace:
-    fold_info->codepoints[0] = _T(' ');
-    fold_info->n_codepoints = 1;
-    return md_skip_unicode_whitespace(label, off, size);
-}
+        new_alloc = ctx->alloc_ref_def_keys + ctx->alloc_ref_def_keys / 2;
+        if(new_alloc < ctx->n_ref_def_keys + max_size)
+            new_alloc = ctx->n_ref_def_keys + max_size;
+        if(new_alloc < 1024)
+            new_alloc = 1024;
 
-static int
-md_link_label_cmp(const CHAR* a_label, SZ a_size, const CHAR* b_label, SZ b_size)
-{
-    OFF a_off;
-    OFF b_off;
-    MD_UNICODE_FOLD_INFO a_fi = { { 0 }, 0 };
-    MD_UNICODE_FOLD_INFO b_fi = { { 0 }, 0 };
-    OFF a_fi_off = 0;
-    OFF b_fi_off = 0;
-    int cmp;
-
-    a_off = md_skip_unicode_whitespace(a_label, 0, a_size);
-    b_off = md_skip_unicode_whitespace(b_label, 0, b_size);
-    while(a_off < a_size || a_fi_off < a_fi.n_codepoints ||
-          b_off < b_size || b_fi_off < b_fi.n_codepoints)
-    {
-        /* If needed, load fold info for next char. */
-        if(a_fi_off >= a_fi.n_codepoints) {
-            a_fi_off = 0;
-            a_off = md_link_label_cmp_load_fold_info(a_label, a_off, a_size, &a_fi);
-        }
-        if(b_fi_off >= b_fi.n_codepoints) {
-            b_fi_off = 0;
-            b_off = md_link_label_cmp_load_fold_info(b_label, b_off, b_size, &b_fi);
+        new_keys = (unsigned char*) md_realloc(ctx, ctx->ref_def_keys, new_alloc);
+        if(new_keys == NULL) {
+            MD_LOG("realloc() failed.");
+            return -1;
         }
 
-        cmp = b_fi.codepoints[b_fi_off] - a_fi.codepoints[a_fi_off];
-        if(cmp != 0)
-            return cmp;
-
-        a_fi_off++;
-        b_fi_off++;
+        ctx->ref_def_keys = new_keys;
+        ctx->alloc_ref_def_keys = new_alloc;
     }
 
+    def->key_off = ctx->n_ref_def_keys;
+    def->key_size = (SZ) md_link_label_key(def->label, def->label_size, ctx->ref_def_keys + def->key_off);
+    def->hash = md_fnv1a(MD_FNV1A_BASE, ctx->ref_def_keys + def->key_off, def->key_size);
+    ctx->n_ref_def_keys += def->key_size;
     return 0;
 }
 
-typedef struct MD_REF_DEF_LIST_tag MD_REF_DEF_LIST;
-struct MD_REF_DEF_LIST_tag {
-    int n_ref_defs;
-    int alloc_ref_defs;
-    MD_REF_DEF* ref_defs[];  /* Valid items always  point into ctx->ref_defs[] */
+/* The hashtable uses open addressing with linear probing. Its size is a power
+ * of two, at least twice the count of the ref. defs. */
+struct MD_REF_DEF_SLOT_tag {
+    unsigned hash;
+    unsigned def;           /* Index into the ref. defs. plus one, or zero if empty. */
 };
 
-static int
-md_ref_def_cmp(const void* a, const void* b)
-{
-    const MD_REF_DEF* a_ref = *(const MD_REF_DEF**)a;
-    const MD_REF_DEF* b_ref = *(const MD_REF_DEF**)b;
-
-    if(a_ref->hash < b_ref->hash)
-        return -1;
-    else if(a_ref->hash > b_ref->hash)
-        return +1;
-    else
-        return md_link_label_cmp(a_ref->label, a_ref->label_size, b_ref->label, b_ref->label_size);
-}
+/* Shared ref. def. dictionary (see md_ref_dict_create()). It has the same
+ * structure as the document's own ref. defs. and their hashtable, except the
+ * ref. defs. have no label, the destinations are offsets into 'strings' and
+ * the titles point into it too. */
+struct MD_REF_DICT {
+    const MD_ALLOCATOR* allocator;
+    MD_REF_DEF* defs;
+    int n_defs;
+    unsigned char* keys;
+    CHAR* strings;
+    MD_REF_DEF_SLOT* hashtable;
+    int hashtable_size;
+};
 
 static int
-md_ref_def_cmp_for_sort(const void* a, const void* b)
+md_ref_def_hashtable_size(int n_defs)
 {
-    int cmp;
-
-    cmp = md_ref_def_cmp(a, b);
-
-    /* Ensure stability of the sorting. */
-    if(cmp == 0) {
-        const MD_REF_DEF* a_ref = *(const MD_REF_DEF**)a;
-        const MD_REF_DEF* b_ref = *(const MD_REF_DEF**)b;
-
-        if(a_ref < b_ref)
-            cmp = -1;
-        else if(a_ref > b_ref)
-            cmp = +1;
-        else
-            cmp = 0;
-    }
+    int size = 16;
 
-    return cmp;
+    while(size < 2 * n_defs)
+        size *= 2;
+    return size;
 }
 
-static int
-md_build_ref_def_hashtable(MD_CTX* ctx)
+/* Fill the (zeroed) hashtable with the ref. defs. */
+static void
+md_fill_ref_def_hashtable(MD_REF_DEF_SLOT* hashtable, int hashtable_size,
+                          const MD_REF_DEF* defs, int n_defs, const unsigned char* keys)
 {
-    int i, j;
+    unsigned mask = (unsigned) hashtable_size - 1;
+    int i;
 
-    if(ctx->n_ref_defs == 0)
-        return 0;
+    for(i = 0; i < n_defs; i++) {
+        const MD_REF_DEF* def = &defs[i];
+        const unsigned char* key = keys + def->key_off;
+        unsigned index = def->hash & mask;
 
-    ctx->ref_def_hashtable_size = (ctx->n_ref_defs * 5) / 4;
-    ctx->ref_def_hashtable = malloc(ctx->ref_def_hashtable_size * sizeof(void*));
-    if(ctx->ref_def_hashtable == NULL) {
-        MD_LOG("malloc() failed.");
-        goto abort;
-    }
-    memset(ctx->ref_def_hashtable, 0, ctx->ref_def_hashtable_size * sizeof(void*));
+        while(1) {
+            MD_REF_DEF_SLOT* slot = &hashtable[index];
+            const MD_REF_DEF* other;
 
-    /* Each member of ctx->ref_def_hashtable[] can be:
-     *  -- NULL,
-     *  -- pointer to the MD_REF_DEF in ctx->ref_defs[], or
-     *  -- pointer to a MD_REF_DEF_LIST, which holds multiple pointers to
-     *     such MD_REF_DEFs.
-     */
-    for(i = 0; i < ctx->n_ref_defs; i++) {
-        MD_REF_DEF* def = &ctx->ref_defs[i];
-        void* bucket;
-        MD_REF_DEF_LIST* list;
+            if(slot->def == 0) {
+                slot->hash = def->hash;
+                slot->def = (unsigned) i + 1;
+                break;
+            }
 
-        def->hash = md_link_label_hash(def->label, def->label_size);
-        bucket = ctx->ref_def_hashtable[def->hash % ctx->ref_def_hashtable_size];
+            /* If the label is already defined, the 1st definition wins. */
+            other = &defs[slot->def - 1];
+            if(slot->hash == def->hash  &&  other->key_size == def->key_size  &&
+               memcmp(keys + other->key_off, key, def->key_size) == 0)
+                break;
 
-        if(bucket == NULL) {
-            /* The bucket is empty. Make it just point to the def. */
-            ctx->ref_def_hashtable[def->hash % ctx->ref_def_hashtable_size] = def;
-            continue;
+            index = (index + 1) & mask;
         }
+    }
+}
 
-        if(ctx->ref_defs <= (MD_REF_DEF*) bucket  &&  (MD_REF_DEF*) bucket < ctx->ref_defs + ctx->n_ref_defs) {
-            /* The bucket already contains one ref. def. Lets see whether it
-             * is the same label (ref. def. duplicate) or different one
-             * (hash conflict). */
-            MD_REF_DEF* old_def = (MD_REF_DEF*) bucket;
+static const MD_REF_DEF*
+md_find_ref_def(const MD_REF_DEF_SLOT* hashtable, int hashtable_size, const MD_REF_DEF* defs,
+                const unsigned char* keys, const unsigned char* key, size_t key_size, unsigned hash)
+{
+    unsigned mask = (unsigned) hashtable_size - 1;
+    unsigned index = hash & mask;
 
-            if(md_link_label_cmp(def->label, def->label_size, old_def->label, old_def->label_size) == 0) {
-                /* Duplicate label: Ignore this ref. def. */
-                continue;
-            }
+    while(hashtable[index].def != 0) {
+        const MD_REF_DEF_SLOT* slot = &hashtable[index];
 
-            /* Make the bucket complex, i.e. able to hold more ref. defs. */
-            list = (MD_REF_DEF_LIST*) malloc(sizeof(MD_REF_DEF_LIST) + 2 * sizeof(MD_REF_DEF*));
-            if(list == NULL) {
-                MD_LOG("malloc() failed.");
-                goto abort;
-            }
-            list->ref_defs[0] = old_def;
-            list->ref_defs[1] = def;
-            list->n_ref_defs = 2;
-            list->alloc_ref_defs = 2;
-            ctx->ref_def_hashtable[def->hash % ctx->ref_def_hashtable_size] = list;
-            continue;
-        }
+        if(slot->hash == hash) {
+            const MD_REF_DEF* def = &defs[slot->def - 1];
 
-        /* Append the def to the complex bucket list.
-         *
-         * Note in this case we ignore potential duplicates to avoid expensive
-         * iterating over the complex bucket. Below, we revisit all the complex
-         * buckets and handle it more cheaply after the complex bucket contents
-         * is sorted. */
-        list = (MD_REF_DEF_LIST*) bucket;
-        if(list->n_ref_defs >= list->alloc_ref_defs) {
-            int alloc_ref_defs = list->alloc_ref_defs + list->alloc_ref_defs / 2;
-            MD_REF_DEF_LIST* list_tmp = (MD_REF_DEF_LIST*) realloc(list,
-                        sizeof(MD_REF_DEF_LIST) + alloc_ref_defs * sizeof(MD_REF_DEF*));
-            if(list_tmp == NULL) {
-                MD_LOG("realloc() failed.");
-                goto abort;
-            }
-            list = list_tmp;
-            list->alloc_ref_defs = alloc_ref_defs;
-            ctx->ref_def_hashtable[def->hash % ctx->ref_def_hashtable_size] = list;
+            if(def->key_size == key_size  &&  memcmp(keys + def->key_off, key, key_size) == 0)
+                return def;
         }
 
-        list->ref_defs[list->n_ref_defs] = def;
-        list->n_ref_defs++;
+        index = (index + 1) & mask;
     }
 
-    /* Sort the complex buckets so we can use bsearch() with them. */
-    for(i = 0; i < ctx->ref_def_hashtable_size; i++) {
-        void* bucket = ctx->ref_def_hashtable[i];
-        MD_REF_DEF_LIST* list;
+    return NULL;
+}
 
-        if(bucket == NULL)
-            continue;
-        if(ctx->ref_defs <= (MD_REF_DEF*) bucket  &&  (MD_REF_DEF*) bucket < ctx->ref_defs + ctx->n_ref_defs)
-            continue;
+static int
+md_build_ref_def_hashtable(MD_CTX* ctx)
+{
+    int phase;
 
-        list = (MD_REF_DEF_LIST*) bucket;
-        qsort(list->ref_defs, list->n_ref_defs, sizeof(MD_REF_DEF*), md_ref_def_cmp_for_sort);
+    if(ctx->n_ref_defs == 0)
+        return 0;
 
-        /* Disable all duplicates in the complex bucket by forcing all such
-         * records to point to the 1st such ref. def. I.e. no matter which
-         * record is found during the lookup, it will always point to the right
-         * ref. def. in ctx->ref_defs[]. */
-        for(j = 1; j < list->n_ref_defs; j++) {
-            if(md_ref_def_cmp(&list->ref_defs[j-1], &list->ref_defs[j]) == 0)
-                list->ref_defs[j] = list->ref_defs[j-1];
+    phase = MD_STATS_ENTER(MD_STATS_REFDEFS);
+    ctx->ref_def_hashtable_size = md_ref_def_hashtable_size(ctx->n_ref_defs);
+    if(ctx->ref_def_hashtable_size > ctx->alloc_ref_def_hashtable) {
+        /* Not md_realloc() as we do not need to preserve the contents. */
+        md_free(ctx, ctx->ref_def_hashtable);
+        ctx->alloc_ref_def_hashtable = 0;
+        ctx->ref_def_hashtable = (MD_REF_DEF_SLOT*) md_malloc(ctx,
+                    ctx->ref_def_hashtable_size * sizeof(MD_REF_DEF_SLOT));
+        if(ctx->ref_def_hashtable == NULL) {
+            MD_LOG("malloc() failed.");
+            ctx->ref_def_hashtable_size = 0;
+            MD_STATS_SWITCH(phase);
+            return -1;
         }
+        ctx->alloc_ref_def_hashtable = ctx->ref_def_hashtable_size;
     }
+    memset(ctx->ref_def_hashtable, 0, ctx->ref_def_hashtable_size * sizeof(MD_REF_DEF_SLOT));
 
+    md_fill_ref_def_hashtable(ctx->ref_def_hashtable, ctx->ref_def_hashtable_size,
+                              ctx->ref_defs, ctx->n_ref_defs, ctx->ref_def_keys);
+    MD_STATS_SWITCH(phase);
     return 0;
+}
 
-abort:
-    return -1;
+/* Makes the table empty. The table itself is kept for a reuse. */
+static void
+md_clear_ref_def_hashtable(MD_CTX* ctx)
+{
+    ctx->ref_def_hashtable_size = 0;
 }
 
 static void
 md_free_ref_def_hashtable(MD_CTX* ctx)
 {
-    if(ctx->ref_def_hashtable != NULL) {
-        int i;
-
-        for(i = 0; i < ctx->ref_def_hashtable_size; i++) {
-            void* bucket = ctx->ref_def_hashtable[i];
-            if(bucket == NULL)
-                continue;
-            if(ctx->ref_defs <= (MD_REF_DEF*) bucket  &&  (MD_REF_DEF*) bucket < ctx->ref_defs + ctx->n_ref_defs)
-                continue;
-            free(bucket);
-        }
-
-        free(ctx->ref_def_hashtable);
-    }
+    md_clear_ref_def_hashtable(ctx);
+    md_free(ctx, ctx->ref_def_hashtable);
+    ctx->ref_def_hashtable = NULL;
+    ctx->alloc_ref_def_hashtable = 0;
 }
 
-static const MD_REF_DEF*
-md_lookup_ref_def(MD_CTX* ctx, const CHAR* label, SZ label_size)
+/* Look up the label among the document's ref. defs. and then in the shared
+ * dictionary (MD_PARSER::ref_dict). *p_def is set to the found ref. def., or
+ * to NULL, and *p_base to what its destination offsets are relative to.
+ * Returns -1 only if out of memory. */
+static int
+md_lookup_ref_def(MD_CTX* ctx, const CHAR* label, SZ label_size,
+                  const MD_REF_DEF** p_def, const CHAR** p_base)
 {
+    const MD_REF_DICT* dict = ctx->parser.ref_dict;
+    const MD_REF_DEF* def = NULL;
+    unsigned char* key;
+    size_t key_size;
     unsigned hash;
-    void* bucket;
 
-    if(ctx->ref_def_hashtable_size == 0)
-        return NULL;
+    ctx->stats.n_ref_def_lookups++;
+    *p_def = NULL;
+    if(ctx->ref_def_hashtable_size == 0  &&  (dict == NULL  ||  dict->n_defs == 0))
+        return 0;
 
-    hash = md_link_label_hash(label, label_size);
-    bucket = ctx->ref_def_hashtable[hash % ctx->ref_def_hashtable_size];
+    key_size = MD_LINK_LABEL_KEY_MAX(label_size);
+    MD_STATS_PEAK(aux_buffer_size, key_size);
+    if(key_size > ctx->alloc_lookup_key) {
+        unsigned char* new_key;
+        size_t new_size = (key_size + key_size / 2 + 128) & ~(size_t) 127;
 
-    if(bucket == NULL) {
-        return NULL;
-    } else if(ctx->ref_defs <= (MD_REF_DEF*) bucket  &&  (MD_REF_DEF*) bucket < ctx->ref_defs + ctx->n_ref_defs) {
-        const MD_REF_DEF* def = (MD_REF_DEF*) bucket;
+        new_key = (unsigned char*) md_realloc(ctx, ctx->lookup_key, new_size);
+        if(new_key == NULL) {
+            MD_LOG("realloc() failed.");
+            return -1;
+        }
 
-        if(md_link_label_cmp(def->label, def->label_size, label, label_size) == 0)
-            return def;
-        else
-            return NULL;
-    } else {
-        MD_REF_DEF_LIST* list = (MD_REF_DEF_LIST*) bucket;
-        MD_REF_DEF key_buf;
-        const MD_REF_DEF* key = &key_buf;
-        const MD_REF_DEF** ret;
-
-        key_buf.label = (CHAR*) label;
-        key_buf.label_size = label_size;
-        key_buf.hash = md_link_label_hash(key_buf.label, key_buf.label_size);
-
-        ret = (const MD_REF_DEF**) bsearch(&key, list->ref_defs,
-                    list->n_ref_defs, sizeof(MD_REF_DEF*), md_ref_def_cmp);
-        if(ret != NULL)
-            return *ret;
-        else
-            return NULL;
+        ctx->lookup_key = new_key;
+        ctx->alloc_lookup_key = new_size;
+    }
+    key = ctx->lookup_key;
+
+    key_size = md_link_label_key(label, label_size, key);
+    hash = md_fnv1a(MD_FNV1A_BASE, key, key_size);
+
+    if(ctx->ref_def_hashtable_size > 0) {
+        def = md_find_ref_def(ctx->ref_def_hashtable, ctx->ref_def_hashtable_size,
+                    ctx->ref_defs, ctx->ref_def_keys, key, key_size, hash);
+        *p_base = ctx->text;
+    }
+    if(def == NULL  &&  dict != NULL  &&  dict->n_defs > 0) {
+        def = md_find_ref_def(dict->hashtable, dict->hashtable_size,
+                    dict->defs, dict->keys, key, key_size, hash);
+        *p_base = dict->strings;
     }
+
+    *p_def = def;
+    return 0;
 }
 
 
@@ -1843,8 +2642,8 @@ md_lookup_ref_def(MD_CTX* ctx, const CHAR* label, SZ label_size)
 
 typedef struct MD_LINK_ATTR_tag MD_LINK_ATTR;
 struct MD_LINK_ATTR_tag {
-    OFF dest_beg;
-    OFF dest_end;
+    const CHAR* dest;
+    SZ dest_size;
 
     CHAR* title;
     SZ title_size;
@@ -2096,6 +2895,10 @@ md_is_link_reference_definition(MD_CTX* ctx, const MD_LINE* lines, int n_lines)
     MD_REF_DEF* def = NULL;
     int ret = 0;
 
+    /* Beyond MD_PARSER::max_ref_defs, it is just a text. */
+    if(ctx->parser.max_ref_defs > 0  &&  (unsigned) ctx->n_ref_defs >= ctx->parser.max_ref_defs)
+        return FALSE;
+
     /* Link label. */
     if(!md_is_link_label(ctx, lines, n_lines, lines[0].beg,
                 &off, &label_contents_line_index, &line_index,
@@ -2145,20 +2948,32 @@ md_is_link_reference_definition(MD_CTX* ctx, const MD_LINE* lines, int n_lines)
     if(off < lines[line_index].end)
         return FALSE;
 
-    /* So, it _is_ a reference definition. Remember it. */
+    /* So, it _is_ a reference definition. */
+    if(ctx->ref_defs_frozen) {
+        /* md_parser_reparse() keeps the hashtable pointing into ctx->ref_defs[]
+         * from the previous parse, so we may not add anything. Give up and
+         * let it parse the whole document again. */
+        ctx->ref_defs_changed = TRUE;
+        return -1;
+    }
+
+    /* Remember it. */
     if(ctx->n_ref_defs >= ctx->alloc_ref_defs) {
         MD_REF_DEF* new_defs;
+        int new_alloc_ref_defs;
 
-        ctx->alloc_ref_defs = (ctx->alloc_ref_defs > 0
+        new_alloc_ref_defs = (ctx->alloc_ref_defs > 0
                 ? ctx->alloc_ref_defs + ctx->alloc_ref_defs / 2
                 : 16);
-        new_defs = (MD_REF_DEF*) realloc(ctx->ref_defs, ctx->alloc_ref_defs * sizeof(MD_REF_DEF));
+        new_defs = (MD_REF_DEF*) md_realloc(ctx, ctx->ref_defs, new_alloc_ref_defs * sizeof(MD_REF_DEF));
         if(new_defs == NULL) {
             MD_LOG("realloc() failed.");
+            ret = -1;
             goto abort;
         }
 
         ctx->ref_defs = new_defs;
+        ctx->alloc_ref_defs = new_alloc_ref_defs;
     }
     def = &ctx->ref_defs[ctx->n_ref_defs];
     memset(def, 0, sizeof(MD_REF_DEF));
@@ -2185,6 +3000,7 @@ md_is_link_reference_definition(MD_CTX* ctx, const MD_LINE* lines, int n_lines)
 
     def->dest_beg = dest_contents_beg;
     def->dest_end = dest_contents_end;
+    MD_CHECK(md_ref_def_make_key(ctx, def));
 
     /* Success. */
     ctx->n_ref_defs++;
@@ -2193,17 +3009,38 @@ md_is_link_reference_definition(MD_CTX* ctx, const MD_LINE* lines, int n_lines)
 abort:
     /* Failure. */
     if(def != NULL  &&  def->label_needs_free)
-        free(def->label);
+        md_free(ctx, def->label);
     if(def != NULL  &&  def->title_needs_free)
-        free(def->title);
+        md_free(ctx, def->title);
     return ret;
 }
 
+/* Find the line containing the given offset, i.e. the first one ending after
+ * it. (Bisect as a paragraph may have very many lines and links.) */
+static int
+md_find_line_index(const MD_LINE* lines, int n_lines, OFF off)
+{
+    int lo = 0;
+    int hi = n_lines - 1;
+
+    while(lo < hi) {
+        int pivot = (lo + hi) / 2;
+
+        if(off >= lines[pivot].end)
+            lo = pivot + 1;
+        else
+            hi = pivot;
+    }
+
+    return lo;
+}
+
 static int
 md_is_link_reference(MD_CTX* ctx, const MD_LINE* lines, int n_lines,
                      OFF beg, OFF end, MD_LINK_ATTR* attr)
 {
     const MD_REF_DEF* def;
+    const CHAR* base;
     const MD_LINE* beg_line;
     const MD_LINE* end_line;
     CHAR* label;
@@ -2218,9 +3055,7 @@ md_is_link_reference(MD_CTX* ctx, const MD_LINE* lines, int n_lines,
 
     /* Find lines corresponding to the beg and end positions. */
     MD_ASSERT(lines[0].beg <= beg);
-    beg_line = lines;
-    while(beg >= beg_line->end)
-        beg_line++;
+    beg_line = lines + md_find_line_index(lines, n_lines, beg);
 
     MD_ASSERT(end <= lines[n_lines-1].end);
     end_line = beg_line;
@@ -2235,19 +3070,20 @@ md_is_link_reference(MD_CTX* ctx, const MD_LINE* lines, int n_lines,
         label_size = end - beg;
     }
 
-    def = md_lookup_ref_def(ctx, label, label_size);
-    if(def != NULL) {
-        attr->dest_beg = def->dest_beg;
-        attr->dest_end = def->dest_end;
+    ret = md_lookup_ref_def(ctx, label, label_size, &def, &base);
+    if(ret == 0  &&  def != NULL) {
+        attr->dest = base + def->dest_beg;
+        attr->dest_size = def->dest_end - def->dest_beg;
         attr->title = def->title;
         attr->title_size = def->title_size;
         attr->title_needs_free = FALSE;
     }
 
     if(beg_line != end_line)
-        free(label);
+        md_free(ctx, label);
 
-    ret = (def != NULL);
+    if(ret == 0)
+        ret = (def != NULL);
 
 abort:
     return ret;
@@ -2257,8 +3093,10 @@ static int
 md_is_inline_link_spec(MD_CTX* ctx, const MD_LINE* lines, int n_lines,
                        OFF beg, OFF* p_end, MD_LINK_ATTR* attr)
 {
-    int line_index = 0;
+    int line_index;
     int tmp_line_index;
+    OFF dest_contents_beg;
+    OFF dest_contents_end;
     OFF title_contents_beg;
     OFF title_contents_end;
     int title_contents_line_index;
@@ -2266,8 +3104,7 @@ md_is_inline_link_spec(MD_CTX* ctx, const MD_LINE* lines, int n_lines,
     OFF off = beg;
     int ret = FALSE;
 
-    while(off >= lines[line_index].end)
-        line_index++;
+    line_index = md_find_line_index(lines, n_lines, off);
 
     MD_ASSERT(CH(off) == _T('('));
     off++;
@@ -2275,7 +3112,7 @@ md_is_inline_link_spec(MD_CTX* ctx, const MD_LINE* lines, int n_lines,
     /* Optional white space with up to one line break. */
     while(off < lines[line_index].end  &&  ISWHITESPACE(off))
         off++;
-    if(off >= lines[line_index].end  &&  ISNEWLINE(off)) {
+    if(off >= lines[line_index].end  &&  (off >= ctx->size  ||  ISNEWLINE(off))) {
         line_index++;
         if(line_index >= n_lines)
             return FALSE;
@@ -2284,8 +3121,8 @@ md_is_inline_link_spec(MD_CTX* ctx, const MD_LINE* lines, int n_lines,
 
     /* Link destination may be omitted, but only when not also having a title. */
     if(off < ctx->size  &&  CH(off) == _T(')')) {
-        attr->dest_beg = off;
-        attr->dest_end = off;
+        attr->dest = STR(off);
+        attr->dest_size = 0;
         attr->title = NULL;
         attr->title_size = 0;
         attr->title_needs_free = FALSE;
@@ -2296,8 +3133,10 @@ md_is_inline_link_spec(MD_CTX* ctx, const MD_LINE* lines, int n_lines,
 
     /* Link destination. */
     if(!md_is_link_destination(ctx, off, lines[line_index].end,
-                        &off, &attr->dest_beg, &attr->dest_end))
+                        &off, &dest_contents_beg, &dest_contents_end))
         return FALSE;
+    attr->dest = STR(dest_contents_beg);
+    attr->dest_size = dest_contents_end - dest_contents_beg;
 
     /* (Optional) title. */
     if(md_is_link_title(ctx, lines + line_index, n_lines - line_index, off,
@@ -2318,7 +3157,7 @@ md_is_inline_link_spec(MD_CTX* ctx, const MD_LINE* lines, int n_lines,
     /* Optional whitespace followed with final ')'. */
     while(off < lines[line_index].end  &&  ISWHITESPACE(off))
         off++;
-    if(off >= lines[line_index].end  &&  ISNEWLINE(off)) {
+    if(off >= lines[line_index].end  &&  (off >= ctx->size  ||  ISNEWLINE(off))) {
         line_index++;
         if(line_index >= n_lines)
             return FALSE;
@@ -2350,8 +3189,10 @@ abort:
     return ret;
 }
 
+/* Releases labels and titles owned by the ref. defs and makes the list empty.
+ * The array itself is kept for a reuse. */
 static void
-md_free_ref_defs(MD_CTX* ctx)
+md_clear_ref_defs(MD_CTX* ctx)
 {
     int i;
 
@@ -2359,12 +3200,25 @@ md_free_ref_defs(MD_CTX* ctx)
         MD_REF_DEF* def = &ctx->ref_defs[i];
 
         if(def->label_needs_free)
-            free(def->label);
+            md_free(ctx, def->label);
         if(def->title_needs_free)
-            free(def->title);
+            md_free(ctx, def->title);
     }
 
-    free(ctx->ref_defs);
+    ctx->n_ref_defs = 0;
+    ctx->n_ref_def_keys = 0;
+}
+
+static void
+md_free_ref_defs(MD_CTX* ctx)
+{
+    md_clear_ref_defs(ctx);
+    md_free(ctx, ctx->ref_defs);
+    ctx->ref_defs = NULL;
+    ctx->alloc_ref_defs = 0;
+    md_free(ctx, ctx->ref_def_keys);
+    ctx->ref_def_keys = NULL;
+    ctx->alloc_ref_def_keys = 0;
 }
 
 
@@ -2465,6 +3319,7 @@ struct MD_MARK_tag {
 #define MD_MARK_EMPH_MOD3_MASK              (0x40 | 0x80)
 #define MD_MARK_AUTOLINK                    0x20  /* Distinguisher for '<', '>'. */
 #define MD_MARK_VALIDPERMISSIVEAUTOLINK     0x20  /* For permissive autolinks. */
+#define MD_MARK_TRUNCATED                   0x20  /* For the dummy last mark: Hit MD_PARSER::max_marks. */
 
 static MD_MARKCHAIN*
 md_asterisk_chain(MD_CTX* ctx, unsigned flags)
@@ -2501,17 +3356,19 @@ md_push_mark(MD_CTX* ctx)
 {
     if(ctx->n_marks >= ctx->alloc_marks) {
         MD_MARK* new_marks;
+        int new_alloc_marks;
 
-        ctx->alloc_marks = (ctx->alloc_marks > 0
+        new_alloc_marks = (ctx->alloc_marks > 0
                 ? ctx->alloc_marks + ctx->alloc_marks / 2
                 : 64);
-        new_marks = realloc(ctx->marks, ctx->alloc_marks * sizeof(MD_MARK));
+        new_marks = md_realloc(ctx, ctx->marks, new_alloc_marks * sizeof(MD_MARK));
         if(new_marks == NULL) {
             MD_LOG("realloc() failed.");
             return NULL;
         }
 
         ctx->marks = new_marks;
+        ctx->alloc_marks = new_alloc_marks;
     }
 
     return &ctx->marks[ctx->n_marks++];
@@ -2626,6 +3483,8 @@ md_rollback(MD_CTX* ctx, int opener_index, int closer_index, int how)
     int i;
     int mark_index;
 
+    ctx->stats.n_rollbacks++;
+
     /* Cut all unresolved openers at the mark index. */
     for(i = OPENERS_CHAIN_FIRST; i < OPENERS_CHAIN_LAST+1; i++) {
         MD_MARKCHAIN* chain = &ctx->mark_chains[i];
@@ -2703,25 +3562,25 @@ md_build_mark_char_map(MD_CTX* ctx)
     ctx->mark_char_map[']'] = 1;
     ctx->mark_char_map['\0'] = 1;
 
-    if(ctx->parser.flags & MD_FLAG_STRIKETHROUGH)
+    if(MD_PARSER_FLAGS(ctx) & MD_FLAG_STRIKETHROUGH)
         ctx->mark_char_map['~'] = 1;
 
-    if(ctx->parser.flags & MD_FLAG_LATEXMATHSPANS)
+    if(MD_PARSER_FLAGS(ctx) & MD_FLAG_LATEXMATHSPANS)
         ctx->mark_char_map['$'] = 1;
 
-    if ((ctx->parser.flags & MD_FLAG_MENTIONS) || (ctx->parser.flags & MD_FLAG_PERMISSIVEEMAILAUTOLINKS))
+    if ((MD_PARSER_FLAGS(ctx) & MD_FLAG_MENTIONS) || (MD_PARSER_FLAGS(ctx) & MD_FLAG_PERMISSIVEEMAILAUTOLINKS))
         ctx->mark_char_map['@'] = 1;
 
-    if(ctx->parser.flags & MD_FLAG_PERMISSIVEURLAUTOLINKS)
+    if(MD_PARSER_FLAGS(ctx) & MD_FLAG_PERMISSIVEURLAUTOLINKS)
         ctx->mark_char_map[':'] = 1;
 
-    if(ctx->parser.flags & MD_FLAG_PERMISSIVEWWWAUTOLINKS)
+    if(MD_PARSER_FLAGS(ctx) & MD_FLAG_PERMISSIVEWWWAUTOLINKS)
         ctx->mark_char_map['.'] = 1;
 
-    if((ctx->parser.flags & MD_FLAG_TABLES) || (ctx->parser.flags & MD_FLAG_WIKILINKS))
+    if((MD_PARSER_FLAGS(ctx) & MD_FLAG_TABLES) || (MD_PARSER_FLAGS(ctx) & MD_FLAG_WIKILINKS))
         ctx->mark_char_map['|'] = 1;
 
-    if(ctx->parser.flags & MD_FLAG_COLLAPSEWHITESPACE) {
+    if(MD_PARSER_FLAGS(ctx) & MD_FLAG_COLLAPSEWHITESPACE) {
         int i;
 
         for(i = 0; i < (int) sizeof(ctx->mark_char_map); i++) {
@@ -2729,6 +3588,46 @@ md_build_mark_char_map(MD_CTX* ctx)
                 ctx->mark_char_map[i] = 1;
         }
     }
+
+#if defined MD_SIMD_SSE2
+    /* Derive the tables for md_skip_non_mark_chars().
+     *
+     * The plain SSE2 path skips ASCII alphanumerics, spaces and non-ASCII
+     * bytes (all of these are not mark chars unless MD_FLAG_COLLAPSEWHITESPACE
+     * is used), and only checks the remaining bytes in mark_char_map[].
+     *
+     * The PSHUFB path classifies each byte by its low and high nibbles:
+     * Each distinct high nibble of any mark char gets its own bit, and the
+     * byte is a mark char iff
+     * (mark_lo_nibbles[byte & 0xf] & mark_hi_nibbles[byte >> 4]) != 0.
+     * This is exact as long as there are at most 8 distinct high nibbles. */
+    {
+        int i;
+        int n_hi_bits = 0;
+
+        ctx->mark_alnum_prefilter_valid = TRUE;
+        memset(ctx->mark_lo_nibbles, 0, sizeof(ctx->mark_lo_nibbles));
+        memset(ctx->mark_hi_nibbles, 0, sizeof(ctx->mark_hi_nibbles));
+        ctx->mark_nibbles_valid = TRUE;
+
+        for(i = 0; i < (int) sizeof(ctx->mark_char_map); i++) {
+            if(!ctx->mark_char_map[i])
+                continue;
+
+            if(ISALNUM_(i)  ||  i == ' '  ||  i >= 0x80)
+                ctx->mark_alnum_prefilter_valid = FALSE;
+
+            if(ctx->mark_hi_nibbles[i >> 4] == 0) {
+                if(n_hi_bits >= 8) {
+                    ctx->mark_nibbles_valid = FALSE;
+                    continue;
+                }
+                ctx->mark_hi_nibbles[i >> 4] = (unsigned char) (1 << n_hi_bits++);
+            }
+            ctx->mark_lo_nibbles[i & 0xf] |= ctx->mark_hi_nibbles[i >> 4];
+        }
+    }
+#endif
 }
 
 /* We limit code span marks to lower than 32 backticks. This solves the
@@ -2960,6 +3859,120 @@ md_is_autolink(MD_CTX* ctx, OFF beg, OFF max_end, OFF* p_end, int* p_missing_mai
     return FALSE;
 }
 
+#ifdef MD4C_USE_UTF16
+    /* For UTF-16, mark_char_map[] covers only ASCII. */
+    #define IS_MARK_CHAR(off)   ((CH(off) < SIZEOF_ARRAY(ctx->mark_char_map))  &&  \
+                                (ctx->mark_char_map[(unsigned char) CH(off)]))
+#else
+    /* For 8-bit encodings, mark_char_map[] covers all 256 elements. */
+    #define IS_MARK_CHAR(off)   (ctx->mark_char_map[(unsigned char) CH(off)])
+#endif
+
+/* Find the first mark char in the range [off, end), or return end. */
+static inline OFF
+md_skip_non_mark_chars_scalar(MD_CTX* ctx, OFF off, OFF end)
+{
+    /* Optimization: Use some loop unrolling. */
+    while(off + 3 < end  &&  !IS_MARK_CHAR(off+0)  &&  !IS_MARK_CHAR(off+1)
+                         &&  !IS_MARK_CHAR(off+2)  &&  !IS_MARK_CHAR(off+3))
+        off += 4;
+    while(off < end  &&  !IS_MARK_CHAR(off+0))
+        off++;
+    return off;
+}
+
+#if defined MD_SIMD_SSE2
+static OFF
+md_skip_non_mark_chars_simd(MD_CTX* ctx, OFF off, OFF end)
+{
+#if defined MD_SIMD_SSSE3
+    if(ctx->mark_nibbles_valid) {
+        const __m128i lo_tbl = _mm_loadu_si128((const __m128i*) ctx->mark_lo_nibbles);
+        const __m128i hi_tbl = _mm_loadu_si128((const __m128i*) ctx->mark_hi_nibbles);
+        const __m128i nibble_mask = _mm_set1_epi8(0x0f);
+#if defined MD_SIMD_AVX2
+        const __m256i lo_tbl2 = _mm256_broadcastsi128_si256(lo_tbl);
+        const __m256i hi_tbl2 = _mm256_broadcastsi128_si256(hi_tbl);
+        const __m256i nibble_mask2 = _mm256_set1_epi8(0x0f);
+
+        while(off + 32 <= end) {
+            __m256i v = _mm256_loadu_si256((const __m256i*) STR(off));
+            __m256i lo = _mm256_shuffle_epi8(lo_tbl2, _mm256_and_si256(v, nibble_mask2));
+            __m256i hi = _mm256_shuffle_epi8(hi_tbl2, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble_mask2));
+            __m256i hit = _mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256());
+            unsigned mask = ~(unsigned) _mm256_movemask_epi8(hit);
+
+            if(mask != 0)
+                return off + md_ctz(mask);
+            off += 32;
+        }
+#endif
+        while(off + 16 <= end) {
+            __m128i v = _mm_loadu_si128((const __m128i*) STR(off));
+            __m128i lo = _mm_shuffle_epi8(lo_tbl, _mm_and_si128(v, nibble_mask));
+            __m128i hi = _mm_shuffle_epi8(hi_tbl, _mm_and_si128(_mm_srli_epi16(v, 4), nibble_mask));
+            __m128i hit = _mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128());
+            unsigned mask = ~(unsigned) _mm_movemask_epi8(hit) & 0xffff;
+
+            if(mask != 0)
+                return off + md_ctz(mask);
+            off += 16;
+        }
+
+        return md_skip_non_mark_chars_scalar(ctx, off, end);
+    }
+#endif
+
+    if(ctx->mark_alnum_prefilter_valid) {
+        const __m128i case_bit = _mm_set1_epi8(0x20);
+        const __m128i before_a = _mm_set1_epi8('a' - 1);
+        const __m128i after_z = _mm_set1_epi8('z' + 1);
+        const __m128i before_0 = _mm_set1_epi8('0' - 1);
+        const __m128i after_9 = _mm_set1_epi8('9' + 1);
+        const __m128i space = _mm_set1_epi8(' ');
+
+        while(off + 16 <= end) {
+            __m128i v = _mm_loadu_si128((const __m128i*) STR(off));
+            __m128i lower = _mm_or_si128(v, case_bit);
+            __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, before_a), _mm_cmplt_epi8(lower, after_z));
+            __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, before_0), _mm_cmplt_epi8(v, after_9));
+            __m128i boring = _mm_or_si128(_mm_or_si128(alpha, digit), _mm_cmpeq_epi8(v, space));
+            /* (Bytes >= 0x80 are negative so they are boring via the sign bit.) */
+            unsigned mask = ~(unsigned) _mm_movemask_epi8(_mm_or_si128(boring, v)) & 0xffff;
+
+            /* Check the remaining candidates in the map. */
+            while(mask != 0) {
+                unsigned i = md_ctz(mask);
+                if(IS_MARK_CHAR(off + i))
+                    return off + i;
+                mask &= mask - 1;
+            }
+            off += 16;
+        }
+    }
+
+    return md_skip_non_mark_chars_scalar(ctx, off, end);
+}
+#endif
+
+static inline OFF
+md_skip_non_mark_chars(MD_CTX* ctx, OFF off, OFF end)
+{
+#if defined MD_SIMD_SSE2
+    /* Short ranges are not worth of the SIMD setup. */
+    if(end - off >= 16) {
+        OFF ret = md_skip_non_mark_chars_simd(ctx, off, end);
+#ifdef DEBUG
+        /* Verify the SIMD scanner against the scalar one. */
+        MD_ASSERT(ret == md_skip_non_mark_chars_scalar(ctx, off, end));
+#endif
+        return ret;
+    }
+#endif
+
+    return md_skip_non_mark_chars_scalar(ctx, off, end);
+}
+
 static int
 md_collect_marks(MD_CTX* ctx, const MD_LINE* lines, int n_lines, int table_mode)
 {
@@ -2968,6 +3981,11 @@ md_collect_marks(MD_CTX* ctx, const MD_LINE* lines, int n_lines, int table_mode)
     MD_MARK* mark;
     OFF codespan_last_potential_closers[CODESPAN_MARK_MAXLEN] = { 0 };
     int codespan_scanned_till_paragraph_end = FALSE;
+    int max_marks = INT_MAX;
+    int truncated = FALSE;
+
+    if(ctx->parser.max_marks > 0  &&  ctx->parser.max_marks < (unsigned) INT_MAX)
+        max_marks = (int) ctx->parser.max_marks;
 
     for(i = 0; i < n_lines; i++) {
         const MD_LINE* line = &lines[i];
@@ -2977,25 +3995,20 @@ md_collect_marks(MD_CTX* ctx, const MD_LINE* lines, int n_lines, int table_mode)
         while(TRUE) {
             CHAR ch;
 
-#ifdef MD4C_USE_UTF16
-    /* For UTF-16, mark_char_map[] covers only ASCII. */
-    #define IS_MARK_CHAR(off)   ((CH(off) < SIZEOF_ARRAY(ctx->mark_char_map))  &&  \
-                                (ctx->mark_char_map[(unsigned char) CH(off)]))
-#else
-    /* For 8-bit encodings, mark_char_map[] covers all 256 elements. */
-    #define IS_MARK_CHAR(off)   (ctx->mark_char_map[(unsigned char) CH(off)])
-#endif
-
-            /* Optimization: Use some loop unrolling. */
-            while(off + 3 < line_end  &&  !IS_MARK_CHAR(off+0)  &&  !IS_MARK_CHAR(off+1)
-                                      &&  !IS_MARK_CHAR(off+2)  &&  !IS_MARK_CHAR(off+3))
-                off += 4;
-            while(off < line_end  &&  !IS_MARK_CHAR(off+0))
-                off++;
+            off = md_skip_non_mark_chars(ctx, off, line_end);
 
             if(off >= line_end)
                 break;
 
+            if(ctx->n_marks >= max_marks) {
+                /* Leave the rest of the block as it is. */
+                truncated = TRUE;
+                i = n_lines;
+                break;
+            }
+
+            MD_CHECK_CANCEL();
+
             ch = CH(off);
 
             /* A backslash escape.
@@ -3130,7 +4143,7 @@ md_collect_marks(MD_CTX* ctx, const MD_LINE* lines, int n_lines, int table_mode)
                 OFF autolink_end;
                 int missing_mailto;
 
-                if(!(ctx->parser.flags & MD_FLAG_NOHTMLSPANS)) {
+                if(!(MD_PARSER_FLAGS(ctx) & MD_FLAG_NOHTMLSPANS)) {
                     int is_html;
                     OFF html_end;
 
@@ -3193,14 +4206,14 @@ md_collect_marks(MD_CTX* ctx, const MD_LINE* lines, int n_lines, int table_mode)
             /* A potential mention link. */
             /* A potential permissive e-mail autolink. */
             if(ch == _T('@')) {
-                if( (ctx->parser.flags & MD_FLAG_MENTIONS) && (line->beg == off || (CH(off-1) == _T(' '))) )
+                if( (MD_PARSER_FLAGS(ctx) & MD_FLAG_MENTIONS) && (line->beg == off || (CH(off-1) == _T(' '))) )
                 {
                     OFF index = off + 1;
                     if (index == line->end || CH(index) == ' ') {
                         off++;
                         continue;
                     }
-                    while (index <= line->end)
+                    while (index < line->end)
                     {
                         if (!(ISALNUM(index) || (CH(index) == '_')))
                             break;
@@ -3276,7 +4289,7 @@ md_collect_marks(MD_CTX* ctx, const MD_LINE* lines, int n_lines, int table_mode)
             }
 
             /* A potential table cell boundary or wiki link label delimiter. */
-            if((table_mode || ctx->parser.flags & MD_FLAG_WIKILINKS) && ch == _T('|')) {
+            if((table_mode || MD_PARSER_FLAGS(ctx) & MD_FLAG_WIKILINKS) && ch == _T('|')) {
                 PUSH_MARK(ch, off, off+1, 0);
                 off++;
                 continue;
@@ -3346,7 +4359,7 @@ md_collect_marks(MD_CTX* ctx, const MD_LINE* lines, int n_lines, int table_mode)
 
     /* Add a dummy mark at the end of the mark vector to simplify
      * process_inlines(). */
-    PUSH_MARK(127, ctx->size, ctx->size, MD_MARK_RESOLVED);
+    PUSH_MARK(127, ctx->size, ctx->size, MD_MARK_RESOLVED | (truncated ? MD_MARK_TRUNCATED : 0));
 
 abort:
     return ret;
@@ -3450,7 +4463,7 @@ md_resolve_links(MD_CTX* ctx, const MD_LINE* lines, int n_lines)
         /* Recognize and resolve wiki links.
          * Wiki-links maybe '[[destination]]' or '[[destination|label]]'.
          */
-        if ((ctx->parser.flags & MD_FLAG_WIKILINKS) &&
+        if ((MD_PARSER_FLAGS(ctx) & MD_FLAG_WIKILINKS) &&
             (opener->end - opener->beg == 1) &&         /* not image */
             next_opener != NULL &&                      /* double '[' opener */
             next_opener->ch == '[' &&
@@ -3575,7 +4588,7 @@ md_resolve_links(MD_CTX* ctx, const MD_LINE* lines, int n_lines)
                             if(ctx->marks[mark->next].beg >= inline_link_end) {
                                 /* Cancel the link status. */
                                 if(attr.title_needs_free)
-                                    free(attr.title);
+                                    md_free(ctx, attr.title);
                                 is_link = FALSE;
                                 break;
                             }
@@ -3607,10 +4620,12 @@ md_resolve_links(MD_CTX* ctx, const MD_LINE* lines, int n_lines)
             closer->flags |= MD_MARK_CLOSER | MD_MARK_RESOLVED;
 
             /* If it is a link, we store the destination and title in the two
-             * dummy marks after the opener. */
+             * dummy marks after the opener. (The destination as a pointer too,
+             * as it may live in MD_PARSER::ref_dict rather than in the
+             * document.) */
             MD_ASSERT(ctx->marks[opener_index+1].ch == 'D');
-            ctx->marks[opener_index+1].beg = attr.dest_beg;
-            ctx->marks[opener_index+1].end = attr.dest_end;
+            md_mark_store_ptr(ctx, opener_index+1, (void*) attr.dest);
+            ctx->marks[opener_index+1].prev = attr.dest_size;
 
             MD_ASSERT(ctx->marks[opener_index+2].ch == 'D');
             md_mark_store_ptr(ctx, opener_index+2, attr.title);
@@ -3632,7 +4647,7 @@ md_resolve_links(MD_CTX* ctx, const MD_LINE* lines, int n_lines)
             /* If the link text is formed by nothing but permissive autolink,
              * suppress the autolink.
              * See https://github.com/mity/md4c/issues/152 for more info. */
-            if(ctx->parser.flags & MD_FLAG_PERMISSIVEAUTOLINKS) {
+            if(MD_PARSER_FLAGS(ctx) & MD_FLAG_PERMISSIVEAUTOLINKS) {
                 MD_MARK* first_nested;
                 MD_MARK* last_nested;
 
@@ -4008,6 +5023,10 @@ md_analyze_marks(MD_CTX* ctx, const MD_LINE* lines, int n_lines,
             continue;
         }
 
+        /* The caller checks ctx->cancelled. */
+        if(MD_IS_CANCELLED())
+            return;
+
         /* Analyze the mark. */
         switch(mark->ch) {
             case '[':   /* Pass through. */
@@ -4032,6 +5051,7 @@ md_analyze_marks(MD_CTX* ctx, const MD_LINE* lines, int n_lines,
 static int
 md_analyze_inlines(MD_CTX* ctx, const MD_LINE* lines, int n_lines, int table_mode)
 {
+    int phase = MD_STATS_ENTER(MD_STATS_MARKS);
     int ret;
 
     /* Reset the previously collected stack of marks. */
@@ -4039,6 +5059,10 @@ md_analyze_inlines(MD_CTX* ctx, const MD_LINE* lines, int n_lines, int table_mod
 
     /* Collect all marks. */
     MD_CHECK(md_collect_marks(ctx, lines, n_lines, table_mode));
+    ctx->stats.n_marks += ctx->n_marks;
+    if(n_lines > 0)
+        ctx->stats.mark_collection_size += lines[n_lines-1].end - lines[0].beg;
+    MD_STATS_SWITCH(MD_STATS_RESOLVE);
 
     /* We analyze marks in few groups to handle their precedence. */
     /* (1) Entities; code spans; autolinks; raw HTML. */
@@ -4046,6 +5070,10 @@ md_analyze_inlines(MD_CTX* ctx, const MD_LINE* lines, int n_lines, int table_mod
 
     /* (2) Links. */
     md_analyze_marks(ctx, lines, n_lines, 0, ctx->n_marks, _T("[]!"));
+    if(ctx->cancelled) {
+        ret = -1;
+        goto abort;
+    }
     MD_CHECK(md_resolve_links(ctx, lines, n_lines));
     BRACKET_OPENERS.head = -1;
     BRACKET_OPENERS.tail = -1;
@@ -4061,13 +5089,17 @@ md_analyze_inlines(MD_CTX* ctx, const MD_LINE* lines, int n_lines, int table_mod
         TABLECELLBOUNDARIES.tail = -1;
         ctx->n_table_cell_boundaries = 0;
         md_analyze_marks(ctx, lines, n_lines, 0, ctx->n_marks, _T("|"));
-        return ret;
+    } else {
+        /* (4) Emphasis and strong emphasis; permissive autolinks. */
+        md_analyze_link_contents(ctx, lines, n_lines, 0, ctx->n_marks);
     }
 
-    /* (4) Emphasis and strong emphasis; permissive autolinks. */
-    md_analyze_link_contents(ctx, lines, n_lines, 0, ctx->n_marks);
+    if(ctx->cancelled)
+        ret = -1;
 
 abort:
+    MD_STATS_PEAK(mark_buffer_size, ctx->n_marks * sizeof(MD_MARK));
+    MD_STATS_SWITCH(phase);
     return ret;
 }
 
@@ -4146,6 +5178,7 @@ md_process_inlines(MD_CTX* ctx, const MD_LINE* lines, int n_lines)
     OFF off = lines[0].beg;
     OFF end = lines[n_lines-1].end;
     int enforce_hardbreak = 0;
+    int truncated = (ctx->marks[ctx->n_marks-1].flags & MD_MARK_TRUNCATED);
     int ret = 0;
 
     /* Find first resolved mark. Note there is always at least one resolved
@@ -4162,7 +5195,12 @@ md_process_inlines(MD_CTX* ctx, const MD_LINE* lines, int n_lines)
         /* Process the text up to the next mark or end-of-line. */
         OFF tmp = (line->end < mark->beg ? line->end : mark->beg);
         if(tmp > off) {
-            MD_TEXT(text_type, STR(off), tmp - off);
+            /* If the marks are truncated, the text may contain anything
+             * including NUL characters. */
+            if(truncated)
+                MD_TEXT_INSECURE(text_type, STR(off), tmp - off);
+            else
+                MD_TEXT(text_type, STR(off), tmp - off);
             off = tmp;
         }
 
@@ -4191,7 +5229,7 @@ md_process_inlines(MD_CTX* ctx, const MD_LINE* lines, int n_lines)
                     break;
 
                 case '_':       /* Underline (or emphasis if we fall through). */
-                    if(ctx->parser.flags & MD_FLAG_UNDERLINE) {
+                    if(MD_PARSER_FLAGS(ctx) & MD_FLAG_UNDERLINE) {
                         if(mark->flags & MD_MARK_OPENER) {
                             while(off < mark->end) {
                                 MD_ENTER_SPAN(MD_SPAN_U, NULL);
@@ -4281,7 +5319,7 @@ md_process_inlines(MD_CTX* ctx, const MD_LINE* lines, int n_lines)
 
                     MD_CHECK(md_enter_leave_span_a(ctx, (mark->ch != ']'),
                                 (opener->ch == '!' ? MD_SPAN_IMG : MD_SPAN_A),
-                                STR(dest_mark->beg), dest_mark->end - dest_mark->beg, FALSE,
+                                md_mark_get_ptr(ctx, (int)(dest_mark - ctx->marks)), dest_mark->prev, FALSE,
                                 md_mark_get_ptr(ctx, (int)(title_mark - ctx->marks)),
 								title_mark->prev));
 
@@ -4312,13 +5350,13 @@ md_process_inlines(MD_CTX* ctx, const MD_LINE* lines, int n_lines)
                 case ':':       /* Permissive URL autolink. */
                 case '.':       /* Permissive WWW autolink. */
                 {
-                    MD_MARK* opener = ((mark->flags & MD_MARK_OPENER) ? mark : &ctx->marks[mark->prev]);
-                    MD_MARK* closer = &ctx->marks[opener->next];
-                    const CHAR* dest = STR(opener->end);
-                    SZ dest_size = closer->beg - opener->end;
+                    MD_MARK* opener;
+                    MD_MARK* closer;
+                    const CHAR* dest;
+                    SZ dest_size;
 
                     MD_SPAN_MENTION_DETAIL det;
-                    if (CH(mark->beg) == '@')
+                    if (mark->ch == _T('@')  &&  !(mark->flags & (MD_MARK_OPENER | MD_MARK_CLOSER)))
                     {
                         det.text = (char *) ctx->text + mark->beg + 1;
                         det.size = mark->end - mark->beg - 1;
@@ -4328,6 +5366,13 @@ md_process_inlines(MD_CTX* ctx, const MD_LINE* lines, int n_lines)
                         break;
                     }
 
+                    /* (Mention marks are not paired so we may only look at
+                     * the opener/closer now.) */
+                    opener = ((mark->flags & MD_MARK_OPENER) ? mark : &ctx->marks[mark->prev]);
+                    closer = &ctx->marks[opener->next];
+                    dest = STR(opener->end);
+                    dest_size = closer->beg - opener->end;
+
                     /* For permissive auto-links we do not know closer mark
                      * position at the time of md_collect_marks(), therefore
                      * it can be out-of-order in ctx->marks[].
@@ -4354,7 +5399,7 @@ md_process_inlines(MD_CTX* ctx, const MD_LINE* lines, int n_lines)
                 }
 
                 case '&':       /* Entity. */
-                    MD_TEXT(MD_TEXT_ENTITY, STR(mark->beg), mark->end - mark->beg);
+                    MD_TEXT_ENTITY_(STR(mark->beg), mark->end - mark->beg);
                     break;
 
                 case '\0':
@@ -4510,7 +5555,7 @@ md_process_table_row(MD_CTX* ctx, MD_BLOCKTYPE cell_type, OFF beg, OFF end,
     /* We have to remember the cell boundaries in local buffer because
      * ctx->marks[] shall be reused during cell contents processing. */
     n = ctx->n_table_cell_boundaries + 2;
-    pipe_offs = (OFF*) malloc(n * sizeof(OFF));
+    pipe_offs = (OFF*) md_malloc(ctx, n * sizeof(OFF));
     if(pipe_offs == NULL) {
         MD_LOG("malloc() failed.");
         ret = -1;
@@ -4538,11 +5583,11 @@ md_process_table_row(MD_CTX* ctx, MD_BLOCKTYPE cell_type, OFF beg, OFF end,
     MD_LEAVE_BLOCK(MD_BLOCK_TR, NULL);
 
 abort:
-    free(pipe_offs);
+    md_free(ctx, pipe_offs);
 
     /* Free any temporary memory blocks stored within some dummy marks. */
     for(i = PTR_CHAIN.head; i >= 0; i = ctx->marks[i].next)
-        free(md_mark_get_ptr(ctx, i));
+        md_free(ctx, md_mark_get_ptr(ctx, i));
     PTR_CHAIN.head = -1;
     PTR_CHAIN.tail = -1;
 
@@ -4560,7 +5605,7 @@ md_process_table_block_contents(MD_CTX* ctx, int col_count, const MD_LINE* lines
      * with the underlines. */
     MD_ASSERT(n_lines >= 2);
 
-    align = malloc(col_count * sizeof(MD_ALIGN));
+    align = md_malloc(ctx, col_count * sizeof(MD_ALIGN));
     if(align == NULL) {
         MD_LOG("malloc() failed.");
         ret = -1;
@@ -4584,7 +5629,7 @@ md_process_table_block_contents(MD_CTX* ctx, int col_count, const MD_LINE* lines
     }
 
 abort:
-    free(align);
+    md_free(ctx, align);
     return ret;
 }
 
@@ -4641,7 +5686,7 @@ md_process_normal_block_contents(MD_CTX* ctx, const MD_LINE* lines, int n_lines)
 abort:
     /* Free any temporary memory blocks stored within some dummy marks. */
     for(i = PTR_CHAIN.head; i >= 0; i = ctx->marks[i].next)
-        free(md_mark_get_ptr(ctx, i));
+        md_free(ctx, md_mark_get_ptr(ctx, i));
     PTR_CHAIN.head = -1;
     PTR_CHAIN.tail = -1;
 
@@ -4744,6 +5789,388 @@ abort:
     return ret;
 }
 
+/* Parallel inline analysis.
+ *
+ * Once the ref. defs are known, the inlines of each leaf block can be analyzed
+ * independently of other blocks. So, for large documents, the ordinary (not
+ * table) leaf blocks are distributed to ctx->workers before
+ * md_process_all_blocks() starts to call the callbacks. Each worker has its
+ * own copy of MD_CTX (i.e. its own marks stack and the other state of the
+ * inline analysis). Only md_process_inlines() (which calls the callbacks) is
+ * then left for the main thread.
+ */
+
+/* Do not bother with a thread for less than this amount of text. */
+#define MD_INLINE_WORKER_MIN_SIZE       (32 * 1024)
+
+/* Process the inlines of the block as analyzed by a worker. With lines ==
+ * NULL, just release the job. */
+static int
+md_process_preanalyzed_block_contents(MD_CTX* ctx, MD_INLINE_JOB* job,
+                                      const MD_LINE* lines, int n_lines)
+{
+    MD_MARK* marks = ctx->marks;
+    int n_marks = ctx->n_marks;
+    int alloc_marks = ctx->alloc_marks;
+    int i;
+    int ret = job->ret;
+
+    if(ret != 0)
+        return ret;
+
+    ctx->marks = job->marks;
+    ctx->n_marks = job->n_marks;
+    ctx->alloc_marks = job->n_marks;
+    PTR_CHAIN.head = job->ptr_chain_head;
+    PTR_CHAIN.tail = job->ptr_chain_tail;
+
+    if(lines != NULL)
+        MD_CHECK(md_process_inlines(ctx, lines, n_lines));
+
+abort:
+    /* Free any temporary memory blocks stored within some dummy marks. */
+    for(i = PTR_CHAIN.head; i >= 0; i = ctx->marks[i].next)
+        md_free(ctx, md_mark_get_ptr(ctx, i));
+    PTR_CHAIN.head = -1;
+    PTR_CHAIN.tail = -1;
+
+    ctx->marks = marks;
+    ctx->n_marks = n_marks;
+    ctx->alloc_marks = alloc_marks;
+    job->ret = -1;
+    return ret;
+}
+
+/* Clean up after md_process_all_blocks(), even if it has not got to all the
+ * jobs. */
+static void
+md_end_inline_jobs(MD_CTX* ctx)
+{
+    int i;
+
+    while(ctx->next_inline_job < ctx->n_inline_jobs)
+        md_process_preanalyzed_block_contents(ctx, &ctx->inline_jobs[ctx->next_inline_job++], NULL, 0);
+    ctx->n_inline_jobs = 0;
+    ctx->next_inline_job = 0;
+
+    /* The arenas cannot be reused piecewise so release it all. */
+    if(ctx->use_arena) {
+        for(i = 0; i < ctx->n_workers; i++) {
+            MD_INLINE_WORKER* w = &ctx->workers[i];
+
+            /* (What the worker has taken has been merged into our count.) */
+            ctx->n_charged_bytes -= w->ctx.arena.n_used;
+            md_arena_release(w->ctx.allocator, &w->ctx.arena);
+            w->ctx.marks = NULL;
+            w->ctx.alloc_marks = 0;
+            w->ctx.buffer = NULL;
+            w->ctx.alloc_buffer = 0;
+            w->ctx.lookup_key = NULL;
+            w->ctx.alloc_lookup_key = 0;
+            w->results = NULL;
+            w->alloc_results = 0;
+        }
+    }
+}
+
+#if defined MD_THREADS
+
+static void
+md_run_inline_worker(MD_INLINE_WORKER* w)
+{
+    MD_CTX* ctx = &w->ctx;
+    int i, j;
+    int ret = 0;
+
+    w->n_results = 0;
+
+    for(i = 0; i < w->n_jobs; i++) {
+        MD_INLINE_JOB* job = &w->jobs[i];
+
+        MD_CHECK(md_analyze_inlines(ctx, (const MD_LINE*)(job->block + 1), job->block->n_lines, FALSE));
+
+        if(w->n_results + ctx->n_marks > w->alloc_results) {
+            MD_MARK* new_results;
+            size_t new_alloc_results;
+
+            new_alloc_results = w->n_results + ctx->n_marks;
+            new_alloc_results += new_alloc_results / 2 + 64;
+            new_results = (MD_MARK*) md_realloc(ctx, w->results, new_alloc_results * sizeof(MD_MARK));
+            if(new_results == NULL) {
+                MD_LOG("realloc() failed.");
+                ret = -1;
+                goto abort;
+            }
+            w->results = new_results;
+            w->alloc_results = new_alloc_results;
+        }
+
+        memcpy(w->results + w->n_results, ctx->marks, ctx->n_marks * sizeof(MD_MARK));
+        job->marks_off = w->n_results;
+        job->n_marks = ctx->n_marks;
+        job->ptr_chain_head = PTR_CHAIN.head;
+        job->ptr_chain_tail = PTR_CHAIN.tail;
+        job->ret = 0;
+        w->n_results += ctx->n_marks;
+        PTR_CHAIN.head = -1;
+        PTR_CHAIN.tail = -1;
+    }
+
+abort:
+    if(ret != 0) {
+        /* The failed job may have stored something already. */
+        for(j = PTR_CHAIN.head; j >= 0; j = ctx->marks[j].next)
+            md_free(ctx, md_mark_get_ptr(ctx, j));
+        PTR_CHAIN.head = -1;
+        PTR_CHAIN.tail = -1;
+
+        for(; i < w->n_jobs; i++)
+            w->jobs[i].ret = ret;
+    }
+}
+
+#if defined _WIN32
+static DWORD WINAPI
+md_inline_worker_thread(LPVOID arg)
+{
+    md_run_inline_worker((MD_INLINE_WORKER*) arg);
+    return 0;
+}
+#else
+static void*
+md_inline_worker_thread(void* arg)
+{
+    md_run_inline_worker((MD_INLINE_WORKER*) arg);
+    return NULL;
+}
+#endif
+
+static void
+md_start_inline_worker(MD_INLINE_WORKER* w)
+{
+#if defined _WIN32
+    w->thread = CreateThread(NULL, 0, md_inline_worker_thread, w, 0, NULL);
+    w->has_thread = (w->thread != NULL);
+#else
+    w->has_thread = (pthread_create(&w->thread, NULL, md_inline_worker_thread, w) == 0);
+#endif
+}
+
+static void
+md_join_inline_worker(MD_INLINE_WORKER* w)
+{
+#if defined _WIN32
+    WaitForSingleObject(w->thread, INFINITE);
+    CloseHandle(w->thread);
+#else
+    pthread_join(w->thread, NULL);
+#endif
+    w->has_thread = FALSE;
+}
+
+static int
+md_push_inline_job(MD_CTX* ctx, const MD_BLOCK* block)
+{
+    MD_INLINE_JOB* job;
+
+    if(ctx->n_inline_jobs >= ctx->alloc_inline_jobs) {
+        MD_INLINE_JOB* new_jobs;
+        int new_alloc_jobs;
+
+        new_alloc_jobs = (ctx->alloc_inline_jobs > 0
+                ? ctx->alloc_inline_jobs + ctx->alloc_inline_jobs / 2
+                : 256);
+        new_jobs = (MD_INLINE_JOB*) md_realloc(ctx, ctx->inline_jobs, new_alloc_jobs * sizeof(MD_INLINE_JOB));
+        if(new_jobs == NULL) {
+            MD_LOG("realloc() failed.");
+            return -1;
+        }
+        ctx->inline_jobs = new_jobs;
+        ctx->alloc_inline_jobs = new_alloc_jobs;
+    }
+
+    job = &ctx->inline_jobs[ctx->n_inline_jobs++];
+    job->block = block;
+    job->marks = NULL;
+    job->marks_off = 0;
+    job->n_marks = 0;
+    job->ptr_chain_head = -1;
+    job->ptr_chain_tail = -1;
+    job->ret = -1;
+    return 0;
+}
+
+static size_t
+md_block_text_size(const MD_BLOCK* block)
+{
+    const MD_LINE* lines = (const MD_LINE*)(block + 1);
+    size_t size = 0;
+    int i;
+
+    for(i = 0; i < (int) block->n_lines; i++)
+        size += lines[i].end - lines[i].beg;
+    return size;
+}
+
+static void
+md_setup_inline_worker(MD_CTX* ctx, MD_INLINE_WORKER* w)
+{
+    MD_CTX* wctx = &w->ctx;
+    MD_MARK* marks = wctx->marks;
+    int alloc_marks = wctx->alloc_marks;
+    CHAR* buffer = wctx->buffer;
+    unsigned alloc_buffer = wctx->alloc_buffer;
+    unsigned char* lookup_key = wctx->lookup_key;
+    size_t alloc_lookup_key = wctx->alloc_lookup_key;
+    MD_ARENA arena = wctx->arena;
+    int i;
+
+    /* Share all the read-only stuff (text, ref. defs, ...) with the main
+     * context, but keep the worker's own buffers. */
+    memcpy(wctx, ctx, sizeof(MD_CTX));
+    wctx->marks = marks;
+    wctx->alloc_marks = alloc_marks;
+    wctx->n_marks = 0;
+    wctx->buffer = buffer;
+    wctx->alloc_buffer = alloc_buffer;
+    wctx->lookup_key = lookup_key;
+    wctx->alloc_lookup_key = alloc_lookup_key;
+    wctx->arena = arena;
+    wctx->workers = NULL;
+    wctx->n_workers = 0;
+    wctx->inline_jobs = NULL;
+    wctx->n_inline_jobs = 0;
+    wctx->alloc_inline_jobs = 0;
+
+    for(i = 0; i < (int) SIZEOF_ARRAY(wctx->mark_chains); i++) {
+        wctx->mark_chains[i].head = -1;
+        wctx->mark_chains[i].tail = -1;
+    }
+    wctx->html_comment_horizon = 0;
+    wctx->html_proc_instr_horizon = 0;
+    wctx->html_decl_horizon = 0;
+    wctx->html_cdata_horizon = 0;
+
+    memset(&wctx->stats, 0, sizeof(MD_PARSE_STATS));
+    wctx->stats_phase = MD_STATS_NONE;
+
+    w->has_thread = FALSE;
+}
+
+/* Add what the worker has measured in md_run_inline_worker() (and whether
+ * it has failed due to a resource limit or a cancellation). */
+static void
+md_merge_inline_worker_stats(MD_CTX* ctx, const MD_INLINE_WORKER* w)
+{
+    const MD_PARSE_STATS* ws = &w->ctx.stats;
+
+    ctx->stats.mark_collection_time += ws->mark_collection_time;
+    ctx->stats.mark_collection_size += ws->mark_collection_size;
+    ctx->stats.mark_resolution_time += ws->mark_resolution_time;
+    ctx->stats.n_marks += ws->n_marks;
+    ctx->stats.n_rollbacks += ws->n_rollbacks;
+    ctx->stats.n_ref_def_lookups += ws->n_ref_def_lookups;
+
+    if(ctx->parser.max_memory > 0)
+        ctx->n_charged_bytes += w->ctx.n_charged_bytes;
+    if(w->ctx.limit_exceeded)
+        ctx->limit_exceeded = TRUE;
+    if(w->ctx.cancelled)
+        ctx->cancelled = TRUE;
+}
+
+static int
+md_analyze_inlines_in_parallel(MD_CTX* ctx)
+{
+    int byte_off = 0;
+    size_t total_size = 0;
+    size_t size = 0;
+    size_t mark_buffer_size = 0;
+    size_t aux_buffer_size = 0;
+    int n_workers;
+    int i, w;
+    int ret = 0;
+
+    /* Collect the jobs. */
+    while(byte_off < ctx->n_block_bytes) {
+        MD_BLOCK* block = (MD_BLOCK*)((char*)ctx->block_bytes + byte_off);
+
+        if(!(block->flags & MD_BLOCK_CONTAINER)) {
+            if(block->type == MD_BLOCK_P  ||  block->type == MD_BLOCK_H) {
+                MD_CHECK(md_push_inline_job(ctx, block));
+                total_size += md_block_text_size(block);
+            }
+
+            if(block->type == MD_BLOCK_CODE || block->type == MD_BLOCK_HTML)
+                byte_off += block->n_lines * sizeof(MD_VERBATIMLINE);
+            else
+                byte_off += block->n_lines * sizeof(MD_LINE);
+        }
+
+        byte_off += sizeof(MD_BLOCK);
+    }
+
+    n_workers = ctx->n_workers;
+    if(total_size / MD_INLINE_WORKER_MIN_SIZE < (size_t) n_workers)
+        n_workers = (int) (total_size / MD_INLINE_WORKER_MIN_SIZE);
+    if(n_workers < 2) {
+        /* Not worth it. */
+        ctx->n_inline_jobs = 0;
+        return 0;
+    }
+
+    /* Split the jobs into contiguous ranges of roughly the same text size,
+     * and start the workers. The 1st range is for this thread. */
+    i = 0;
+    for(w = 0; w < n_workers; w++) {
+        MD_INLINE_WORKER* worker = &ctx->workers[w];
+        size_t limit = total_size / n_workers * (w + 1);
+
+        md_setup_inline_worker(ctx, worker);
+        if(ctx->parser.max_memory > 0) {
+            /* Each worker gets its share of what remains of the budget. */
+            size_t share = (ctx->parser.max_memory - ctx->n_charged_bytes) / n_workers;
+            worker->ctx.parser.max_memory = (share > 0 ? share : 1);
+            worker->ctx.n_charged_bytes = 0;
+        }
+        worker->jobs = &ctx->inline_jobs[i];
+        while(i < ctx->n_inline_jobs  &&  (size < limit  ||  w == n_workers-1))
+            size += md_block_text_size(ctx->inline_jobs[i++].block);
+        worker->n_jobs = (int) (&ctx->inline_jobs[i] - worker->jobs);
+
+        if(w > 0)
+            md_start_inline_worker(worker);
+    }
+
+    /* Do our share, and also the share of any worker whose thread has failed
+     * to start. */
+    for(w = 0; w < n_workers; w++) {
+        if(!ctx->workers[w].has_thread)
+            md_run_inline_worker(&ctx->workers[w]);
+    }
+
+    for(w = 0; w < n_workers; w++) {
+        MD_INLINE_WORKER* worker = &ctx->workers[w];
+
+        if(worker->has_thread)
+            md_join_inline_worker(worker);
+        md_merge_inline_worker_stats(ctx, worker);
+        for(i = 0; i < worker->n_jobs; i++)
+            worker->jobs[i].marks = worker->results + worker->jobs[i].marks_off;
+        mark_buffer_size += worker->ctx.stats.mark_buffer_size + worker->n_results * sizeof(MD_MARK);
+        aux_buffer_size += worker->ctx.stats.aux_buffer_size;
+    }
+
+    /* The workers have used their buffers all at the same time. */
+    MD_STATS_PEAK(mark_buffer_size, mark_buffer_size);
+    MD_STATS_PEAK(aux_buffer_size, aux_buffer_size);
+
+abort:
+    return ret;
+}
+
+#endif  /* MD_THREADS */
+
 static int
 md_process_leaf_block(MD_CTX* ctx, const MD_BLOCK* block)
 {
@@ -4752,8 +6179,8 @@ md_process_leaf_block(MD_CTX* ctx, const MD_BLOCK* block)
         MD_BLOCK_CODE_DETAIL code;
         MD_BLOCK_TABLE_DETAIL table;
     } det;
-    MD_ATTRIBUTE_BUILD info_build;
-    MD_ATTRIBUTE_BUILD lang_build;
+    MD_ATTRIBUTE_BUILD info_build = { 0 };
+    MD_ATTRIBUTE_BUILD lang_build = { 0 };
     int is_in_tight_list;
     int clean_fence_code_detail = FALSE;
     int ret = 0;
@@ -4815,8 +6242,16 @@ md_process_leaf_block(MD_CTX* ctx, const MD_BLOCK* block)
             break;
 
         default:
-            MD_CHECK(md_process_normal_block_contents(ctx,
+            if(ctx->next_inline_job < ctx->n_inline_jobs  &&
+               ctx->inline_jobs[ctx->next_inline_job].block == block)
+            {
+                MD_CHECK(md_process_preanalyzed_block_contents(ctx,
+                            &ctx->inline_jobs[ctx->next_inline_job++],
+                            (const MD_LINE*)(block + 1), block->n_lines));
+            } else {
+                MD_CHECK(md_process_normal_block_contents(ctx,
                             (const MD_LINE*)(block + 1), block->n_lines));
+            }
             break;
     }
 
@@ -4835,6 +6270,7 @@ static int
 md_process_all_blocks(MD_CTX* ctx)
 {
     int byte_off = 0;
+    int phase = MD_STATS_ENTER(MD_STATS_EMIT);
     int ret = 0;
 
     /* ctx->containers now is not needed for detection of lists and list items
@@ -4843,6 +6279,17 @@ md_process_all_blocks(MD_CTX* ctx)
      * level of lists. */
     ctx->n_containers = 0;
 
+#if defined MD_THREADS
+    if(ctx->n_workers > 1) {
+        /* The workers measure the time on their own. */
+        MD_STATS_SWITCH(MD_STATS_NONE);
+        ret = md_analyze_inlines_in_parallel(ctx);
+        MD_STATS_SWITCH(MD_STATS_EMIT);
+        if(ret < 0)
+            goto abort;
+    }
+#endif
+
     while(byte_off < ctx->n_block_bytes) {
         MD_BLOCK* block = (MD_BLOCK*)((char*)ctx->block_bytes + byte_off);
         union {
@@ -4851,6 +6298,8 @@ md_process_all_blocks(MD_CTX* ctx)
             MD_BLOCK_LI_DETAIL li;
         } det;
 
+        MD_CHECK_CANCEL();
+
         switch(block->type) {
             case MD_BLOCK_UL:
                 det.ul.is_tight = (block->flags & MD_BLOCK_LOOSE_LIST) ? FALSE : TRUE;
@@ -4866,7 +6315,7 @@ md_process_all_blocks(MD_CTX* ctx)
             case MD_BLOCK_LI:
                 det.li.is_task = (block->data != 0);
                 det.li.task_mark = (CHAR) block->data;
-                det.li.task_mark_offset = (OFF) block->n_lines;
+                det.li.task_mark_offset = ctx->text_base + (OFF) block->n_lines;
                 break;
 
             default:
@@ -4874,6 +6323,9 @@ md_process_all_blocks(MD_CTX* ctx)
                 break;
         }
 
+        if(!(block->flags & MD_BLOCK_CONTAINER)  ||  (block->flags & MD_BLOCK_CONTAINER_OPENER))
+            ctx->stats.n_blocks++;
+
         if(block->flags & MD_BLOCK_CONTAINER) {
             if(block->flags & MD_BLOCK_CONTAINER_CLOSER) {
                 MD_LEAVE_BLOCK(block->type, &det);
@@ -4911,6 +6363,8 @@ md_process_all_blocks(MD_CTX* ctx)
     ctx->n_block_bytes = 0;
 
 abort:
+    md_end_inline_jobs(ctx);
+    MD_STATS_SWITCH(phase);
     return ret;
 }
 
@@ -4926,11 +6380,12 @@ md_push_block_bytes(MD_CTX* ctx, int n_bytes)
 
     if(ctx->n_block_bytes + n_bytes > ctx->alloc_block_bytes) {
         void* new_block_bytes;
+        int new_alloc_block_bytes;
 
-        ctx->alloc_block_bytes = (ctx->alloc_block_bytes > 0
+        new_alloc_block_bytes = (ctx->alloc_block_bytes > 0
                 ? ctx->alloc_block_bytes + ctx->alloc_block_bytes / 2
                 : 512);
-        new_block_bytes = realloc(ctx->block_bytes, ctx->alloc_block_bytes);
+        new_block_bytes = md_realloc(ctx, ctx->block_bytes, new_alloc_block_bytes);
         if(new_block_bytes == NULL) {
             MD_LOG("realloc() failed.");
             return NULL;
@@ -4943,10 +6398,12 @@ md_push_block_bytes(MD_CTX* ctx, int n_bytes)
         }
 
         ctx->block_bytes = new_block_bytes;
+        ctx->alloc_block_bytes = new_alloc_block_bytes;
     }
 
     ptr = (char*)ctx->block_bytes + ctx->n_block_bytes;
     ctx->n_block_bytes += n_bytes;
+    MD_STATS_PEAK(block_buffer_size, ctx->n_block_bytes);
     return ptr;
 }
 
@@ -5012,6 +6469,7 @@ md_consume_link_reference_definitions(MD_CTX* ctx)
     MD_LINE* lines = (MD_LINE*) (ctx->current_block + 1);
     int n_lines = ctx->current_block->n_lines;
     int n = 0;
+    int phase = MD_STATS_ENTER(MD_STATS_REFDEFS);
 
     /* Compute how many lines at the start of the block form one or more
      * reference definitions. */
@@ -5026,15 +6484,19 @@ md_consume_link_reference_definitions(MD_CTX* ctx)
 
         /* We fail if it is the ref. def. but it could not be stored due
          * a memory allocation error. */
-        if(n_link_ref_lines < 0)
+        if(n_link_ref_lines < 0) {
+            MD_STATS_SWITCH(phase);
             return -1;
+        }
 
         n += n_link_ref_lines;
+        ctx->stats.n_ref_defs++;
     }
 
     /* If there was at least one reference definition, we need to remove
      * its lines from the block, or perhaps even the whole block. */
     if(n > 0) {
+        ctx->stats.ref_def_size += lines[n-1].end - lines[0].beg;
         if(n == n_lines) {
             /* Remove complete block. */
             ctx->n_block_bytes -= n * sizeof(MD_LINE);
@@ -5048,6 +6510,7 @@ md_consume_link_reference_definitions(MD_CTX* ctx)
         }
     }
 
+    MD_STATS_SWITCH(phase);
     return 0;
 }
 
@@ -5062,8 +6525,9 @@ md_end_current_block(MD_CTX* ctx)
     /* Check whether there is a reference definition. (We do this here instead
      * of in md_analyze_line() because reference definition can take multiple
      * lines.) */
-    if(ctx->current_block->type == MD_BLOCK_P  ||
-       (ctx->current_block->type == MD_BLOCK_H  &&  (ctx->current_block->flags & MD_BLOCK_SETEXT_HEADER)))
+    if(!(MD_PARSER_FLAGS(ctx) & MD_FLAG_NOREFDEFS)  &&
+       (ctx->current_block->type == MD_BLOCK_P  ||
+        (ctx->current_block->type == MD_BLOCK_H  &&  (ctx->current_block->flags & MD_BLOCK_SETEXT_HEADER))))
     {
         MD_LINE* lines = (MD_LINE*) (ctx->current_block + 1);
         if(CH(lines[0].beg) == _T('[')) {
@@ -5143,6 +6607,11 @@ md_push_container_bytes(MD_CTX* ctx, MD_BLOCKTYPE type, unsigned start,
     block->data = data;
     block->n_lines = start;
 
+    /* The top of ctx->block_bytes may be some line of a leaf block, so we
+     * cannot simply look there whether the list item has any contents. */
+    if(type == MD_BLOCK_LI  &&  (flags & MD_BLOCK_CONTAINER_OPENER))
+        ctx->li_opener_end = ctx->n_block_bytes;
+
 abort:
     return ret;
 }
@@ -5194,7 +6663,7 @@ md_is_atxheader_line(MD_CTX* ctx, OFF beg, OFF* p_beg, OFF* p_end, unsigned* p_l
         return FALSE;
     *p_level = n;
 
-    if(!(ctx->parser.flags & MD_FLAG_PERMISSIVEATXHEADERS)  &&  off < ctx->size  &&
+    if(!(MD_PARSER_FLAGS(ctx) & MD_FLAG_PERMISSIVEATXHEADERS)  &&  off < ctx->size  &&
        CH(off) != _T(' ')  &&  CH(off) != _T('\t')  &&  !ISNEWLINE(off))
         return FALSE;
 
@@ -5565,20 +7034,23 @@ md_push_container(MD_CTX* ctx, const MD_CONTAINER* container)
 {
     if(ctx->n_containers >= ctx->alloc_containers) {
         MD_CONTAINER* new_containers;
+        int new_alloc_containers;
 
-        ctx->alloc_containers = (ctx->alloc_containers > 0
+        new_alloc_containers = (ctx->alloc_containers > 0
                 ? ctx->alloc_containers + ctx->alloc_containers / 2
                 : 16);
-        new_containers = realloc(ctx->containers, ctx->alloc_containers * sizeof(MD_CONTAINER));
+        new_containers = md_realloc(ctx, ctx->containers, new_alloc_containers * sizeof(MD_CONTAINER));
         if(new_containers == NULL) {
             MD_LOG("realloc() failed.");
             return -1;
         }
 
         ctx->containers = new_containers;
+        ctx->alloc_containers = new_alloc_containers;
     }
 
     memcpy(&ctx->containers[ctx->n_containers++], container, sizeof(MD_CONTAINER));
+    MD_STATS_PEAK(container_buffer_size, ctx->n_containers * sizeof(MD_CONTAINER));
     return 0;
 }
 
@@ -5603,7 +7075,7 @@ md_enter_child_containers(MD_CTX* ctx, int n_children)
             case _T('*'):
                 /* Remember offset in ctx->block_bytes so we can revisit the
                  * block if we detect it is a loose list. */
-                md_end_current_block(ctx);
+                MD_CHECK(md_end_current_block(ctx));
                 c->block_byte_off = ctx->n_block_bytes;
 
                 MD_CHECK(md_push_container_bytes(ctx,
@@ -5713,7 +7185,7 @@ md_is_container_mark(MD_CTX* ctx, unsigned indent, OFF beg, OFF* p_end, MD_CONTA
         p_container->start = p_container->start * 10 + CH(off) - _T('0');
         off++;
     }
-    if(off > beg  &&
+    if(off > beg  &&  off < ctx->size  &&
        (CH(off) == _T('.') || CH(off) == _T(')'))  &&
        (off+1 >= ctx->size || ISBLANK(off+1) || ISNEWLINE(off+1)))
     {
@@ -5749,6 +7221,73 @@ md_line_indentation(MD_CTX* ctx, unsigned total_indent, OFF beg, OFF* p_end)
 
 static const MD_LINE_ANALYSIS md_dummy_blank_line = { MD_LINE_BLANK, 0, 0, 0, 0 };
 
+#if defined MD_SIMD_SSE2
+/* Find the first '\r' or '\n' at or after off (or ctx->size if none).
+ *
+ * The text is classified 32 bytes at a time and the resulting bitmask is
+ * remembered, so for documents made of many short lines, subsequent calls
+ * mostly just consume bits of the mask of the current window without touching
+ * the text at all. Calls have to be made with non-decreasing off. */
+static OFF
+md_find_newline(MD_CTX* ctx, OFF off)
+{
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+
+    while(TRUE) {
+        if(ctx->newline_window_valid  &&  off - ctx->newline_window_beg < 32) {
+            unsigned mask = ctx->newline_window_mask >> (off - ctx->newline_window_beg);
+            if(mask != 0)
+                return off + md_ctz(mask);
+            off = ctx->newline_window_beg + 32;
+        }
+
+        if(off + 32 > ctx->size)
+            break;
+
+        {
+#if defined MD_SIMD_AVX2
+            __m256i v = _mm256_loadu_si256((const __m256i*) STR(off));
+            __m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')),
+                                          _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+            ctx->newline_window_mask = (unsigned) _mm256_movemask_epi8(hit);
+#else
+            __m128i v0 = _mm_loadu_si128((const __m128i*) STR(off));
+            __m128i v1 = _mm_loadu_si128((const __m128i*) STR(off + 16));
+            __m128i hit0 = _mm_or_si128(_mm_cmpeq_epi8(v0, cr), _mm_cmpeq_epi8(v0, lf));
+            __m128i hit1 = _mm_or_si128(_mm_cmpeq_epi8(v1, cr), _mm_cmpeq_epi8(v1, lf));
+            ctx->newline_window_mask = (unsigned) _mm_movemask_epi8(hit0) |
+                                       ((unsigned) _mm_movemask_epi8(hit1) << 16);
+#endif
+            ctx->newline_window_beg = off;
+            ctx->newline_window_valid = TRUE;
+        }
+    }
+
+    /* The tail of the document. */
+    MD_UNUSED(cr);
+    MD_UNUSED(lf);
+    while(off < ctx->size  &&  !ISNEWLINE(off))
+        off++;
+    return off;
+}
+
+#ifdef DEBUG
+static OFF
+md_find_newline_checked(MD_CTX* ctx, OFF off)
+{
+    OFF ret = md_find_newline(ctx, off);
+
+    /* Verify the prepass against plain scanning. */
+    while(off < ctx->size  &&  !ISNEWLINE(off))
+        off++;
+    MD_ASSERT(ret == off);
+    return ret;
+}
+#define md_find_newline     md_find_newline_checked
+#endif
+#endif
+
 /* Analyze type of the line and find some its properties. This serves as a
  * main input for determining type and boundaries of a block. */
 static int
@@ -5894,11 +7433,9 @@ md_analyze_line(MD_CTX* ctx, OFF beg, OFF* p_end,
                  */
                 if(n_parents > 0  &&  ctx->containers[n_parents-1].ch != _T('>')  &&
                    n_brothers + n_children == 0  &&  ctx->current_block == NULL  &&
-                   ctx->n_block_bytes > (int) sizeof(MD_BLOCK))
+                   ctx->n_block_bytes == ctx->li_opener_end)
                 {
-                    MD_BLOCK* top_block = (MD_BLOCK*) ((char*)ctx->block_bytes + ctx->n_block_bytes - sizeof(MD_BLOCK));
-                    if(top_block->type == MD_BLOCK_LI)
-                        ctx->last_list_item_starts_with_two_blank_lines = TRUE;
+                    ctx->last_list_item_starts_with_two_blank_lines = TRUE;
                 }
     #endif
             }
@@ -5913,11 +7450,9 @@ md_analyze_line(MD_CTX* ctx, OFF beg, OFF* p_end,
             if(ctx->last_list_item_starts_with_two_blank_lines) {
                 if(n_parents > 0  &&  ctx->containers[n_parents-1].ch != _T('>')  &&
                    n_brothers + n_children == 0  &&  ctx->current_block == NULL  &&
-                   ctx->n_block_bytes > (int) sizeof(MD_BLOCK))
+                   ctx->n_block_bytes == ctx->li_opener_end)
                 {
-                    MD_BLOCK* top_block = (MD_BLOCK*) ((char*)ctx->block_bytes + ctx->n_block_bytes - sizeof(MD_BLOCK));
-                    if(top_block->type == MD_BLOCK_LI)
-                        n_parents--;
+                    n_parents--;
                 }
 
                 ctx->last_list_item_starts_with_two_blank_lines = FALSE;
@@ -5998,8 +7533,10 @@ md_analyze_line(MD_CTX* ctx, OFF beg, OFF* p_end,
             break;
         }
 
-        /* Check for start of a new container block. */
+        /* Check for start of a new container block (unless it would be
+         * nested too deep; see MD_PARSER::max_nesting). */
         if(line->indent < ctx->code_indent_offset  &&
+           (ctx->parser.max_nesting == 0  ||  (unsigned)(n_parents + n_brothers + n_children) < ctx->parser.max_nesting)  &&
            md_is_container_mark(ctx, line->indent, off, &off, &container))
         {
             if(pivot_line->type == MD_LINE_TEXT  &&  n_parents == ctx->n_containers  &&
@@ -6071,7 +7608,7 @@ md_analyze_line(MD_CTX* ctx, OFF beg, OFF* p_end,
 
         /* Check for start of raw HTML block. */
         if(off < ctx->size  &&  CH(off) == _T('<')
-            &&  !(ctx->parser.flags & MD_FLAG_NOHTMLBLOCKS))
+            &&  !(MD_PARSER_FLAGS(ctx) & MD_FLAG_NOHTMLBLOCKS))
         {
             ctx->html_block_type = md_is_html_block_start_condition(ctx, off);
 
@@ -6092,7 +7629,7 @@ md_analyze_line(MD_CTX* ctx, OFF beg, OFF* p_end,
         }
 
         /* Check for table underline. */
-        if((ctx->parser.flags & MD_FLAG_TABLES)  &&  pivot_line->type == MD_LINE_TEXT
+        if((MD_PARSER_FLAGS(ctx) & MD_FLAG_TABLES)  &&  pivot_line->type == MD_LINE_TEXT
             &&  off < ctx->size  &&  ISANYOF3(off, _T('|'), _T('-'), _T(':'))
             &&  n_parents == ctx->n_containers)
         {
@@ -6115,7 +7652,7 @@ md_analyze_line(MD_CTX* ctx, OFF beg, OFF* p_end,
         }
 
         /* Check for task mark. */
-        if((ctx->parser.flags & MD_FLAG_TASKLISTS)  &&  n_brothers + n_children > 0  &&
+        if((MD_PARSER_FLAGS(ctx) & MD_FLAG_TASKLISTS)  &&  n_brothers + n_children > 0  &&
            ISANYOF_(ctx->containers[ctx->n_containers-1].ch, _T("-+*.)")))
         {
             OFF tmp = off;
@@ -6144,7 +7681,10 @@ md_analyze_line(MD_CTX* ctx, OFF beg, OFF* p_end,
      * Note this is quite a bottleneck of the parsing as we here iterate almost
      * over compete document.
      */
-#if defined __linux__ && !defined MD4C_USE_UTF16
+#if defined MD_SIMD_SSE2
+    off = md_find_newline(ctx, off);
+#else
+  #if defined __linux__ && !defined MD4C_USE_UTF16
     /* Recent glibc versions have superbly optimized strcspn(), even using
      * vectorization if available. */
     if(ctx->doc_ends_with_newline  &&  off < ctx->size) {
@@ -6159,7 +7699,7 @@ md_analyze_line(MD_CTX* ctx, OFF beg, OFF* p_end,
                 break;
         }
     } else
-#endif
+  #endif
     {
         /* Optimization: Use some loop unrolling. */
         while(off + 3 < ctx->size  &&  !ISNEWLINE(off+0)  &&  !ISNEWLINE(off+1)
@@ -6168,6 +7708,7 @@ md_analyze_line(MD_CTX* ctx, OFF beg, OFF* p_end,
         while(off < ctx->size  &&  !ISNEWLINE(off))
             off++;
     }
+#endif
 
     /* Set end of the line. */
     line->end = off;
@@ -6179,7 +7720,7 @@ md_analyze_line(MD_CTX* ctx, OFF beg, OFF* p_end,
             tmp--;
         while(tmp > line->beg && CH(tmp-1) == _T('#'))
             tmp--;
-        if(tmp == line->beg || CH(tmp-1) == _T(' ') || (ctx->parser.flags & MD_FLAG_PERMISSIVEATXHEADERS))
+        if(tmp == line->beg || CH(tmp-1) == _T(' ') || (MD_PARSER_FLAGS(ctx) & MD_FLAG_PERMISSIVEATXHEADERS))
             line->end = tmp;
     }
 
@@ -6306,25 +7847,88 @@ abort:
 }
 
 static int
-md_process_doc(MD_CTX *ctx)
+md_begin_doc(MD_CTX* ctx)
 {
-    const MD_LINE_ANALYSIS* pivot_line = &md_dummy_blank_line;
-    MD_LINE_ANALYSIS line_buf[2];
-    MD_LINE_ANALYSIS* line = &line_buf[0];
-    OFF off = 0;
     int ret = 0;
 
+    /* No callback at all if cancelled before we start. */
+    MD_CHECK_CANCEL();
     MD_ENTER_BLOCK(MD_BLOCK_DOC, NULL);
 
-    while(off < ctx->size) {
-        if(line == pivot_line)
-            line = (line == &line_buf[0] ? &line_buf[1] : &line_buf[0]);
+abort:
+    return ret;
+}
+
+/* Analyze all the lines up to ctx->size. This may be called repeatedly, as
+ * ctx->size grows (see md_parser_feed()), provided ctx->size is always at the
+ * end of a complete line. */
+static int
+md_process_next_line(MD_CTX* ctx)
+{
+    int ret = 0;
+
+    MD_CHECK_CANCEL();
+
+    if(ctx->line == ctx->pivot_line)
+        ctx->line = (ctx->line == &ctx->line_buf[0] ? &ctx->line_buf[1] : &ctx->line_buf[0]);
+
+    MD_CHECK(md_analyze_line(ctx, ctx->line_off, &ctx->line_off, ctx->pivot_line, ctx->line));
+    MD_CHECK(md_process_line(ctx, &ctx->pivot_line, ctx->line));
+    ctx->stats.n_lines++;
+
+abort:
+    return ret;
+}
+
+/* Whether a line analyzed at ctx->line_off would be analyzed the same way
+ * regardless of any preceding line. */
+static int
+md_is_segment_boundary(MD_CTX* ctx)
+{
+    return (ctx->current_block == NULL  &&  ctx->n_containers == 0  &&
+            ctx->pivot_line == &md_dummy_blank_line  &&
+            !ctx->last_line_has_list_loosening_effect  &&
+            !ctx->last_list_item_starts_with_two_blank_lines);
+}
 
-        MD_CHECK(md_analyze_line(ctx, off, &off, pivot_line, line));
-        MD_CHECK(md_process_line(ctx, &pivot_line, line));
+/* With MD_FLAG_NOREFDEFS, nothing which comes later in the document can
+ * change how the blocks gathered so far are rendered. So whenever we get to
+ * a line where no block nor container is open, we may process the blocks
+ * right away and reuse ctx->block_bytes for the rest of the document. */
+static int
+md_flush_blocks(MD_CTX* ctx)
+{
+    if(ctx->n_block_bytes == 0  ||  !md_is_segment_boundary(ctx))
+        return 0;
+
+    return md_process_all_blocks(ctx);
+}
+
+static int
+md_process_lines(MD_CTX* ctx)
+{
+    OFF line_off = ctx->line_off;
+    int phase = MD_STATS_ENTER(MD_STATS_LINES);
+    int ret = 0;
+
+    while(ctx->line_off < ctx->size) {
+        MD_CHECK(md_process_next_line(ctx));
+        if(MD_PARSER_FLAGS(ctx) & MD_FLAG_NOREFDEFS)
+            MD_CHECK(md_flush_blocks(ctx));
     }
 
-    md_end_current_block(ctx);
+abort:
+    ctx->stats.line_analysis_size += ctx->line_off - line_off;
+    MD_STATS_SWITCH(phase);
+    return ret;
+}
+
+static int
+md_end_doc(MD_CTX* ctx)
+{
+    int ret = 0;
+
+    MD_CHECK(md_end_current_block(ctx));
 
     MD_CHECK(md_build_ref_def_hashtable(ctx));
 
@@ -6335,33 +7939,1903 @@ md_process_doc(MD_CTX *ctx)
     MD_LEAVE_BLOCK(MD_BLOCK_DOC, NULL);
 
 abort:
+    return ret;
+}
 
-#if 0
-    /* Output some memory consumption statistics. */
-    {
-        char buffer[256];
-        sprintf(buffer, "Alloced %u bytes for block buffer.",
-                    (unsigned)(ctx->alloc_block_bytes));
-        MD_LOG(buffer);
-
-        sprintf(buffer, "Alloced %u bytes for containers buffer.",
-                    (unsigned)(ctx->alloc_containers * sizeof(MD_CONTAINER)));
-        MD_LOG(buffer);
-
-        sprintf(buffer, "Alloced %u bytes for marks buffer.",
-                    (unsigned)(ctx->alloc_marks * sizeof(MD_MARK)));
-        MD_LOG(buffer);
+static int
+md_process_doc(MD_CTX *ctx)
+{
+    int ret = 0;
 
-        sprintf(buffer, "Alloced %u bytes for aux. buffer.",
-                    (unsigned)(ctx->alloc_buffer * sizeof(MD_CHAR)));
-        MD_LOG(buffer);
-    }
-#endif
+    /* (Not MD_CHECK() as any non-zero value from the callback aborts.) */
+    ret = md_begin_doc(ctx);
+    if(ret != 0)
+        goto abort;
+    MD_CHECK(md_process_lines(ctx));
+    MD_CHECK(md_end_doc(ctx));
 
+abort:
     return ret;
 }
 
 
+/*****************************
+ ***  Context Setup/Reuse  ***
+ *****************************/
+
+/* Default of MD_PARSER_HANDLE::trim_threshold. */
+#define MD_DEFAULT_TRIM_THRESHOLD       (1024 * 1024)
+
+/* Limit for md_parser_set_thread_count(). */
+#define MD_MAX_THREADS                  64
+
+/* Size of the MD_PARSER structure as known to the application, which has
+ * set up the given abi_version. */
+static size_t
+md_parser_abi_size(unsigned abi_version)
+{
+    switch(abi_version) {
+        case 0:     return offsetof(MD_PARSER, allocator);
+        case 1:     return offsetof(MD_PARSER, ref_dict);
+        case 2:     return offsetof(MD_PARSER, stats);
+        case 3:     return offsetof(MD_PARSER, max_memory);
+        case 4:     return offsetof(MD_PARSER, time_limit);
+        case 5:     return offsetof(MD_PARSER, entity);
+        default:    return sizeof(MD_PARSER);
+    }
+}
+
+/* Check the MD_PARSER can be used for parsing with this build. */
+static int
+md_check_parser(const MD_PARSER* parser, void* userdata)
+{
+    if(parser->abi_version > MD_PARSER_ABI_VERSION) {
+        if(parser->debug_log != NULL)
+            parser->debug_log("Unsupported abi_version.", userdata);
+        return -1;
+    }
+
+#ifdef MD4C_FIXED_FLAGS
+    if((parser->flags & MD_FIXED_FLAGS_MASK) != ((unsigned) (MD4C_FIXED_FLAGS) & MD_FIXED_FLAGS_MASK)) {
+        if(parser->debug_log != NULL)
+            parser->debug_log("Flags not supported by this build (see MD4C_FIXED_FLAGS).", userdata);
+        return -1;
+    }
+#endif
+
+    return 0;
+}
+
+static void
+md_setup_ctx(MD_CTX* ctx, const MD_PARSER* parser)
+{
+    memset(ctx, 0, sizeof(MD_CTX));
+    memcpy(&ctx->parser, parser, md_parser_abi_size(parser->abi_version));
+    ctx->allocator = ctx->parser.allocator;
+    ctx->use_arena = (ctx->parser.alloc_flags & MD_ALLOC_ARENA);
+    ctx->code_indent_offset = (MD_PARSER_FLAGS(ctx) & MD_FLAG_NOINDENTEDCODEBLOCKS) ? (OFF)(-1) : 4;
+    md_build_mark_char_map(ctx);
+}
+
+static void
+md_set_userdata(MD_CTX* ctx, void* userdata)
+{
+    if(ctx->batch != NULL) {
+        ctx->batch->userdata = userdata;
+        ctx->batch->n_events = 0;
+        userdata = ctx->batch;
+    }
+
+    ctx->userdata = userdata;
+}
+
+/* Resets the per-document state, except the ref. defs, so that the line
+ * analysis can start at the given offset. (The caller is responsible for
+ * the offset being a start of a line where no block or container is open.) */
+static void
+md_rewind_ctx(MD_CTX* ctx, const CHAR* text, SZ size, void* userdata, OFF off)
+{
+    int i;
+
+    ctx->text = text;
+    ctx->size = size;
+    ctx->text_base = 0;
+    md_set_userdata(ctx, userdata);
+    ctx->doc_ends_with_newline = (size > 0  &&  ISNEWLINE_(text[size-1]));
+
+    ctx->n_marks = 0;
+
+    /* Reset all unresolved opener mark chains. */
+    for(i = 0; i < (int) SIZEOF_ARRAY(ctx->mark_chains); i++) {
+        ctx->mark_chains[i].head = -1;
+        ctx->mark_chains[i].tail = -1;
+    }
+    ctx->n_table_cell_boundaries = 0;
+    ctx->unresolved_link_head = -1;
+    ctx->unresolved_link_tail = -1;
+
+    ctx->html_comment_horizon = 0;
+    ctx->html_proc_instr_horizon = 0;
+    ctx->html_decl_horizon = 0;
+    ctx->html_cdata_horizon = 0;
+
+    ctx->current_block = NULL;
+    ctx->n_block_bytes = 0;
+    ctx->n_containers = 0;
+
+#if defined MD_SIMD_SSE2
+    ctx->newline_window_valid = FALSE;
+#endif
+
+    ctx->code_fence_length = 0;
+    ctx->html_block_type = 0;
+    ctx->last_line_has_list_loosening_effect = FALSE;
+    ctx->last_list_item_starts_with_two_blank_lines = FALSE;
+    ctx->li_opener_end = -1;
+
+    ctx->line_off = off;
+    ctx->pivot_line = &md_dummy_blank_line;
+    ctx->line = &ctx->line_buf[0];
+}
+
+/* Resets all the per-document state while keeping the work buffers (and
+ * stuff depending only on the MD_PARSER, like ctx->mark_char_map) intact. */
+static void
+md_reset_ctx(MD_CTX* ctx, const CHAR* text, SZ size, void* userdata)
+{
+    ctx->n_ref_defs = 0;
+    ctx->n_ref_def_keys = 0;
+    ctx->ref_def_hashtable_size = 0;
+    md_rewind_ctx(ctx, text, size, userdata, 0);
+}
+
+/* Starts gathering MD_PARSER::stats, counting against the resource limits
+ * and the MD_PARSER::time_limit for a new document. */
+static void
+md_begin_parse(MD_CTX* ctx)
+{
+    memset(&ctx->stats, 0, sizeof(MD_PARSE_STATS));
+    ctx->stats_phase = MD_STATS_NONE;
+    ctx->n_charged_bytes = 0;
+    ctx->limit_exceeded = FALSE;
+    ctx->deadline = (ctx->parser.time_limit > 0.0 ? md_clock() + ctx->parser.time_limit : 0.0);
+    ctx->cancelled = FALSE;
+    md_poll_cancel(ctx);
+}
+
+/* Makes a failure caused by exceeding a resource limit or by a cancellation
+ * distinguishable. */
+static int
+md_limit_error(MD_CTX* ctx, int ret)
+{
+    if(ret == -1  &&  ctx->cancelled)
+        return MD_ERROR_CANCELLED;
+    /* Even if the failed allocation has not been fatal, the output may be
+     * incomplete. (But keep any value a callback has aborted with.) */
+    return ((ret == -1 || ret == 0)  &&  ctx->limit_exceeded) ? MD_ERROR_LIMIT : ret;
+}
+
+/* Passes the gathered stats to the application, and the return value to
+ * be returned from the public API. */
+static int
+md_end_parse(MD_CTX* ctx, int ret)
+{
+    MD_PARSE_STATS* stats = ctx->parser.stats;
+
+    if(stats == NULL)
+        return md_limit_error(ctx, ret);
+
+    memcpy(stats, &ctx->stats, sizeof(MD_PARSE_STATS));
+    /* (The other buffer sizes are recorded as the buffers are used.) */
+    stats->ref_def_buffer_size = ctx->n_ref_defs * sizeof(MD_REF_DEF) +
+                ctx->n_ref_def_keys + ctx->ref_def_hashtable_size * sizeof(MD_REF_DEF_SLOT);
+    return md_limit_error(ctx, ret);
+}
+
+/* Releases whatever the last document has left behind in the work buffers
+ * (but not the buffers themselves). */
+static void
+md_clear_ctx(MD_CTX* ctx)
+{
+    md_clear_ref_def_hashtable(ctx);
+    md_clear_ref_defs(ctx);
+}
+
+static void
+md_trim_inline_workers(MD_CTX* ctx, size_t threshold)
+{
+    int i;
+
+    for(i = 0; i < ctx->n_workers; i++) {
+        MD_INLINE_WORKER* w = &ctx->workers[i];
+
+        if(w->alloc_results * sizeof(MD_MARK) > threshold) {
+            md_free(&w->ctx, w->results);
+            w->results = NULL;
+            w->alloc_results = 0;
+        }
+        if(w->ctx.alloc_marks * sizeof(MD_MARK) > threshold) {
+            md_free(&w->ctx, w->ctx.marks);
+            w->ctx.marks = NULL;
+            w->ctx.alloc_marks = 0;
+        }
+        if(w->ctx.alloc_buffer * sizeof(CHAR) > threshold) {
+            md_free(&w->ctx, w->ctx.buffer);
+            w->ctx.buffer = NULL;
+            w->ctx.alloc_buffer = 0;
+        }
+        if(w->ctx.alloc_lookup_key > threshold) {
+            md_free(&w->ctx, w->ctx.lookup_key);
+            w->ctx.lookup_key = NULL;
+            w->ctx.alloc_lookup_key = 0;
+        }
+        if(threshold == 0)
+            md_arena_release(w->ctx.allocator, &w->ctx.arena);
+    }
+}
+
+/* Releases any work buffer whose allocation exceeds the given threshold so
+ * that a single huge document does not pin its memory for the lifetime of
+ * the MD_PARSER_HANDLE. Zero threshold releases everything. */
+static void
+md_trim_ctx(MD_CTX* ctx, size_t threshold)
+{
+    if(ctx->alloc_buffer * sizeof(CHAR) > threshold) {
+        md_free(ctx, ctx->buffer);
+        ctx->buffer = NULL;
+        ctx->alloc_buffer = 0;
+    }
+    if(ctx->alloc_lookup_key > threshold) {
+        md_free(ctx, ctx->lookup_key);
+        ctx->lookup_key = NULL;
+        ctx->alloc_lookup_key = 0;
+    }
+    if(ctx->alloc_ref_defs * sizeof(MD_REF_DEF) > threshold  ||  ctx->alloc_ref_def_keys > threshold)
+        md_free_ref_defs(ctx);
+    if(ctx->alloc_ref_def_hashtable * sizeof(MD_REF_DEF_SLOT) > threshold)
+        md_free_ref_def_hashtable(ctx);
+    if(ctx->alloc_marks * sizeof(MD_MARK) > threshold) {
+        md_free(ctx, ctx->marks);
+        ctx->marks = NULL;
+        ctx->alloc_marks = 0;
+    }
+    if((size_t) ctx->alloc_block_bytes > threshold) {
+        md_free(ctx, ctx->block_bytes);
+        ctx->block_bytes = NULL;
+        ctx->alloc_block_bytes = 0;
+    }
+    if(ctx->alloc_containers * sizeof(MD_CONTAINER) > threshold) {
+        md_free(ctx, ctx->containers);
+        ctx->containers = NULL;
+        ctx->alloc_containers = 0;
+    }
+    if(ctx->alloc_inline_jobs * sizeof(MD_INLINE_JOB) > threshold) {
+        md_free(ctx, ctx->inline_jobs);
+        ctx->inline_jobs = NULL;
+        ctx->alloc_inline_jobs = 0;
+    }
+    md_trim_inline_workers(ctx, threshold);
+}
+
+static void
+md_free_ctx(MD_CTX* ctx)
+{
+    md_clear_ctx(ctx);
+    md_trim_ctx(ctx, 0);
+    ctx->n_charged_bytes -= ctx->arena.n_used;
+    md_arena_release(ctx->allocator, &ctx->arena);
+}
+
+static int
+md_parse_with_ctx(MD_CTX* ctx, const CHAR* text, SZ size, void* userdata)
+{
+    int ret;
+
+    md_reset_ctx(ctx, text, size, userdata);
+    md_begin_parse(ctx);
+    ret = md_end_parse(ctx, md_process_doc(ctx));
+    md_clear_ctx(ctx);
+
+    return ret;
+}
+
+
+/* For md_parser_reparse(), the document is split into segments. Each one
+ * starts at a line where no block nor container is open (so the analysis of
+ * its lines does not depend on anything before), and holds one or more
+ * complete top-level blocks. */
+typedef struct MD_SEGMENT_tag MD_SEGMENT;
+struct MD_SEGMENT_tag {
+    OFF beg;
+    unsigned n_blocks;          /* Count of top-level blocks. */
+    unsigned n_ref_defs;        /* Count of ref. defs. */
+};
+
+struct MD_PARSER_HANDLE {
+    MD_CTX ctx;
+    size_t trim_threshold;
+
+    /* For md_parser_begin(), md_parser_feed() and md_parser_finish(). */
+    CHAR* stream_buffer;
+    SZ stream_size;
+    SZ stream_alloc;
+    int stream_ret;
+
+    /* For md_parser_reparse(). */
+    MD_SEGMENT* segments;       /* Segments of the last document. */
+    unsigned n_segments;
+    unsigned alloc_segments;
+    MD_SEGMENT* new_segments;   /* Segments being (re)analyzed. */
+    unsigned n_new_segments;
+    unsigned alloc_new_segments;
+    const CHAR* reparse_text;   /* The last document. */
+    SZ reparse_size;
+    int reparse_valid;
+
+    /* For md_parser_set_event_sink(). */
+    MD_EVENT_BATCH batch;
+};
+
+/* Make the stream buffer large enough for the given size. As the ref. defs
+ * (non-allocated) labels and titles point into the buffer, rebase them if
+ * the buffer moves. */
+static int
+md_stream_reserve(MD_PARSER_HANDLE* handle, SZ size)
+{
+    MD_CTX* ctx = &handle->ctx;
+    CHAR* new_buffer;
+    SZ new_alloc;
+    int i;
+
+    if(size <= handle->stream_alloc)
+        return 0;
+
+    new_alloc = handle->stream_alloc + handle->stream_alloc / 2;
+    if(new_alloc < size)
+        new_alloc = size;
+    if(new_alloc < 4096)
+        new_alloc = 4096;
+    if(new_alloc < size) {
+        /* Overflow. */
+        MD_LOG("Input too large.");
+        return -1;
+    }
+
+    new_buffer = (CHAR*) md_sys_realloc(ctx->allocator, handle->stream_buffer, new_alloc * sizeof(CHAR));
+    if(new_buffer == NULL) {
+        MD_LOG("realloc() failed.");
+        return -1;
+    }
+
+    if(new_buffer != handle->stream_buffer  &&  handle->stream_buffer != NULL) {
+        for(i = 0; i < ctx->n_ref_defs; i++) {
+            MD_REF_DEF* def = &ctx->ref_defs[i];
+
+            if(!def->label_needs_free)
+                def->label = new_buffer + (def->label - handle->stream_buffer);
+            if(!def->title_needs_free  &&  def->title != NULL)
+                def->title = new_buffer + (def->title - handle->stream_buffer);
+        }
+    }
+
+    handle->stream_buffer = new_buffer;
+    handle->stream_alloc = new_alloc;
+    ctx->text = new_buffer;
+    return 0;
+}
+
+static void
+md_stream_release(MD_PARSER_HANDLE* handle, size_t threshold)
+{
+    if(handle->stream_alloc * sizeof(CHAR) > threshold) {
+        md_sys_free(handle->ctx.allocator, handle->stream_buffer);
+        handle->stream_buffer = NULL;
+        handle->stream_alloc = 0;
+    }
+}
+
+/* With MD_FLAG_NOREFDEFS, md_flush_blocks() has possibly processed all the
+ * blocks gathered so far. If so, drop the input they have been made of, so
+ * that the buffer holds only the not yet processed lines. */
+static void
+md_stream_discard(MD_PARSER_HANDLE* handle)
+{
+    MD_CTX* ctx = &handle->ctx;
+    OFF off = ctx->line_off;
+
+    if(off == 0  ||  ctx->n_block_bytes > 0  ||  !md_is_segment_boundary(ctx))
+        return;
+
+    memmove(handle->stream_buffer, handle->stream_buffer + off,
+            (handle->stream_size - off) * sizeof(CHAR));
+    handle->stream_size -= off;
+    ctx->size -= off;
+    ctx->text_base += off;
+    ctx->line_off = 0;
+
+    /* The scan horizons refer to the dropped text. */
+    ctx->html_comment_horizon = 0;
+    ctx->html_proc_instr_horizon = 0;
+    ctx->html_decl_horizon = 0;
+    ctx->html_cdata_horizon = 0;
+#if defined MD_SIMD_SSE2
+    ctx->newline_window_valid = FALSE;
+#endif
+}
+
+/* Forget whatever md_parser_reparse() has kept for a next incremental run
+ * (but keep ->segments[] to still know how many top-level blocks the
+ * application has got from it). */
+static void
+md_reparse_invalidate(MD_PARSER_HANDLE* handle)
+{
+    MD_CTX* ctx = &handle->ctx;
+
+    md_clear_ctx(ctx);
+    handle->reparse_valid = FALSE;
+
+    /* Back to the arena if md_parser_reparse() has given it up. */
+    if(!ctx->use_arena  &&  (ctx->parser.alloc_flags & MD_ALLOC_ARENA)) {
+        md_free_ctx(ctx);
+        ctx->use_arena = TRUE;
+    }
+}
+
+/* Count the blocks in the given range of ctx->block_bytes which are direct
+ * children of MD_BLOCK_DOC. */
+static unsigned
+md_count_top_level_blocks(MD_CTX* ctx, int byte_off, int byte_end)
+{
+    unsigned n = 0;
+    int depth = 0;
+
+    while(byte_off < byte_end) {
+        MD_BLOCK* block = (MD_BLOCK*)((char*)ctx->block_bytes + byte_off);
+
+        if(block->flags & MD_BLOCK_CONTAINER) {
+            if(block->flags & MD_BLOCK_CONTAINER_CLOSER)
+                depth--;
+            if(block->flags & MD_BLOCK_CONTAINER_OPENER) {
+                if(depth == 0)
+                    n++;
+                depth++;
+            }
+        } else {
+            if(depth == 0)
+                n++;
+
+            if(block->type == MD_BLOCK_CODE || block->type == MD_BLOCK_HTML)
+                byte_off += block->n_lines * sizeof(MD_VERBATIMLINE);
+            else
+                byte_off += block->n_lines * sizeof(MD_LINE);
+        }
+
+        byte_off += sizeof(MD_BLOCK);
+    }
+
+    return n;
+}
+
+static int
+md_push_new_segment(MD_PARSER_HANDLE* handle, OFF beg, int byte_off, int ref_def_index)
+{
+    MD_CTX* ctx = &handle->ctx;
+    MD_SEGMENT* seg;
+
+    if(handle->n_new_segments >= handle->alloc_new_segments) {
+        MD_SEGMENT* new_segments;
+        unsigned new_alloc_segments;
+
+        new_alloc_segments = (handle->alloc_new_segments > 0
+                ? handle->alloc_new_segments + handle->alloc_new_segments / 2
+                : 64);
+        new_segments = (MD_SEGMENT*) md_sys_realloc(ctx->allocator,
+                    handle->new_segments, new_alloc_segments * sizeof(MD_SEGMENT));
+        if(new_segments == NULL) {
+            MD_LOG("realloc() failed.");
+            return -1;
+        }
+
+        handle->new_segments = new_segments;
+        handle->alloc_new_segments = new_alloc_segments;
+    }
+
+    seg = &handle->new_segments[handle->n_new_segments++];
+    seg->beg = beg;
+    seg->n_blocks = md_count_top_level_blocks(ctx, byte_off, ctx->n_block_bytes);
+    seg->n_ref_defs = ctx->n_ref_defs - ref_def_index;
+    return 0;
+}
+
+/* Analyze lines from ctx->line_off and split them into handle->new_segments[].
+ *
+ * If 'resync' is set, we stop as soon as we reach a segment boundary at or
+ * after the end of the edit (new_end) which corresponds (when shifted by the
+ * edit size difference) to a boundary of an old segment *p_index or later.
+ * On return, *p_index is the index of that old segment, or handle->n_segments
+ * if we have reached the end of the document. */
+static int
+md_reparse_lines(MD_PARSER_HANDLE* handle, int resync, OFF new_end, OFF old_end,
+                 unsigned* p_index)
+{
+    MD_CTX* ctx = &handle->ctx;
+    unsigned i = *p_index;
+    OFF line_off = ctx->line_off;
+    OFF seg_beg = ctx->line_off;
+    int seg_byte_off = ctx->n_block_bytes;
+    int seg_ref_def_index = ctx->n_ref_defs;
+    int phase = MD_STATS_ENTER(MD_STATS_LINES);
+    int ret = 0;
+
+    handle->n_new_segments = 0;
+
+    while(ctx->line_off < ctx->size) {
+        if(ctx->line_off > seg_beg  &&  md_is_segment_boundary(ctx)) {
+            if(resync  &&  ctx->line_off >= new_end) {
+                OFF old_off = ctx->line_off - new_end + old_end;
+
+                while(i < handle->n_segments  &&  handle->segments[i].beg < old_off)
+                    i++;
+                if(i < handle->n_segments  &&  handle->segments[i].beg == old_off) {
+                    /* The rest is the same as before. */
+                    MD_CHECK(md_push_new_segment(handle, seg_beg, seg_byte_off, seg_ref_def_index));
+                    *p_index = i;
+                    goto abort;
+                }
+            }
+
+            if(ctx->n_block_bytes > seg_byte_off) {
+                MD_CHECK(md_push_new_segment(handle, seg_beg, seg_byte_off, seg_ref_def_index));
+                seg_beg = ctx->line_off;
+                seg_byte_off = ctx->n_block_bytes;
+                seg_ref_def_index = ctx->n_ref_defs;
+            }
+        }
+
+        MD_CHECK(md_process_next_line(ctx));
+    }
+
+    MD_CHECK(md_end_current_block(ctx));
+    MD_CHECK(md_leave_child_containers(ctx, 0));
+    MD_CHECK(md_push_new_segment(handle, seg_beg, seg_byte_off, seg_ref_def_index));
+    *p_index = handle->n_segments;
+
+abort:
+    ctx->stats.line_analysis_size += ctx->line_off - line_off;
+    MD_STATS_SWITCH(phase);
+    return ret;
+}
+
+static unsigned
+md_count_segment_blocks(const MD_SEGMENT* segments, unsigned beg, unsigned end)
+{
+    unsigned n = 0;
+
+    while(beg < end)
+        n += segments[beg++].n_blocks;
+    return n;
+}
+
+static int
+md_reparse_full(MD_PARSER_HANDLE* handle, const CHAR* text, SZ size,
+                MD_REPARSE_INFO* info, void* userdata)
+{
+    MD_CTX* ctx = &handle->ctx;
+    MD_SEGMENT* tmp_segments;
+    unsigned tmp_alloc_segments;
+    unsigned index = 0;
+    int ret = 0;
+
+    info->first_block = 0;
+    info->n_old_blocks = md_count_segment_blocks(handle->segments, 0, handle->n_segments);
+    info->is_full = TRUE;
+
+    md_clear_ctx(ctx);
+    md_reset_ctx(ctx, text, size, userdata);
+    MD_CHECK(md_reparse_lines(handle, FALSE, 0, 0, &index));
+    MD_CHECK(md_build_ref_def_hashtable(ctx));
+
+    /* Swap the old and new segments. */
+    tmp_segments = handle->segments;
+    tmp_alloc_segments = handle->alloc_segments;
+    handle->segments = handle->new_segments;
+    handle->n_segments = handle->n_new_segments;
+    handle->alloc_segments = handle->alloc_new_segments;
+    handle->new_segments = tmp_segments;
+    handle->n_new_segments = 0;
+    handle->alloc_new_segments = tmp_alloc_segments;
+    info->n_new_blocks = md_count_segment_blocks(handle->segments, 0, handle->n_segments);
+
+    MD_CHECK(md_process_all_blocks(ctx));
+
+abort:
+    return ret;
+}
+
+/* Shift an offset in the old document into the new one. (The offset may not
+ * lie inside the edit.) */
+#define MD_REPARSE_SHIFT(off, old_end, new_end)     \
+            ((off) >= (old_end) ? (off) - (old_end) + (new_end) : (off))
+
+/* Reanalyze only the segments touched by the edit. Sets *p_need_full if it
+ * cannot be done. */
+static int
+md_reparse_partial(MD_PARSER_HANDLE* handle, const CHAR* text, SZ size,
+                   const MD_EDIT* edit, MD_REPARSE_INFO* info, void* userdata,
+                   int* p_need_full)
+{
+    MD_CTX* ctx = &handle->ctx;
+    OFF old_end = edit->beg + edit->old_size;
+    OFF new_end = edit->beg + edit->new_size;
+    unsigned a, b, lo, hi, i;
+    unsigned n_segments;
+    int ret = 0;
+
+    /* Find the last segment starting before the edit. (Strictly before: If
+     * the edit starts with '\n' just after '\r', even the preceding line
+     * changes.) */
+    lo = 0;
+    hi = handle->n_segments;
+    while(hi - lo > 1) {
+        unsigned pivot = (lo + hi) / 2;
+        if(handle->segments[pivot].beg < edit->beg)
+            lo = pivot;
+        else
+            hi = pivot;
+    }
+    a = lo;
+
+    /* Rebase the ref. defs into the new text. Those in the segments we
+     * reanalyze get wrong offsets but we then give up anyway. */
+    for(i = 0; i < (unsigned) ctx->n_ref_defs; i++) {
+        MD_REF_DEF* def = &ctx->ref_defs[i];
+        OFF off;
+
+        if(!def->label_needs_free) {
+            off = (OFF) (def->label - handle->reparse_text);
+            def->label = (CHAR*) text + MD_REPARSE_SHIFT(off, old_end, new_end);
+        }
+        if(!def->title_needs_free  &&  def->title != NULL) {
+            off = (OFF) (def->title - handle->reparse_text);
+            def->title = (CHAR*) text + MD_REPARSE_SHIFT(off, old_end, new_end);
+        }
+        def->dest_beg = MD_REPARSE_SHIFT(def->dest_beg, old_end, new_end);
+        def->dest_end = MD_REPARSE_SHIFT(def->dest_end, old_end, new_end);
+    }
+    handle->reparse_text = text;
+    handle->reparse_size = size;
+
+    md_rewind_ctx(ctx, text, size, userdata, handle->segments[a].beg);
+    b = a + 1;
+    ctx->ref_defs_frozen = TRUE;
+    ctx->ref_defs_changed = FALSE;
+    ret = md_reparse_lines(handle, TRUE, new_end, old_end, &b);
+    ctx->ref_defs_frozen = FALSE;
+    if(ret != 0) {
+        if(ctx->ref_defs_changed) {
+            *p_need_full = TRUE;
+            ret = 0;
+        }
+        goto abort;
+    }
+    for(i = a; i < b; i++) {
+        if(handle->segments[i].n_ref_defs > 0) {
+            *p_need_full = TRUE;
+            goto abort;
+        }
+    }
+
+    info->first_block = md_count_segment_blocks(handle->segments, 0, a);
+    info->n_old_blocks = md_count_segment_blocks(handle->segments, a, b);
+    info->n_new_blocks = md_count_segment_blocks(handle->new_segments, 0, handle->n_new_segments);
+    info->is_full = FALSE;
+
+    /* Replace segments [a, b) with the new ones and shift the rest. */
+    n_segments = handle->n_segments - (b - a) + handle->n_new_segments;
+    if(n_segments > handle->alloc_segments) {
+        MD_SEGMENT* new_segments;
+
+        new_segments = (MD_SEGMENT*) md_sys_realloc(ctx->allocator,
+                    handle->segments, n_segments * sizeof(MD_SEGMENT));
+        if(new_segments == NULL) {
+            MD_LOG("realloc() failed.");
+            ret = -1;
+            goto abort;
+        }
+        handle->segments = new_segments;
+        handle->alloc_segments = n_segments;
+    }
+    memmove(handle->segments + a + handle->n_new_segments, handle->segments + b,
+            (handle->n_segments - b) * sizeof(MD_SEGMENT));
+    memcpy(handle->segments + a, handle->new_segments,
+            handle->n_new_segments * sizeof(MD_SEGMENT));
+    for(i = a + handle->n_new_segments; i < n_segments; i++)
+        handle->segments[i].beg = handle->segments[i].beg - old_end + new_end;
+    handle->n_segments = n_segments;
+
+    MD_CHECK(md_process_all_blocks(ctx));
+
+abort:
+    return ret;
+}
+
+
+/***************************
+ ***  Batched Callbacks  ***
+ ***************************/
+
+static int
+md_batch_flush(MD_EVENT_BATCH* batch)
+{
+    unsigned n = batch->n_events;
+
+    if(n == 0)
+        return 0;
+
+    batch->n_events = 0;
+    return batch->flush(batch->events, n, batch->userdata);
+}
+
+/* Details (and the strings they refer to) live only until the callback
+ * returns, so events having a detail are flushed immediately. Otherwise we
+ * flush when the array is full and at the end of each block. */
+static int
+md_batch_push(MD_EVENT_BATCH* batch, unsigned kind, unsigned type,
+              const void* data, SZ size, int flush)
+{
+    MD_EVENT* event = &batch->events[batch->n_events++];
+
+    event->kind = (unsigned char) kind;
+    event->type = (unsigned char) type;
+    event->size = size;
+    event->data = data;
+
+    if(flush  ||  batch->n_events >= batch->capacity)
+        return md_batch_flush(batch);
+    return 0;
+}
+
+static int
+md_batch_enter_block(MD_BLOCKTYPE type, void* detail, void* userdata)
+{
+    return md_batch_push((MD_EVENT_BATCH*) userdata, MD_EVENT_ENTER_BLOCK, type, detail, 0, (detail != NULL));
+}
+
+static int
+md_batch_leave_block(MD_BLOCKTYPE type, void* detail, void* userdata)
+{
+    return md_batch_push((MD_EVENT_BATCH*) userdata, MD_EVENT_LEAVE_BLOCK, type, detail, 0, TRUE);
+}
+
+static int
+md_batch_enter_span(MD_SPANTYPE type, void* detail, void* userdata)
+{
+    return md_batch_push((MD_EVENT_BATCH*) userdata, MD_EVENT_ENTER_SPAN, type, detail, 0, (detail != NULL));
+}
+
+static int
+md_batch_leave_span(MD_SPANTYPE type, void* detail, void* userdata)
+{
+    return md_batch_push((MD_EVENT_BATCH*) userdata, MD_EVENT_LEAVE_SPAN, type, detail, 0, (detail != NULL));
+}
+
+static int
+md_batch_text(MD_TEXTTYPE type, const MD_CHAR* text, MD_SIZE size, void* userdata)
+{
+    return md_batch_push((MD_EVENT_BATCH*) userdata, MD_EVENT_TEXT, type, text, size, FALSE);
+}
+
+static void
+md_batch_debug_log(const char* msg, void* userdata)
+{
+    MD_EVENT_BATCH* batch = (MD_EVENT_BATCH*) userdata;
+
+    if(batch->parser.debug_log != NULL)
+        batch->parser.debug_log(msg, batch->userdata);
+}
+
+
+/***********************
+ ***  Document Tree  ***
+ ***********************/
+
+/* MD_TREE as returned to the application is the head of this. The arena
+ * holds this structure as well as everything the tree refers to (except the
+ * texts of MD_NODE_TEXT nodes). */
+typedef struct MD_TREE_IMPL_tag MD_TREE_IMPL;
+struct MD_TREE_IMPL_tag {
+    MD_TREE tree;
+    const MD_ALLOCATOR* allocator;
+    MD_ARENA arena;
+};
+
+/* Node of the tree which has been entered and not left yet. */
+typedef struct MD_TREE_OPEN_NODE_tag MD_TREE_OPEN_NODE;
+struct MD_TREE_OPEN_NODE_tag {
+    unsigned index;
+    unsigned aux;       /* Last child (when building the tree), or end of the
+                         * node's subtree (when replaying it). */
+};
+
+typedef struct MD_TREE_BUILDER_tag MD_TREE_BUILDER;
+struct MD_TREE_BUILDER_tag {
+    const CHAR* text;
+    SZ size;
+    const MD_ALLOCATOR* allocator;
+    void (*debug_log)(const char*, void*);
+    MD_ARENA arena;
+
+    MD_NODE* nodes;
+    unsigned n_nodes;
+    unsigned alloc_nodes;
+
+    MD_TREE_OPEN_NODE* open_nodes;
+    unsigned n_open_nodes;
+    unsigned alloc_open_nodes;
+};
+
+static void
+md_tree_debug_log(const char* msg, void* userdata)
+{
+    MD_TREE_BUILDER* b = (MD_TREE_BUILDER*) userdata;
+
+    if(b->debug_log != NULL)
+        b->debug_log(msg, NULL);
+}
+
+static int
+md_tree_push_open_node(const MD_ALLOCATOR* allocator, MD_TREE_OPEN_NODE** p_open_nodes,
+                       unsigned* p_n_open_nodes, unsigned* p_alloc_open_nodes,
+                       unsigned index, unsigned aux)
+{
+    if(*p_n_open_nodes >= *p_alloc_open_nodes) {
+        MD_TREE_OPEN_NODE* new_open_nodes;
+        unsigned new_alloc;
+
+        new_alloc = (*p_alloc_open_nodes > 0 ? *p_alloc_open_nodes * 2 : 16);
+        new_open_nodes = (MD_TREE_OPEN_NODE*) md_sys_realloc(allocator,
+                    *p_open_nodes, new_alloc * sizeof(MD_TREE_OPEN_NODE));
+        if(new_open_nodes == NULL)
+            return -1;
+
+        *p_open_nodes = new_open_nodes;
+        *p_alloc_open_nodes = new_alloc;
+    }
+
+    (*p_open_nodes)[*p_n_open_nodes].index = index;
+    (*p_open_nodes)[*p_n_open_nodes].aux = aux;
+    (*p_n_open_nodes)++;
+    return 0;
+}
+
+/* Append a new node and link it as the last child of the current open node. */
+static MD_NODE*
+md_tree_push_node(MD_TREE_BUILDER* b, unsigned kind, unsigned type)
+{
+    MD_NODE* node;
+    unsigned index;
+
+    if(b->n_nodes >= b->alloc_nodes) {
+        MD_NODE* new_nodes;
+        unsigned new_alloc;
+
+        new_alloc = (b->alloc_nodes > 0 ? b->alloc_nodes + b->alloc_nodes / 2 : 64);
+        new_nodes = (MD_NODE*) md_sys_realloc(b->allocator, b->nodes, new_alloc * sizeof(MD_NODE));
+        if(new_nodes == NULL) {
+            md_tree_debug_log("realloc() failed.", b);
+            return NULL;
+        }
+
+        b->nodes = new_nodes;
+        b->alloc_nodes = new_alloc;
+    }
+
+    index = b->n_nodes++;
+    node = &b->nodes[index];
+    node->kind = (unsigned char) kind;
+    node->type = (unsigned char) type;
+    node->flags = 0;
+    node->first_child = 0;
+    node->next_sibling = 0;
+    node->beg = 0;
+    node->end = 0;
+    node->size = 0;
+    node->data = NULL;
+
+    if(b->n_open_nodes > 0) {
+        MD_TREE_OPEN_NODE* parent = &b->open_nodes[b->n_open_nodes-1];
+
+        if(parent->aux == 0)
+            b->nodes[parent->index].first_child = index;
+        else
+            b->nodes[parent->aux].next_sibling = index;
+        parent->aux = index;
+    }
+
+    return node;
+}
+
+static void
+md_tree_extend_range(MD_NODE* node, OFF beg, OFF end)
+{
+    if(!(node->flags & MD_NODE_HASRANGE)) {
+        node->flags |= MD_NODE_HASRANGE;
+        node->beg = beg;
+        node->end = end;
+    } else {
+        if(beg < node->beg)
+            node->beg = beg;
+        if(end > node->end)
+            node->end = end;
+    }
+}
+
+static int
+md_tree_is_in_input(MD_TREE_BUILDER* b, const CHAR* str)
+{
+    return (str >= b->text  &&  str < b->text + b->size);
+}
+
+static void*
+md_tree_copy(MD_TREE_BUILDER* b, const void* data, size_t size)
+{
+    void* copy;
+
+    copy = md_arena_alloc(b->allocator, &b->arena, size);
+    if(copy == NULL) {
+        md_tree_debug_log("malloc() failed.", b);
+        return NULL;
+    }
+
+    memcpy(copy, data, size);
+    return copy;
+}
+
+/* The strings in the attributes may live in a temporary buffer (and the
+ * arrays of substrings even on the stack), so copy whatever is not in the
+ * input. */
+static int
+md_tree_copy_attribute(MD_TREE_BUILDER* b, MD_ATTRIBUTE* attr)
+{
+    unsigned n = 0;
+
+    if(attr->text != NULL  &&  attr->size > 0  &&  !md_tree_is_in_input(b, attr->text)) {
+        attr->text = (const CHAR*) md_tree_copy(b, attr->text, attr->size * sizeof(CHAR));
+        if(attr->text == NULL)
+            return -1;
+    }
+
+    if(attr->substr_offsets != NULL) {
+        while(attr->substr_offsets[n] < attr->size)
+            n++;
+
+        attr->substr_offsets = (const MD_OFFSET*) md_tree_copy(b,
+                    attr->substr_offsets, (n+1) * sizeof(MD_OFFSET));
+        if(attr->substr_offsets == NULL)
+            return -1;
+    }
+
+    if(attr->substr_types != NULL) {
+        attr->substr_types = (const MD_TEXTTYPE*) md_tree_copy(b,
+                    attr->substr_types, (n > 0 ? n : 1) * sizeof(MD_TEXTTYPE));
+        if(attr->substr_types == NULL)
+            return -1;
+    }
+
+    return 0;
+}
+
+/* Make a deep copy of the detail structure of the given block or span. */
+static int
+md_tree_copy_detail(MD_TREE_BUILDER* b, MD_NODE* node, const void* detail)
+{
+    size_t size = 0;
+    void* copy;
+
+    if(detail == NULL)
+        return 0;
+
+    if(node->kind == MD_NODE_BLOCK) {
+        switch(node->type) {
+            case MD_BLOCK_UL:       size = sizeof(MD_BLOCK_UL_DETAIL); break;
+            case MD_BLOCK_OL:       size = sizeof(MD_BLOCK_OL_DETAIL); break;
+            case MD_BLOCK_LI:       size = sizeof(MD_BLOCK_LI_DETAIL); break;
+            case MD_BLOCK_H:        size = sizeof(MD_BLOCK_H_DETAIL); break;
+            case MD_BLOCK_CODE:     size = sizeof(MD_BLOCK_CODE_DETAIL); break;
+            case MD_BLOCK_TABLE:    size = sizeof(MD_BLOCK_TABLE_DETAIL); break;
+            case MD_BLOCK_TH:       /* Pass through. */
+            case MD_BLOCK_TD:       size = sizeof(MD_BLOCK_TD_DETAIL); break;
+            default:                break;
+        }
+    } else {
+        switch(node->type) {
+            case MD_SPAN_A:         size = sizeof(MD_SPAN_A_DETAIL); break;
+            case MD_SPAN_IMG:       size = sizeof(MD_SPAN_IMG_DETAIL); break;
+            case MD_SPAN_WIKILINK:  size = sizeof(MD_SPAN_WIKILINK_DETAIL); break;
+            case MD_SPAN_MENTION:   size = sizeof(MD_SPAN_MENTION_DETAIL); break;
+            default:                break;
+        }
+    }
+
+    if(size == 0)
+        return 0;
+
+    copy = md_tree_copy(b, detail, size);
+    if(copy == NULL)
+        return -1;
+    node->data = copy;
+
+    if(node->kind == MD_NODE_BLOCK  &&  node->type == MD_BLOCK_CODE) {
+        MD_BLOCK_CODE_DETAIL* det = (MD_BLOCK_CODE_DETAIL*) copy;
+        if(md_tree_copy_attribute(b, &det->info) != 0  ||  md_tree_copy_attribute(b, &det->lang) != 0)
+            return -1;
+    } else if(node->kind == MD_NODE_SPAN) {
+        switch(node->type) {
+            case MD_SPAN_A:
+            {
+                MD_SPAN_A_DETAIL* det = (MD_SPAN_A_DETAIL*) copy;
+                if(md_tree_copy_attribute(b, &det->href) != 0  ||  md_tree_copy_attribute(b, &det->title) != 0)
+                    return -1;
+                break;
+            }
+
+            case MD_SPAN_IMG:
+            {
+                MD_SPAN_IMG_DETAIL* det = (MD_SPAN_IMG_DETAIL*) copy;
+                if(md_tree_copy_attribute(b, &det->src) != 0  ||  md_tree_copy_attribute(b, &det->title) != 0)
+                    return -1;
+                break;
+            }
+
+            case MD_SPAN_WIKILINK:
+            {
+                MD_SPAN_WIKILINK_DETAIL* det = (MD_SPAN_WIKILINK_DETAIL*) copy;
+                if(md_tree_copy_attribute(b, &det->target) != 0)
+                    return -1;
+                break;
+            }
+
+            case MD_SPAN_MENTION:
+            {
+                MD_SPAN_MENTION_DETAIL* det = (MD_SPAN_MENTION_DETAIL*) copy;
+                if(det->text != NULL  &&  det->size > 0  &&  !md_tree_is_in_input(b, det->text)) {
+                    det->text = (MD_CHAR*) md_tree_copy(b, det->text, det->size * sizeof(CHAR));
+                    if(det->text == NULL)
+                        return -1;
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    return 0;
+}
+
+static int
+md_tree_enter(MD_TREE_BUILDER* b, unsigned kind, unsigned type, const void* detail)
+{
+    MD_NODE* node;
+
+    node = md_tree_push_node(b, kind, type);
+    if(node == NULL)
+        return -1;
+    if(md_tree_copy_detail(b, node, detail) != 0)
+        return -1;
+
+    if(md_tree_push_open_node(b->allocator, &b->open_nodes, &b->n_open_nodes,
+                &b->alloc_open_nodes, (unsigned)(node - b->nodes), 0) != 0)
+    {
+        md_tree_debug_log("realloc() failed.", b);
+        return -1;
+    }
+
+    return 0;
+}
+
+/* Leave the innermost open node of the given kind and type.
+ *
+ * The parser does not always nest the spans properly: In some corner cases
+ * (e.g. permissive autolinks within a table cell), it may leave a span it has
+ * never entered, or not leave a span before its block ends. So any nodes
+ * above the matching one are left implicitly, and a leave matching no open
+ * node is ignored. (A span is never looked up past the innermost block.) */
+static int
+md_tree_leave(MD_TREE_BUILDER* b, unsigned kind, unsigned type)
+{
+    unsigned i = b->n_open_nodes;
+
+    while(i > 0) {
+        const MD_NODE* open = &b->nodes[b->open_nodes[i-1].index];
+
+        if(open->kind == kind  &&  open->type == type)
+            break;
+        if(kind == MD_NODE_SPAN  &&  open->kind == MD_NODE_BLOCK)
+            return 0;
+        i--;
+    }
+    if(i == 0)
+        return 0;
+
+    while(b->n_open_nodes >= i) {
+        MD_NODE* node = &b->nodes[b->open_nodes[--b->n_open_nodes].index];
+
+        /* Propagate the range to the parent. */
+        if(b->n_open_nodes > 0  &&  (node->flags & MD_NODE_HASRANGE))
+            md_tree_extend_range(&b->nodes[b->open_nodes[b->n_open_nodes-1].index], node->beg, node->end);
+    }
+
+    return 0;
+}
+
+static int
+md_tree_enter_block(MD_BLOCKTYPE type, void* detail, void* userdata)
+{
+    return md_tree_enter((MD_TREE_BUILDER*) userdata, MD_NODE_BLOCK, type, detail);
+}
+
+static int
+md_tree_leave_block(MD_BLOCKTYPE type, void* detail, void* userdata)
+{
+    MD_UNUSED(detail);
+    return md_tree_leave((MD_TREE_BUILDER*) userdata, MD_NODE_BLOCK, type);
+}
+
+static int
+md_tree_enter_span(MD_SPANTYPE type, void* detail, void* userdata)
+{
+    return md_tree_enter((MD_TREE_BUILDER*) userdata, MD_NODE_SPAN, type, detail);
+}
+
+static int
+md_tree_leave_span(MD_SPANTYPE type, void* detail, void* userdata)
+{
+    MD_UNUSED(detail);
+    return md_tree_leave((MD_TREE_BUILDER*) userdata, MD_NODE_SPAN, type);
+}
+
+static int
+md_tree_text(MD_TEXTTYPE type, const MD_CHAR* text, MD_SIZE size, void* userdata)
+{
+    MD_TREE_BUILDER* b = (MD_TREE_BUILDER*) userdata;
+    MD_NODE* node;
+
+    node = md_tree_push_node(b, MD_NODE_TEXT, type);
+    if(node == NULL)
+        return -1;
+
+    /* The text is either in the input, or it is a string literal of ours,
+     * so we do not need to copy it. */
+    node->size = size;
+    node->data = text;
+
+    if(md_tree_is_in_input(b, text)) {
+        OFF beg = (OFF) (text - b->text);
+
+        md_tree_extend_range(node, beg, beg + size);
+        if(b->n_open_nodes > 0)
+            md_tree_extend_range(&b->nodes[b->open_nodes[b->n_open_nodes-1].index], beg, beg + size);
+    }
+
+    return 0;
+}
+
+/* Move the nodes into the arena, together with the MD_TREE_IMPL itself. */
+static MD_TREE_IMPL*
+md_tree_finish(MD_TREE_BUILDER* b)
+{
+    MD_TREE_IMPL* impl;
+    MD_NODE* nodes;
+
+    impl = (MD_TREE_IMPL*) md_arena_alloc(b->allocator, &b->arena, sizeof(MD_TREE_IMPL));
+    nodes = (MD_NODE*) md_arena_alloc(b->allocator, &b->arena, b->n_nodes * sizeof(MD_NODE));
+    if(impl == NULL  ||  nodes == NULL) {
+        md_tree_debug_log("malloc() failed.", b);
+        return NULL;
+    }
+
+    memcpy(nodes, b->nodes, b->n_nodes * sizeof(MD_NODE));
+    impl->tree.nodes = nodes;
+    impl->tree.n_nodes = b->n_nodes;
+    impl->tree.text = b->text;
+    impl->tree.size = b->size;
+    impl->allocator = b->allocator;
+    impl->arena = b->arena;
+    return impl;
+}
+
+
+/*******************
+ ***  Event Log  ***
+ *******************/
+
+/* The event log is a sequence of 32-bit words (so that it can be read in
+ * place when memory-mapped), starting with a header:
+ *
+ *   [0] MD_EVENT_LOG_MAGIC
+ *   [1] MD_EVENT_LOG_VERSION
+ *   [2] MD_EVENT_LOG_BOM (to detect a log recorded with other byte order)
+ *   [3] MD_EVENT_LOG_SIZES (to detect a log recorded with other type sizes)
+ *   [4] size of the input document
+ *   [5] MD_PARSER::flags the log has been recorded with
+ *
+ * Then each record begins with a word holding the opcode in the lowest byte,
+ * the block, span or text type in the 2nd byte, and MD_EVENT_LOG_HASDETAIL
+ * (for enter records) in the upper half. Data of the record follow:
+ *
+ *   - MD_EVENT_LOG_TEXT: offset and size of the text in the input.
+ *   - MD_EVENT_LOG_TEXTCOPY: size, and the text itself padded to whole words.
+ *   - MD_EVENT_LOG_ENTER_BLOCK, MD_EVENT_LOG_ENTER_SPAN: the detail, if any,
+ *     as written by md_event_log_put_detail().
+ *   - MD_EVENT_LOG_LEAVE_BLOCK, MD_EVENT_LOG_LEAVE_SPAN: nothing (the detail
+ *     is the same as for the matching enter record).
+ */
+#define MD_EVENT_LOG_MAGIC          0x4c34444dU     /* "MD4L" on little endian machines. */
+#define MD_EVENT_LOG_BOM            0x01020304U
+#define MD_EVENT_LOG_SIZES          ((unsigned) (sizeof(CHAR) | (sizeof(MD_TEXTTYPE) << 8) |    \
+                                                 (sizeof(MD_OFFSET) << 16) | (sizeof(unsigned) << 24)))
+#define MD_EVENT_LOG_HEADER_WORDS   6
+
+#define MD_EVENT_LOG_ENTER_BLOCK    1
+#define MD_EVENT_LOG_LEAVE_BLOCK    2
+#define MD_EVENT_LOG_ENTER_SPAN     3
+#define MD_EVENT_LOG_LEAVE_SPAN     4
+#define MD_EVENT_LOG_TEXT           5
+#define MD_EVENT_LOG_TEXTCOPY       6
+
+#define MD_EVENT_LOG_HASDETAIL      0x00010000U
+
+/* Attribute text location (1st word of a recorded attribute). */
+#define MD_EVENT_LOG_ATTR_NULL      0
+#define MD_EVENT_LOG_ATTR_INPUT     1
+#define MD_EVENT_LOG_ATTR_COPY      2
+
+#define MD_EVENT_LOG_NOSUBSTR       0xffffffffU
+
+#define MD_EVENT_LOG_WORDS(n_bytes) (((n_bytes) + sizeof(unsigned) - 1) / sizeof(unsigned))
+
+/* MD_PARSER::flags known to this version (header word [5]). */
+#define MD_EVENT_LOG_KNOWN_FLAGS    (MD_FLAG_COLLAPSEWHITESPACE | MD_FLAG_PERMISSIVEATXHEADERS |            \
+                                     MD_FLAG_PERMISSIVEAUTOLINKS | MD_FLAG_NOINDENTEDCODEBLOCKS |           \
+                                     MD_FLAG_NOHTML | MD_FLAG_TABLES | MD_FLAG_STRIKETHROUGH |              \
+                                     MD_FLAG_TASKLISTS | MD_FLAG_LATEXMATHSPANS | MD_FLAG_WIKILINKS |       \
+                                     MD_FLAG_UNDERLINE | MD_FLAG_MENTIONS | MD_FLAG_NOREFDEFS)
+
+typedef struct MD_EVENT_LOG_WRITER_tag MD_EVENT_LOG_WRITER;
+struct MD_EVENT_LOG_WRITER_tag {
+    const CHAR* text;
+    SZ size;
+    const MD_ALLOCATOR* allocator;
+    void (*debug_log)(const char*, void*);
+
+    unsigned* words;
+    size_t n_words;
+    size_t alloc_words;
+    int out_of_memory;
+
+    /* Heads of the enter records not left yet (see md_event_log_leave()). */
+    unsigned* open_heads;
+    unsigned n_open_heads;
+    unsigned alloc_open_heads;
+};
+
+static void
+md_event_log_grow(MD_EVENT_LOG_WRITER* w, size_t n)
+{
+    unsigned* new_words;
+    size_t new_alloc;
+
+    if(w->out_of_memory)
+        return;
+
+    new_alloc = (w->alloc_words > 0 ? w->alloc_words * 2 : 1024);
+    while(new_alloc < w->n_words + n)
+        new_alloc *= 2;
+
+    new_words = (unsigned*) md_sys_realloc(w->allocator, w->words, new_alloc * sizeof(unsigned));
+    if(new_words == NULL) {
+        if(w->debug_log != NULL)
+            w->debug_log("realloc() failed.", NULL);
+        w->out_of_memory = TRUE;
+        return;
+    }
+
+    w->words = new_words;
+    w->alloc_words = new_alloc;
+}
+
+static void
+md_event_log_put_word(MD_EVENT_LOG_WRITER* w, unsigned word)
+{
+    if(w->n_words >= w->alloc_words) {
+        md_event_log_grow(w, 1);
+        if(w->out_of_memory)
+            return;
+    }
+
+    w->words[w->n_words++] = word;
+}
+
+static void
+md_event_log_put_bytes(MD_EVENT_LOG_WRITER* w, const void* data, size_t n_bytes)
+{
+    size_t n = MD_EVENT_LOG_WORDS(n_bytes);
+
+    if(n == 0)
+        return;
+
+    if(w->n_words + n > w->alloc_words) {
+        md_event_log_grow(w, n);
+        if(w->out_of_memory)
+            return;
+    }
+
+    /* Zero the padding so the log is deterministic. */
+    w->words[w->n_words + n - 1] = 0;
+    memcpy(w->words + w->n_words, data, n_bytes);
+    w->n_words += n;
+}
+
+static int
+md_event_log_is_in_input(MD_EVENT_LOG_WRITER* w, const CHAR* str)
+{
+    return (str >= w->text  &&  str < w->text + w->size);
+}
+
+static void
+md_event_log_put_attribute(MD_EVENT_LOG_WRITER* w, const MD_ATTRIBUTE* attr)
+{
+    unsigned n = 0;
+
+    if(attr->text == NULL) {
+        md_event_log_put_word(w, MD_EVENT_LOG_ATTR_NULL);
+        md_event_log_put_word(w, 0);
+    } else if(attr->size > 0  &&  md_event_log_is_in_input(w, attr->text)) {
+        md_event_log_put_word(w, MD_EVENT_LOG_ATTR_INPUT);
+        md_event_log_put_word(w, attr->size);
+        md_event_log_put_word(w, (unsigned) (attr->text - w->text));
+    } else {
+        md_event_log_put_word(w, MD_EVENT_LOG_ATTR_COPY);
+        md_event_log_put_word(w, attr->size);
+        md_event_log_put_bytes(w, attr->text, attr->size * sizeof(CHAR));
+    }
+
+    if(attr->substr_offsets == NULL  ||  attr->substr_types == NULL) {
+        md_event_log_put_word(w, MD_EVENT_LOG_NOSUBSTR);
+        return;
+    }
+
+    while(attr->substr_offsets[n] < attr->size)
+        n++;
+    md_event_log_put_word(w, n);
+    md_event_log_put_bytes(w, attr->substr_types, n * sizeof(MD_TEXTTYPE));
+    md_event_log_put_bytes(w, attr->substr_offsets, (n+1) * sizeof(MD_OFFSET));
+}
+
+/* Write the detail of the given block or span type. Returns FALSE if the
+ * type has no detail. */
+static int
+md_event_log_put_detail(MD_EVENT_LOG_WRITER* w, int is_span, unsigned type, const void* detail)
+{
+    if(!is_span) {
+        switch(type) {
+            case MD_BLOCK_UL:
+            {
+                const MD_BLOCK_UL_DETAIL* det = (const MD_BLOCK_UL_DETAIL*) detail;
+                md_event_log_put_word(w, (unsigned) det->is_tight);
+                md_event_log_put_word(w, (unsigned) det->mark);
+                return TRUE;
+            }
+
+            case MD_BLOCK_OL:
+            {
+                const MD_BLOCK_OL_DETAIL* det = (const MD_BLOCK_OL_DETAIL*) detail;
+                md_event_log_put_word(w, det->start);
+                md_event_log_put_word(w, (unsigned) det->is_tight);
+                md_event_log_put_word(w, (unsigned) det->mark_delimiter);
+                return TRUE;
+            }
+
+            case MD_BLOCK_LI:
+            {
+                const MD_BLOCK_LI_DETAIL* det = (const MD_BLOCK_LI_DETAIL*) detail;
+                md_event_log_put_word(w, (unsigned) det->is_task);
+                md_event_log_put_word(w, (unsigned) det->task_mark);
+                md_event_log_put_word(w, det->task_mark_offset);
+                return TRUE;
+            }
+
+            case MD_BLOCK_H:
+                md_event_log_put_word(w, ((const MD_BLOCK_H_DETAIL*) detail)->level);
+                return TRUE;
+
+            case MD_BLOCK_CODE:
+            {
+                const MD_BLOCK_CODE_DETAIL* det = (const MD_BLOCK_CODE_DETAIL*) detail;
+                md_event_log_put_word(w, (unsigned) det->fence_char);
+                md_event_log_put_attribute(w, &det->info);
+                md_event_log_put_attribute(w, &det->lang);
+                return TRUE;
+            }
+
+            case MD_BLOCK_TABLE:
+            {
+                const MD_BLOCK_TABLE_DETAIL* det = (const MD_BLOCK_TABLE_DETAIL*) detail;
+                md_event_log_put_word(w, det->col_count);
+                md_event_log_put_word(w, det->head_row_count);
+                md_event_log_put_word(w, det->body_row_count);
+                return TRUE;
+            }
+
+            case MD_BLOCK_TH:
+            case MD_BLOCK_TD:
+                md_event_log_put_word(w, (unsigned) ((const MD_BLOCK_TD_DETAIL*) detail)->align);
+                return TRUE;
+
+            default:
+                return FALSE;
+        }
+    } else {
+        switch(type) {
+            case MD_SPAN_A:
+            {
+                const MD_SPAN_A_DETAIL* det = (const MD_SPAN_A_DETAIL*) detail;
+                md_event_log_put_attribute(w, &det->href);
+                md_event_log_put_attribute(w, &det->title);
+                return TRUE;
+            }
+
+            case MD_SPAN_IMG:
+            {
+                const MD_SPAN_IMG_DETAIL* det = (const MD_SPAN_IMG_DETAIL*) detail;
+                md_event_log_put_attribute(w, &det->src);
+                md_event_log_put_attribute(w, &det->title);
+                return TRUE;
+            }
+
+            case MD_SPAN_WIKILINK:
+                md_event_log_put_attribute(w, &((const MD_SPAN_WIKILINK_DETAIL*) detail)->target);
+                return TRUE;
+
+            case MD_SPAN_MENTION:
+            {
+                const MD_SPAN_MENTION_DETAIL* det = (const MD_SPAN_MENTION_DETAIL*) detail;
+                md_event_log_put_word(w, det->size);
+                md_event_log_put_bytes(w, det->text, det->size * sizeof(CHAR));
+                return TRUE;
+            }
+
+            default:
+                return FALSE;
+        }
+    }
+}
+
+static int
+md_event_log_enter(MD_EVENT_LOG_WRITER* w, int is_span, unsigned type, const void* detail)
+{
+    unsigned op = (is_span ? MD_EVENT_LOG_ENTER_SPAN : MD_EVENT_LOG_ENTER_BLOCK);
+    size_t head = w->n_words;
+
+    if(w->n_open_heads >= w->alloc_open_heads) {
+        unsigned* new_open_heads;
+        unsigned new_alloc;
+
+        new_alloc = (w->alloc_open_heads > 0 ? w->alloc_open_heads * 2 : 16);
+        new_open_heads = (unsigned*) md_sys_realloc(w->allocator, w->open_heads,
+                    new_alloc * sizeof(unsigned));
+        if(new_open_heads == NULL) {
+            if(w->debug_log != NULL)
+                w->debug_log("realloc() failed.", NULL);
+            w->out_of_memory = TRUE;
+            return -1;
+        }
+
+        w->open_heads = new_open_heads;
+        w->alloc_open_heads = new_alloc;
+    }
+    w->open_heads[w->n_open_heads++] = op | (type << 8);
+
+    md_event_log_put_word(w, op | (type << 8));
+    if(detail != NULL  &&  md_event_log_put_detail(w, is_span, type, detail)  &&  !w->out_of_memory)
+        w->words[head] |= MD_EVENT_LOG_HASDETAIL;
+
+    return (w->out_of_memory ? -1 : 0);
+}
+
+/* Record the leave of the innermost open block or span of the given type.
+ *
+ * md_event_log_replay() accepts only properly nested records, but the parser
+ * does not always nest the spans properly (see md_tree_leave()). So this
+ * normalizes the records the same way as the tree does: Blocks and spans
+ * above the matching one are left implicitly, a leave matching nothing is not
+ * recorded at all, and a span is never looked up past the innermost block. */
+static int
+md_event_log_leave(MD_EVENT_LOG_WRITER* w, int is_span, unsigned type)
+{
+    unsigned op = (is_span ? MD_EVENT_LOG_ENTER_SPAN : MD_EVENT_LOG_ENTER_BLOCK);
+    unsigned i = w->n_open_heads;
+
+    while(i > 0) {
+        if(w->open_heads[i-1] == (op | (type << 8)))
+            break;
+        if(is_span  &&  (w->open_heads[i-1] & 0xff) == MD_EVENT_LOG_ENTER_BLOCK)
+            return 0;
+        i--;
+    }
+    if(i == 0)
+        return 0;
+
+    /* (Each leave opcode follows its enter opcode.) */
+    while(w->n_open_heads >= i)
+        md_event_log_put_word(w, w->open_heads[--w->n_open_heads] + 1);
+
+    return (w->out_of_memory ? -1 : 0);
+}
+
+static int
+md_event_log_enter_block(MD_BLOCKTYPE type, void* detail, void* userdata)
+{
+    return md_event_log_enter((MD_EVENT_LOG_WRITER*) userdata, FALSE, type, detail);
+}
+
+static int
+md_event_log_leave_block(MD_BLOCKTYPE type, void* detail, void* userdata)
+{
+    MD_UNUSED(detail);
+    return md_event_log_leave((MD_EVENT_LOG_WRITER*) userdata, FALSE, type);
+}
+
+static int
+md_event_log_enter_span(MD_SPANTYPE type, void* detail, void* userdata)
+{
+    return md_event_log_enter((MD_EVENT_LOG_WRITER*) userdata, TRUE, type, detail);
+}
+
+static int
+md_event_log_leave_span(MD_SPANTYPE type, void* detail, void* userdata)
+{
+    MD_UNUSED(detail);
+    return md_event_log_leave((MD_EVENT_LOG_WRITER*) userdata, TRUE, type);
+}
+
+static int
+md_event_log_text(MD_TEXTTYPE type, const MD_CHAR* text, MD_SIZE size, void* userdata)
+{
+    MD_EVENT_LOG_WRITER* w = (MD_EVENT_LOG_WRITER*) userdata;
+
+    if(size > 0  &&  md_event_log_is_in_input(w, text)) {
+        md_event_log_put_word(w, MD_EVENT_LOG_TEXT | ((unsigned) type << 8));
+        md_event_log_put_word(w, (unsigned) (text - w->text));
+        md_event_log_put_word(w, size);
+    } else {
+        /* A string literal of the parser (e.g. a replacement character). */
+        md_event_log_put_word(w, MD_EVENT_LOG_TEXTCOPY | ((unsigned) type << 8));
+        md_event_log_put_word(w, size);
+        md_event_log_put_bytes(w, text, size * sizeof(CHAR));
+    }
+
+    return (w->out_of_memory ? -1 : 0);
+}
+
+static void
+md_event_log_debug_log(const char* msg, void* userdata)
+{
+    MD_EVENT_LOG_WRITER* w = (MD_EVENT_LOG_WRITER*) userdata;
+
+    if(w->debug_log != NULL)
+        w->debug_log(msg, NULL);
+}
+
+typedef struct MD_EVENT_LOG_READER_tag MD_EVENT_LOG_READER;
+struct MD_EVENT_LOG_READER_tag {
+    const unsigned* pos;
+    const unsigned* end;
+    const CHAR* text;
+    SZ size;
+    int malformed;
+};
+
+static unsigned
+md_event_log_get_word(MD_EVENT_LOG_READER* r)
+{
+    if(r->pos >= r->end) {
+        r->malformed = TRUE;
+        return 0;
+    }
+
+    return *r->pos++;
+}
+
+static const void*
+md_event_log_get_bytes(MD_EVENT_LOG_READER* r, size_t n_bytes)
+{
+    const void* data = r->pos;
+    size_t n = MD_EVENT_LOG_WORDS(n_bytes);
+
+    if(n > (size_t) (r->end - r->pos)) {
+        r->malformed = TRUE;
+        return NULL;
+    }
+
+    r->pos += n;
+    return data;
+}
+
+/* Get a text in the input: Make sure it does not point outside. */
+static const CHAR*
+md_event_log_get_input(MD_EVENT_LOG_READER* r, OFF off, SZ size)
+{
+    if(off > r->size  ||  size > r->size - off) {
+        r->malformed = TRUE;
+        return NULL;
+    }
+
+    return r->text + off;
+}
+
+static void
+md_event_log_get_attribute(MD_EVENT_LOG_READER* r, MD_ATTRIBUTE* attr)
+{
+    unsigned where = md_event_log_get_word(r);
+    unsigned n;
+    unsigned i;
+
+    attr->size = md_event_log_get_word(r);
+    switch(where) {
+        case MD_EVENT_LOG_ATTR_NULL:
+            attr->text = NULL;
+            break;
+
+        case MD_EVENT_LOG_ATTR_INPUT:
+            attr->text = md_event_log_get_input(r, md_event_log_get_word(r), attr->size);
+            break;
+
+        case MD_EVENT_LOG_ATTR_COPY:
+            /* Guard the multiplication below against a corrupted size. */
+            if(attr->size > (size_t) (r->end - r->pos) * sizeof(unsigned)) {
+                r->malformed = TRUE;
+                return;
+            }
+            attr->text = (const CHAR*) md_event_log_get_bytes(r, attr->size * sizeof(CHAR));
+            break;
+
+        default:
+            r->malformed = TRUE;
+            return;
+    }
+
+    n = md_event_log_get_word(r);
+    if(n == MD_EVENT_LOG_NOSUBSTR) {
+        attr->substr_types = NULL;
+        attr->substr_offsets = NULL;
+        return;
+    }
+
+    if(n >= (size_t) (r->end - r->pos)) {
+        r->malformed = TRUE;
+        return;
+    }
+    attr->substr_types = (const MD_TEXTTYPE*) md_event_log_get_bytes(r, n * sizeof(MD_TEXTTYPE));
+    attr->substr_offsets = (const MD_OFFSET*) md_event_log_get_bytes(r, (n+1) * sizeof(MD_OFFSET));
+    if(r->malformed)
+        return;
+
+    /* The renderers walk the substrings blindly: The offsets have to split
+     * the whole text, in order, and each type has to be a known one. */
+    if(attr->substr_offsets[0] != 0  ||  attr->substr_offsets[n] != attr->size) {
+        r->malformed = TRUE;
+        return;
+    }
+    for(i = 0; i < n; i++) {
+        if(attr->substr_offsets[i+1] < attr->substr_offsets[i]  ||
+           (unsigned) attr->substr_types[i] > (unsigned) MD_TEXT_LATEXMATH)
+        {
+            r->malformed = TRUE;
+            return;
+        }
+    }
+}
+
+typedef union MD_EVENT_LOG_DETAIL_tag MD_EVENT_LOG_DETAIL;
+union MD_EVENT_LOG_DETAIL_tag {
+    MD_BLOCK_UL_DETAIL ul;
+    MD_BLOCK_OL_DETAIL ol;
+    MD_BLOCK_LI_DETAIL li;
+    MD_BLOCK_H_DETAIL h;
+    MD_BLOCK_CODE_DETAIL code;
+    MD_BLOCK_TABLE_DETAIL table;
+    MD_BLOCK_TD_DETAIL td;
+    MD_SPAN_A_DETAIL a;
+    MD_SPAN_IMG_DETAIL img;
+    MD_SPAN_WIKILINK_DETAIL wikilink;
+    MD_SPAN_MENTION_DETAIL mention;
+};
+
+/* Block or span which has been entered and not left yet (when replaying). */
+typedef struct MD_EVENT_LOG_OPENER_tag MD_EVENT_LOG_OPENER;
+struct MD_EVENT_LOG_OPENER_tag {
+    unsigned head;          /* The word which has begun the enter record. */
+    MD_EVENT_LOG_DETAIL detail;
+};
+
+static void
+md_event_log_get_detail(MD_EVENT_LOG_READER* r, int is_span, unsigned type, MD_EVENT_LOG_DETAIL* det)
+{
+    if(!is_span) {
+        switch(type) {
+            case MD_BLOCK_UL:
+                det->ul.is_tight = (int) md_event_log_get_word(r);
+                det->ul.mark = (CHAR) md_event_log_get_word(r);
+                break;
+
+            case MD_BLOCK_OL:
+                det->ol.start = md_event_log_get_word(r);
+                det->ol.is_tight = (int) md_event_log_get_word(r);
+                det->ol.mark_delimiter = (CHAR) md_event_log_get_word(r);
+                break;
+
+            case MD_BLOCK_LI:
+                det->li.is_task = (int) md_event_log_get_word(r);
+                det->li.task_mark = (CHAR) md_event_log_get_word(r);
+                det->li.task_mark_offset = md_event_log_get_word(r);
+                break;
+
+            case MD_BLOCK_H:
+                det->h.level = md_event_log_get_word(r);
+                break;
+
+            case MD_BLOCK_CODE:
+                det->code.fence_char = (CHAR) md_event_log_get_word(r);
+                md_event_log_get_attribute(r, &det->code.info);
+                md_event_log_get_attribute(r, &det->code.lang);
+                break;
+
+            case MD_BLOCK_TABLE:
+                det->table.col_count = md_event_log_get_word(r);
+                det->table.head_row_count = md_event_log_get_word(r);
+                det->table.body_row_count = md_event_log_get_word(r);
+                break;
+
+            case MD_BLOCK_TH:
+            case MD_BLOCK_TD:
+                det->td.align = (MD_ALIGN) md_event_log_get_word(r);
+                break;
+
+            default:
+                r->malformed = TRUE;
+                break;
+        }
+    } else {
+        switch(type) {
+            case MD_SPAN_A:
+                md_event_log_get_attribute(r, &det->a.href);
+                md_event_log_get_attribute(r, &det->a.title);
+                break;
+
+            case MD_SPAN_IMG:
+                md_event_log_get_attribute(r, &det->img.src);
+                md_event_log_get_attribute(r, &det->img.title);
+                break;
+
+            case MD_SPAN_WIKILINK:
+                md_event_log_get_attribute(r, &det->wikilink.target);
+                break;
+
+            case MD_SPAN_MENTION:
+                det->mention.size = (unsigned char) md_event_log_get_word(r);
+                det->mention.text = (MD_CHAR*) md_event_log_get_bytes(r, det->mention.size * sizeof(CHAR));
+                break;
+
+            default:
+                r->malformed = TRUE;
+                break;
+        }
+    }
+}
+
+/* Check the header of the log. Returns its version, or zero if it is not an
+ * event log we can read. */
+static unsigned
+md_event_log_check_header(const void* log, size_t log_size)
+{
+    const unsigned* words = (const unsigned*) log;
+
+    if(log_size < MD_EVENT_LOG_HEADER_WORDS * sizeof(unsigned)  ||  ((size_t) log % sizeof(unsigned)) != 0)
+        return 0;
+    if(words[0] != MD_EVENT_LOG_MAGIC  ||  words[2] != MD_EVENT_LOG_BOM  ||  words[3] != MD_EVENT_LOG_SIZES)
+        return 0;
+    if((words[5] & ~(unsigned) MD_EVENT_LOG_KNOWN_FLAGS) != 0)
+        return 0;
+    return words[1];
+}
+
+
+/**************************************
+ ***  Shared Reference Definitions  ***
+ **************************************/
+
+/* Collect the ref. defs. of the document into ctx->ref_defs[]. Only the
+ * lines are analyzed; no block is processed (and so no callback is called). */
+static int
+md_ref_dict_collect(MD_CTX* ctx, const CHAR* text, SZ size)
+{
+    int ret = 0;
+
+    md_reset_ctx(ctx, text, size, NULL);
+    MD_CHECK(md_process_lines(ctx));
+    MD_CHECK(md_end_current_block(ctx));
+
+abort:
+    return ret;
+}
+
+/* Copy the ref. defs. collected in the context into a new dictionary. All of
+ * it lives in a single allocation: The MD_REF_DICT, the ref. defs., the
+ * hashtable, the destinations and titles, and the keys. */
+static MD_REF_DICT*
+md_ref_dict_build(MD_CTX* ctx)
+{
+    MD_REF_DICT* dict;
+    size_t n_strings = 0;
+    size_t defs_size;
+    size_t hashtable_size;
+    size_t size;
+    SZ off = 0;
+    int i;
+
+    for(i = 0; i < ctx->n_ref_defs; i++)
+        n_strings += (ctx->ref_defs[i].dest_end - ctx->ref_defs[i].dest_beg) + ctx->ref_defs[i].title_size;
+
+    defs_size = ctx->n_ref_defs * sizeof(MD_REF_DEF);
+    hashtable_size = md_ref_def_hashtable_size(ctx->n_ref_defs) * sizeof(MD_REF_DEF_SLOT);
+    size = sizeof(MD_REF_DICT) + defs_size + hashtable_size + n_strings * sizeof(CHAR) + ctx->n_ref_def_keys;
+
+    dict = (MD_REF_DICT*) md_sys_malloc(ctx->allocator, size);
+    if(dict == NULL) {
+        MD_LOG("malloc() failed.");
+        return NULL;
+    }
+
+    dict->allocator = ctx->allocator;
+    dict->defs = (MD_REF_DEF*) (dict + 1);
+    dict->n_defs = ctx->n_ref_defs;
+    dict->hashtable = (MD_REF_DEF_SLOT*) ((char*) dict->defs + defs_size);
+    dict->hashtable_size = md_ref_def_hashtable_size(ctx->n_ref_defs);
+    dict->strings = (CHAR*) ((char*) dict->hashtable + hashtable_size);
+    dict->keys = (unsigned char*) (dict->strings + n_strings);
+
+    for(i = 0; i < ctx->n_ref_defs; i++) {
+        const MD_REF_DEF* src = &ctx->ref_defs[i];
+        MD_REF_DEF* def = &dict->defs[i];
+        SZ dest_size = src->dest_end - src->dest_beg;
+
+        memset(def, 0, sizeof(MD_REF_DEF));
+        def->hash = src->hash;
+        def->key_off = src->key_off;
+        def->key_size = src->key_size;
+
+        memcpy(dict->strings + off, ctx->text + src->dest_beg, dest_size * sizeof(CHAR));
+        def->dest_beg = off;
+        def->dest_end = off + dest_size;
+        off += dest_size;
+
+        memcpy(dict->strings + off, src->title, src->title_size * sizeof(CHAR));
+        def->title = dict->strings + off;
+        def->title_size = src->title_size;
+        off += src->title_size;
+    }
+
+    memcpy(dict->keys, ctx->ref_def_keys, ctx->n_ref_def_keys);
+    memset(dict->hashtable, 0, hashtable_size);
+    md_fill_ref_def_hashtable(dict->hashtable, dict->hashtable_size,
+                              dict->defs, dict->n_defs, dict->keys);
+    return dict;
+}
+
+
 /********************
  ***  Public API  ***
  ********************/
@@ -6370,43 +9844,703 @@ int
 md_parse(const MD_CHAR* text, MD_SIZE size, const MD_PARSER* parser, void* userdata)
 {
     MD_CTX ctx;
-    int i;
     int ret;
 
-    if(parser->abi_version != 0) {
+    if(md_check_parser(parser, userdata) != 0)
+        return -1;
+
+    md_setup_ctx(&ctx, parser);
+    ret = md_parse_with_ctx(&ctx, text, size, userdata);
+    md_free_ctx(&ctx);
+
+    return ret;
+}
+
+MD_PARSER_HANDLE*
+md_parser_create(const MD_PARSER* parser)
+{
+    const MD_ALLOCATOR* allocator = NULL;
+    MD_PARSER_HANDLE* handle;
+
+    if(md_check_parser(parser, NULL) != 0)
+        return NULL;
+
+    if(parser->abi_version >= 1)
+        allocator = parser->allocator;
+    handle = (MD_PARSER_HANDLE*) md_sys_malloc(allocator, sizeof(MD_PARSER_HANDLE));
+    if(handle == NULL)
+        return NULL;
+
+    md_setup_ctx(&handle->ctx, parser);
+    handle->trim_threshold = MD_DEFAULT_TRIM_THRESHOLD;
+    handle->stream_buffer = NULL;
+    handle->stream_size = 0;
+    handle->stream_alloc = 0;
+    handle->stream_ret = 0;
+    handle->segments = NULL;
+    handle->n_segments = 0;
+    handle->alloc_segments = 0;
+    handle->new_segments = NULL;
+    handle->n_new_segments = 0;
+    handle->alloc_new_segments = 0;
+    handle->reparse_text = NULL;
+    handle->reparse_size = 0;
+    handle->reparse_valid = FALSE;
+    memset(&handle->batch, 0, sizeof(MD_EVENT_BATCH));
+    return handle;
+}
+
+int
+md_parser_parse(MD_PARSER_HANDLE* handle, const MD_CHAR* text, MD_SIZE size, void* userdata)
+{
+    int ret;
+
+    md_reparse_invalidate(handle);
+    ret = md_parse_with_ctx(&handle->ctx, text, size, userdata);
+    if(handle->ctx.use_arena) {
+        /* The arena cannot be reused piecewise so release it all. */
+        md_free_ctx(&handle->ctx);
+    } else {
+        md_trim_ctx(&handle->ctx, handle->trim_threshold);
+    }
+
+    return ret;
+}
+
+int
+md_parser_begin(MD_PARSER_HANDLE* handle, void* userdata)
+{
+    MD_CTX* ctx = &handle->ctx;
+
+    md_reparse_invalidate(handle);
+    md_reset_ctx(ctx, handle->stream_buffer, 0, userdata);
+    md_begin_parse(ctx);
+    /* All the data we analyze before md_parser_finish() end with a newline. */
+    ctx->doc_ends_with_newline = TRUE;
+    handle->stream_size = 0;
+    handle->stream_ret = md_limit_error(ctx, md_begin_doc(ctx));
+    return handle->stream_ret;
+}
+
+int
+md_parser_feed(MD_PARSER_HANDLE* handle, const MD_CHAR* text, MD_SIZE size)
+{
+    MD_CTX* ctx = &handle->ctx;
+    OFF old_size = handle->stream_size;
+    OFF off;
+
+    if(handle->stream_ret != 0)
+        return handle->stream_ret;
+
+    if(handle->stream_size + size < handle->stream_size) {
+        MD_LOG("Input too large.");
+        handle->stream_ret = -1;
+        return -1;
+    }
+    handle->stream_ret = md_stream_reserve(handle, handle->stream_size + size);
+    if(handle->stream_ret != 0)
+        return handle->stream_ret;
+    memcpy(handle->stream_buffer + handle->stream_size, text, size * sizeof(CHAR));
+    handle->stream_size += size;
+
+    /* Analyze all the complete lines we have got so far, i.e. up to (and
+     * including) the last '\n'. We may not stop after '\r' as we do not know
+     * yet whether '\n' follows. */
+    off = handle->stream_size;
+    while(off > old_size  &&  handle->stream_buffer[off-1] != _T('\n'))
+        off--;
+    if(off > old_size) {
+        ctx->size = off;
+        handle->stream_ret = md_limit_error(ctx, md_process_lines(ctx));
+        if(handle->stream_ret == 0  &&  (MD_PARSER_FLAGS(ctx) & MD_FLAG_NOREFDEFS))
+            md_stream_discard(handle);
+    }
+
+    return handle->stream_ret;
+}
+
+int
+md_parser_finish(MD_PARSER_HANDLE* handle)
+{
+    MD_CTX* ctx = &handle->ctx;
+    int ret = handle->stream_ret;
+
+    if(ret == 0) {
+        ctx->size = handle->stream_size;
+        ctx->doc_ends_with_newline = (ctx->size > 0  &&  ISNEWLINE_(ctx->text[ctx->size-1]));
+        ret = md_process_lines(ctx);
+        if(ret == 0)
+            ret = md_end_doc(ctx);
+    }
+    ret = md_end_parse(ctx, ret);
+
+    md_clear_ctx(ctx);
+    if(ctx->use_arena) {
+        md_free_ctx(ctx);
+    } else {
+        md_trim_ctx(ctx, handle->trim_threshold);
+    }
+    md_stream_release(handle, handle->trim_threshold);
+    handle->stream_size = 0;
+    handle->stream_ret = 0;
+    return ret;
+}
+
+int
+md_parser_reparse(MD_PARSER_HANDLE* handle, const MD_CHAR* text, MD_SIZE size,
+                  const MD_EDIT* edit, MD_REPARSE_INFO* info, void* userdata)
+{
+    MD_CTX* ctx = &handle->ctx;
+    int need_full = TRUE;
+    int ret;
+
+    /* The state kept for the next call is freed and reallocated piecewise
+     * with each edit, but the arena can only be released as a whole. So it
+     * would grow with every edit: Do not use it here. (md_reparse_invalidate()
+     * turns it on again.) */
+    if(ctx->use_arena) {
+        md_free_ctx(ctx);
+        ctx->use_arena = FALSE;
+        handle->reparse_valid = FALSE;
+    }
+
+    md_set_userdata(ctx, userdata);
+    if(edit != NULL  &&  handle->reparse_valid) {
+        if(edit->beg <= handle->reparse_size  &&
+           edit->old_size <= handle->reparse_size - edit->beg  &&
+           size == handle->reparse_size - edit->old_size + edit->new_size)
+        {
+            need_full = FALSE;
+        } else {
+            MD_LOG("MD_EDIT does not match the document size.");
+        }
+    }
+
+    handle->reparse_valid = FALSE;
+    md_begin_parse(ctx);
+    if(need_full) {
+        ret = md_reparse_full(handle, text, size, info, userdata);
+    } else {
+        ret = md_reparse_partial(handle, text, size, edit, info, userdata, &need_full);
+        if(ret == 0  &&  need_full)
+            ret = md_reparse_full(handle, text, size, info, userdata);
+    }
+    ret = md_end_parse(ctx, ret);
+
+    if(ret == 0) {
+        handle->reparse_text = text;
+        handle->reparse_size = size;
+        handle->reparse_valid = TRUE;
+    }
+    return ret;
+}
+
+void
+md_parser_set_trim_threshold(MD_PARSER_HANDLE* handle, MD_SIZE threshold)
+{
+    handle->trim_threshold = threshold;
+    md_reparse_invalidate(handle);
+    md_trim_ctx(&handle->ctx, threshold);
+    md_stream_release(handle, threshold);
+}
+
+int
+md_parser_set_thread_count(MD_PARSER_HANDLE* handle, unsigned n_threads)
+{
+    MD_CTX* ctx = &handle->ctx;
+    MD_INLINE_WORKER* workers = NULL;
+    unsigned i;
+
+    if(n_threads > MD_MAX_THREADS)
+        n_threads = MD_MAX_THREADS;
+
+#if defined MD_THREADS
+    if(n_threads > 1) {
+        workers = (MD_INLINE_WORKER*) md_sys_malloc(ctx->allocator, n_threads * sizeof(MD_INLINE_WORKER));
+        if(workers == NULL) {
+            MD_LOG("malloc() failed.");
+            return -1;
+        }
+        memset(workers, 0, n_threads * sizeof(MD_INLINE_WORKER));
+        for(i = 0; i < n_threads; i++) {
+            workers[i].ctx.allocator = ctx->allocator;
+            workers[i].ctx.use_arena = ctx->use_arena;
+        }
+    }
+#else
+    MD_UNUSED(i);
+    if(n_threads > 1)
+        return -1;
+#endif
+
+    md_trim_inline_workers(ctx, 0);
+    md_sys_free(ctx->allocator, ctx->workers);
+    ctx->workers = workers;
+    ctx->n_workers = (workers != NULL ? (int) n_threads : 0);
+    return 0;
+}
+
+int
+md_parser_set_event_sink(MD_PARSER_HANDLE* handle, MD_EVENT* events, unsigned capacity,
+                         int (*flush)(const MD_EVENT*, unsigned, void*))
+{
+    MD_CTX* ctx = &handle->ctx;
+    MD_EVENT_BATCH* batch = &handle->batch;
+
+    /* Restore the original callbacks. */
+    if(ctx->batch != NULL) {
+        ctx->userdata = batch->userdata;
+        ctx->parser = batch->parser;
+        ctx->batch = NULL;
+    }
+
+    if(events == NULL)
+        return 0;
+    if(capacity == 0  ||  flush == NULL) {
+        MD_LOG("md_parser_set_event_sink(): Invalid arguments.");
+        return -1;
+    }
+
+    batch->parser = ctx->parser;
+    batch->userdata = ctx->userdata;
+    batch->events = events;
+    batch->n_events = 0;
+    batch->capacity = capacity;
+    batch->flush = flush;
+
+    ctx->parser.enter_block = md_batch_enter_block;
+    ctx->parser.leave_block = md_batch_leave_block;
+    ctx->parser.enter_span = md_batch_enter_span;
+    ctx->parser.leave_span = md_batch_leave_span;
+    ctx->parser.text = md_batch_text;
+    ctx->parser.entity = NULL;
+    ctx->parser.debug_log = md_batch_debug_log;
+    ctx->batch = batch;
+    ctx->userdata = batch;
+    return 0;
+}
+
+void
+md_parser_reset(MD_PARSER_HANDLE* handle)
+{
+    md_reparse_invalidate(handle);
+    md_trim_ctx(&handle->ctx, 0);
+    md_stream_release(handle, 0);
+}
+
+void
+md_parser_destroy(MD_PARSER_HANDLE* handle)
+{
+    if(handle != NULL) {
+        md_free_ctx(&handle->ctx);
+        md_sys_free(handle->ctx.allocator, handle->ctx.workers);
+        md_stream_release(handle, 0);
+        md_sys_free(handle->ctx.allocator, handle->segments);
+        md_sys_free(handle->ctx.allocator, handle->new_segments);
+        md_sys_free(handle->ctx.allocator, handle);
+    }
+}
+
+int
+md_parse_to_tree(const MD_CHAR* text, MD_SIZE size, const MD_PARSER* parser, MD_TREE** p_tree)
+{
+    MD_PARSER tree_parser;
+    MD_TREE_BUILDER b;
+    MD_TREE_IMPL* impl = NULL;
+    int ret;
+
+    *p_tree = NULL;
+    if(md_check_parser(parser, NULL) != 0)
+        return -1;
+
+    /* Parse with our own callbacks building the tree. */
+    memset(&tree_parser, 0, sizeof(MD_PARSER));
+    memcpy(&tree_parser, parser, md_parser_abi_size(parser->abi_version));
+    tree_parser.abi_version = MD_PARSER_ABI_VERSION;
+    tree_parser.enter_block = md_tree_enter_block;
+    tree_parser.leave_block = md_tree_leave_block;
+    tree_parser.enter_span = md_tree_enter_span;
+    tree_parser.leave_span = md_tree_leave_span;
+    tree_parser.text = md_tree_text;
+    tree_parser.entity = NULL;
+    tree_parser.debug_log = md_tree_debug_log;
+
+    memset(&b, 0, sizeof(MD_TREE_BUILDER));
+    b.text = text;
+    b.size = size;
+    b.allocator = tree_parser.allocator;
+    b.debug_log = parser->debug_log;
+
+    ret = md_parse(text, size, &tree_parser, &b);
+    if(ret == 0) {
+        impl = md_tree_finish(&b);
+        if(impl == NULL)
+            ret = -1;
+    }
+
+    md_sys_free(b.allocator, b.nodes);
+    md_sys_free(b.allocator, b.open_nodes);
+    if(ret != 0) {
+        md_arena_release(b.allocator, &b.arena);
+        return ((ret == MD_ERROR_LIMIT || ret == MD_ERROR_CANCELLED) ? ret : -1);
+    }
+
+    *p_tree = &impl->tree;
+    return 0;
+}
+
+/* Report a recorded text as md_parse() would (i.e. an entity through
+ * MD_PARSER::entity if set). The text may come from a corrupted event log, so
+ * it is decoded only if it really is an entity; if not, it goes to text() as
+ * it is. */
+static int
+md_replay_text(const MD_PARSER* parser, MD_TEXTTYPE type, const CHAR* str, SZ size, void* userdata)
+{
+    if(type == MD_TEXT_ENTITY  &&  parser->abi_version >= 6  &&  parser->entity != NULL) {
+        MD_ENTITY_DETAIL detail;
+
+        if(md_decode_entity(str, size, &detail) == 0)
+            return parser->entity(str, size, &detail, userdata);
+    }
+
+    return parser->text(type, str, size, userdata);
+}
+
+int
+md_tree_replay(const MD_TREE* tree, const MD_PARSER* parser, void* userdata)
+{
+    const MD_TREE_IMPL* impl = (const MD_TREE_IMPL*) tree;
+    MD_TREE_OPEN_NODE* open_nodes = NULL;
+    unsigned n_open_nodes = 0;
+    unsigned alloc_open_nodes = 0;
+    unsigned i, end;
+    int ret = 0;
+
+    /* The nodes are in the document order, so the subtree of a node spans
+     * up to its next sibling (or up to where the subtree of its parent
+     * ends). */
+    for(i = 0; i <= tree->n_nodes; i++) {
+        while(n_open_nodes > 0  &&  open_nodes[n_open_nodes-1].aux <= i) {
+            const MD_NODE* node = &tree->nodes[open_nodes[--n_open_nodes].index];
+
+            if(node->kind == MD_NODE_BLOCK)
+                ret = parser->leave_block((MD_BLOCKTYPE) node->type, (void*) node->data, userdata);
+            else
+                ret = parser->leave_span((MD_SPANTYPE) node->type, (void*) node->data, userdata);
+            if(ret != 0)
+                goto abort;
+        }
+
+        if(i < tree->n_nodes) {
+            const MD_NODE* node = &tree->nodes[i];
+
+            if(node->kind == MD_NODE_TEXT) {
+                ret = md_replay_text(parser, (MD_TEXTTYPE) node->type, (const CHAR*) node->data, node->size, userdata);
+                if(ret != 0)
+                    goto abort;
+                continue;
+            }
+
+            if(node->kind == MD_NODE_BLOCK)
+                ret = parser->enter_block((MD_BLOCKTYPE) node->type, (void*) node->data, userdata);
+            else
+                ret = parser->enter_span((MD_SPANTYPE) node->type, (void*) node->data, userdata);
+            if(ret != 0)
+                goto abort;
+
+            if(node->next_sibling != 0)
+                end = node->next_sibling;
+            else if(n_open_nodes > 0)
+                end = open_nodes[n_open_nodes-1].aux;
+            else
+                end = tree->n_nodes;
+
+            if(md_tree_push_open_node(impl->allocator, &open_nodes, &n_open_nodes,
+                        &alloc_open_nodes, i, end) != 0)
+            {
+                if(parser->debug_log != NULL)
+                    parser->debug_log("realloc() failed.", userdata);
+                md_sys_free(impl->allocator, open_nodes);
+                return -1;
+            }
+        }
+    }
+
+abort:
+    if(ret != 0  &&  parser->debug_log != NULL)
+        parser->debug_log("Aborted from a callback.", userdata);
+    md_sys_free(impl->allocator, open_nodes);
+    return ret;
+}
+
+void
+md_tree_free(MD_TREE* tree)
+{
+    if(tree != NULL) {
+        MD_TREE_IMPL* impl = (MD_TREE_IMPL*) tree;
+        const MD_ALLOCATOR* allocator = impl->allocator;
+        MD_ARENA arena = impl->arena;
+
+        /* (The impl itself lives in the arena.) */
+        md_arena_release(allocator, &arena);
+    }
+}
+
+int
+md_parse_to_event_log(const MD_CHAR* text, MD_SIZE size, const MD_PARSER* parser,
+                      void** p_log, size_t* p_log_size)
+{
+    MD_PARSER log_parser;
+    MD_EVENT_LOG_WRITER w;
+    int ret;
+
+    *p_log = NULL;
+    *p_log_size = 0;
+    if(md_check_parser(parser, NULL) != 0)
+        return -1;
+
+    /* Parse with our own callbacks recording the log. */
+    memset(&log_parser, 0, sizeof(MD_PARSER));
+    memcpy(&log_parser, parser, md_parser_abi_size(parser->abi_version));
+    log_parser.abi_version = MD_PARSER_ABI_VERSION;
+    log_parser.enter_block = md_event_log_enter_block;
+    log_parser.leave_block = md_event_log_leave_block;
+    log_parser.enter_span = md_event_log_enter_span;
+    log_parser.leave_span = md_event_log_leave_span;
+    log_parser.text = md_event_log_text;
+    log_parser.entity = NULL;
+    log_parser.debug_log = md_event_log_debug_log;
+
+    memset(&w, 0, sizeof(MD_EVENT_LOG_WRITER));
+    w.text = text;
+    w.size = size;
+    w.allocator = log_parser.allocator;
+    w.debug_log = parser->debug_log;
+
+    md_event_log_put_word(&w, MD_EVENT_LOG_MAGIC);
+    md_event_log_put_word(&w, MD_EVENT_LOG_VERSION);
+    md_event_log_put_word(&w, MD_EVENT_LOG_BOM);
+    md_event_log_put_word(&w, MD_EVENT_LOG_SIZES);
+    md_event_log_put_word(&w, size);
+    md_event_log_put_word(&w, parser->flags);
+
+    ret = (w.out_of_memory ? -1 : md_parse(text, size, &log_parser, &w));
+
+    /* Leaving MD_BLOCK_DOC leaves everything, but just in case. */
+    while(ret == 0  &&  w.n_open_heads > 0) {
+        md_event_log_put_word(&w, w.open_heads[--w.n_open_heads] + 1);
+        if(w.out_of_memory)
+            ret = -1;
+    }
+
+    md_sys_free(w.allocator, w.open_heads);
+    if(ret != 0) {
+        md_sys_free(w.allocator, w.words);
+        return ((ret == MD_ERROR_LIMIT || ret == MD_ERROR_CANCELLED) ? ret : -1);
+    }
+
+    *p_log = w.words;
+    *p_log_size = w.n_words * sizeof(unsigned);
+    return 0;
+}
+
+unsigned
+md_event_log_version(const void* log, size_t log_size)
+{
+    return md_event_log_check_header(log, log_size);
+}
+
+int
+md_event_log_replay(const void* log, size_t log_size, const MD_CHAR* text, MD_SIZE size,
+                    const MD_PARSER* parser, void* userdata)
+{
+    const MD_ALLOCATOR* allocator = NULL;
+    MD_EVENT_LOG_READER r;
+    MD_EVENT_LOG_OPENER* openers = NULL;
+    unsigned n_openers = 0;
+    unsigned alloc_openers = 0;
+    int ret = 0;
+
+    if(parser->abi_version >= 1)
+        allocator = parser->allocator;
+
+    if(md_event_log_check_header(log, log_size) != MD_EVENT_LOG_VERSION  ||
+       ((const unsigned*) log)[4] != size)
+    {
         if(parser->debug_log != NULL)
-            parser->debug_log("Unsupported abi_version.", userdata);
+            parser->debug_log("Event log does not match this version or this input.", userdata);
         return -1;
     }
 
-    /* Setup context structure. */
-    memset(&ctx, 0, sizeof(MD_CTX));
-    ctx.text = text;
-    ctx.size = size;
-    memcpy(&ctx.parser, parser, sizeof(MD_PARSER));
-    ctx.userdata = userdata;
-    ctx.code_indent_offset = (ctx.parser.flags & MD_FLAG_NOINDENTEDCODEBLOCKS) ? (OFF)(-1) : 4;
-    md_build_mark_char_map(&ctx);
-    ctx.doc_ends_with_newline = (size > 0  &&  ISNEWLINE_(text[size-1]));
+    r.pos = (const unsigned*) log + MD_EVENT_LOG_HEADER_WORDS;
+    r.end = (const unsigned*) log + log_size / sizeof(unsigned);
+    r.text = text;
+    r.size = size;
+    r.malformed = FALSE;
 
-    /* Reset all unresolved opener mark chains. */
-    for(i = 0; i < (int) SIZEOF_ARRAY(ctx.mark_chains); i++) {
-        ctx.mark_chains[i].head = -1;
-        ctx.mark_chains[i].tail = -1;
+    while(r.pos < r.end) {
+        unsigned head = md_event_log_get_word(&r);
+        unsigned type = (head >> 8) & 0xff;
+
+        switch(head & 0xff) {
+            case MD_EVENT_LOG_ENTER_BLOCK:
+            case MD_EVENT_LOG_ENTER_SPAN:
+            {
+                MD_EVENT_LOG_OPENER* opener;
+                void* detail = NULL;
+
+                if(n_openers >= alloc_openers) {
+                    MD_EVENT_LOG_OPENER* new_openers;
+                    unsigned new_alloc = (alloc_openers > 0 ? alloc_openers * 2 : 16);
+
+                    new_openers = (MD_EVENT_LOG_OPENER*) md_sys_realloc(allocator,
+                                openers, new_alloc * sizeof(MD_EVENT_LOG_OPENER));
+                    if(new_openers == NULL) {
+                        if(parser->debug_log != NULL)
+                            parser->debug_log("realloc() failed.", userdata);
+                        ret = -1;
+                        goto abort;
+                    }
+                    openers = new_openers;
+                    alloc_openers = new_alloc;
+                }
+
+                opener = &openers[n_openers++];
+                opener->head = head;
+                if(head & MD_EVENT_LOG_HASDETAIL) {
+                    md_event_log_get_detail(&r, ((head & 0xff) == MD_EVENT_LOG_ENTER_SPAN), type, &opener->detail);
+                    detail = &opener->detail;
+                }
+                if(r.malformed)
+                    break;
+
+                if((head & 0xff) == MD_EVENT_LOG_ENTER_BLOCK)
+                    ret = parser->enter_block((MD_BLOCKTYPE) type, detail, userdata);
+                else
+                    ret = parser->enter_span((MD_SPANTYPE) type, detail, userdata);
+                if(ret != 0)
+                    goto abort_callback;
+                break;
+            }
+
+            case MD_EVENT_LOG_LEAVE_BLOCK:
+            case MD_EVENT_LOG_LEAVE_SPAN:
+            {
+                MD_EVENT_LOG_OPENER* opener;
+                void* detail;
+
+                /* Must match the enter record. */
+                if(n_openers == 0  ||  (openers[n_openers-1].head & 0xffff) != (head & 0xffff) - 1) {
+                    r.malformed = TRUE;
+                    break;
+                }
+
+                opener = &openers[--n_openers];
+                detail = ((opener->head & MD_EVENT_LOG_HASDETAIL) ? &opener->detail : NULL);
+                if((head & 0xff) == MD_EVENT_LOG_LEAVE_BLOCK)
+                    ret = parser->leave_block((MD_BLOCKTYPE) type, detail, userdata);
+                else
+                    ret = parser->leave_span((MD_SPANTYPE) type, detail, userdata);
+                if(ret != 0)
+                    goto abort_callback;
+                break;
+            }
+
+            case MD_EVENT_LOG_TEXT:
+            {
+                OFF off = md_event_log_get_word(&r);
+                SZ n = md_event_log_get_word(&r);
+                const CHAR* str = md_event_log_get_input(&r, off, n);
+
+                if(r.malformed)
+                    break;
+                ret = md_replay_text(parser, (MD_TEXTTYPE) type, str, n, userdata);
+                if(ret != 0)
+                    goto abort_callback;
+                break;
+            }
+
+            case MD_EVENT_LOG_TEXTCOPY:
+            {
+                SZ n = md_event_log_get_word(&r);
+                const CHAR* str;
+
+                if(n > (size_t) (r.end - r.pos) * sizeof(unsigned)) {
+                    r.malformed = TRUE;
+                    break;
+                }
+                str = (const CHAR*) md_event_log_get_bytes(&r, n * sizeof(CHAR));
+                if(r.malformed)
+                    break;
+                ret = md_replay_text(parser, (MD_TEXTTYPE) type, str, n, userdata);
+                if(ret != 0)
+                    goto abort_callback;
+                break;
+            }
+
+            default:
+                r.malformed = TRUE;
+                break;
+        }
+
+        if(r.malformed)
+            break;
+    }
+
+    if(r.malformed  ||  n_openers != 0) {
+        if(parser->debug_log != NULL)
+            parser->debug_log("Malformed event log.", userdata);
+        ret = -1;
     }
-    ctx.unresolved_link_head = -1;
-    ctx.unresolved_link_tail = -1;
+    goto abort;
+
+abort_callback:
+    if(parser->debug_log != NULL)
+        parser->debug_log("Aborted from a callback.", userdata);
+
+abort:
+    md_sys_free(allocator, openers);
+    return ret;
+}
+
+void
+md_event_log_free(void* log, const MD_PARSER* parser)
+{
+    md_sys_free((parser->abi_version >= 1 ? parser->allocator : NULL), log);
+}
+
+int
+md_ref_dict_create(const MD_CHAR* text, MD_SIZE size, const MD_PARSER* parser, MD_REF_DICT** p_dict)
+{
+    MD_CTX ctx;
+    int ret;
+
+    *p_dict = NULL;
+    if(md_check_parser(parser, NULL) != 0)
+        return -1;
 
-    /* All the work. */
-    ret = md_process_doc(&ctx);
+    md_setup_ctx(&ctx, parser);
+    /* Of course we want the ref. defs. here. */
+    ctx.parser.flags &= ~MD_FLAG_NOREFDEFS;
+    ctx.parser.ref_dict = NULL;
+    ctx.parser.stats = NULL;
 
-    /* Clean-up. */
-    md_free_ref_defs(&ctx);
-    md_free_ref_def_hashtable(&ctx);
-    free(ctx.buffer);
-    free(ctx.marks);
-    free(ctx.block_bytes);
-    free(ctx.containers);
+    md_begin_parse(&ctx);
+    ret = md_ref_dict_collect(&ctx, text, size);
+    if(ret == 0) {
+        *p_dict = md_ref_dict_build(&ctx);
+        if(*p_dict == NULL)
+            ret = -1;
+    }
+    ret = md_end_parse(&ctx, ret);
 
+    md_free_ctx(&ctx);
     return ret;
 }
+
+void
+md_ref_dict_free(MD_REF_DICT* dict)
+{
+    if(dict != NULL)
+        md_sys_free(dict->allocator, dict);
+}
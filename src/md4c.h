@@ -26,6 +26,8 @@
 #ifndef MD4C_H
 #define MD4C_H
 
+#include <stddef.h>
+
 #ifdef __cplusplus
     extern "C" {
 #endif
@@ -174,7 +176,8 @@ typedef enum MD_TEXTTYPE {
      * (c) Hexadecimal entity, e.g. &#x12AB;
      *
      * As MD4C is mostly encoding agnostic, application gets the verbatim
-     * entity text into the MD_PARSER::text_callback(). */
+     * entity text into the MD_PARSER::text_callback(). (Or, if it sets
+     * MD_PARSER::entity, the codepoints the entity stands for too.) */
     MD_TEXT_ENTITY,
 
     /* Text in a code block (inside MD_BLOCK_CODE) or inlined code (`code`).
@@ -238,6 +241,20 @@ typedef struct MD_ATTRIBUTE {
 } MD_ATTRIBUTE;
 
 
+/* Codepoints an entity (MD_TEXT_ENTITY) stands for. See MD_PARSER::entity
+ * and md_decode_entity().
+ */
+typedef struct MD_ENTITY_DETAIL {
+    /* 1, or 2 for a few named entities. Zero for a named entity which HTML
+     * does not define (it is then usually output verbatim). */
+    unsigned n_codepoints;
+
+    /* Numerical entities of zero or beyond U+10FFFF are decoded as the
+     * replacement character U+FFFD, as CommonMark requires. */
+    unsigned codepoints[2];
+} MD_ENTITY_DETAIL;
+
+
 /* Detailed info for MD_BLOCK_UL. */
 typedef struct MD_BLOCK_UL_DETAIL {
     int is_tight;           /* Non-zero if tight list, zero if loose. */
@@ -325,6 +342,7 @@ typedef struct MD_SPAN_MENTION {
 #define MD_FLAG_WIKILINKS                   0x2000  /* Enable wiki links extension. */
 #define MD_FLAG_UNDERLINE                   0x4000  /* Enable underline extension (and disables '_' for normal emphasis). */
 #define MD_FLAG_MENTIONS                    0x8000  /* Enable mention links extension. */
+#define MD_FLAG_NOREFDEFS                   0x10000 /* Disable link reference definitions (so reference links only use MD_PARSER::ref_dict). Blocks are then reported as soon as they end. */
 
 #define MD_FLAG_PERMISSIVEAUTOLINKS         (MD_FLAG_PERMISSIVEEMAILAUTOLINKS | MD_FLAG_PERMISSIVEURLAUTOLINKS | MD_FLAG_PERMISSIVEWWWAUTOLINKS)
 #define MD_FLAG_NOHTML                      (MD_FLAG_NOHTMLBLOCKS | MD_FLAG_NOHTMLSPANS)
@@ -341,14 +359,98 @@ typedef struct MD_SPAN_MENTION {
 #define MD_DIALECT_COMMONMARK               0
 #define MD_DIALECT_GITHUB                   (MD_FLAG_PERMISSIVEAUTOLINKS | MD_FLAG_TABLES | MD_FLAG_STRIKETHROUGH | MD_FLAG_TASKLISTS)
 
+/* Memory allocator.
+ *
+ * If provided (see MD_PARSER::allocator), all memory the parser needs is
+ * allocated through these functions instead of malloc(), realloc() and free()
+ * from the C library. All three functions have to be set. The last argument
+ * is always MD_ALLOCATOR::userdata.
+ */
+typedef struct MD_ALLOCATOR {
+    void* (*malloc_fn)(size_t /*size*/, void* /*userdata*/);
+    void* (*realloc_fn)(void* /*ptr*/, size_t /*size*/, void* /*userdata*/);
+    void (*free_fn)(void* /*ptr*/, void* /*userdata*/);
+    void* userdata;
+} MD_ALLOCATOR;
+
+/* Flags for MD_PARSER::alloc_flags.
+ *
+ * MD_ALLOC_ARENA: Serve all allocations from a bump arena (its chunks are
+ * obtained from the allocator), and release it as a whole when md_parse()
+ * returns. This makes the number of calls to the allocator proportional to
+ * the total memory consumption rather than to the number of allocations.
+ */
+#define MD_ALLOC_ARENA                      0x0001
+
+/* Shared dictionary of link reference definitions. See md_ref_dict_create().
+ */
+typedef struct MD_REF_DICT MD_REF_DICT;
+
+/* Statistics of parsing a document. See MD_PARSER::stats.
+ *
+ * The times are in seconds, measured with a monotonic clock (where available).
+ * Measuring them has some overhead, so the statistics are only gathered if
+ * requested.
+ */
+typedef struct MD_PARSE_STATS {
+    /* Time spent in each phase of the parsing, and how many characters the
+     * phase has processed. */
+    double line_analysis_time;      /* Block structure of the lines. */
+    MD_SIZE line_analysis_size;
+    double ref_def_time;            /* Consuming link reference definitions. */
+    MD_SIZE ref_def_size;
+    double mark_collection_time;    /* Collecting inline marks. */
+    MD_SIZE mark_collection_size;
+    double mark_resolution_time;    /* Analysis/resolution of the marks (of emphasis, links, ...). */
+    double emission_time;           /* Calling the callbacks (including the time spent in them). */
+    MD_SIZE emission_size;          /* Size of all the text passed to the text() callback. */
+
+    /* Counts. */
+    unsigned n_lines;
+    unsigned n_blocks;
+    unsigned n_marks;               /* Inline marks collected. */
+    unsigned n_rollbacks;           /* Marks dropped when resolving an enclosing span. */
+    unsigned n_ref_defs;
+    unsigned n_ref_def_lookups;
+
+    /* Peak sizes (in bytes) of the internal work buffers used for parsing
+     * the document, summed over the worker threads when the inlines are
+     * analyzed in parallel (see md_parser_set_thread_count()). The buffers
+     * themselves may be larger, e.g. when kept by an MD_PARSER_HANDLE from
+     * the previous documents. */
+    size_t block_buffer_size;
+    size_t container_buffer_size;
+    size_t mark_buffer_size;
+    size_t aux_buffer_size;
+    size_t ref_def_buffer_size;     /* Including the normalized labels and the hash table. */
+} MD_PARSE_STATS;
+
+/* The most recent layout version of MD_PARSER. See MD_PARSER::abi_version.
+ *
+ *  0: The original layout (up to and including the member syntax).
+ *  1: Adds members allocator and alloc_flags.
+ *  2: Adds member ref_dict.
+ *  3: Adds member stats.
+ *  4: Adds members max_memory, max_marks, max_nesting and max_ref_defs.
+ *  5: Adds members time_limit and cancel.
+ *  6: Adds member entity.
+ */
+#define MD_PARSER_ABI_VERSION               6
+
 /* Parser structure.
  */
 typedef struct MD_PARSER {
-    /* Reserved. Set to zero.
+    /* Layout version of this structure. Set to zero, or to
+     * MD_PARSER_ABI_VERSION if the application needs any of the members
+     * added in a later version (see the members' comments).
      */
     unsigned abi_version;
 
     /* Dialect options. Bitmask of MD_FLAG_xxxx values.
+     *
+     * Note that if MD4C is built with MD4C_FIXED_FLAGS (see the CMake option
+     * of the same name), parsing fails for any other flags than those (with
+     * the exception of MD_FLAG_NOREFDEFS).
      */
     unsigned flags;
 
@@ -387,6 +489,102 @@ typedef struct MD_PARSER {
     /* Reserved. Set to NULL.
      */
     void (*syntax)(void);
+
+    /* Memory allocator. Optional (may be NULL, then the C library is used).
+     * Only recognized if abi_version >= 1.
+     *
+     * The structure has to stay valid until md_parse() returns (or, for
+     * MD_PARSER_HANDLE, until md_parser_destroy() is called).
+     */
+    const MD_ALLOCATOR* allocator;
+
+    /* Bitmask of MD_ALLOC_xxxx flags. Only recognized if abi_version >= 1.
+     */
+    unsigned alloc_flags;
+
+    /* Link reference definitions shared by all the documents. Optional (may
+     * be NULL). Only recognized if abi_version >= 2.
+     *
+     * Reference links which do not match any reference definition in the
+     * document itself are looked up here. This works with MD_FLAG_NOREFDEFS
+     * too (then only the dictionary is used), so that the blocks can still
+     * be reported as soon as they end.
+     *
+     * The dictionary has to stay valid until md_parse() returns (or, for
+     * MD_PARSER_HANDLE, until md_parser_destroy() is called).
+     */
+    const MD_REF_DICT* ref_dict;
+
+    /* Statistics of the parsing. Optional (may be NULL). Only recognized if
+     * abi_version >= 3.
+     *
+     * If set, the structure is filled whenever the parsing of a document
+     * finishes (successfully or not), i.e. by md_parse(), md_parser_parse(),
+     * md_parser_finish() and md_parser_reparse() (which only counts the
+     * re-analyzed blocks). With md_parser_set_thread_count(), the times of
+     * the inline analysis are summed over all the threads.
+     */
+    MD_PARSE_STATS* stats;
+
+    /* Resource limits for parsing a single document, for applications which
+     * process untrusted input. Zero means no limit. Only recognized if
+     * abi_version >= 4.
+     *
+     * max_memory: Bytes the parser may have allocated at any moment. The
+     * memory is counted as it is allocated and freed (with the allocator's
+     * overhead of a few bytes per block), so this is a limit of the peak
+     * memory consumption. (Buffers kept by MD_PARSER_HANDLE from the previous
+     * documents are not counted.) If it is exceeded, parsing fails with
+     * MD_ERROR_LIMIT.
+     *
+     * max_marks: Inline marks (potential emphasis delimiters, brackets etc.)
+     * collected in a single paragraph, heading or table row. The rest of the
+     * block is treated as literal text.
+     *
+     * max_nesting: Depth of nested container blocks (block quotes, lists and
+     * list items). Any deeper container mark is treated as literal text.
+     *
+     * max_ref_defs: Link reference definitions. Any further one is treated
+     * as literal text.
+     */
+    size_t max_memory;
+    unsigned max_marks;
+    unsigned max_nesting;
+    unsigned max_ref_defs;
+
+    /* Cooperative cancellation of the parsing of a single document. Only
+     * recognized if abi_version >= 5.
+     *
+     * time_limit: Seconds the parsing may take (measured by a monotonic clock
+     * where available, including the time spent in the callbacks). It starts
+     * counting in md_parse(), md_parser_parse(), md_parser_begin() (so for a
+     * streamed document it includes the time between md_parser_feed() calls)
+     * or md_parser_reparse(). Zero means no limit.
+     *
+     * cancel: If not NULL, the parsing stops as soon as *cancel becomes
+     * non-zero. It may be set from another thread, or from a callback.
+     *
+     * Both are only checked every few hundreds of lines, blocks or inline
+     * marks, so the parsing may go on for a (short) while after the deadline.
+     * Then the parsing fails with MD_ERROR_CANCELLED, no further callback is
+     * called, and everything allocated for the document is released.
+     */
+    double time_limit;
+    const volatile int* cancel;
+
+    /* Entities in the text. Optional (may be NULL, then they are reported
+     * to text() as MD_TEXT_ENTITY). Only recognized if abi_version >= 6.
+     *
+     * If set, it is called instead of text() for each entity, with the
+     * codepoints of the entity already decoded (named entities are looked
+     * up in the list of entities defined by HTML), so the application does
+     * not need to parse the entity again.
+     *
+     * Entities in MD_ATTRIBUTE strings are not reported this way (use
+     * md_decode_entity() for them), nor with md_parser_set_event_sink() (the
+     * MD_EVENT_TEXT events carry no detail).
+     */
+    int (*entity)(const MD_CHAR* /*text*/, MD_SIZE /*size*/, const MD_ENTITY_DETAIL* /*detail*/, void* /*userdata*/);
 } MD_PARSER;
 
 
@@ -403,9 +601,365 @@ typedef MD_PARSER MD_RENDERER;
  * Zero is returned on success. If a runtime error occurs (e.g. a memory
  * fails), -1 is returned. If the processing is aborted due any callback
  * returning non-zero, the return value of the callback is returned.
+ *
+ * MD_ERROR_LIMIT is returned if a resource limit (MD_PARSER::max_memory)
+ * is exceeded, and MD_ERROR_CANCELLED if the parsing is cancelled (see
+ * MD_PARSER::time_limit and MD_PARSER::cancel). (Applications which want to
+ * distinguish them should not return them from the callbacks.)
  */
+#define MD_ERROR_LIMIT                      (-2)
+#define MD_ERROR_CANCELLED                  (-3)
+
 int md_parse(const MD_CHAR* text, MD_SIZE size, const MD_PARSER* parser, void* userdata);
 
+/* Decode the entity (e.g. "&amp;", "&#1234;" or "&#x12AB;", as reported as
+ * MD_TEXT_ENTITY) into the codepoints it stands for, the same way as for
+ * MD_PARSER::entity. Returns zero on success, or -1 if the text is not an
+ * entity.
+ */
+int md_decode_entity(const MD_CHAR* text, MD_SIZE size, MD_ENTITY_DETAIL* detail);
+
+
+/* Reusable parser.
+ *
+ * md_parse() sets up all its internal work buffers from scratch and releases
+ * them before it returns. Applications parsing many (typically small)
+ * documents may instead create a long-lived parser handle which keeps the
+ * buffers allocated between the documents, so subsequent parses mostly avoid
+ * any memory (re)allocation.
+ *
+ * The handle is not thread-safe. Use one handle per thread.
+ */
+typedef struct MD_PARSER_HANDLE MD_PARSER_HANDLE;
+
+/* Create the parser handle. The MD_PARSER structure is copied so the caller
+ * does not need to keep it alive (but see MD_PARSER::allocator).
+ *
+ * Note that with MD_ALLOC_ARENA, the arena and all the buffers are released
+ * after each document anyway. (md_parser_reparse() does not use the arena,
+ * as it keeps its state from one call to the next.)
+ *
+ * Returns NULL on failure (e.g. when out of memory).
+ */
+MD_PARSER_HANDLE* md_parser_create(const MD_PARSER* parser);
+
+/* Same as md_parse() but reusing the buffers kept in the handle.
+ */
+int md_parser_parse(MD_PARSER_HANDLE* handle, const MD_CHAR* text, MD_SIZE size, void* userdata);
+
+/* Set the high-water mark (in bytes) of the trim policy: After each
+ * md_parser_parse(), any internal buffer larger than the threshold is
+ * released so that a single huge document does not keep its memory pinned.
+ * Zero means no buffer is kept at all. The default is 1 MB.
+ */
+void md_parser_set_trim_threshold(MD_PARSER_HANDLE* handle, MD_SIZE threshold);
+
+/* Chunked (streaming) input.
+ *
+ * Instead of passing the whole document to md_parser_parse(), the application
+ * may call md_parser_begin(), then md_parser_feed() for each chunk of the
+ * input as it arrives, and finally md_parser_finish(). Chunk boundaries may
+ * be anywhere (even in the middle of a line or a UTF-8 sequence).
+ *
+ * Lines are analyzed as soon as they are complete, so the analysis overlaps
+ * with the input I/O. Note however that the parser still keeps all the input
+ * in an internal buffer, and the callbacks (beyond the MD_BLOCK_DOC enter)
+ * are only called from md_parser_finish(): Any link may refer to
+ * a reference definition which only comes later in the input.
+ *
+ * That is not so with MD_FLAG_NOREFDEFS: Each top-level block is then
+ * reported from md_parser_feed() as soon as its end is seen, and the input
+ * it has been made of is dropped from the buffer. (Offsets in the details,
+ * like MD_BLOCK_LI_DETAIL::task_mark_offset, still refer to the whole input,
+ * counted from the first byte passed to md_parser_feed().)
+ *
+ * md_parser_begin() and md_parser_feed() return zero on success. Otherwise
+ * the error (or the value returned by a callback) is returned, further calls
+ * of md_parser_feed() just return it again, and md_parser_finish() reports
+ * it too. md_parser_finish() has to be called in any case. It returns the
+ * same as md_parse() would for the whole input.
+ *
+ * md_parser_set_trim_threshold() and md_parser_reset() must not be called
+ * between md_parser_begin() and md_parser_finish().
+ */
+int md_parser_begin(MD_PARSER_HANDLE* handle, void* userdata);
+int md_parser_feed(MD_PARSER_HANDLE* handle, const MD_CHAR* text, MD_SIZE size);
+int md_parser_finish(MD_PARSER_HANDLE* handle);
+
+/* Incremental re-parsing (e.g. for a live preview in an editor).
+ *
+ * md_parser_reparse() remembers how the document is split into top-level
+ * blocks (i.e. the direct children of MD_BLOCK_DOC). When called again with
+ * the edited document and a description of the edit, only the top-level
+ * blocks touched by the edit are analyzed again, and the callbacks are
+ * called only for the blocks which replace them. The MD_REPARSE_INFO tells
+ * the application which top-level blocks of the previous output the new
+ * ones replace.
+ *
+ * The whole document is parsed again (and all its top-level blocks are
+ * reported as replaced) when called for the first time, when 'edit' is NULL,
+ * after any other function (except md_parser_reparse()) has been used with
+ * the handle, or when the edit adds, removes or changes any link reference
+ * definition.
+ *
+ * The handle keeps its buffers (regardless the trim threshold) between the
+ * calls. md_parser_reset() releases them.
+ *
+ * md_parser_reparse() never enters or leaves MD_BLOCK_DOC.
+ *
+ * Offsets in the details (MD_BLOCK_LI_DETAIL::task_mark_offset) refer to the
+ * text passed to the call which has reported the block. So in the blocks the
+ * application keeps after the edit, they are off by (new_size - old_size).
+ *
+ * The text passed to the previous call does not need to stay valid, but the
+ * edit has to describe precisely how it has been changed into the new one.
+ */
+typedef struct MD_EDIT {
+    MD_OFFSET beg;          /* Where the edit begins. */
+    MD_SIZE old_size;       /* Size of the replaced text in the old document. */
+    MD_SIZE new_size;       /* Size of its replacement in the new document. */
+} MD_EDIT;
+
+typedef struct MD_REPARSE_INFO {
+    unsigned first_block;   /* Index of the 1st replaced top-level block. */
+    unsigned n_old_blocks;  /* Count of the replaced top-level blocks. */
+    unsigned n_new_blocks;  /* Count of the top-level blocks replacing them. */
+    int is_full;            /* Non-zero if the whole document was parsed again. */
+} MD_REPARSE_INFO;
+
+int md_parser_reparse(MD_PARSER_HANDLE* handle, const MD_CHAR* text, MD_SIZE size,
+                      const MD_EDIT* edit, MD_REPARSE_INFO* info, void* userdata);
+
+/* Set how many threads may be used for parsing a document. The default is 1.
+ *
+ * With more threads, the inlines of the paragraphs and headers of large
+ * documents are analyzed by the worker threads in parallel, after all the
+ * lines of the document are analyzed (so that all the link reference
+ * definitions are known), and before any callback for the blocks is called.
+ * The callbacks are still called only from the calling thread, in the
+ * document order, but note MD_PARSER::debug_log may be called from any of
+ * the threads. And the allocator (MD_PARSER::allocator), if any, has to be
+ * thread-safe.
+ *
+ * Returns zero on success, or -1 on failure (e.g. when out of memory, or when
+ * MD4C has been built without the support of threads).
+ */
+int md_parser_set_thread_count(MD_PARSER_HANDLE* handle, unsigned n_threads);
+
+/* Batched callbacks.
+ *
+ * md_parser_set_event_sink() makes the handle collect the events (i.e. what
+ * would be the calls of the callbacks of MD_PARSER) into the array provided
+ * by the application, and call flush() with them in bulk, instead of calling
+ * the callbacks one by one. This saves many indirect calls, mainly for the
+ * text-heavy documents, and even more for the bindings to other languages
+ * where each call into the application is expensive.
+ *
+ * The array is flushed whenever it is full and at the end of each block. As
+ * the detail structures (and the strings they refer to) are valid only
+ * during the flush which reports them, the array is also flushed right after
+ * any event having a detail. The texts point into the input document (or to
+ * static strings).
+ *
+ * If flush() returns non-zero, parsing is aborted and the value is returned
+ * as if returned by a callback. The events collected when the parsing fails
+ * or is aborted are not flushed.
+ *
+ * The array has to stay valid as long as the sink is set. Pass NULL events
+ * to get back to the callbacks of MD_PARSER. It must not be called between
+ * md_parser_begin() and md_parser_finish().
+ *
+ * Returns zero on success, or -1 when the arguments are invalid.
+ */
+#define MD_EVENT_ENTER_BLOCK    0
+#define MD_EVENT_LEAVE_BLOCK    1
+#define MD_EVENT_ENTER_SPAN     2
+#define MD_EVENT_LEAVE_SPAN     3
+#define MD_EVENT_TEXT           4
+
+typedef struct MD_EVENT {
+    unsigned char kind;     /* MD_EVENT_xxxx. */
+    unsigned char type;     /* MD_BLOCKTYPE, MD_SPANTYPE or MD_TEXTTYPE. */
+    MD_SIZE size;           /* For MD_EVENT_TEXT, size of the text. */
+
+    /* For MD_EVENT_TEXT, the text. Otherwise the detail (as passed to the
+     * respective callback, so it may be NULL). */
+    const void* data;
+} MD_EVENT;
+
+int md_parser_set_event_sink(MD_PARSER_HANDLE* handle, MD_EVENT* events, unsigned capacity,
+                             int (*flush)(const MD_EVENT* /*events*/, unsigned /*n_events*/, void* /*userdata*/));
+
+/* Release all the buffers kept in the handle. The handle stays usable.
+ */
+void md_parser_reset(MD_PARSER_HANDLE* handle);
+
+/* Destroy the handle.
+ */
+void md_parser_destroy(MD_PARSER_HANDLE* handle);
+
+
+/* Shared reference definitions.
+ *
+ * Applications which prepend or append the same (possibly large) set of link
+ * reference definitions to many documents may instead compile them once into
+ * a dictionary and pass it to the parser as MD_PARSER::ref_dict.
+ *
+ * md_ref_dict_create() collects all the link reference definitions in the
+ * given Markdown text (everything else in it is ignored), and the dictionary
+ * keeps its own copy of everything it needs. Only MD_PARSER::flags,
+ * ::debug_log (called with NULL userdata), ::allocator, ::alloc_flags and the
+ * resource limits are used; the allocator has to stay valid until
+ * md_ref_dict_free() is called.
+ *
+ * The dictionary is immutable, so it may be used by any number of parsers
+ * in any number of threads at the same time.
+ *
+ * Returns zero and sets *p_dict on success, or -1 (or MD_ERROR_LIMIT or
+ * MD_ERROR_CANCELLED) on failure.
+ */
+int md_ref_dict_create(const MD_CHAR* text, MD_SIZE size, const MD_PARSER* parser, MD_REF_DICT** p_dict);
+
+/* Release the dictionary.
+ */
+void md_ref_dict_free(MD_REF_DICT* dict);
+
+
+/* Document tree.
+ *
+ * md_parse_to_tree() records everything md_parse() would report through the
+ * callbacks into an array of nodes, so that an application which needs to
+ * walk the document several times does not have to parse it again, nor to
+ * build its own tree.
+ *
+ * The nodes are stored in the document order (the order in which md_parse()
+ * enters the blocks and spans or reports the texts), i.e. the root node
+ * (MD_BLOCK_DOC) is MD_TREE::nodes[0], and each node is followed by its
+ * descendants. Index zero also stands for "none" in MD_NODE::first_child and
+ * MD_NODE::next_sibling (the root can never be a child nor a sibling).
+ *
+ * The whole tree, including the detail structures and any strings they
+ * refer to, lives in a single arena allocated through MD_PARSER::allocator.
+ * The only exception are the texts (MD_NODE_TEXT) which point directly into
+ * the input document (or to static strings), so the input has to stay valid
+ * as long as the tree is used.
+ */
+#define MD_NODE_BLOCK       0
+#define MD_NODE_SPAN        1
+#define MD_NODE_TEXT        2
+
+/* Flags of MD_NODE::flags. */
+#define MD_NODE_HASRANGE    0x0001  /* MD_NODE::beg and ::end are valid. */
+
+typedef struct MD_NODE {
+    unsigned char kind;     /* MD_NODE_BLOCK, MD_NODE_SPAN or MD_NODE_TEXT. */
+    unsigned char type;     /* MD_BLOCKTYPE, MD_SPANTYPE or MD_TEXTTYPE. */
+    unsigned short flags;   /* Bitmask of MD_NODE_xxxx flags. */
+    unsigned first_child;   /* Index of the 1st child, or zero. */
+    unsigned next_sibling;  /* Index of the next sibling, or zero. */
+
+    /* Range of the input the node has been made of. For blocks and spans,
+     * this covers all the texts inside (so e.g. it does not include the
+     * list item mark, and a block with no text has no range at all). */
+    MD_OFFSET beg;
+    MD_OFFSET end;
+
+    /* For MD_NODE_TEXT, the text and its size. Otherwise the detail
+     * structure (NULL for types which have none). */
+    MD_SIZE size;
+    const void* data;
+} MD_NODE;
+
+typedef struct MD_TREE {
+    const MD_NODE* nodes;
+    unsigned n_nodes;
+    const MD_CHAR* text;    /* The input document. */
+    MD_SIZE size;
+} MD_TREE;
+
+/* Parse the document into a tree. Only MD_PARSER::flags, ::debug_log and the
+ * members added in later ABI versions (::allocator etc.) are used; the other
+ * callbacks are ignored.
+ * (The debug_log is called with NULL userdata, and the allocator has to stay
+ * valid until md_tree_free() is called.)
+ *
+ * Returns zero and sets *p_tree on success, or -1 (or MD_ERROR_LIMIT or
+ * MD_ERROR_CANCELLED) on failure.
+ */
+int md_parse_to_tree(const MD_CHAR* text, MD_SIZE size, const MD_PARSER* parser, MD_TREE** p_tree);
+
+/* Call the callbacks of the parser as md_parse() would have called them for
+ * the document the tree has been built from. (The detail is NULL for the
+ * types which have none.) Returns zero, or the non-zero value returned by a
+ * callback which has aborted the replay, or -1 if out of memory.
+ *
+ * Note the tree is always properly nested, even where md_parse() is not
+ * (in some corner cases, it may leave a span it has not entered, or not leave
+ * a span before leaving its block). The replay then does not report such
+ * a stray leave, and it leaves the unclosed span right before its parent.
+ * Also, the leave of each block or span gets the same detail as its enter
+ * (unlike md_parse(), which reports MD_BLOCK_UL_DETAIL::is_tight and
+ * MD_BLOCK_OL_DETAIL::is_tight of a loose list as set when leaving it).
+ */
+int md_tree_replay(const MD_TREE* tree, const MD_PARSER* parser, void* userdata);
+
+/* Release the tree.
+ */
+void md_tree_free(MD_TREE* tree);
+
+
+/* Event log.
+ *
+ * md_parse_to_event_log() records the callbacks md_parse() would call into a
+ * flat binary buffer. The buffer contains no pointers (the texts are recorded
+ * as offsets into the input document), so it can be stored, e.g. alongside a
+ * cache of the rendered output, and later loaded or memory-mapped back at any
+ * address (aligned at least to 4 bytes) and replayed into any MD_PARSER with
+ * md_event_log_replay(), together with the same input document.
+ *
+ * The log begins with a header holding MD_EVENT_LOG_VERSION. Logs recorded by
+ * a different version, or on a machine with different byte order or sizes of
+ * the basic types, are refused by md_event_log_replay().
+ */
+#define MD_EVENT_LOG_VERSION    1
+
+/* Parse the document and record the log. Only MD_PARSER::flags, ::debug_log
+ * and the members added in later ABI versions (::allocator etc.) are used;
+ * the other callbacks are ignored.
+ * (The debug_log is called with NULL userdata.)
+ *
+ * Returns zero and sets *p_log and *p_log_size on success, or -1 (or
+ * MD_ERROR_LIMIT or MD_ERROR_CANCELLED) on failure. The log is to be
+ * released with md_event_log_free().
+ */
+int md_parse_to_event_log(const MD_CHAR* text, MD_SIZE size, const MD_PARSER* parser,
+                          void** p_log, size_t* p_log_size);
+
+/* Return the version of the log (so the application can tell whether its
+ * stored logs are still usable), or zero if the buffer is not an event log
+ * recorded on a compatible machine.
+ */
+unsigned md_event_log_version(const void* log, size_t log_size);
+
+/* Call the callbacks of the parser as md_parse() would have called them for
+ * the document the log has been recorded from. The text and size must be the
+ * same document. Returns zero, or the non-zero value returned by a callback
+ * which has aborted the replay, or -1 if the log is malformed, does not match
+ * the document, or if out of memory.
+ *
+ * Like md_tree_replay(), the replay is always properly nested, and each leave
+ * gets the detail of its enter, even where md_parse() differs:
+ * md_parse_to_event_log() records the stray leaves and unclosed spans
+ * normalized the same way.
+ */
+int md_event_log_replay(const void* log, size_t log_size, const MD_CHAR* text, MD_SIZE size,
+                        const MD_PARSER* parser, void* userdata);
+
+/* Release the log returned by md_parse_to_event_log(). The parser has to use
+ * the same allocator as when the log has been recorded.
+ */
+void md_event_log_free(void* log, const MD_PARSER* parser);
+
 
 #ifdef __cplusplus
     }  /* extern "C" { */
@@ -0,0 +1,3111 @@
+/*
+ * MD4C: Markdown parser for C
+ * (http://github.com/mity/md4c)
+ *
+ * Copyright (c) 2016-2020 Martin Mitas
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/* Tests of the C API.
+ *
+ * Each test parses the documents (the built-in ones below, and the files
+ * given on the command line) through some API, and checks that the callbacks
+ * are called exactly the same way as by plain md_parse() (or that the output
+ * is the same as of plain md_html()). The callbacks are recorded into a DUMP,
+ * a textual description of all the callbacks and their arguments.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "md4c.h"
+#include "md4c-html.h"
+
+#ifdef _WIN32
+    #define snprintf _snprintf
+#endif
+
+
+#define SIZEOF_ARRAY(a)     (sizeof(a) / sizeof(a[0]))
+
+
+/*************************
+ ***  Checks & Report  ***
+ *************************/
+
+static unsigned n_passed = 0;
+static unsigned n_failed = 0;
+
+/* Description of the current test case for the failure reports. */
+static char current_case[256] = "";
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if(cond) {                                                          \
+            n_passed++;                                                     \
+        } else {                                                            \
+            n_failed++;                                                     \
+            fprintf(stderr, "%s:%d: %s: Check failed: %s\n",                \
+                    __FILE__, __LINE__, current_case, #cond);               \
+        }                                                                   \
+    } while(0)
+
+
+/*******************
+ ***  Documents  ***
+ *******************/
+
+typedef struct TEST_DOC {
+    const char* name;
+    const MD_CHAR* text;
+    MD_SIZE size;
+} TEST_DOC;
+
+static const char* builtin_docs[] = {
+    "",
+    "a",
+    "\n\n\n",
+    "# Title\n\nSome *emphasis*, **strong** and `code`.\n",
+    "Setext\n======\n\npara with [link](/url \"title\") and ![img](/a.png)\n",
+    "[foo]\n\n[foo]: /url\n[bar]: /bar 'Bar &amp; \\* title'\n\n[bar][] [baz]\n",
+    "<a href=\"&quot;x\">&copy; &#123; &#xAB; &bogus;</a>\n",
+    "- a\n- b\n\n  c\n- [ ] task\n- [x] done\n\n1. one\n2) two\n",
+    "> quote\n> > nested\n> - list in quote\n\nlazy\ncontinuation\n",
+    "```c++ info &amp;\ncode\n```\n\n    indented\n\n~~~\nunclosed fence\n",
+    "| a | b |\n|:--|:-:|\n| c | d |\n| e\n\ntext after table\n",
+    "<div>\nraw *html*\n</div>\n\n<!-- comment -->\n",
+    "www.example.com, https://example.org/path?x=1 and me@example.com.\n",
+    "~~strike~~ _under_ $math$ $$display$$ [[wiki|label]] @mention\n",
+    "line\r\nwith CRLF\r\n\r\n* item\r\n",
+    "trailing spaces  \nhard break\\\nbackslash break\n",
+    "no newline at the end",
+    "*a **b *c* d** e* ***f*** *g\n\nunclosed **strong\n",
+    "[x](/a&amp;b&lt;c&gt;d\\*e&quot;f&amp;g&amp;h&amp;i&amp;j&amp;k \"&amp;t\\\"\")\n",
+    "[A Rather Long Link Label][] and [another one]\n\n[a rather long\nlink label]: /long\n",
+
+    /* The parser does not nest these properly (with MD_DIALECT_GITHUB). */
+    "www.x.com|__|3__",
+    "a|b\n-|-\nwww..w|_/|_",
+    "a|b\n-|-\nwww..aw~/~",
+    "*.3@|[``a[](|w*[.-)_a]",
+    "|a|b\n|-|-\n|_.w@a_.w",
+};
+
+static char builtin_names[SIZEOF_ARRAY(builtin_docs)][16];
+
+static TEST_DOC* docs = NULL;
+static unsigned n_docs = 0;
+
+static void
+add_doc(const char* name, const MD_CHAR* text, MD_SIZE size)
+{
+    docs = (TEST_DOC*) realloc(docs, (n_docs + 1) * sizeof(TEST_DOC));
+    if(docs == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+
+    docs[n_docs].name = name;
+    docs[n_docs].text = text;
+    docs[n_docs].size = size;
+    n_docs++;
+}
+
+/* A document large enough for md_parser_set_thread_count() to really use
+ * several threads: All the built-in documents over and over. */
+static void
+add_large_doc(void)
+{
+    static const MD_SIZE min_size = 512 * 1024;
+    char* text = (char*) malloc(min_size + 4096);
+    MD_SIZE size = 0;
+    unsigned i = 0;
+
+    if(text == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+
+    while(size < min_size) {
+        MD_SIZE n = (MD_SIZE) strlen(builtin_docs[i]);
+
+        memcpy(text + size, builtin_docs[i], n);
+        memcpy(text + size + n, "\n\n", 2);
+        size += n + 2;
+        i = (i + 1) % SIZEOF_ARRAY(builtin_docs);
+    }
+
+    add_doc("#large", text, size);
+}
+
+static int
+load_doc(const char* path)
+{
+    FILE* in;
+    char* text = NULL;
+    size_t size = 0;
+    size_t alloc = 0;
+    size_t n;
+
+    in = fopen(path, "rb");
+    if(in == NULL) {
+        fprintf(stderr, "Cannot open %s.\n", path);
+        return -1;
+    }
+
+    do {
+        if(size + 4096 > alloc) {
+            alloc = alloc * 2 + 4096;
+            text = (char*) realloc(text, alloc);
+            if(text == NULL) {
+                fprintf(stderr, "Out of memory.\n");
+                fclose(in);
+                return -1;
+            }
+        }
+        n = fread(text + size, 1, alloc - size, in);
+        size += n;
+    } while(n > 0);
+
+    fclose(in);
+    add_doc(path, text, (MD_SIZE) size);
+    return 0;
+}
+
+
+/********************************
+ ***  Recording of Callbacks  ***
+ ********************************/
+
+/* (Negative, as md_parse() ignores a positive value returned by some of
+ * the callbacks.) */
+#define ABORT_VALUE     (-42)
+
+/* Block or span entered and not left yet (see DUMP::normalize). */
+typedef struct DUMP_OPEN {
+    int is_span;
+    unsigned type;
+    size_t beg;         /* The enter line in DUMP::data. */
+    size_t end;
+} DUMP_OPEN;
+
+typedef struct DUMP {
+    char* data;
+    size_t size;
+    size_t alloc;
+
+    unsigned n_events;
+    size_t text_size;   /* Of all the text passed to the text() callback. */
+    unsigned n_entity_texts;    /* Recorded text(MD_TEXT_ENTITY) calls. */
+    unsigned n_entity_calls;    /* Calls of MD_PARSER::entity. */
+    unsigned abort_at;  /* If non-zero, the abort_at-th callback returns abort_value. */
+    int abort_value;
+    int omit_offsets;   /* Do not record MD_BLOCK_LI_DETAIL::task_mark_offset. */
+    unsigned cancel_at; /* If non-zero, the cancel_at-th callback sets *cancel. */
+    volatile int* cancel;
+
+    /* Where the blocks at the nesting level top_level end. (With top_level
+     * zero, these are the top-level blocks reported by md_parser_reparse().) */
+    int top_level;
+    int level;
+    size_t* block_ends;
+    unsigned n_blocks;
+    unsigned alloc_blocks;
+
+    /* If set, record the callbacks properly nested, as md_tree_replay()
+     * reports them: A leave of a block or span (but a span not past a block)
+     * implicitly leaves whatever has been entered in it and not left, and
+     * a leave matching nothing is not recorded. Leaves are recorded with the
+     * detail of their enter. */
+    int normalize;
+    DUMP_OPEN* open;
+    unsigned n_open;
+    unsigned alloc_open;
+} DUMP;
+
+static void
+dump_init(DUMP* dump)
+{
+    memset(dump, 0, sizeof(DUMP));
+    dump->abort_value = ABORT_VALUE;
+}
+
+static void
+dump_fini(DUMP* dump)
+{
+    free(dump->data);
+    free(dump->block_ends);
+    free(dump->open);
+}
+
+static void
+dump_append(DUMP* dump, const char* str, size_t size)
+{
+    if(size == 0)
+        return;
+
+    if(dump->size + size > dump->alloc) {
+        dump->alloc = (dump->size + size) * 2 + 256;
+        dump->data = (char*) realloc(dump->data, dump->alloc);
+        if(dump->data == NULL) {
+            fprintf(stderr, "Out of memory.\n");
+            exit(1);
+        }
+    }
+
+    memcpy(dump->data + dump->size, str, size);
+    dump->size += size;
+}
+
+static void
+dump_block_end_at(DUMP* dump, size_t end)
+{
+    if(dump->n_blocks >= dump->alloc_blocks) {
+        dump->alloc_blocks = dump->alloc_blocks * 2 + 16;
+        dump->block_ends = (size_t*) realloc(dump->block_ends, dump->alloc_blocks * sizeof(size_t));
+        if(dump->block_ends == NULL) {
+            fprintf(stderr, "Out of memory.\n");
+            exit(1);
+        }
+    }
+
+    dump->block_ends[dump->n_blocks++] = end;
+}
+
+static void
+dump_str(DUMP* dump, const char* str)
+{
+    dump_append(dump, str, strlen(str));
+}
+
+static void
+dump_uint(DUMP* dump, unsigned value)
+{
+    char buf[16];
+
+    snprintf(buf, sizeof(buf), " %u", value);
+    dump_str(dump, buf);
+}
+
+static void
+dump_attribute(DUMP* dump, const MD_ATTRIBUTE* attr)
+{
+    unsigned i;
+
+    dump_str(dump, " [");
+    if(attr->text != NULL)
+        dump_append(dump, attr->text, attr->size);
+    dump_str(dump, "]");
+
+    /* (Indented code blocks have the attributes of MD_BLOCK_CODE_DETAIL
+     * all zeroed.) */
+    if(attr->substr_offsets == NULL)
+        return;
+
+    for(i = 0; attr->substr_offsets[i] < attr->size; i++) {
+        dump_uint(dump, attr->substr_types[i]);
+        dump_uint(dump, attr->substr_offsets[i]);
+    }
+}
+
+static void
+dump_block_detail(DUMP* dump, MD_BLOCKTYPE type, const void* detail)
+{
+    switch(type) {
+        case MD_BLOCK_UL:
+        {
+            const MD_BLOCK_UL_DETAIL* det = (const MD_BLOCK_UL_DETAIL*) detail;
+            dump_uint(dump, (unsigned) det->is_tight);
+            dump_uint(dump, (unsigned) det->mark);
+            break;
+        }
+
+        case MD_BLOCK_OL:
+        {
+            const MD_BLOCK_OL_DETAIL* det = (const MD_BLOCK_OL_DETAIL*) detail;
+            dump_uint(dump, det->start);
+            dump_uint(dump, (unsigned) det->is_tight);
+            dump_uint(dump, (unsigned) det->mark_delimiter);
+            break;
+        }
+
+        case MD_BLOCK_LI:
+        {
+            const MD_BLOCK_LI_DETAIL* det = (const MD_BLOCK_LI_DETAIL*) detail;
+            dump_uint(dump, (unsigned) det->is_task);
+            if(det->is_task) {
+                dump_uint(dump, (unsigned) det->task_mark);
+                if(!dump->omit_offsets)
+                    dump_uint(dump, det->task_mark_offset);
+            }
+            break;
+        }
+
+        case MD_BLOCK_H:
+            dump_uint(dump, ((const MD_BLOCK_H_DETAIL*) detail)->level);
+            break;
+
+        case MD_BLOCK_CODE:
+        {
+            const MD_BLOCK_CODE_DETAIL* det = (const MD_BLOCK_CODE_DETAIL*) detail;
+            dump_attribute(dump, &det->info);
+            dump_attribute(dump, &det->lang);
+            dump_uint(dump, (unsigned) det->fence_char);
+            break;
+        }
+
+        case MD_BLOCK_TABLE:
+        {
+            const MD_BLOCK_TABLE_DETAIL* det = (const MD_BLOCK_TABLE_DETAIL*) detail;
+            dump_uint(dump, det->col_count);
+            dump_uint(dump, det->head_row_count);
+            dump_uint(dump, det->body_row_count);
+            break;
+        }
+
+        case MD_BLOCK_TH:
+        case MD_BLOCK_TD:
+            dump_uint(dump, (unsigned) ((const MD_BLOCK_TD_DETAIL*) detail)->align);
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void
+dump_span_detail(DUMP* dump, MD_SPANTYPE type, const void* detail)
+{
+    switch(type) {
+        case MD_SPAN_A:
+        {
+            const MD_SPAN_A_DETAIL* det = (const MD_SPAN_A_DETAIL*) detail;
+            dump_attribute(dump, &det->href);
+            dump_attribute(dump, &det->title);
+            break;
+        }
+
+        case MD_SPAN_IMG:
+        {
+            const MD_SPAN_IMG_DETAIL* det = (const MD_SPAN_IMG_DETAIL*) detail;
+            dump_attribute(dump, &det->src);
+            dump_attribute(dump, &det->title);
+            break;
+        }
+
+        case MD_SPAN_WIKILINK:
+            dump_attribute(dump, &((const MD_SPAN_WIKILINK_DETAIL*) detail)->target);
+            break;
+
+        case MD_SPAN_MENTION:
+        {
+            const MD_SPAN_MENTION_DETAIL* det = (const MD_SPAN_MENTION_DETAIL*) detail;
+            dump_str(dump, " [");
+            dump_append(dump, det->text, det->size);
+            dump_str(dump, "]");
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+static void
+dump_push_open(DUMP* dump, int is_span, unsigned type, size_t beg)
+{
+    if(dump->n_open >= dump->alloc_open) {
+        dump->alloc_open = dump->alloc_open * 2 + 16;
+        dump->open = (DUMP_OPEN*) realloc(dump->open, dump->alloc_open * sizeof(DUMP_OPEN));
+        if(dump->open == NULL) {
+            fprintf(stderr, "Out of memory.\n");
+            exit(1);
+        }
+    }
+
+    dump->open[dump->n_open].is_span = is_span;
+    dump->open[dump->n_open].type = type;
+    dump->open[dump->n_open].beg = beg;
+    dump->open[dump->n_open].end = dump->size;
+    dump->n_open++;
+}
+
+/* With DUMP::normalize, find the block or span the leave matches, and record
+ * its leave together with the implicit leaves of all entered in it. */
+static void
+dump_pop_open(DUMP* dump, int is_span, unsigned type)
+{
+    unsigned i = dump->n_open;
+
+    while(i > 0) {
+        const DUMP_OPEN* open = &dump->open[i-1];
+
+        if(open->is_span == is_span  &&  open->type == type)
+            break;
+        if(is_span  &&  !open->is_span)
+            return;
+        i--;
+    }
+    if(i == 0)
+        return;
+
+    while(dump->n_open >= i) {
+        const DUMP_OPEN* open = &dump->open[--dump->n_open];
+        size_t size = open->end - open->beg - 5;
+        char* rest;
+
+        /* The leave looks like the enter, except for the name. (The enter is
+         * copied first, as dump_append() may move dump->data.) This also
+         * gives the leave the detail of the enter, as md_tree_replay() does,
+         * while md_parse() may report MD_BLOCK_UL_DETAIL::is_tight and
+         * MD_BLOCK_OL_DETAIL::is_tight of a loose list differently on the
+         * leave. */
+        rest = (char*) malloc(size);
+        if(rest == NULL) {
+            fprintf(stderr, "Out of memory.\n");
+            exit(1);
+        }
+        memcpy(rest, dump->data + open->beg + 5, size);
+        dump_str(dump, "leave");
+        dump_append(dump, rest, size);
+        free(rest);
+        if(!open->is_span) {
+            dump->level--;
+            if(dump->level == dump->top_level)
+                dump_block_end_at(dump, dump->size);
+        }
+    }
+}
+
+static int
+dump_event(DUMP* dump)
+{
+    dump->n_events++;
+    if(dump->n_events == dump->cancel_at  &&  dump->cancel != NULL)
+        *dump->cancel = 1;
+    return (dump->n_events == dump->abort_at ? dump->abort_value : 0);
+}
+
+static int
+dump_enter_block(MD_BLOCKTYPE type, void* detail, void* userdata)
+{
+    DUMP* dump = (DUMP*) userdata;
+    size_t beg = dump->size;
+
+    dump_str(dump, "enter_block");
+    dump_uint(dump, (unsigned) type);
+    dump_block_detail(dump, type, detail);
+    dump_str(dump, "\n");
+    dump->level++;
+    if(dump->normalize)
+        dump_push_open(dump, 0, (unsigned) type, beg);
+    return dump_event(dump);
+}
+
+static int
+dump_leave_block(MD_BLOCKTYPE type, void* detail, void* userdata)
+{
+    DUMP* dump = (DUMP*) userdata;
+
+    if(dump->normalize) {
+        dump_pop_open(dump, 0, (unsigned) type);
+        return dump_event(dump);
+    }
+
+    dump_str(dump, "leave_block");
+    dump_uint(dump, (unsigned) type);
+    dump_block_detail(dump, type, detail);
+    dump_str(dump, "\n");
+    dump->level--;
+    if(dump->level == dump->top_level)
+        dump_block_end_at(dump, dump->size);
+    return dump_event(dump);
+}
+
+static int
+dump_enter_span(MD_SPANTYPE type, void* detail, void* userdata)
+{
+    DUMP* dump = (DUMP*) userdata;
+    size_t beg = dump->size;
+
+    dump_str(dump, "enter_span");
+    dump_uint(dump, (unsigned) type);
+    dump_span_detail(dump, type, detail);
+    dump_str(dump, "\n");
+    if(dump->normalize)
+        dump_push_open(dump, 1, (unsigned) type, beg);
+    return dump_event(dump);
+}
+
+static int
+dump_leave_span(MD_SPANTYPE type, void* detail, void* userdata)
+{
+    DUMP* dump = (DUMP*) userdata;
+
+    if(dump->normalize) {
+        dump_pop_open(dump, 1, (unsigned) type);
+        return dump_event(dump);
+    }
+
+    dump_str(dump, "leave_span");
+    dump_uint(dump, (unsigned) type);
+    dump_span_detail(dump, type, detail);
+    dump_str(dump, "\n");
+    return dump_event(dump);
+}
+
+static int
+dump_text(MD_TEXTTYPE type, const MD_CHAR* text, MD_SIZE size, void* userdata)
+{
+    DUMP* dump = (DUMP*) userdata;
+
+    dump_str(dump, "text");
+    dump_uint(dump, (unsigned) type);
+    dump_str(dump, " [");
+    dump_append(dump, text, size);
+    dump_str(dump, "]\n");
+    dump->text_size += size;
+    if(type == MD_TEXT_ENTITY)
+        dump->n_entity_texts++;
+    return dump_event(dump);
+}
+
+/* Recorded as text(MD_TEXT_ENTITY), so the dump compares with one made
+ * without MD_PARSER::entity. */
+static int
+dump_entity(const MD_CHAR* text, MD_SIZE size, const MD_ENTITY_DETAIL* detail, void* userdata)
+{
+    DUMP* dump = (DUMP*) userdata;
+    MD_ENTITY_DETAIL decoded;
+
+    CHECK(md_decode_entity(text, size, &decoded) == 0);
+    CHECK(memcmp(detail, &decoded, sizeof(MD_ENTITY_DETAIL)) == 0);
+    dump->n_entity_calls++;
+    return dump_text(MD_TEXT_ENTITY, text, size, dump);
+}
+
+static void
+init_parser(MD_PARSER* parser, unsigned flags)
+{
+    memset(parser, 0, sizeof(MD_PARSER));
+    parser->abi_version = MD_PARSER_ABI_VERSION;
+    parser->flags = flags;
+    parser->enter_block = dump_enter_block;
+    parser->leave_block = dump_leave_block;
+    parser->enter_span = dump_enter_span;
+    parser->leave_span = dump_leave_span;
+    parser->text = dump_text;
+}
+
+static int
+dump_contains(const DUMP* dump, const char* str)
+{
+    size_t n = strlen(str);
+    size_t off;
+
+    for(off = 0; off + n <= dump->size; off++) {
+        if(memcmp(dump->data + off, str, n) == 0)
+            return 1;
+    }
+    return 0;
+}
+
+/* Check the dump is the same as the reference one (made by md_parse()). */
+static void
+check_dump(const DUMP* ref, const DUMP* dump, const char* what)
+{
+    size_t off = 0;
+
+    if(dump->size == ref->size  &&  (ref->size == 0  ||  memcmp(dump->data, ref->data, ref->size) == 0)) {
+        n_passed++;
+        return;
+    }
+
+    while(off < dump->size  &&  off < ref->size  &&  dump->data[off] == ref->data[off])
+        off++;
+    while(off > 0  &&  ref->data[off-1] != '\n')
+        off--;
+
+    n_failed++;
+    fprintf(stderr, "%s: %s: Callbacks differ from md_parse() at line:\n", current_case, what);
+    fprintf(stderr, "    expected: %.*s\n", (int) strcspn(ref->data + off, "\n"), ref->data + off);
+    fprintf(stderr, "    got:      %.*s\n", (int) strcspn(dump->data + off, "\n"), dump->data + off);
+}
+
+
+/***************************
+ ***  Failing Allocator  ***
+ ***************************/
+
+/* MD_ALLOCATOR which fails the fail_at-th call (if non-zero), and which
+ * checks that only what has been allocated through it is freed (and only
+ * once). */
+typedef struct TEST_BLOCK {
+    void* ptr;
+    size_t size;
+} TEST_BLOCK;
+
+typedef struct TEST_ALLOCATOR {
+    MD_ALLOCATOR allocator;
+    unsigned n_calls;
+    unsigned fail_at;
+
+    TEST_BLOCK* live;       /* Blocks allocated and not freed yet. */
+    unsigned n_live;
+    unsigned alloc_live;
+    unsigned n_bad_frees;
+
+    size_t n_live_bytes;
+    size_t peak_bytes;
+} TEST_ALLOCATOR;
+
+static int
+test_allocator_should_fail(TEST_ALLOCATOR* ta)
+{
+    ta->n_calls++;
+    return (ta->n_calls == ta->fail_at);
+}
+
+static void
+test_allocator_add(TEST_ALLOCATOR* ta, void* ptr, size_t size)
+{
+    if(ta->n_live >= ta->alloc_live) {
+        ta->alloc_live = ta->alloc_live * 2 + 64;
+        ta->live = (TEST_BLOCK*) realloc(ta->live, ta->alloc_live * sizeof(TEST_BLOCK));
+        if(ta->live == NULL) {
+            fprintf(stderr, "Out of memory.\n");
+            exit(1);
+        }
+    }
+    ta->live[ta->n_live].ptr = ptr;
+    ta->live[ta->n_live].size = size;
+    ta->n_live++;
+
+    ta->n_live_bytes += size;
+    if(ta->n_live_bytes > ta->peak_bytes)
+        ta->peak_bytes = ta->n_live_bytes;
+}
+
+/* Returns the size of the block, or (size_t) -1 if it is not live. */
+static size_t
+test_allocator_remove(TEST_ALLOCATOR* ta, void* ptr)
+{
+    size_t size;
+    unsigned i;
+
+    for(i = ta->n_live; i > 0; i--) {
+        if(ta->live[i-1].ptr == ptr) {
+            size = ta->live[i-1].size;
+            ta->live[i-1] = ta->live[--ta->n_live];
+            ta->n_live_bytes -= size;
+            return size;
+        }
+    }
+
+    ta->n_bad_frees++;
+    return (size_t) -1;
+}
+
+static void*
+test_malloc(size_t size, void* userdata)
+{
+    TEST_ALLOCATOR* ta = (TEST_ALLOCATOR*) userdata;
+    void* ptr;
+
+    if(test_allocator_should_fail(ta))
+        return NULL;
+    ptr = malloc(size > 0 ? size : 1);
+    if(ptr != NULL)
+        test_allocator_add(ta, ptr, size);
+    return ptr;
+}
+
+static void*
+test_realloc(void* ptr, size_t size, void* userdata)
+{
+    TEST_ALLOCATOR* ta = (TEST_ALLOCATOR*) userdata;
+    void* new_ptr;
+    size_t old_size;
+
+    if(ptr == NULL)
+        return test_malloc(size, userdata);
+    if(test_allocator_should_fail(ta))
+        return NULL;
+    old_size = test_allocator_remove(ta, ptr);
+    if(old_size == (size_t) -1)
+        return NULL;
+    new_ptr = realloc(ptr, size > 0 ? size : 1);
+    if(new_ptr != NULL)
+        test_allocator_add(ta, new_ptr, size);
+    else
+        test_allocator_add(ta, ptr, old_size);
+    return new_ptr;
+}
+
+static void
+test_free(void* ptr, void* userdata)
+{
+    TEST_ALLOCATOR* ta = (TEST_ALLOCATOR*) userdata;
+
+    if(ptr != NULL  &&  test_allocator_remove(ta, ptr) != (size_t) -1)
+        free(ptr);
+}
+
+static void
+test_allocator_init(TEST_ALLOCATOR* ta, unsigned fail_at)
+{
+    memset(ta, 0, sizeof(TEST_ALLOCATOR));
+    ta->allocator.malloc_fn = test_malloc;
+    ta->allocator.realloc_fn = test_realloc;
+    ta->allocator.free_fn = test_free;
+    ta->allocator.userdata = ta;
+    ta->fail_at = fail_at;
+}
+
+/* Check everything has been freed exactly once. */
+static void
+test_allocator_fini(TEST_ALLOCATOR* ta)
+{
+    unsigned i;
+
+    CHECK(ta->n_live == 0);
+    CHECK(ta->n_bad_frees == 0);
+    for(i = 0; i < ta->n_live; i++)
+        free(ta->live[i].ptr);
+    free(ta->live);
+}
+
+/* md4c-html has no MD_ALLOCATOR, so to fail its allocations, we replace
+ * malloc() & co. for the whole process. glibc supports that (see "Replacing
+ * malloc" in its manual). (But the sanitizers replace them too.) */
+#if defined __has_feature
+    #if __has_feature(address_sanitizer)  ||  __has_feature(memory_sanitizer)  ||  __has_feature(thread_sanitizer)
+        #define TEST_NO_MALLOC_HOOKS    1
+    #endif
+#endif
+#if defined __SANITIZE_ADDRESS__  ||  defined __SANITIZE_THREAD__
+    #define TEST_NO_MALLOC_HOOKS        1
+#endif
+#if defined __GLIBC__  &&  !defined TEST_NO_MALLOC_HOOKS
+    #define TEST_MALLOC_HOOKS           1
+#endif
+
+#ifdef TEST_MALLOC_HOOKS
+
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t n, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void __libc_free(void* ptr);
+
+/* Only while malloc_hooked is set, the calls are counted, the malloc_fail_at-th
+ * one fails, and malloc_live counts the blocks allocated and not freed. */
+static int malloc_hooked = 0;
+static unsigned malloc_calls;
+static unsigned malloc_fail_at;
+static long malloc_live;
+
+static void
+malloc_hooks_begin(unsigned fail_at)
+{
+    malloc_calls = 0;
+    malloc_fail_at = fail_at;
+    malloc_live = 0;
+    malloc_hooked = 1;
+}
+
+static void
+malloc_hooks_end(void)
+{
+    malloc_hooked = 0;
+}
+
+static int
+malloc_should_fail(void)
+{
+    if(!malloc_hooked)
+        return 0;
+    malloc_calls++;
+    return (malloc_calls == malloc_fail_at);
+}
+
+void*
+malloc(size_t size)
+{
+    void* ptr;
+
+    if(malloc_should_fail())
+        return NULL;
+    ptr = __libc_malloc(size);
+    if(malloc_hooked  &&  ptr != NULL)
+        malloc_live++;
+    return ptr;
+}
+
+void*
+calloc(size_t n, size_t size)
+{
+    void* ptr;
+
+    if(malloc_should_fail())
+        return NULL;
+    ptr = __libc_calloc(n, size);
+    if(malloc_hooked  &&  ptr != NULL)
+        malloc_live++;
+    return ptr;
+}
+
+void*
+realloc(void* ptr, size_t size)
+{
+    void* new_ptr;
+
+    if(malloc_should_fail())
+        return NULL;
+    new_ptr = __libc_realloc(ptr, size);
+    if(malloc_hooked) {
+        if(ptr == NULL  &&  new_ptr != NULL)
+            malloc_live++;
+        else if(ptr != NULL  &&  new_ptr == NULL  &&  size == 0)
+            malloc_live--;
+    }
+    return new_ptr;
+}
+
+void
+free(void* ptr)
+{
+    if(malloc_hooked  &&  ptr != NULL)
+        malloc_live--;
+    __libc_free(ptr);
+}
+
+#endif  /* TEST_MALLOC_HOOKS */
+
+
+/*********************
+ ***  Test Runner  ***
+ *********************/
+
+static const unsigned test_flags[] = {
+    MD_DIALECT_COMMONMARK,
+    MD_DIALECT_GITHUB,
+    MD_DIALECT_GITHUB | MD_FLAG_LATEXMATHSPANS | MD_FLAG_WIKILINKS | MD_FLAG_UNDERLINE | MD_FLAG_MENTIONS,
+    MD_DIALECT_GITHUB | MD_FLAG_NOREFDEFS
+};
+
+typedef void (*TEST_FUNC)(const TEST_DOC* /*doc*/, unsigned /*flags*/, const DUMP* /*ref*/);
+
+/* Call the test for each document with each of the test_flags, together with
+ * the dump of the reference md_parse(). */
+static void
+run_test(const char* name, TEST_FUNC test)
+{
+    unsigned i, j;
+
+    printf("%s\n", name);
+    for(i = 0; i < n_docs; i++) {
+        for(j = 0; j < SIZEOF_ARRAY(test_flags); j++) {
+            MD_PARSER parser;
+            DUMP ref;
+
+            init_parser(&parser, test_flags[j]);
+            dump_init(&ref);
+            if(md_parse(docs[i].text, docs[i].size, &parser, &ref) == 0) {
+                snprintf(current_case, sizeof(current_case), "%s: document %s, flags 0x%x",
+                         name, docs[i].name, test_flags[j]);
+                test(&docs[i], test_flags[j], &ref);
+            } else {
+                /* The parser may have been built with MD4C_FIXED_FLAGS. */
+            }
+            dump_fini(&ref);
+        }
+    }
+}
+
+
+/**************************
+ ***  MD_PARSER_HANDLE  ***
+ **************************/
+
+static void
+test_handle(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    DUMP dump;
+    int i;
+
+    init_parser(&parser, flags);
+    handle = md_parser_create(&parser);
+    CHECK(handle != NULL);
+    if(handle == NULL)
+        return;
+
+    /* Parse the document several times, with the buffers kept from the
+     * previous run, after they are trimmed, and after they are released. */
+    for(i = 0; i < 4; i++) {
+        if(i == 2)
+            md_parser_set_trim_threshold(handle, 0);
+        if(i == 3)
+            md_parser_reset(handle);
+
+        dump_init(&dump);
+        CHECK(md_parser_parse(handle, doc->text, doc->size, &dump) == 0);
+        check_dump(ref, &dump, "md_parser_parse()");
+        dump_fini(&dump);
+    }
+
+    /* Abort from a callback. */
+    dump_init(&dump);
+    dump.abort_at = 1 + ref->n_events / 2;
+    CHECK(md_parser_parse(handle, doc->text, doc->size, &dump) == ABORT_VALUE);
+    CHECK(dump.n_events == dump.abort_at);
+    dump_fini(&dump);
+
+    /* Any non-zero value aborts when entering MD_BLOCK_DOC. */
+    dump_init(&dump);
+    dump.abort_at = 1;
+    dump.abort_value = 1;
+    CHECK(md_parser_parse(handle, doc->text, doc->size, &dump) == 1);
+    CHECK(dump.n_events == 1);
+    dump_fini(&dump);
+
+    md_parser_destroy(handle);
+}
+
+
+/***********************
+ ***  Chunked Input  ***
+ ***********************/
+
+static int
+feed_in_chunks(MD_PARSER_HANDLE* handle, const TEST_DOC* doc, MD_SIZE chunk_size, void* userdata)
+{
+    MD_SIZE off = 0;
+    int ret;
+
+    ret = md_parser_begin(handle, userdata);
+    while(ret == 0  &&  off < doc->size) {
+        MD_SIZE n = (doc->size - off < chunk_size ? doc->size - off : chunk_size);
+
+        ret = md_parser_feed(handle, doc->text + off, n);
+        off += n;
+
+        /* Empty chunks are fine too. */
+        if(ret == 0)
+            ret = md_parser_feed(handle, doc->text + off, 0);
+    }
+
+    if(ret == 0)
+        return md_parser_finish(handle);
+
+    /* Further feeding after an error just returns the error again, and so
+     * does md_parser_finish(). */
+    CHECK(md_parser_feed(handle, doc->text, doc->size) == ret);
+    CHECK(md_parser_finish(handle) == ret);
+    return ret;
+}
+
+static void
+test_stream(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    static const MD_SIZE chunk_sizes[] = { 1, 2, 17, 4096 };
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    DUMP dump;
+    char what[64];
+    unsigned i;
+
+    init_parser(&parser, flags);
+    handle = md_parser_create(&parser);
+    CHECK(handle != NULL);
+    if(handle == NULL)
+        return;
+
+    for(i = 0; i < SIZEOF_ARRAY(chunk_sizes); i++) {
+        snprintf(what, sizeof(what), "md_parser_feed() by %u bytes", (unsigned) chunk_sizes[i]);
+        dump_init(&dump);
+        CHECK(feed_in_chunks(handle, doc, chunk_sizes[i], &dump) == 0);
+        check_dump(ref, &dump, what);
+        dump_fini(&dump);
+
+        /* Abort from a callback: md_parser_begin() (entering MD_BLOCK_DOC),
+         * md_parser_feed() or md_parser_finish() has to return what the
+         * callback has returned, and no further callback may be called. */
+        dump_init(&dump);
+        dump.abort_at = 1 + (i * 13) % ref->n_events;
+        CHECK(feed_in_chunks(handle, doc, chunk_sizes[i], &dump) == ABORT_VALUE);
+        CHECK(dump.n_events == dump.abort_at);
+        dump_fini(&dump);
+    }
+
+    /* The handle is still usable for normal parsing. */
+    dump_init(&dump);
+    CHECK(md_parser_parse(handle, doc->text, doc->size, &dump) == 0);
+    check_dump(ref, &dump, "md_parser_parse() after md_parser_finish()");
+    dump_fini(&dump);
+
+    md_parser_destroy(handle);
+}
+
+
+/*****************************
+ ***  Incremental Reparse  ***
+ *****************************/
+
+/* The edits applied one after another to each document. Each one replaces
+ * old_size bytes at pos_permille of the current document with new_text. */
+static const struct {
+    unsigned pos_permille;
+    MD_SIZE old_size;
+    const char* new_text;
+} test_edits[] = {
+    { 500, 0, "x" },
+    { 0, 0, "# " },
+    { 1000, 0, "\n\npara *emph*" },
+    { 250, 1, "" },
+    { 750, 2, "*" },
+    { 500, 0, "\n\n" },
+    { 100, 3, "- a\n" },
+    { 900, 0, "\n[foo]: /x\n" },
+    { 300, 6, "```\n" },
+    { 0, 1000000, "" },
+    { 0, 0, "> quote\n\n| a |\n|---|\n" }
+};
+
+/* Replace the top-level blocks [first, first + n_old) of the preview with
+ * the ones reported by md_parser_reparse() in the dump. */
+static void
+update_preview(DUMP* preview, unsigned first, unsigned n_old, const DUMP* dump)
+{
+    DUMP result;
+    size_t beg = (first > 0 ? preview->block_ends[first-1] : 0);
+    size_t end = (n_old > 0 ? preview->block_ends[first + n_old - 1] : beg);
+    unsigned i;
+
+    dump_init(&result);
+    dump_append(&result, preview->data, beg);
+    for(i = 0; i < first; i++)
+        dump_block_end_at(&result, preview->block_ends[i]);
+    dump_append(&result, dump->data, dump->size);
+    for(i = 0; i < dump->n_blocks; i++)
+        dump_block_end_at(&result, beg + dump->block_ends[i]);
+    dump_append(&result, preview->data + end, preview->size - end);
+    for(i = first + n_old; i < preview->n_blocks; i++)
+        dump_block_end_at(&result, preview->block_ends[i] - end + beg + dump->size);
+
+    dump_fini(preview);
+    *preview = result;
+}
+
+/* Check the preview is the same as the reference dump (of md_parse()) apart
+ * from the enter and leave of MD_BLOCK_DOC. */
+static void
+check_preview(const DUMP* ref, const DUMP* preview, const char* what)
+{
+    DUMP ref_blocks;
+    size_t beg = strcspn(ref->data, "\n") + 1;
+    size_t end = ref->size - 1;
+
+    while(end > 0  &&  ref->data[end-1] != '\n')
+        end--;
+
+    dump_init(&ref_blocks);
+    dump_append(&ref_blocks, ref->data + beg, end - beg);
+    check_dump(&ref_blocks, preview, what);
+    dump_fini(&ref_blocks);
+}
+
+static void
+test_reparse(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    MD_REPARSE_INFO info;
+    MD_EDIT edit;
+    DUMP preview;
+    DUMP dump;
+    DUMP new_ref;
+    char what[64];
+    MD_CHAR* text;
+    MD_SIZE size;
+    unsigned i;
+
+    init_parser(&parser, flags);
+    handle = md_parser_create(&parser);
+    CHECK(handle != NULL);
+    if(handle == NULL)
+        return;
+
+    /* (The text passed to the previous call need not stay valid, so each
+     * edit makes a new copy and frees the old one.) */
+    size = doc->size;
+    text = (MD_CHAR*) malloc(size + 1);
+    if(text == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+    memcpy(text, doc->text, size);
+
+    /* The first call parses the whole document. */
+    dump_init(&preview);
+    CHECK(md_parser_reparse(handle, text, size, NULL, &info, &preview) == 0);
+    CHECK(info.is_full);
+    CHECK(info.first_block == 0);
+    CHECK(info.n_old_blocks == 0);
+    CHECK(info.n_new_blocks == preview.n_blocks);
+    check_preview(ref, &preview, "md_parser_reparse() of the whole document");
+    dump_fini(&preview);
+
+    /* Again, with no edit. This time without the task mark offsets: They are
+     * not updated in the blocks kept after an edit. */
+    dump_init(&preview);
+    preview.omit_offsets = 1;
+    CHECK(md_parser_reparse(handle, text, size, NULL, &info, &preview) == 0);
+    CHECK(info.is_full);
+    CHECK(info.n_new_blocks == preview.n_blocks);
+
+    for(i = 0; i < SIZEOF_ARRAY(test_edits); i++) {
+        MD_SIZE new_size = (MD_SIZE) strlen(test_edits[i].new_text);
+        MD_CHAR* new_text;
+
+        edit.beg = (MD_OFFSET) (size * test_edits[i].pos_permille / 1000);
+        edit.old_size = test_edits[i].old_size;
+        if(edit.old_size > size - edit.beg)
+            edit.old_size = size - edit.beg;
+        edit.new_size = new_size;
+
+        new_text = (MD_CHAR*) malloc(size - edit.old_size + new_size + 1);
+        if(new_text == NULL) {
+            fprintf(stderr, "Out of memory.\n");
+            exit(1);
+        }
+        memcpy(new_text, text, edit.beg);
+        memcpy(new_text + edit.beg, test_edits[i].new_text, new_size);
+        memcpy(new_text + edit.beg + new_size, text + edit.beg + edit.old_size,
+               size - edit.beg - edit.old_size);
+        free(text);
+        text = new_text;
+        size = size - edit.old_size + new_size;
+
+        dump_init(&dump);
+        dump.omit_offsets = 1;
+        CHECK(md_parser_reparse(handle, text, size, &edit, &info, &dump) == 0);
+        CHECK(info.n_new_blocks == dump.n_blocks);
+        CHECK(info.first_block + info.n_old_blocks <= preview.n_blocks);
+        if(info.is_full) {
+            CHECK(info.first_block == 0);
+            CHECK(info.n_old_blocks == preview.n_blocks);
+        }
+        if(info.first_block + info.n_old_blocks <= preview.n_blocks)
+            update_preview(&preview, info.first_block, info.n_old_blocks, &dump);
+        dump_fini(&dump);
+
+        init_parser(&parser, flags);
+        dump_init(&new_ref);
+        new_ref.omit_offsets = 1;
+        CHECK(md_parse(text, size, &parser, &new_ref) == 0);
+        snprintf(what, sizeof(what), "md_parser_reparse() after edit #%u", i);
+        check_preview(&new_ref, &preview, what);
+        dump_fini(&new_ref);
+    }
+
+    /* Any other use of the handle makes the next call parse it all again. */
+    dump_init(&dump);
+    CHECK(md_parser_parse(handle, text, size, &dump) == 0);
+    dump_fini(&dump);
+    edit.beg = 0;
+    edit.old_size = 0;
+    edit.new_size = 0;
+    dump_init(&dump);
+    CHECK(md_parser_reparse(handle, text, size, &edit, &info, &dump) == 0);
+    CHECK(info.is_full);
+    CHECK(info.n_new_blocks == dump.n_blocks);
+    dump_fini(&dump);
+
+    /* An edit which does not match the document too. */
+    edit.beg = size + 1;
+    dump_init(&dump);
+    CHECK(md_parser_reparse(handle, text, size, &edit, &info, &dump) == 0);
+    CHECK(info.is_full);
+    dump_fini(&dump);
+
+    dump_fini(&preview);
+    free(text);
+    md_parser_destroy(handle);
+}
+
+/* Repeated edits do not make the handle grow, with MD_ALLOC_ARENA neither. */
+static void
+test_reparse_memory(void)
+{
+    static const char text_a[] = "para [l&amp;x](/u&amp;v \"t&amp;i\") end\n";
+    static const char text_b[] = "para [l&amp;x](/u&amp;v \"t&amp;i\") eend\n";
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    MD_REPARSE_INFO info;
+    MD_EDIT edit;
+    TEST_ALLOCATOR ta;
+    DUMP dump;
+    size_t warm_bytes = 0;
+    unsigned alloc_flags;
+    unsigned i;
+
+    printf("md_parser_reparse() memory\n");
+    for(alloc_flags = 0; alloc_flags <= MD_ALLOC_ARENA; alloc_flags += MD_ALLOC_ARENA) {
+        snprintf(current_case, sizeof(current_case), "md_parser_reparse() memory, alloc_flags 0x%x", alloc_flags);
+        init_parser(&parser, 0);
+        test_allocator_init(&ta, 0);
+        parser.allocator = &ta.allocator;
+        parser.alloc_flags = alloc_flags;
+        handle = md_parser_create(&parser);
+        if(handle == NULL) {
+            /* The parser may have been built with MD4C_FIXED_FLAGS. */
+            test_allocator_fini(&ta);
+            return;
+        }
+
+        dump_init(&dump);
+        CHECK(md_parser_reparse(handle, text_a, (MD_SIZE) strlen(text_a), NULL, &info, &dump) == 0);
+        dump_fini(&dump);
+
+        /* Insert and remove an 'e' over and over. */
+        edit.beg = (MD_OFFSET) (strstr(text_a, "end") - text_a);
+        for(i = 0; i < 1000; i++) {
+            const char* text = (i % 2 == 0 ? text_b : text_a);
+
+            edit.old_size = (i % 2 == 0 ? 0 : 1);
+            edit.new_size = (i % 2 == 0 ? 1 : 0);
+            dump_init(&dump);
+            CHECK(md_parser_reparse(handle, text, (MD_SIZE) strlen(text), &edit, &info, &dump) == 0);
+            CHECK(!info.is_full);
+            dump_fini(&dump);
+
+            if(i == 9)
+                warm_bytes = ta.n_live_bytes;
+        }
+        CHECK(ta.n_live_bytes <= warm_bytes);
+
+        /* Other uses of the handle in between are fine too. */
+        dump_init(&dump);
+        CHECK(md_parser_parse(handle, text_a, (MD_SIZE) strlen(text_a), &dump) == 0);
+        CHECK(md_parser_reparse(handle, text_a, (MD_SIZE) strlen(text_a), NULL, &info, &dump) == 0);
+        CHECK(md_parser_parse(handle, text_a, (MD_SIZE) strlen(text_a), &dump) == 0);
+        dump_fini(&dump);
+
+        md_parser_destroy(handle);
+        test_allocator_fini(&ta);
+    }
+}
+
+
+/*****************
+ ***  Threads  ***
+ *****************/
+
+static void
+test_threads(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    static const unsigned thread_counts[] = { 2, 3, 8, 1000, 1, 0 };
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    DUMP dump;
+    char what[64];
+    unsigned i;
+    int ret;
+
+    init_parser(&parser, flags);
+    handle = md_parser_create(&parser);
+    CHECK(handle != NULL);
+    if(handle == NULL)
+        return;
+
+    for(i = 0; i < SIZEOF_ARRAY(thread_counts); i++) {
+        /* (Without threads (MD4C_NO_THREADS), more than one is refused.) */
+        ret = md_parser_set_thread_count(handle, thread_counts[i]);
+        CHECK(ret == 0  ||  (ret == -1  &&  thread_counts[i] > 1));
+        if(ret != 0)
+            continue;
+
+        snprintf(what, sizeof(what), "md_parser_parse() with %u threads", thread_counts[i]);
+        dump_init(&dump);
+        CHECK(md_parser_parse(handle, doc->text, doc->size, &dump) == 0);
+        check_dump(ref, &dump, what);
+        dump_fini(&dump);
+
+        snprintf(what, sizeof(what), "md_parser_feed() with %u threads", thread_counts[i]);
+        dump_init(&dump);
+        CHECK(feed_in_chunks(handle, doc, 4096, &dump) == 0);
+        check_dump(ref, &dump, what);
+        dump_fini(&dump);
+
+        /* Abort from a callback after the workers are done. */
+        dump_init(&dump);
+        dump.abort_at = 1 + ref->n_events / 2;
+        CHECK(md_parser_parse(handle, doc->text, doc->size, &dump) == ABORT_VALUE);
+        CHECK(dump.n_events == dump.abort_at);
+        dump_fini(&dump);
+    }
+
+    md_parser_destroy(handle);
+}
+
+
+/***********************
+ ***  Document Tree  ***
+ ***********************/
+
+/* Check the tree links all the nodes properly in the document order. */
+static void
+check_tree_structure(const MD_TREE* tree)
+{
+    unsigned* parents;
+    unsigned i, child;
+    int ok = 1;
+
+    CHECK(tree->n_nodes > 0);
+    if(tree->n_nodes == 0)
+        return;
+    CHECK(tree->nodes[0].kind == MD_NODE_BLOCK  &&  tree->nodes[0].type == MD_BLOCK_DOC);
+
+    /* Each node but the root is a child of exactly one node preceding it. */
+    parents = (unsigned*) calloc(tree->n_nodes, sizeof(unsigned));
+    if(parents == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+    for(i = 0; i < tree->n_nodes; i++) {
+        const MD_NODE* node = &tree->nodes[i];
+
+        if(node->kind == MD_NODE_TEXT  &&  node->first_child != 0)
+            ok = 0;
+        for(child = node->first_child; child != 0; child = tree->nodes[child].next_sibling) {
+            if(child <= i  ||  child >= tree->n_nodes  ||  parents[child] != 0) {
+                ok = 0;
+                break;
+            }
+            parents[child] = i + 1;
+        }
+    }
+    for(i = 1; i < tree->n_nodes; i++) {
+        if(parents[i] == 0)
+            ok = 0;
+    }
+    free(parents);
+    CHECK(ok);
+}
+
+static void
+test_tree(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    MD_PARSER parser;
+    MD_TREE* tree;
+    DUMP normalized_ref;
+    DUMP dump;
+
+    init_parser(&parser, flags);
+    CHECK(md_parse_to_tree(doc->text, doc->size, &parser, &tree) == 0);
+    if(tree == NULL)
+        return;
+    check_tree_structure(tree);
+    CHECK(tree->text == doc->text);
+    CHECK(tree->size == doc->size);
+
+    /* The replay matches md_parse(), once it is properly nested. */
+    dump_init(&normalized_ref);
+    normalized_ref.normalize = 1;
+    CHECK(md_parse(doc->text, doc->size, &parser, &normalized_ref) == 0);
+    dump_init(&dump);
+    CHECK(md_tree_replay(tree, &parser, &dump) == 0);
+    check_dump(&normalized_ref, &dump, "md_tree_replay()");
+    dump_fini(&dump);
+
+    /* Again (the replay does not change the tree). */
+    dump_init(&dump);
+    CHECK(md_tree_replay(tree, &parser, &dump) == 0);
+    check_dump(&normalized_ref, &dump, "md_tree_replay() again");
+    dump_fini(&dump);
+
+    /* Abort from a callback. */
+    dump_init(&dump);
+    dump.abort_at = 1 + ref->n_events / 2;
+    CHECK(md_tree_replay(tree, &parser, &dump) == ABORT_VALUE);
+    CHECK(dump.n_events == dump.abort_at);
+    dump_fini(&dump);
+
+    dump_fini(&normalized_ref);
+    md_tree_free(tree);
+}
+
+
+/*******************
+ ***  Event Log  ***
+ *******************/
+
+static void
+test_event_log(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    MD_PARSER parser;
+    DUMP normalized_ref;
+    DUMP dump;
+    void* log;
+    void* log_copy;
+    size_t log_size;
+
+    init_parser(&parser, flags);
+    CHECK(md_parse_to_event_log(doc->text, doc->size, &parser, &log, &log_size) == 0);
+    if(log == NULL)
+        return;
+    CHECK(md_event_log_version(log, log_size) == MD_EVENT_LOG_VERSION);
+
+    /* Every log recorded replays as md_parse() (normalized as the tree). */
+    dump_init(&normalized_ref);
+    normalized_ref.normalize = 1;
+    CHECK(md_parse(doc->text, doc->size, &parser, &normalized_ref) == 0);
+    dump_init(&dump);
+    CHECK(md_event_log_replay(log, log_size, doc->text, doc->size, &parser, &dump) == 0);
+    check_dump(&normalized_ref, &dump, "md_event_log_replay()");
+    dump_fini(&dump);
+
+    /* The log holds no pointers, so it works from anywhere. */
+    log_copy = malloc(log_size);
+    if(log_copy == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+    memcpy(log_copy, log, log_size);
+    md_event_log_free(log, &parser);
+    dump_init(&dump);
+    CHECK(md_event_log_replay(log_copy, log_size, doc->text, doc->size, &parser, &dump) == 0);
+    check_dump(&normalized_ref, &dump, "md_event_log_replay() of a copy");
+    dump_fini(&dump);
+
+    /* Abort from a callback. */
+    dump_init(&dump);
+    dump.abort_at = 1 + ref->n_events / 2;
+    CHECK(md_event_log_replay(log_copy, log_size, doc->text, doc->size, &parser, &dump) == ABORT_VALUE);
+    CHECK(dump.n_events == dump.abort_at);
+    dump_fini(&dump);
+
+    /* A log not matching the document, or truncated, is refused. */
+    dump_init(&dump);
+    CHECK(md_event_log_replay(log_copy, log_size, doc->text, doc->size + 1, &parser, &dump) == -1);
+    CHECK(dump.n_events == 0);
+    CHECK(md_event_log_replay(log_copy, log_size - sizeof(unsigned), doc->text, doc->size, &parser, &dump) == -1);
+    CHECK(md_event_log_version(log_copy, 2 * sizeof(unsigned)) == 0);
+    dump_fini(&dump);
+
+    dump_fini(&normalized_ref);
+    free(log_copy);
+}
+
+/* A log corrupted within an attribute, or recorded with unknown flags, is
+ * refused (and nothing out of the attribute's text is passed on). */
+static void
+test_event_log_corrupted(void)
+{
+    static const char text[] = "[a](/u&amp;v)\n";
+    /* n, the types, and the offsets of the href "/u&amp;v". */
+    static const unsigned href_substrs[] = { 3, MD_TEXT_NORMAL, MD_TEXT_ENTITY, MD_TEXT_NORMAL, 0, 2, 7, 8 };
+    static const struct {
+        unsigned index;     /* Into href_substrs[]. */
+        unsigned value;
+    } corruptions[] = {
+        { 4, 1 },                   /* offsets[0] != 0 */
+        { 5, 8 }, { 6, 1 },         /* decreasing offsets */
+        { 6, 100 },                 /* offset beyond the size */
+        { 7, 9 },                   /* offsets[n] != size */
+        { 2, 1000 },                /* unknown type */
+    };
+    MD_PARSER parser;
+    DUMP dump;
+    void* log;
+    unsigned* words;
+    size_t log_size;
+    size_t n_words;
+    size_t pos;
+    unsigned i;
+
+    printf("md_event_log_replay() of a corrupted log\n");
+    snprintf(current_case, sizeof(current_case), "md_event_log_replay() of a corrupted log");
+    init_parser(&parser, 0);
+    if(md_parse_to_event_log(text, (MD_SIZE) strlen(text), &parser, &log, &log_size) != 0) {
+        /* The parser may have been built with MD4C_FIXED_FLAGS. */
+        return;
+    }
+    words = (unsigned*) log;
+    n_words = log_size / sizeof(unsigned);
+
+    for(pos = 0; pos + SIZEOF_ARRAY(href_substrs) <= n_words; pos++) {
+        if(memcmp(&words[pos], href_substrs, sizeof(href_substrs)) == 0)
+            break;
+    }
+    CHECK(pos + SIZEOF_ARRAY(href_substrs) <= n_words);
+    if(pos + SIZEOF_ARRAY(href_substrs) <= n_words) {
+        for(i = 0; i < SIZEOF_ARRAY(corruptions); i++) {
+            unsigned saved = words[pos + corruptions[i].index];
+
+            words[pos + corruptions[i].index] = corruptions[i].value;
+            dump_init(&dump);
+            CHECK(md_event_log_replay(log, log_size, text, (MD_SIZE) strlen(text), &parser, &dump) == -1);
+            CHECK(!dump_contains(&dump, "/u&amp;v"));
+            dump_fini(&dump);
+            words[pos + corruptions[i].index] = saved;
+        }
+    }
+
+    /* Unknown flags in the header. */
+    words[5] |= 0x80000000U;
+    CHECK(md_event_log_version(log, log_size) == 0);
+    dump_init(&dump);
+    CHECK(md_event_log_replay(log, log_size, text, (MD_SIZE) strlen(text), &parser, &dump) == -1);
+    CHECK(dump.n_events == 0);
+    dump_fini(&dump);
+    words[5] &= ~0x80000000U;
+
+    dump_init(&dump);
+    CHECK(md_event_log_replay(log, log_size, text, (MD_SIZE) strlen(text), &parser, &dump) == 0);
+    CHECK(dump_contains(&dump, "/u&amp;v"));
+    dump_fini(&dump);
+
+    md_event_log_free(log, &parser);
+}
+
+
+/********************
+ ***  Event Sink  ***
+ ********************/
+
+typedef struct SINK {
+    DUMP* dump;
+    unsigned capacity;
+    unsigned n_flushes;
+    int bad_batch;      /* Set if a batch has been flushed when it should not. */
+} SINK;
+
+/* Replay the events into the DUMP callbacks. */
+static int
+sink_flush(const MD_EVENT* events, unsigned n_events, void* userdata)
+{
+    SINK* sink = (SINK*) userdata;
+    unsigned i;
+    int ret = 0;
+
+    sink->n_flushes++;
+    if(n_events == 0  ||  n_events > sink->capacity)
+        sink->bad_batch = 1;
+
+    for(i = 0; i < n_events  &&  ret == 0; i++) {
+        const MD_EVENT* ev = &events[i];
+
+        /* The details are valid only during the flush reporting them. */
+        if(ev->kind != MD_EVENT_TEXT  &&  ev->data != NULL  &&  i + 1 < n_events)
+            sink->bad_batch = 1;
+
+        switch(ev->kind) {
+            case MD_EVENT_ENTER_BLOCK:
+                ret = dump_enter_block((MD_BLOCKTYPE) ev->type, (void*) ev->data, sink->dump);
+                break;
+            case MD_EVENT_LEAVE_BLOCK:
+                ret = dump_leave_block((MD_BLOCKTYPE) ev->type, (void*) ev->data, sink->dump);
+                break;
+            case MD_EVENT_ENTER_SPAN:
+                ret = dump_enter_span((MD_SPANTYPE) ev->type, (void*) ev->data, sink->dump);
+                break;
+            case MD_EVENT_LEAVE_SPAN:
+                ret = dump_leave_span((MD_SPANTYPE) ev->type, (void*) ev->data, sink->dump);
+                break;
+            case MD_EVENT_TEXT:
+                ret = dump_text((MD_TEXTTYPE) ev->type, (const MD_CHAR*) ev->data, ev->size, sink->dump);
+                break;
+            default:
+                sink->bad_batch = 1;
+                break;
+        }
+    }
+
+    return ret;
+}
+
+static void
+test_event_sink(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    static const unsigned capacities[] = { 1, 2, 17, 1024 };
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    MD_EVENT* events;
+    SINK sink;
+    DUMP dump;
+    char what[64];
+    unsigned i;
+
+    init_parser(&parser, flags);
+    handle = md_parser_create(&parser);
+    CHECK(handle != NULL);
+    if(handle == NULL)
+        return;
+    events = (MD_EVENT*) malloc(1024 * sizeof(MD_EVENT));
+    if(events == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+
+    for(i = 0; i < SIZEOF_ARRAY(capacities); i++) {
+        CHECK(md_parser_set_event_sink(handle, events, capacities[i], sink_flush) == 0);
+
+        snprintf(what, sizeof(what), "event sink of %u events", capacities[i]);
+        memset(&sink, 0, sizeof(SINK));
+        sink.dump = &dump;
+        sink.capacity = capacities[i];
+        dump_init(&dump);
+        CHECK(md_parser_parse(handle, doc->text, doc->size, &sink) == 0);
+        check_dump(ref, &dump, what);
+        CHECK(!sink.bad_batch);
+        CHECK(sink.n_flushes <= ref->n_events);
+        dump_fini(&dump);
+
+        snprintf(what, sizeof(what), "event sink of %u events, md_parser_feed()", capacities[i]);
+        memset(&sink, 0, sizeof(SINK));
+        sink.dump = &dump;
+        sink.capacity = capacities[i];
+        dump_init(&dump);
+        CHECK(feed_in_chunks(handle, doc, 17, &sink) == 0);
+        check_dump(ref, &dump, what);
+        CHECK(!sink.bad_batch);
+        dump_fini(&dump);
+
+        /* Abort from the flush: No event after the aborting one is seen. */
+        memset(&sink, 0, sizeof(SINK));
+        sink.dump = &dump;
+        sink.capacity = capacities[i];
+        dump_init(&dump);
+        dump.abort_at = 1 + ref->n_events / 2;
+        CHECK(md_parser_parse(handle, doc->text, doc->size, &sink) == ABORT_VALUE);
+        CHECK(dump.n_events == dump.abort_at);
+        dump_fini(&dump);
+    }
+
+    /* Invalid arguments are refused (and the callbacks are used again). */
+    CHECK(md_parser_set_event_sink(handle, events, 0, sink_flush) == -1);
+    CHECK(md_parser_set_event_sink(handle, events, 16, NULL) == -1);
+    dump_init(&dump);
+    CHECK(md_parser_parse(handle, doc->text, doc->size, &dump) == 0);
+    check_dump(ref, &dump, "callbacks after invalid md_parser_set_event_sink()");
+    dump_fini(&dump);
+
+    /* Back to the callbacks. */
+    CHECK(md_parser_set_event_sink(handle, events, 16, sink_flush) == 0);
+    CHECK(md_parser_set_event_sink(handle, NULL, 0, NULL) == 0);
+    dump_init(&dump);
+    CHECK(md_parser_parse(handle, doc->text, doc->size, &dump) == 0);
+    check_dump(ref, &dump, "callbacks after md_parser_set_event_sink(NULL)");
+    dump_fini(&dump);
+
+    md_parser_destroy(handle);
+    free(events);
+}
+
+
+/**************************************
+ ***  Shared Reference Definitions  ***
+ **************************************/
+
+/* Definitions no document refers to: The dictionary must change nothing. */
+static const char unused_dict_defs[] =
+    "[md4c dict a]: /dict-a\n"
+    "[md4c dict b]: <> 'B'\n";
+
+static void
+test_unused_ref_dict(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    MD_REF_DICT* dict;
+    DUMP dump;
+
+    init_parser(&parser, flags);
+    CHECK(md_ref_dict_create(unused_dict_defs, (MD_SIZE) strlen(unused_dict_defs), &parser, &dict) == 0);
+    if(dict == NULL)
+        return;
+    parser.ref_dict = dict;
+
+    dump_init(&dump);
+    CHECK(md_parse(doc->text, doc->size, &parser, &dump) == 0);
+    check_dump(ref, &dump, "md_parse() with MD_PARSER::ref_dict");
+    dump_fini(&dump);
+
+    handle = md_parser_create(&parser);
+    CHECK(handle != NULL);
+    if(handle != NULL) {
+        dump_init(&dump);
+        CHECK(feed_in_chunks(handle, doc, 17, &dump) == 0);
+        check_dump(ref, &dump, "md_parser_feed() with MD_PARSER::ref_dict");
+        dump_fini(&dump);
+        md_parser_destroy(handle);
+    }
+
+    md_ref_dict_free(dict);
+}
+
+/* Documents using a dictionary, and equivalent documents with the same
+ * definitions inline (if NULL, the definitions appended to the document). */
+static const struct {
+    const char* dict_defs;
+    const char* doc;
+    const char* equivalent;
+} ref_dict_cases[] = {
+    { "[foo]: /dict 'Title'\n",
+      "[foo], [foo][] and [Foo][foo]\n", NULL },
+    /* The document's own definitions take precedence. */
+    { "[foo]: /dict\n",
+      "[foo] [bar]\n\n[foo]: /doc\n", "[foo] [bar]\n\n[foo]: /doc\n" },
+    { "[foo]: /dict\n[bar]: /dict-bar\n",
+      "[foo] [bar]\n\n[foo]: /doc\n", "[foo] [bar]\n\n[foo]: /doc\n[bar]: /dict-bar\n" },
+    /* The first definition in the dictionary wins. */
+    { "[a]: /first\n[A]: /second\n",
+      "[a]\n", "[a]\n\n[a]: /first\n" },
+    /* Labels are matched case-insensitively, with whitespace collapsed. */
+    { "[\xe1\xba\x9e Foo  Bar]: /x\n",
+      "[ss foo\nbar] and ![SS FOO BAR]\n", NULL },
+    /* Only the definitions count. */
+    { "not a def\n\n    [b]: /indented\n[c]:\n/c\n",
+      "[b] [c]\n", "[b] [c]\n\n[c]:\n/c\n" },
+};
+
+static void
+test_ref_dict_case(unsigned i, unsigned flags)
+{
+    const char* dict_defs = ref_dict_cases[i].dict_defs;
+    const char* doc = ref_dict_cases[i].doc;
+    char equivalent[256];
+    MD_PARSER parser;
+    MD_REF_DICT* dict;
+    DUMP ref;
+    DUMP dump;
+
+    snprintf(current_case, sizeof(current_case), "MD_PARSER::ref_dict: case #%u, flags 0x%x", i, flags);
+    if(ref_dict_cases[i].equivalent != NULL)
+        snprintf(equivalent, sizeof(equivalent), "%s", ref_dict_cases[i].equivalent);
+    else
+        snprintf(equivalent, sizeof(equivalent), "%s\n%s", doc, dict_defs);
+
+    init_parser(&parser, flags);
+    dump_init(&ref);
+    if(md_parse(equivalent, (MD_SIZE) strlen(equivalent), &parser, &ref) != 0) {
+        /* The parser may have been built with MD4C_FIXED_FLAGS. */
+        dump_fini(&ref);
+        return;
+    }
+
+    CHECK(md_ref_dict_create(dict_defs, (MD_SIZE) strlen(dict_defs), &parser, &dict) == 0);
+    if(dict != NULL) {
+        parser.ref_dict = dict;
+        dump_init(&dump);
+        CHECK(md_parse(doc, (MD_SIZE) strlen(doc), &parser, &dump) == 0);
+        check_dump(&ref, &dump, "md_parse() with MD_PARSER::ref_dict");
+        dump_fini(&dump);
+        md_ref_dict_free(dict);
+    }
+
+    dump_fini(&ref);
+}
+
+/* With MD_FLAG_NOREFDEFS, only the dictionary is used. */
+static void
+test_ref_dict_norefdefs(void)
+{
+    static const char dict_defs[] = "[foo]: /dict\n";
+    static const char doc_text[] = "[foo]\n\n[foo]: /doc\n\n[foo]\n";
+    TEST_DOC doc;
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    MD_REF_DICT* dict;
+    DUMP ref;
+    DUMP dump;
+
+    snprintf(current_case, sizeof(current_case), "MD_PARSER::ref_dict with MD_FLAG_NOREFDEFS");
+    doc.name = "";
+    doc.text = doc_text;
+    doc.size = (MD_SIZE) strlen(doc_text);
+    init_parser(&parser, MD_FLAG_NOREFDEFS);
+    dump_init(&ref);
+    if(md_parse(doc.text, doc.size, &parser, &ref) != 0) {
+        /* The parser may have been built with MD4C_FIXED_FLAGS. */
+        dump_fini(&ref);
+        return;
+    }
+    dump_fini(&ref);
+
+    CHECK(md_ref_dict_create(dict_defs, (MD_SIZE) strlen(dict_defs), &parser, &dict) == 0);
+    if(dict == NULL)
+        return;
+    parser.ref_dict = dict;
+
+    dump_init(&ref);
+    if(md_parse(doc.text, doc.size, &parser, &ref) == 0) {
+        CHECK(dump_contains(&ref, "enter_span 2 [/dict]"));
+        CHECK(!dump_contains(&ref, "[/doc]"));
+
+        /* The blocks reported as they end resolve the links too. */
+        handle = md_parser_create(&parser);
+        CHECK(handle != NULL);
+        if(handle != NULL) {
+            dump_init(&dump);
+            CHECK(feed_in_chunks(handle, &doc, 1, &dump) == 0);
+            check_dump(&ref, &dump, "md_parser_feed() with MD_PARSER::ref_dict");
+            dump_fini(&dump);
+            md_parser_destroy(handle);
+        }
+    }
+    dump_fini(&ref);
+
+    md_ref_dict_free(dict);
+}
+
+static void
+test_ref_dict(void)
+{
+    unsigned i, j;
+
+    printf("MD_PARSER::ref_dict\n");
+    for(i = 0; i < SIZEOF_ARRAY(ref_dict_cases); i++) {
+        for(j = 0; j < SIZEOF_ARRAY(test_flags); j++) {
+            /* (The document's own definitions would be ignored.) */
+            if(!(test_flags[j] & MD_FLAG_NOREFDEFS))
+                test_ref_dict_case(i, test_flags[j]);
+        }
+    }
+    test_ref_dict_norefdefs();
+}
+
+/* Count the allocations made when parsing the given number of reference
+ * links with a long label. */
+static unsigned
+count_ref_lookup_allocations(unsigned n_links)
+{
+    static const char def[] = "[a rather long link label]: /long\n\n";
+    static const char link[] = "[A Rather Long Link Label] ";
+    MD_PARSER parser;
+    TEST_ALLOCATOR ta;
+    DUMP dump;
+    char* text;
+    size_t size;
+    unsigned n_calls = 0;
+    unsigned i;
+
+    size = strlen(def) + n_links * strlen(link);
+    text = (char*) malloc(size + 1);
+    if(text == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+    strcpy(text, def);
+    for(i = 0; i < n_links; i++)
+        strcat(text, link);
+
+    init_parser(&parser, 0);
+    test_allocator_init(&ta, 0);
+    parser.allocator = &ta.allocator;
+    dump_init(&dump);
+    if(md_parse(text, (MD_SIZE) size, &parser, &dump) == 0) {
+        CHECK(dump_contains(&dump, "[/long]"));
+        n_calls = ta.n_calls;
+    }
+    dump_fini(&dump);
+    test_allocator_fini(&ta);
+    free(text);
+    return n_calls;
+}
+
+/* Looking up a label too long for a small buffer does not allocate each time. */
+static void
+test_ref_lookup_allocations(void)
+{
+    unsigned n_few;
+    unsigned n_many;
+
+    printf("Reference link lookups\n");
+    snprintf(current_case, sizeof(current_case), "Reference link lookups");
+    n_few = count_ref_lookup_allocations(10);
+    n_many = count_ref_lookup_allocations(1000);
+    CHECK(n_many < n_few + 100);
+}
+
+
+/**************************
+ ***  Parsing Statistics  ***
+ **************************/
+
+/* Count the lines as the parser does: Each ends with "\n", "\r\n" or "\r",
+ * or with the end of the document. */
+static unsigned
+count_lines(const TEST_DOC* doc)
+{
+    unsigned n = 0;
+    MD_SIZE off;
+
+    for(off = 0; off < doc->size; off++) {
+        if(doc->text[off] == '\r'  &&  off + 1 < doc->size  &&  doc->text[off+1] == '\n')
+            off++;
+        if(doc->text[off] == '\r'  ||  doc->text[off] == '\n')
+            n++;
+    }
+    if(doc->size > 0  &&  doc->text[doc->size-1] != '\r'  &&  doc->text[doc->size-1] != '\n')
+        n++;
+    return n;
+}
+
+#define CHECK_STAT(ref, stats, member, what)                                \
+    do {                                                                    \
+        if((stats)->member == (ref)->member) {                              \
+            n_passed++;                                                     \
+        } else {                                                            \
+            n_failed++;                                                     \
+            fprintf(stderr, "%s: %s: MD_PARSE_STATS::%s is %lu, expected %lu.\n", \
+                    current_case, (what), #member,                          \
+                    (unsigned long) (stats)->member, (unsigned long) (ref)->member); \
+        }                                                                   \
+    } while(0)
+
+/* Check the counts are the same as gathered by md_parse(). (The times and
+ * the buffer sizes depend on the API.) */
+static void
+check_stats_counts(const MD_PARSE_STATS* ref, const MD_PARSE_STATS* stats, const char* what)
+{
+    CHECK_STAT(ref, stats, line_analysis_size, what);
+    CHECK_STAT(ref, stats, ref_def_size, what);
+    CHECK_STAT(ref, stats, mark_collection_size, what);
+    CHECK_STAT(ref, stats, emission_size, what);
+    CHECK_STAT(ref, stats, n_lines, what);
+    CHECK_STAT(ref, stats, n_blocks, what);
+    CHECK_STAT(ref, stats, n_marks, what);
+    CHECK_STAT(ref, stats, n_rollbacks, what);
+    CHECK_STAT(ref, stats, n_ref_defs, what);
+    CHECK_STAT(ref, stats, n_ref_def_lookups, what);
+}
+
+/* Check the peak sizes of the work buffers are the same as with md_parse(),
+ * whatever the buffers kept by a handle from the previous documents. */
+static void
+check_stats_buffers(const MD_PARSE_STATS* ref, const MD_PARSE_STATS* stats, const char* what)
+{
+    CHECK_STAT(ref, stats, block_buffer_size, what);
+    CHECK_STAT(ref, stats, container_buffer_size, what);
+    CHECK_STAT(ref, stats, mark_buffer_size, what);
+    CHECK_STAT(ref, stats, aux_buffer_size, what);
+    CHECK_STAT(ref, stats, ref_def_buffer_size, what);
+}
+
+/* Check the stats are filled in at all. (They are set to garbage before the
+ * parsing; and NaN fails any comparison.) */
+static void
+check_stats_times(const MD_PARSE_STATS* stats)
+{
+    CHECK(stats->line_analysis_time >= 0.0);
+    CHECK(stats->ref_def_time >= 0.0);
+    CHECK(stats->mark_collection_time >= 0.0);
+    CHECK(stats->mark_resolution_time >= 0.0);
+    CHECK(stats->emission_time >= 0.0);
+}
+
+static void
+test_stats(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    MD_PARSE_STATS ref_stats;
+    MD_PARSE_STATS stats;
+    DUMP dump;
+    char* text;
+    int i;
+
+    init_parser(&parser, flags);
+    parser.stats = &ref_stats;
+
+    /* Asking for the stats changes nothing else. */
+    memset(&ref_stats, 0xff, sizeof(MD_PARSE_STATS));
+    dump_init(&dump);
+    CHECK(md_parse(doc->text, doc->size, &parser, &dump) == 0);
+    check_dump(ref, &dump, "md_parse() with MD_PARSER::stats");
+    dump_fini(&dump);
+
+    check_stats_times(&ref_stats);
+    CHECK(ref_stats.line_analysis_size == doc->size);
+    CHECK(ref_stats.n_lines == count_lines(doc));
+    CHECK(ref_stats.emission_size == ref->text_size);
+    CHECK(ref_stats.ref_def_size <= doc->size);
+    CHECK(ref_stats.mark_collection_size <= doc->size);
+    CHECK(ref_stats.n_rollbacks <= ref_stats.n_marks);
+    if(flags & MD_FLAG_NOREFDEFS)
+        CHECK(ref_stats.n_ref_defs == 0);
+    if(ref_stats.n_blocks > 0)
+        CHECK(ref_stats.block_buffer_size > 0);
+    if(ref_stats.n_marks > 0)
+        CHECK(ref_stats.mark_buffer_size > 0);
+
+    parser.stats = &stats;
+    handle = md_parser_create(&parser);
+    CHECK(handle != NULL);
+    if(handle == NULL)
+        return;
+
+    /* The stats are of the last document only, not accumulated over the
+     * documents parsed by the handle. */
+    for(i = 0; i < 2; i++) {
+        memset(&stats, 0xff, sizeof(MD_PARSE_STATS));
+        dump_init(&dump);
+        CHECK(md_parser_parse(handle, doc->text, doc->size, &dump) == 0);
+        dump_fini(&dump);
+        check_stats_times(&stats);
+        check_stats_counts(&ref_stats, &stats, "md_parser_parse()");
+        check_stats_buffers(&ref_stats, &stats, "md_parser_parse()");
+    }
+
+    /* Nor do they include the buffers grown for a larger document before. */
+    text = (char*) malloc(4 * doc->size + 1);
+    CHECK(text != NULL);
+    if(text != NULL) {
+        for(i = 0; i < 4; i++)
+            memcpy(text + i * doc->size, doc->text, doc->size);
+        dump_init(&dump);
+        CHECK(md_parser_parse(handle, text, 4 * doc->size, &dump) == 0);
+        dump_fini(&dump);
+        free(text);
+
+        memset(&stats, 0xff, sizeof(MD_PARSE_STATS));
+        dump_init(&dump);
+        CHECK(md_parser_parse(handle, doc->text, doc->size, &dump) == 0);
+        dump_fini(&dump);
+        check_stats_buffers(&ref_stats, &stats, "md_parser_parse() after a larger document");
+    }
+
+    memset(&stats, 0xff, sizeof(MD_PARSE_STATS));
+    dump_init(&dump);
+    CHECK(feed_in_chunks(handle, doc, 17, &dump) == 0);
+    dump_fini(&dump);
+    check_stats_times(&stats);
+    check_stats_counts(&ref_stats, &stats, "md_parser_feed() by 17 bytes");
+    check_stats_buffers(&ref_stats, &stats, "md_parser_feed() by 17 bytes");
+
+    if(md_parser_set_thread_count(handle, 3) == 0) {
+        memset(&stats, 0xff, sizeof(MD_PARSE_STATS));
+        dump_init(&dump);
+        CHECK(md_parser_parse(handle, doc->text, doc->size, &dump) == 0);
+        dump_fini(&dump);
+        check_stats_times(&stats);
+        check_stats_counts(&ref_stats, &stats, "md_parser_parse() with 3 threads");
+        if(stats.n_marks > 0)
+            CHECK(stats.mark_buffer_size > 0);
+        md_parser_set_thread_count(handle, 1);
+    }
+
+    /* The stats are filled in even if the parsing is aborted, and count
+     * only what has been done until then. */
+    memset(&stats, 0xff, sizeof(MD_PARSE_STATS));
+    dump_init(&dump);
+    dump.abort_at = 1 + ref->n_events / 2;
+    CHECK(md_parser_parse(handle, doc->text, doc->size, &dump) == ABORT_VALUE);
+    check_stats_times(&stats);
+    CHECK(stats.emission_size >= dump.text_size);
+    CHECK(stats.emission_size <= ref_stats.emission_size);
+    CHECK(stats.n_lines <= ref_stats.n_lines);
+    CHECK(stats.n_blocks <= ref_stats.n_blocks);
+    dump_fini(&dump);
+
+    md_parser_destroy(handle);
+}
+
+
+/*************************
+ ***  Resource Limits  ***
+ *************************/
+
+/* Documents hitting the limits, and what the dump has to contain. */
+static const struct {
+    const char* doc;
+    unsigned max_marks;
+    unsigned max_nesting;
+    unsigned max_ref_defs;
+    const char* expected;
+} limit_cases[] = {
+    /* The rest of the block is literal text. */
+    { "*a* *b* *c*\n", 2, 0, 0, "text 0 [ *b* *c*]\n" },
+    { "*a* *b* *c*\n", 4, 0, 0, "text 0 [ *c*]\n" },
+    /* Deeper containers are literal text. */
+    { "> > > a\n", 0, 2, 0, "text 0 [> a]\n" },
+    { "- - - a\n", 0, 2, 0, "text 0 [- a]\n" },
+    /* Further definitions are paragraph text. */
+    { "[a]: /a\n[b]: /b\n\n[a] [b]\n", 0, 0, 1, "text 0 [[b]: /b]\n" },
+};
+
+static void
+test_limit_case(unsigned i, unsigned flags)
+{
+    const char* doc = limit_cases[i].doc;
+    MD_PARSER parser;
+    DUMP dump;
+
+    snprintf(current_case, sizeof(current_case), "resource limits: case #%u, flags 0x%x", i, flags);
+    init_parser(&parser, flags);
+
+    /* Without the limits, the case does not produce the expected text. */
+    dump_init(&dump);
+    if(md_parse(doc, (MD_SIZE) strlen(doc), &parser, &dump) != 0) {
+        /* The parser may have been built with MD4C_FIXED_FLAGS. */
+        dump_fini(&dump);
+        return;
+    }
+    CHECK(!dump_contains(&dump, limit_cases[i].expected));
+    dump_fini(&dump);
+
+    parser.max_marks = limit_cases[i].max_marks;
+    parser.max_nesting = limit_cases[i].max_nesting;
+    parser.max_ref_defs = limit_cases[i].max_ref_defs;
+    dump_init(&dump);
+    CHECK(md_parse(doc, (MD_SIZE) strlen(doc), &parser, &dump) == 0);
+    CHECK(dump_contains(&dump, limit_cases[i].expected));
+    dump_fini(&dump);
+}
+
+/* Whatever the limits, the parsing succeeds and all the APIs agree on the
+ * outcome. (Truncated blocks are parsed by the inline worker threads too.) */
+static void
+test_limits(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    static const unsigned limits[] = { 1, 2, 7 };
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    MD_PARSE_STATS stats;
+    DUMP limited;
+    DUMP dump;
+    char what[64];
+    unsigned i;
+
+    for(i = 0; i < SIZEOF_ARRAY(limits); i++) {
+        init_parser(&parser, flags);
+        parser.max_marks = limits[i];
+        parser.max_nesting = limits[i];
+        parser.max_ref_defs = limits[i];
+        parser.stats = &stats;
+
+        dump_init(&limited);
+        CHECK(md_parse(doc->text, doc->size, &parser, &limited) == 0);
+        CHECK(stats.n_ref_defs <= limits[i]);
+
+        handle = md_parser_create(&parser);
+        CHECK(handle != NULL);
+        if(handle != NULL) {
+            snprintf(what, sizeof(what), "md_parser_feed() with limits %u", limits[i]);
+            dump_init(&dump);
+            CHECK(feed_in_chunks(handle, doc, 17, &dump) == 0);
+            check_dump(&limited, &dump, what);
+            dump_fini(&dump);
+
+            if(md_parser_set_thread_count(handle, 3) == 0) {
+                snprintf(what, sizeof(what), "md_parser_parse() with 3 threads and limits %u", limits[i]);
+                dump_init(&dump);
+                CHECK(md_parser_parse(handle, doc->text, doc->size, &dump) == 0);
+                check_dump(&limited, &dump, what);
+                dump_fini(&dump);
+            }
+            md_parser_destroy(handle);
+        }
+
+        dump_fini(&limited);
+    }
+
+    /* Limits never reached change nothing. */
+    init_parser(&parser, flags);
+    parser.max_memory = (size_t) -1;
+    parser.max_marks = (unsigned) -1;
+    parser.max_nesting = (unsigned) -1;
+    parser.max_ref_defs = (unsigned) -1;
+    dump_init(&dump);
+    CHECK(md_parse(doc->text, doc->size, &parser, &dump) == 0);
+    check_dump(ref, &dump, "md_parse() with limits never reached");
+    dump_fini(&dump);
+}
+
+/* Double MD_PARSER::max_memory until the parsing succeeds. Before that, it
+ * has to fail cleanly with MD_ERROR_LIMIT. The parser may never have more
+ * memory allocated than the limit. */
+static void
+test_memory_limit(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    TEST_ALLOCATOR ta;
+    DUMP dump;
+    size_t max_memory;
+    int ret;
+
+    for(max_memory = 64; ; max_memory *= 2) {
+        init_parser(&parser, flags);
+        test_allocator_init(&ta, 0);
+        parser.allocator = &ta.allocator;
+        parser.max_memory = max_memory;
+
+        dump_init(&dump);
+        ret = md_parse(doc->text, doc->size, &parser, &dump);
+        CHECK(ret == 0  ||  ret == MD_ERROR_LIMIT);
+        CHECK(ta.peak_bytes <= max_memory);
+        if(ret == 0)
+            check_dump(ref, &dump, "md_parse() with MD_PARSER::max_memory");
+        dump_fini(&dump);
+
+        /* The handle may need more memory (for the input fed in chunks) or
+         * less (with MD_FLAG_NOREFDEFS). The buffers it keeps from the
+         * previous document are not counted, so md_parser_parse() may
+         * succeed even if md_parse() has failed, but not vice versa. */
+        handle = md_parser_create(&parser);
+        CHECK(handle != NULL);
+        if(handle != NULL) {
+            int handle_ret;
+
+            dump_init(&dump);
+            handle_ret = feed_in_chunks(handle, doc, 17, &dump);
+            CHECK(handle_ret == 0  ||  handle_ret == MD_ERROR_LIMIT);
+            if(handle_ret == 0)
+                check_dump(ref, &dump, "md_parser_feed() with MD_PARSER::max_memory");
+            dump_fini(&dump);
+
+            dump_init(&dump);
+            handle_ret = md_parser_parse(handle, doc->text, doc->size, &dump);
+            CHECK(handle_ret == 0  ||  (handle_ret == MD_ERROR_LIMIT  &&  ret != 0));
+            if(handle_ret == 0)
+                check_dump(ref, &dump, "md_parser_parse() with MD_PARSER::max_memory");
+            dump_fini(&dump);
+
+            md_parser_destroy(handle);
+        }
+
+        test_allocator_fini(&ta);
+        if(ret == 0)
+            break;
+    }
+}
+
+/* Parse the document with the MD_PARSER::max_memory, and check the outcome. */
+static int
+parse_with_max_memory(const TEST_DOC* doc, const DUMP* ref, unsigned alloc_flags,
+                      size_t max_memory, size_t* p_peak_bytes)
+{
+    MD_PARSER parser;
+    TEST_ALLOCATOR ta;
+    DUMP dump;
+    int ret;
+
+    init_parser(&parser, 0);
+    test_allocator_init(&ta, 0);
+    parser.allocator = &ta.allocator;
+    parser.alloc_flags = alloc_flags;
+    parser.max_memory = max_memory;
+
+    dump_init(&dump);
+    ret = md_parse(doc->text, doc->size, &parser, &dump);
+    CHECK(ret == 0  ||  ret == MD_ERROR_LIMIT);
+    if(ret == 0)
+        check_dump(ref, &dump, "md_parse() with MD_PARSER::max_memory");
+    dump_fini(&dump);
+    if(p_peak_bytes != NULL)
+        *p_peak_bytes = ta.peak_bytes;
+    test_allocator_fini(&ta);
+    return ret;
+}
+
+/* Many reference links: Nothing what is freed during the parsing may be
+ * counted against MD_PARSER::max_memory, and no failed allocation may be
+ * silently taken as "no such reference definition". */
+static void
+test_memory_limit_peak(void)
+{
+    TEST_DOC doc;
+    MD_PARSER parser;
+    DUMP ref;
+    char* text;
+    size_t size = 0;
+    size_t peak_bytes;
+    size_t max_memory;
+    unsigned alloc_flags;
+    int i;
+
+    printf("MD_PARSER::max_memory (peak)\n");
+    snprintf(current_case, sizeof(current_case), "MD_PARSER::max_memory (peak)");
+    text = (char*) malloc(2000 * 80);
+    if(text == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+    for(i = 0; i < 2000; i++)
+        size += (size_t) sprintf(text + size, "[Reference Link Number %d][]\n", i);
+    for(i = 0; i < 2000; i++)
+        size += (size_t) sprintf(text + size, "[reference link number %d]: /url/%d\n", i, i);
+    doc.name = "";
+    doc.text = text;
+    doc.size = (MD_SIZE) size;
+
+    init_parser(&parser, 0);
+    dump_init(&ref);
+    if(md_parse(doc.text, doc.size, &parser, &ref) == 0) {
+        /* The limit is exact. */
+        CHECK(parse_with_max_memory(&doc, &ref, 0, (size_t) -1, &peak_bytes) == 0);
+        CHECK(parse_with_max_memory(&doc, &ref, 0, peak_bytes, NULL) == 0);
+        CHECK(parse_with_max_memory(&doc, &ref, 0, peak_bytes - 1, NULL) == MD_ERROR_LIMIT);
+
+        for(alloc_flags = 0; alloc_flags <= MD_ALLOC_ARENA; alloc_flags += MD_ALLOC_ARENA) {
+            for(max_memory = peak_bytes / 8; max_memory < 2 * peak_bytes; max_memory += max_memory / 8)
+                parse_with_max_memory(&doc, &ref, alloc_flags, max_memory, NULL);
+        }
+    }
+    dump_fini(&ref);
+    free(text);
+}
+
+static void
+test_limit_cases(void)
+{
+    unsigned i, j;
+
+    printf("MD_PARSER::max_marks, max_nesting, max_ref_defs\n");
+    for(i = 0; i < SIZEOF_ARRAY(limit_cases); i++) {
+        for(j = 0; j < SIZEOF_ARRAY(test_flags); j++) {
+            /* (With MD_FLAG_NOREFDEFS, all definitions are text.) */
+            if(!(test_flags[j] & MD_FLAG_NOREFDEFS))
+                test_limit_case(i, test_flags[j]);
+        }
+    }
+}
+
+
+/**********************
+ ***  Cancellation  ***
+ **********************/
+
+/* The parser looks at MD_PARSER::cancel and the clock only every few hundreds
+ * of lines, blocks or marks. Documents this large have always much more left
+ * to do, so they have to be cancelled (and not only the small ones may be). */
+#define CANCEL_MIN_SIZE     (256 * 1024)
+
+/* Check the dump is the beginning of the reference one (made by md_parse()). */
+static void
+check_dump_prefix(const DUMP* ref, const DUMP* dump, const char* what)
+{
+    if(dump->size <= ref->size  &&  (dump->size == 0  ||  memcmp(dump->data, ref->data, dump->size) == 0)) {
+        n_passed++;
+        return;
+    }
+
+    n_failed++;
+    fprintf(stderr, "%s: %s: Callbacks are not a prefix of those of md_parse().\n", current_case, what);
+}
+
+/* A parsing which is cancelled half-way either fails with MD_ERROR_CANCELLED
+ * after some of the callbacks, or succeeds if it has ended before noticing. */
+static void
+check_cancelled(const TEST_DOC* doc, const DUMP* ref, const DUMP* dump, int ret, const char* what)
+{
+    if(ret == 0) {
+        CHECK(doc->size < CANCEL_MIN_SIZE);
+        check_dump(ref, dump, what);
+    } else {
+        CHECK(ret == MD_ERROR_CANCELLED);
+        check_dump_prefix(ref, dump, what);
+    }
+}
+
+static void
+test_cancel(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    volatile int cancel = 0;
+    DUMP dump;
+    char what[64];
+    int ret;
+    int i;
+
+    init_parser(&parser, flags);
+    parser.cancel = &cancel;
+
+    /* Cancelled before the parsing starts: No callback is called. */
+    cancel = 1;
+    dump_init(&dump);
+    CHECK(md_parse(doc->text, doc->size, &parser, &dump) == MD_ERROR_CANCELLED);
+    CHECK(dump.n_events == 0);
+    dump_fini(&dump);
+
+    /* Cancelled from a callback: The callbacks stop. */
+    cancel = 0;
+    dump_init(&dump);
+    dump.cancel = &cancel;
+    dump.cancel_at = 1 + ref->n_events / 4;
+    ret = md_parse(doc->text, doc->size, &parser, &dump);
+    check_cancelled(doc, ref, &dump, ret, "md_parse() cancelled from a callback");
+    CHECK(dump.n_events >= dump.cancel_at);
+    dump_fini(&dump);
+
+    /* A handle parses normally after a cancelled parsing, with one thread and
+     * with four. */
+    handle = md_parser_create(&parser);
+    CHECK(handle != NULL);
+    if(handle == NULL)
+        return;
+
+    for(i = 1; i <= 4; i += 3) {
+        /* (Without threads (MD4C_NO_THREADS), more than one is refused.) */
+        if(md_parser_set_thread_count(handle, i) != 0)
+            break;
+
+        cancel = 1;
+        dump_init(&dump);
+        CHECK(md_parser_parse(handle, doc->text, doc->size, &dump) == MD_ERROR_CANCELLED);
+        CHECK(dump.n_events == 0);
+        dump_fini(&dump);
+
+        cancel = 0;
+        snprintf(what, sizeof(what), "md_parser_parse() with %d threads cancelled from a callback", i);
+        dump_init(&dump);
+        dump.cancel = &cancel;
+        dump.cancel_at = 1 + ref->n_events / 4;
+        ret = md_parser_parse(handle, doc->text, doc->size, &dump);
+        check_cancelled(doc, ref, &dump, ret, what);
+        dump_fini(&dump);
+
+        cancel = 0;
+        snprintf(what, sizeof(what), "md_parser_parse() with %d threads after a cancellation", i);
+        dump_init(&dump);
+        CHECK(md_parser_parse(handle, doc->text, doc->size, &dump) == 0);
+        check_dump(ref, &dump, what);
+        dump_fini(&dump);
+
+        snprintf(what, sizeof(what), "md_parser_feed() with %d threads after a cancellation", i);
+        dump_init(&dump);
+        CHECK(feed_in_chunks(handle, doc, 4096, &dump) == 0);
+        check_dump(ref, &dump, what);
+        dump_fini(&dump);
+    }
+
+    md_parser_destroy(handle);
+}
+
+static void
+test_time_limit(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    DUMP dump;
+    int ret;
+
+    /* A limit never reached changes nothing. */
+    init_parser(&parser, flags);
+    parser.time_limit = 1000.0;
+    dump_init(&dump);
+    CHECK(md_parse(doc->text, doc->size, &parser, &dump) == 0);
+    check_dump(ref, &dump, "md_parse() with MD_PARSER::time_limit never reached");
+    dump_fini(&dump);
+
+    /* A tiny one stops the parsing of a large document. */
+    parser.time_limit = 1e-9;
+    dump_init(&dump);
+    ret = md_parse(doc->text, doc->size, &parser, &dump);
+    check_cancelled(doc, ref, &dump, ret, "md_parse() with a tiny MD_PARSER::time_limit");
+    dump_fini(&dump);
+
+    /* Also in the inline worker threads. */
+    handle = md_parser_create(&parser);
+    CHECK(handle != NULL);
+    if(handle == NULL)
+        return;
+    if(md_parser_set_thread_count(handle, 4) == 0) {
+        dump_init(&dump);
+        ret = md_parser_parse(handle, doc->text, doc->size, &dump);
+        check_cancelled(doc, ref, &dump, ret, "md_parser_parse() with 4 threads and a tiny MD_PARSER::time_limit");
+        dump_fini(&dump);
+    }
+    md_parser_destroy(handle);
+}
+
+
+/**********************
+ ***  End of Input  ***
+ **********************/
+
+/* Documents ending where the byte following the end would change the result
+ * if the parser read it. */
+static const struct {
+    const char* text;
+    MD_SIZE size;
+    unsigned flags;
+} input_end_cases[] = {
+    { "[a](b)", 5, 0 },
+    { "1.", 1, 0 },
+    { "hi @mex", 6, MD_FLAG_MENTIONS },
+    { "me@example.com@x", 14, MD_FLAG_MENTIONS },
+};
+
+static void
+test_input_end(void)
+{
+    char text[32];
+    MD_PARSER parser;
+    DUMP ref;
+    DUMP dump;
+    unsigned i;
+
+    printf("End of input\n");
+    for(i = 0; i < SIZEOF_ARRAY(input_end_cases); i++) {
+        MD_SIZE size = input_end_cases[i].size;
+
+        snprintf(current_case, sizeof(current_case), "End of input: case #%u", i);
+        init_parser(&parser, input_end_cases[i].flags);
+
+        /* The same document followed by a byte the parser ignores. */
+        memcpy(text, input_end_cases[i].text, size);
+        text[size] = '\0';
+        dump_init(&ref);
+        if(md_parse(text, size, &parser, &ref) == 0) {
+            dump_init(&dump);
+            CHECK(md_parse(input_end_cases[i].text, size, &parser, &dump) == 0);
+            check_dump(&ref, &dump, "md_parse()");
+            dump_fini(&dump);
+        }
+        dump_fini(&ref);
+    }
+}
+
+
+/******************
+ ***  Entities  ***
+ ******************/
+
+static const struct {
+    const char* text;
+    int ret;
+    unsigned n_codepoints;
+    unsigned codepoints[2];
+} decode_entity_cases[] = {
+    { "&amp;", 0, 1, { 0x26, 0 } },
+    { "&NotEqualTilde;", 0, 2, { 0x2242, 0x338 } },
+    { "&#65;", 0, 1, { 0x41, 0 } },
+    { "&#X10fFfF;", 0, 1, { 0x10ffff, 0 } },
+    /* CommonMark wants U+FFFD for these. */
+    { "&#0;", 0, 1, { 0xfffd, 0 } },
+    { "&#x110000;", 0, 1, { 0xfffd, 0 } },
+    /* Well-formed, but HTML does not define it. */
+    { "&bogus;", 0, 0, { 0, 0 } },
+    /* Not entities at all. */
+    { "", -1, 0, { 0, 0 } },
+    { "&amp", -1, 0, { 0, 0 } },
+    { "&amp; ", -1, 0, { 0, 0 } },
+    { "amp;", -1, 0, { 0, 0 } },
+    { "&#;", -1, 0, { 0, 0 } },
+    { "&#x;", -1, 0, { 0, 0 } },
+    { "&#12345678;", -1, 0, { 0, 0 } },
+    { "&#x1234567;", -1, 0, { 0, 0 } },
+};
+
+static void
+test_decode_entity(void)
+{
+    MD_ENTITY_DETAIL detail;
+    unsigned i;
+
+    printf("md_decode_entity()\n");
+    for(i = 0; i < SIZEOF_ARRAY(decode_entity_cases); i++) {
+        const char* text = decode_entity_cases[i].text;
+        int ret;
+
+        snprintf(current_case, sizeof(current_case), "md_decode_entity(\"%s\")", text);
+        ret = md_decode_entity(text, (MD_SIZE) strlen(text), &detail);
+        CHECK(ret == decode_entity_cases[i].ret);
+        if(ret == 0) {
+            CHECK(detail.n_codepoints == decode_entity_cases[i].n_codepoints);
+            CHECK(detail.codepoints[0] == decode_entity_cases[i].codepoints[0]);
+            CHECK(detail.codepoints[1] == decode_entity_cases[i].codepoints[1]);
+        }
+    }
+}
+
+/* With MD_PARSER::entity set, every entity goes to it (and the detail is
+ * what md_decode_entity() says) and none to text(). */
+static void
+check_entity_calls(const DUMP* ref, const DUMP* dump)
+{
+    CHECK(dump->n_entity_calls == ref->n_entity_texts);
+    CHECK(dump->n_entity_texts == dump->n_entity_calls);
+}
+
+static void
+test_entity(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    MD_PARSER parser;
+    MD_PARSER_HANDLE* handle;
+    MD_TREE* tree;
+    MD_EVENT events[16];
+    SINK sink;
+    DUMP normalized_ref;
+    DUMP dump;
+    void* log;
+    size_t log_size;
+
+    init_parser(&parser, flags);
+    parser.entity = dump_entity;
+
+    dump_init(&dump);
+    CHECK(md_parse(doc->text, doc->size, &parser, &dump) == 0);
+    check_dump(ref, &dump, "md_parse() with MD_PARSER::entity");
+    check_entity_calls(ref, &dump);
+    dump_fini(&dump);
+
+    /* Older parsers have no such member. */
+    parser.abi_version = 5;
+    dump_init(&dump);
+    CHECK(md_parse(doc->text, doc->size, &parser, &dump) == 0);
+    check_dump(ref, &dump, "md_parse() with MD_PARSER::entity and abi_version 5");
+    CHECK(dump.n_entity_calls == 0);
+    dump_fini(&dump);
+    parser.abi_version = MD_PARSER_ABI_VERSION;
+
+    dump_init(&normalized_ref);
+    normalized_ref.normalize = 1;
+    CHECK(md_parse(doc->text, doc->size, &parser, &normalized_ref) == 0);
+
+    CHECK(md_parse_to_tree(doc->text, doc->size, &parser, &tree) == 0);
+    if(tree != NULL) {
+        dump_init(&dump);
+        CHECK(md_tree_replay(tree, &parser, &dump) == 0);
+        check_dump(&normalized_ref, &dump, "md_tree_replay() with MD_PARSER::entity");
+        check_entity_calls(ref, &dump);
+        dump_fini(&dump);
+        md_tree_free(tree);
+    }
+
+    CHECK(md_parse_to_event_log(doc->text, doc->size, &parser, &log, &log_size) == 0);
+    if(log != NULL) {
+        dump_init(&dump);
+        CHECK(md_event_log_replay(log, log_size, doc->text, doc->size, &parser, &dump) == 0);
+        check_dump(&normalized_ref, &dump, "md_event_log_replay() with MD_PARSER::entity");
+        check_entity_calls(ref, &dump);
+        dump_fini(&dump);
+        md_event_log_free(log, &parser);
+    }
+
+    dump_fini(&normalized_ref);
+
+    /* The events carry no detail: The sink gets MD_TEXT_ENTITY. */
+    handle = md_parser_create(&parser);
+    CHECK(handle != NULL);
+    if(handle != NULL) {
+        CHECK(md_parser_set_event_sink(handle, events, SIZEOF_ARRAY(events), sink_flush) == 0);
+        memset(&sink, 0, sizeof(SINK));
+        sink.dump = &dump;
+        sink.capacity = SIZEOF_ARRAY(events);
+        dump_init(&dump);
+        CHECK(md_parser_parse(handle, doc->text, doc->size, &sink) == 0);
+        check_dump(ref, &dump, "event sink with MD_PARSER::entity");
+        CHECK(dump.n_entity_calls == 0);
+        CHECK(dump.n_entity_texts == ref->n_entity_texts);
+        dump_fini(&dump);
+        md_parser_destroy(handle);
+    }
+}
+
+/* The event log refers to the input: Replayed with another text (of the same
+ * size), what has been an entity may be not anymore. It then goes to text(). */
+static void
+test_entity_replay_other_text(void)
+{
+    static const char text[] = "a &amp; b\n";
+    static const char other_text[] = "a &&&&& b\n";
+    MD_PARSER parser;
+    DUMP dump;
+    void* log;
+    size_t log_size;
+
+    printf("MD_PARSER::entity in md_event_log_replay() of another text\n");
+    snprintf(current_case, sizeof(current_case), "MD_PARSER::entity in md_event_log_replay() of another text");
+    init_parser(&parser, 0);
+    parser.entity = dump_entity;
+    if(md_parse_to_event_log(text, (MD_SIZE) strlen(text), &parser, &log, &log_size) != 0) {
+        /* The parser may have been built with MD4C_FIXED_FLAGS. */
+        return;
+    }
+
+    dump_init(&dump);
+    CHECK(md_event_log_replay(log, log_size, other_text, (MD_SIZE) strlen(other_text), &parser, &dump) == 0);
+    CHECK(dump.n_entity_calls == 0);
+    CHECK(dump.n_entity_texts == 1);
+    CHECK(dump_contains(&dump, "[&&&&&]"));
+    dump_fini(&dump);
+
+    md_event_log_free(log, &parser);
+}
+
+
+/***************************
+ ***  HTML into Buffers  ***
+ ***************************/
+
+static void
+html_output(const MD_CHAR* text, MD_SIZE size, void* userdata)
+{
+    dump_append((DUMP*) userdata, text, size);
+}
+
+/* The output of plain md_html() to compare with (only the data is used). */
+static int
+render_html(const TEST_DOC* doc, unsigned flags, DUMP* html)
+{
+    dump_init(html);
+    if(md_html(doc->text, doc->size, html_output, html, flags, 0) != 0) {
+        /* The parser may have been built with MD4C_FIXED_FLAGS. */
+        dump_fini(html);
+        return -1;
+    }
+    return 0;
+}
+
+/* (Unlike memcmp(), it takes NULL data if the size is zero.) */
+static int
+is_html_prefix(const DUMP* html, const char* data, size_t size)
+{
+    return (size <= html->size  &&  (size == 0  ||  memcmp(data, html->data, size) == 0));
+}
+
+static char*
+alloc_buffer(size_t size)
+{
+    char* buffer = (char*) malloc(size + 1);
+
+    if(buffer == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+    return buffer;
+}
+
+static void
+test_html_to_buffer(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    DUMP html;
+    char* buffer;
+    MD_SIZE half;
+    MD_SIZE size;
+
+    if(render_html(doc, flags, &html) != 0)
+        return;
+    buffer = alloc_buffer(html.size);
+
+    /* Large enough. */
+    CHECK(md_html_to_buffer(doc->text, doc->size, buffer, (MD_SIZE) html.size, flags, 0, &size) == 0);
+    CHECK(size == html.size);
+    CHECK(is_html_prefix(&html, buffer, html.size));
+
+    /* Just the size. */
+    size = 0;
+    CHECK(md_html_to_buffer(doc->text, doc->size, NULL, 0, flags, 0, &size) == 0);
+    CHECK(size == html.size);
+
+    /* Truncated: The prefix, and not a byte more. */
+    half = (MD_SIZE) html.size / 2;
+    memset(buffer, '#', html.size + 1);
+    CHECK(md_html_to_buffer(doc->text, doc->size, buffer, half, flags, 0, &size) == 0);
+    CHECK(size == html.size);
+    CHECK(is_html_prefix(&html, buffer, half));
+    CHECK(buffer[half] == '#');
+
+    free(buffer);
+    dump_fini(&html);
+}
+
+static void
+test_html_to_buffer_resume(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    static const MD_SIZE chunk_sizes[] = { 1, 7, 4096 };
+    DUMP html;
+    char* buffer;
+    MD_HTML_RESUME* resume;
+    MD_SIZE written;
+    size_t size;
+    unsigned i;
+    int ret;
+
+    if(render_html(doc, flags, &html) != 0)
+        return;
+    buffer = alloc_buffer(html.size);
+
+    /* All at once. */
+    CHECK(md_html_to_buffer_begin(doc->text, doc->size, buffer, (MD_SIZE) html.size,
+                                  flags, 0, &written, &resume) == 0);
+    CHECK(written == html.size);
+    CHECK(resume == NULL);
+    CHECK(is_html_prefix(&html, buffer, html.size));
+
+    /* In chunks (each written behind the previous one). */
+    for(i = 0; i < SIZEOF_ARRAY(chunk_sizes); i++) {
+        MD_SIZE chunk_size = chunk_sizes[i];
+
+        memset(buffer, '#', html.size + 1);
+        ret = md_html_to_buffer_begin(doc->text, doc->size, buffer, chunk_size,
+                                      flags, 0, &written, &resume);
+        size = written;
+        /* (Each call but the last one fills the chunk.) */
+        while(ret == 1  &&  written == chunk_size  &&  size < html.size) {
+            ret = md_html_to_buffer_resume(resume, buffer + size, chunk_size, &written);
+            size += written;
+        }
+        if(ret == 1)
+            md_html_to_buffer_abort(resume);
+        CHECK(ret == 0);
+        CHECK(size == html.size);
+        CHECK(is_html_prefix(&html, buffer, html.size));
+        CHECK(buffer[html.size] == '#');
+    }
+
+    /* Not interested in the rest (after a part of it). */
+    if(html.size >= 4) {
+        ret = md_html_to_buffer_begin(doc->text, doc->size, buffer, 1,
+                                      flags, 0, &written, &resume);
+        CHECK(ret == 1);
+        if(ret == 1) {
+            CHECK(md_html_to_buffer_resume(resume, buffer + 1, 2, &written) == 1);
+            CHECK(written == 2);
+            CHECK(is_html_prefix(&html, buffer, 3));
+            md_html_to_buffer_abort(resume);
+        }
+    }
+
+    free(buffer);
+    dump_fini(&html);
+}
+
+
+/**********************
+ ***  HTML Segments  ***
+ **********************/
+
+/* Segments referring to the input are the long runs of it. */
+static int
+segment_in_input(const TEST_DOC* doc, const MD_HTML_SEGMENT* segment)
+{
+    return (doc->text <= segment->text  &&  segment->text + segment->size <= doc->text + doc->size);
+}
+
+static void
+test_html_to_segments(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    MD_HTML_SEGMENTS* segments;
+    DUMP html;
+    DUMP dump;
+    size_t total_size = 0;
+    unsigned i;
+
+    if(render_html(doc, flags, &html) != 0)
+        return;
+
+    CHECK(md_html_to_segments(doc->text, doc->size, flags, 0, &segments) == 0);
+    if(segments != NULL) {
+        dump_init(&dump);
+        for(i = 0; i < segments->n_segments; i++) {
+            const MD_HTML_SEGMENT* segment = &segments->segments[i];
+
+            if(segment_in_input(doc, segment))
+                CHECK(segment->size >= 64);
+            dump_append(&dump, segment->text, segment->size);
+            total_size += segment->size;
+        }
+        CHECK(dump.size == html.size);
+        CHECK(is_html_prefix(&html, dump.data, dump.size));
+        CHECK(segments->total_size == total_size);
+        dump_fini(&dump);
+        md_html_segments_free(segments);
+    }
+
+    dump_fini(&html);
+}
+
+/* A run of 64 bytes of text or more is not copied. */
+static void
+test_html_segments_refer_input(void)
+{
+    static const char text[] =
+        "Some *text*, and a longer run of it:\n"
+        "0123456789012345678901234567890123456789012345678901234567890123456789\n";
+    TEST_DOC doc;
+    DUMP html;
+    MD_HTML_SEGMENTS* segments;
+    const char* run = strchr(text, '\n') + 1;
+    int found = 0;
+    unsigned i;
+
+    snprintf(current_case, sizeof(current_case), "md_html_to_segments(): referring the input");
+    doc.name = "";
+    doc.text = text;
+    doc.size = (MD_SIZE) strlen(text);
+    if(render_html(&doc, 0, &html) != 0)
+        return;
+    dump_fini(&html);
+
+    CHECK(md_html_to_segments(doc.text, doc.size, 0, 0, &segments) == 0);
+    if(segments == NULL)
+        return;
+    for(i = 0; i < segments->n_segments; i++) {
+        const MD_HTML_SEGMENT* segment = &segments->segments[i];
+
+        if(segment_in_input(&doc, segment)  &&  segment->text <= run  &&  run + 70 <= segment->text + segment->size)
+            found = 1;
+    }
+    CHECK(found);
+    md_html_segments_free(segments);
+}
+
+#ifdef TEST_MALLOC_HOOKS
+/* Fail each allocation in turn (of the parser too). */
+static void
+test_html_to_segments_alloc_failures(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    MD_HTML_SEGMENTS* segments;
+    unsigned fail_at;
+    int ret;
+
+    /* Large documents would take too long. */
+    if(doc->size > 4096)
+        return;
+
+    for(fail_at = 1; ; fail_at++) {
+        malloc_hooks_begin(fail_at);
+        ret = md_html_to_segments(doc->text, doc->size, flags, 0, &segments);
+        if(ret == 0)
+            md_html_segments_free(segments);
+        malloc_hooks_end();
+
+        CHECK(ret == 0  ||  ret == -1);
+        if(ret != 0)
+            CHECK(segments == NULL);
+        CHECK(malloc_live == 0);
+
+        /* Stop when no allocation has failed. */
+        if(malloc_calls < fail_at)
+            break;
+    }
+}
+#endif
+
+
+/************************
+ ***  Failing Memory  ***
+ ************************/
+
+/* Fail each allocation in turn. The parsing has to fail cleanly (returning
+ * -1 and freeing all it has allocated), or to succeed normally if the failed
+ * allocation was not essential. */
+static void
+test_alloc_failures(const TEST_DOC* doc, unsigned flags, const DUMP* ref)
+{
+    MD_PARSER parser;
+    TEST_ALLOCATOR ta;
+    DUMP dump;
+    unsigned alloc_flags;
+    unsigned fail_at;
+    int ret;
+
+    /* Large documents would take too long. */
+    if(doc->size > 4096)
+        return;
+
+    for(alloc_flags = 0; alloc_flags <= MD_ALLOC_ARENA; alloc_flags += MD_ALLOC_ARENA) {
+        for(fail_at = 1; ; fail_at++) {
+            init_parser(&parser, flags);
+            test_allocator_init(&ta, fail_at);
+            parser.allocator = &ta.allocator;
+            parser.alloc_flags = alloc_flags;
+
+            dump_init(&dump);
+            ret = md_parse(doc->text, doc->size, &parser, &dump);
+            CHECK(ret == 0  ||  ret == -1);
+            if(ret == 0)
+                check_dump(ref, &dump, "md_parse() with a failed allocation");
+            dump_fini(&dump);
+            test_allocator_fini(&ta);
+
+            /* Stop when no allocation has failed. */
+            if(ta.n_calls < fail_at)
+                break;
+        }
+    }
+}
+
+
+/**********************
+ ***  Main Program  ***
+ **********************/
+
+int
+main(int argc, char** argv)
+{
+    unsigned i;
+
+    for(i = 0; i < SIZEOF_ARRAY(builtin_docs); i++) {
+        snprintf(builtin_names[i], sizeof(builtin_names[i]), "#%u", i);
+        add_doc(builtin_names[i], builtin_docs[i], (MD_SIZE) strlen(builtin_docs[i]));
+    }
+    add_large_doc();
+    for(i = 1; i < (unsigned) argc; i++) {
+        if(load_doc(argv[i]) != 0)
+            return 1;
+    }
+
+    run_test("md_parser_parse()", test_handle);
+    run_test("md_parser_begin(), md_parser_feed(), md_parser_finish()", test_stream);
+    run_test("md_parser_reparse()", test_reparse);
+    test_reparse_memory();
+    run_test("md_parser_set_thread_count()", test_threads);
+    run_test("md_parser_set_event_sink()", test_event_sink);
+    run_test("md_parse_to_tree(), md_tree_replay()", test_tree);
+    run_test("md_parse_to_event_log(), md_event_log_replay()", test_event_log);
+    test_event_log_corrupted();
+    run_test("MD_PARSER::ref_dict (unused)", test_unused_ref_dict);
+    test_ref_dict();
+    test_ref_lookup_allocations();
+    run_test("MD_PARSER::stats", test_stats);
+    test_limit_cases();
+    test_memory_limit_peak();
+    run_test("MD_PARSER::max_marks, max_nesting, max_ref_defs (all documents)", test_limits);
+    run_test("MD_PARSER::max_memory", test_memory_limit);
+    run_test("MD_PARSER::cancel", test_cancel);
+    run_test("MD_PARSER::time_limit", test_time_limit);
+    test_input_end();
+    test_decode_entity();
+    run_test("MD_PARSER::entity", test_entity);
+    test_entity_replay_other_text();
+    run_test("md_html_to_buffer()", test_html_to_buffer);
+    run_test("md_html_to_buffer_begin(), md_html_to_buffer_resume(), md_html_to_buffer_abort()",
+             test_html_to_buffer_resume);
+    run_test("md_html_to_segments()", test_html_to_segments);
+    test_html_segments_refer_input();
+#ifdef TEST_MALLOC_HOOKS
+    run_test("md_html_to_segments() with a failed malloc()", test_html_to_segments_alloc_failures);
+#endif
+    run_test("MD_PARSER::allocator failures", test_alloc_failures);
+
+    printf("%u passed, %u failed\n", n_passed, n_failed);
+    return (n_failed == 0 ? 0 : 1);
+}
@@ -0,0 +1,341 @@
+/*
+ * MD4C: Markdown parser for C
+ * (http://github.com/mity/md4c)
+ *
+ * Copyright (c) 2016-2020 Martin Mitas
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/* Tests of the SIMD scanners of the parser.
+ *
+ * The SIMD code is chosen at compile time, so the build compiles this file
+ * once for each instruction set (plain SSE2, -mssse3 and -mavx2), and each
+ * variant compares md_skip_non_mark_chars_simd() with the scalar
+ * md_skip_non_mark_chars_scalar() over the documents given on the command
+ * line and over generated buffers exercising the block boundaries, the tails
+ * and bytes >= 0x80.
+ *
+ * The scanners are static, so we include the parser source directly.
+ */
+
+#include "md4c.c"
+
+#include <stdio.h>
+
+
+#if defined MD_SIMD_SSE2
+
+/*************************
+ ***  Checks & Report  ***
+ *************************/
+
+static unsigned n_passed = 0;
+static unsigned n_failed = 0;
+
+/* Description of the current test case for the failure reports. */
+static char current_case[256] = "";
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if(cond) {                                                          \
+            n_passed++;                                                     \
+        } else {                                                            \
+            n_failed++;                                                     \
+            fprintf(stderr, "%s:%d: %s: Check failed: %s\n",                \
+                    __FILE__, __LINE__, current_case, #cond);               \
+        }                                                                   \
+    } while(0)
+
+
+/*********************
+ ***  Scan Checks  ***
+ *********************/
+
+/* Flag sets giving different mark_char_map[] (and so different SIMD paths:
+ * MD_FLAG_COLLAPSEWHITESPACE disables the alnum prefilter). */
+static const unsigned test_flags[] = {
+    0,
+    MD_DIALECT_GITHUB,
+    MD_DIALECT_GITHUB | MD_FLAG_LATEXMATHSPANS | MD_FLAG_WIKILINKS | MD_FLAG_MENTIONS,
+    MD_FLAG_COLLAPSEWHITESPACE | MD_FLAG_STRIKETHROUGH,
+};
+
+static void
+init_ctx(MD_CTX* ctx, unsigned flags)
+{
+    memset(ctx, 0, sizeof(MD_CTX));
+    ctx->parser.flags = flags;
+    md_build_mark_char_map(ctx);
+}
+
+/* Compare the scanners over [off, end) of the buffer. The buffer is allocated
+ * with the exact size, so a memory checker catches any read past its end. */
+static void
+check_scan(MD_CTX* ctx, const CHAR* text, SZ size, OFF off, OFF end)
+{
+    OFF simd_ret, scalar_ret;
+
+    ctx->text = text;
+    ctx->size = size;
+
+    simd_ret = md_skip_non_mark_chars_simd(ctx, off, end);
+    scalar_ret = md_skip_non_mark_chars_scalar(ctx, off, end);
+    if(simd_ret != scalar_ret) {
+        fprintf(stderr, "%s: [%u, %u): SIMD scanner stops at %u, scalar one at %u.\n",
+                current_case, (unsigned) off, (unsigned) end,
+                (unsigned) simd_ret, (unsigned) scalar_ret);
+    }
+    CHECK(simd_ret == scalar_ret);
+}
+
+static CHAR*
+copy_buffer(const CHAR* text, SZ size)
+{
+    /* (malloc(0) may return NULL.) */
+    CHAR* buffer = (CHAR*) malloc(size > 0 ? size : 1);
+
+    if(buffer == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+    memcpy(buffer, text, size);
+    return buffer;
+}
+
+
+/*******************
+ ***  The Tests  ***
+ *******************/
+
+/* Range lengths around the 16- and 32-byte blocks. */
+static const unsigned test_lengths[] = {
+    0, 1, 15, 16, 17, 31, 32, 33, 47, 48, 63, 64, 65, 100
+};
+
+/* Scan from each offset of the document, up to its end and up to various
+ * range lengths. */
+static void
+test_doc(const char* name, const CHAR* text, SZ size)
+{
+    CHAR* buffer = copy_buffer(text, size);
+    MD_CTX ctx;
+    unsigned i, j;
+    OFF off;
+
+    for(i = 0; i < SIZEOF_ARRAY(test_flags); i++) {
+        snprintf(current_case, sizeof(current_case), "%s, flags 0x%x", name, test_flags[i]);
+        init_ctx(&ctx, test_flags[i]);
+
+        for(off = 0; off < size; off++) {
+            check_scan(&ctx, buffer, size, off, size);
+            for(j = 0; j < SIZEOF_ARRAY(test_lengths); j++) {
+                if(off + test_lengths[j] <= size)
+                    check_scan(&ctx, buffer, size, off, off + test_lengths[j]);
+            }
+        }
+    }
+
+    free(buffer);
+}
+
+/* Check each byte value in each lane of the blocks and in the scalar tail:
+ * First in buffers filled with it, then with it placed among the bytes the
+ * SIMD paths treat specially (alphanumerics, spaces, punctuation, bytes
+ * >= 0x80). */
+static void
+test_byte_positions(void)
+{
+    static const CHAR fillers[] = "aZ09 \t,-/=+\x7f\x80\xbf\xff";
+    static const unsigned sizes[] = { 16, 17, 31, 32, 33, 64, 65 };
+    static const unsigned starts[] = { 0, 1, 15, 16, 17 };
+    MD_CTX ctx;
+    CHAR text[65];
+    CHAR* buffer;
+    unsigned i, j, k;
+    unsigned ch, fill;
+    unsigned pos;
+
+    for(i = 0; i < SIZEOF_ARRAY(test_flags); i++) {
+        init_ctx(&ctx, test_flags[i]);
+
+        for(j = 0; j < SIZEOF_ARRAY(sizes); j++) {
+            SZ size = sizes[j];
+
+            for(ch = 0; ch < 256; ch++) {
+                snprintf(current_case, sizeof(current_case),
+                         "flags 0x%x, %u bytes of 0x%02x", test_flags[i], (unsigned) size, ch);
+                memset(text, (int) ch, size);
+                buffer = copy_buffer(text, size);
+                for(k = 0; k < SIZEOF_ARRAY(starts); k++)
+                    check_scan(&ctx, buffer, size, starts[k], size);
+                free(buffer);
+            }
+
+            for(fill = 0; fill < sizeof(fillers) - 1; fill++) {
+                if(ctx.mark_char_map[(unsigned char) fillers[fill]])
+                    continue;
+
+                for(ch = 0; ch < 256; ch++) {
+                    for(pos = 0; pos < size; pos++) {
+                        snprintf(current_case, sizeof(current_case),
+                                 "flags 0x%x, %u bytes of 0x%02x, 0x%02x at %u",
+                                 test_flags[i], (unsigned) size,
+                                 (unsigned char) fillers[fill], ch, pos);
+                        memset(text, fillers[fill], size);
+                        text[pos] = (CHAR) ch;
+                        buffer = copy_buffer(text, size);
+                        for(k = 0; k < SIZEOF_ARRAY(starts)  &&  starts[k] <= pos; k++)
+                            check_scan(&ctx, buffer, size, starts[k], size);
+                        free(buffer);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* Pseudo-random buffers with sparse mark chars among the bytes the SIMD
+ * paths treat specially. (A fixed generator, so failures are reproducible.) */
+static void
+test_random(void)
+{
+    static const CHAR fillers[] = "aZ09 \t,-/=+\x7f\x80\xbf\xc3\xa9\xff";
+    unsigned seed = 1;
+    MD_CTX ctx;
+    CHAR text[256];
+    unsigned i, round;
+
+    for(i = 0; i < SIZEOF_ARRAY(test_flags); i++) {
+        init_ctx(&ctx, test_flags[i]);
+
+        for(round = 0; round < 2000; round++) {
+            SZ size;
+            CHAR* buffer;
+            OFF off;
+            unsigned k;
+
+            seed = seed * 1103515245 + 12345;
+            size = (seed >> 8) % sizeof(text);
+            for(k = 0; k < size; k++) {
+                seed = seed * 1103515245 + 12345;
+                if(((seed >> 16) % 64) == 0)
+                    text[k] = (CHAR) ((seed >> 8) & 0xff);
+                else
+                    text[k] = fillers[(seed >> 16) % (sizeof(fillers) - 1)];
+            }
+
+            snprintf(current_case, sizeof(current_case),
+                     "flags 0x%x, random buffer #%u", test_flags[i], round);
+            buffer = copy_buffer(text, size);
+            for(off = 0; off < size; off++)
+                check_scan(&ctx, buffer, size, off, size);
+            free(buffer);
+        }
+    }
+}
+
+
+/**********************
+ ***  Main Program  ***
+ **********************/
+
+static int
+load_and_test_doc(const char* path)
+{
+    FILE* f;
+    CHAR* text = NULL;
+    SZ size = 0;
+    SZ alloc = 0;
+    size_t n;
+
+    f = fopen(path, "rb");
+    if(f == NULL) {
+        fprintf(stderr, "Cannot open %s.\n", path);
+        return -1;
+    }
+
+    while(1) {
+        if(size + 4096 > alloc) {
+            alloc = alloc + alloc / 2 + 4096;
+            text = (CHAR*) realloc(text, alloc);
+            if(text == NULL) {
+                fprintf(stderr, "Out of memory.\n");
+                exit(1);
+            }
+        }
+        n = fread(text + size, 1, 4096, f);
+        if(n == 0)
+            break;
+        size += (SZ) n;
+    }
+    fclose(f);
+
+    test_doc(path, text, size);
+    free(text);
+    return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+    int i;
+
+#if defined MD_SIMD_AVX2  &&  defined __GNUC__
+    if(!__builtin_cpu_supports("avx2")) {
+        printf("Skipped (the CPU does not support AVX2).\n");
+        return 0;
+    }
+#elif defined MD_SIMD_SSSE3  &&  defined __GNUC__
+    if(!__builtin_cpu_supports("ssse3")) {
+        printf("Skipped (the CPU does not support SSSE3).\n");
+        return 0;
+    }
+#endif
+
+    for(i = 1; i < argc; i++) {
+        if(load_and_test_doc(argv[i]) != 0)
+            return 1;
+    }
+    test_byte_positions();
+    test_random();
+
+#if defined MD_SIMD_AVX2
+    printf("AVX2: ");
+#elif defined MD_SIMD_SSSE3
+    printf("SSSE3: ");
+#else
+    printf("SSE2: ");
+#endif
+    printf("%u passed, %u failed\n", n_passed, n_failed);
+    return (n_failed == 0 ? 0 : 1);
+}
+
+#else   /* #if defined MD_SIMD_SSE2 */
+
+int
+main(int argc, char** argv)
+{
+    MD_UNUSED(argc);
+    MD_UNUSED(argv);
+    printf("Skipped (no SIMD scanners in this build).\n");
+    return 0;
+}
+
+#endif  /* #if defined MD_SIMD_SSE2 */
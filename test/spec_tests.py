@@ -99,7 +99,7 @@ def get_tests(specfile):
                 example_number = example_number + 1
                 end_line = line_number
                 tests.append({
-                    "markdown":''.join(markdown_lines).replace('→',"\t"),
+                    "markdown":''.join(markdown_lines).replace('→',"\t").replace('␀',"\0"),
                     "html":''.join(html_lines).replace('→',"\t"),
                     "example": example_number,
                     "start_line": start_line,